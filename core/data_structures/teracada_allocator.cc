@@ -0,0 +1,556 @@
+/*!
+  @file
+  @author Rishabh Soni (Prevalent Dynamics)
+
+  @brief
+    Implementation of the TeracadaArray buffer allocators
+
+  @details
+    The heap allocator is the default of every array. The arena, pool and huge page allocators are passed
+    per instance to the arrays (and dictionaries) that benefit from them. The allocators only count the calls
+    and the memory held from the system, errors are raised by the arrays when nullptr is returned.
+*/
+
+
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include <sys/mman.h>
+
+#include "teracada_allocator.h"
+
+
+static tc_uint64 alignUp ( tc_uint64 ui64Bytes ) {
+  return ((ui64Bytes + TC_ALLOC_ALIGNMENT - 1) / TC_ALLOC_ALIGNMENT) * TC_ALLOC_ALIGNMENT;
+}
+
+
+/* TeracadaAllocator */
+
+TeracadaAllocator::TeracadaAllocator ( void ) :
+  m_aui64NumAllocs(0),
+  m_aui64NumReallocs(0),
+  m_aui64NumFrees(0),
+  m_aui64NumSystemAllocs(0),
+  m_aui64SystemBytes(0)
+{
+
+}
+
+
+stdTeracadaAllocatorStats TeracadaAllocator::getStats ( void ) const {
+  stdTeracadaAllocatorStats stStats;
+
+  stStats.ui64NumAllocs = m_aui64NumAllocs.load(std::memory_order_relaxed);
+  stStats.ui64NumReallocs = m_aui64NumReallocs.load(std::memory_order_relaxed);
+  stStats.ui64NumFrees = m_aui64NumFrees.load(std::memory_order_relaxed);
+  stStats.ui64NumSystemAllocs = m_aui64NumSystemAllocs.load(std::memory_order_relaxed);
+  stStats.ui64SystemBytes = m_aui64SystemBytes.load(std::memory_order_relaxed);
+
+  return stStats;
+}
+
+
+// The system bytes are still held, they are not reset
+tc_void TeracadaAllocator::resetStats ( void ) {
+  m_aui64NumAllocs.store(0, std::memory_order_relaxed);
+  m_aui64NumReallocs.store(0, std::memory_order_relaxed);
+  m_aui64NumFrees.store(0, std::memory_order_relaxed);
+  m_aui64NumSystemAllocs.store(0, std::memory_order_relaxed);
+}
+
+
+TeracadaAllocator* TeracadaAllocator::getDefault ( void ) {
+  static TeracadaHeapAllocator objHeapAllocator;
+  return &objHeapAllocator;
+}
+
+
+/* TeracadaHeapAllocator */
+
+tc_void* TeracadaHeapAllocator::allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill ) {
+  tc_void* pvBuffer = bZeroFill ? calloc(ui64Bytes, 1) : malloc(ui64Bytes);
+
+  m_aui64NumAllocs.fetch_add(1, std::memory_order_relaxed);
+
+  if ( pvBuffer )
+    recordSystemAlloc(ui64Bytes);
+
+  return pvBuffer;
+}
+
+
+tc_void* TeracadaHeapAllocator::reallocate ( tc_void* pvBuffer, tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes ) {
+  tc_void* pvNewBuffer = realloc(pvBuffer, ui64NewBytes);
+
+  m_aui64NumReallocs.fetch_add(1, std::memory_order_relaxed);
+
+  if ( pvNewBuffer ) {
+    recordSystemAlloc(ui64NewBytes);
+    recordSystemFree(ui64PreBytes);
+  }
+
+  return pvNewBuffer;
+}
+
+
+tc_void TeracadaHeapAllocator::deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) {
+  if ( ! pvBuffer )
+    return;
+
+  free(pvBuffer);
+  m_aui64NumFrees.fetch_add(1, std::memory_order_relaxed);
+  recordSystemFree(ui64Bytes);
+}
+
+
+/* TeracadaArenaAllocator */
+
+TeracadaArenaAllocator::TeracadaArenaAllocator ( tc_uint64 ui64BlockSize ) :
+  m_pstBlock(nullptr),
+  m_ui64BlockSize(std::max<tc_uint64>(ui64BlockSize, TC_ALLOC_ALIGNMENT)),
+  m_pvLastBuffer(nullptr)
+{
+
+}
+
+
+TeracadaArenaAllocator::~TeracadaArenaAllocator ( void ) {
+  stdArenaBlock* pstPrevBlock = nullptr;
+
+  while ( m_pstBlock ) {
+    pstPrevBlock = m_pstBlock->pstPrev;
+    recordSystemFree(ui64BLOCK_HEADER_SIZE + m_pstBlock->ui64Size);
+    free(m_pstBlock);
+    m_pstBlock = pstPrevBlock;
+  }
+}
+
+
+// Start a new block with space for at least ui64MinBytes, the rest of the current block is left unused
+tc_bool TeracadaArenaAllocator::addBlock ( tc_uint64 ui64MinBytes ) {
+  tc_uint64 ui64Size = std::max(m_ui64BlockSize, ui64MinBytes);
+  stdArenaBlock* pstBlock = (stdArenaBlock*) malloc(ui64BLOCK_HEADER_SIZE + ui64Size);
+
+  if ( ! pstBlock ) {
+    TC_LOG(LOG_ERR, "TeracadaArenaAllocator::addBlock(): Failed to allocate an arena block [ SIZE: %lu ]", ui64Size);
+    return false;
+  }
+
+  pstBlock->pstPrev = m_pstBlock;
+  pstBlock->ui64Size = ui64Size;
+  pstBlock->ui64Used = 0;
+
+  m_pstBlock = pstBlock;
+  recordSystemAlloc(ui64BLOCK_HEADER_SIZE + ui64Size);
+
+  return true;
+}
+
+
+tc_void* TeracadaArenaAllocator::carve ( tc_uint64 ui64Bytes ) {
+  tc_uint64 ui64AlignedBytes = alignUp(std::max<tc_uint64>(ui64Bytes, 1));
+  tc_void* pvBuffer = nullptr;
+
+  if ( ! m_pstBlock || (m_pstBlock->ui64Size - m_pstBlock->ui64Used) < ui64AlignedBytes ) {
+    if ( ! addBlock(ui64AlignedBytes) )
+      return nullptr;
+  }
+
+  pvBuffer = getBlockData(m_pstBlock) + m_pstBlock->ui64Used;
+  m_pstBlock->ui64Used += ui64AlignedBytes;
+  m_pvLastBuffer = pvBuffer;
+
+  return pvBuffer;
+}
+
+
+tc_void* TeracadaArenaAllocator::allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill ) {
+  tc_void* pvBuffer = nullptr;
+
+  m_aui64NumAllocs.fetch_add(1, std::memory_order_relaxed);
+
+  if ( isHeapBuffer(ui64Bytes) ) {
+    pvBuffer = bZeroFill ? calloc(ui64Bytes, 1) : malloc(ui64Bytes);
+
+    if ( pvBuffer )
+      recordSystemAlloc(ui64Bytes);
+
+    return pvBuffer;
+  }
+
+  pvBuffer = carve(ui64Bytes);
+
+  if ( pvBuffer && bZeroFill )
+    memset(pvBuffer, 0, ui64Bytes);
+
+  return pvBuffer;
+}
+
+
+tc_void* TeracadaArenaAllocator::reallocate ( tc_void* pvBuffer, tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes ) {
+  tc_uint64 ui64Offset = 0;
+  tc_void* pvNewBuffer = nullptr;
+
+  m_aui64NumReallocs.fetch_add(1, std::memory_order_relaxed);
+
+  // Both sizes are out of the blocks
+  if ( isHeapBuffer(ui64PreBytes) && isHeapBuffer(ui64NewBytes) ) {
+    pvNewBuffer = realloc(pvBuffer, ui64NewBytes);
+
+    if ( pvNewBuffer ) {
+      recordSystemAlloc(ui64NewBytes);
+      recordSystemFree(ui64PreBytes);
+    }
+
+    return pvNewBuffer;
+  }
+
+  // Moving from the blocks to the heap, the old buffer is only reclaimed by reset()
+  if ( isHeapBuffer(ui64NewBytes) ) {
+    pvNewBuffer = malloc(ui64NewBytes);
+
+    if ( ! pvNewBuffer )
+      return nullptr;
+
+    recordSystemAlloc(ui64NewBytes);
+
+    if ( pvBuffer )
+      memcpy(pvNewBuffer, pvBuffer, std::min(ui64PreBytes, ui64NewBytes));
+
+    return pvNewBuffer;
+  }
+
+  // The last buffer of the current block grows/shrinks in place
+  if ( pvBuffer && pvBuffer == m_pvLastBuffer ) {
+    ui64Offset = (tc_byte*) pvBuffer - getBlockData(m_pstBlock);
+
+    if ( (m_pstBlock->ui64Size - ui64Offset) >= alignUp(ui64NewBytes) ) {
+      m_pstBlock->ui64Used = ui64Offset + alignUp(std::max<tc_uint64>(ui64NewBytes, 1));
+      return pvBuffer;
+    }
+  }
+
+  // Otherwise a new buffer is carved, the old one is only reclaimed by reset() (or freed, if it was on the heap)
+  pvNewBuffer = carve(ui64NewBytes);
+
+  if ( pvNewBuffer && pvBuffer ) {
+    memcpy(pvNewBuffer, pvBuffer, std::min(ui64PreBytes, ui64NewBytes));
+
+    if ( isHeapBuffer(ui64PreBytes) ) {
+      free(pvBuffer);
+      recordSystemFree(ui64PreBytes);
+    }
+  }
+
+  return pvNewBuffer;
+}
+
+
+tc_void TeracadaArenaAllocator::deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) {
+  if ( ! pvBuffer )
+    return;
+
+  m_aui64NumFrees.fetch_add(1, std::memory_order_relaxed);
+
+  if ( isHeapBuffer(ui64Bytes) ) {
+    free(pvBuffer);
+    recordSystemFree(ui64Bytes);
+    return;
+  }
+
+  if ( pvBuffer == m_pvLastBuffer ) {
+    m_pstBlock->ui64Used = (tc_byte*) pvBuffer - getBlockData(m_pstBlock);
+    m_pvLastBuffer = nullptr;
+  }
+}
+
+
+tc_void TeracadaArenaAllocator::reset ( void ) {
+  stdArenaBlock* pstPrevBlock = nullptr;
+
+  if ( ! m_pstBlock )
+    return;
+
+  while ( m_pstBlock->pstPrev ) {
+    pstPrevBlock = m_pstBlock->pstPrev;
+    recordSystemFree(ui64BLOCK_HEADER_SIZE + m_pstBlock->ui64Size);
+    free(m_pstBlock);
+    m_pstBlock = pstPrevBlock;
+  }
+
+  m_pstBlock->ui64Used = 0;
+  m_pvLastBuffer = nullptr;
+}
+
+
+/* TeracadaPoolAllocator */
+
+TeracadaPoolAllocator::TeracadaPoolAllocator ( void ) :
+  m_pvSlabs(nullptr),
+  m_pb8SlabCursor(nullptr),
+  m_pb8SlabEnd(nullptr)
+{
+  for ( tc_int iSizeClass = 0; iSizeClass < TC_POOL_NUM_SIZE_CLASSES; iSizeClass++ )
+    m_apvFreeLists[iSizeClass] = nullptr;
+}
+
+
+TeracadaPoolAllocator::~TeracadaPoolAllocator ( void ) {
+  tc_void* pvNextSlab = nullptr;
+
+  // The first bytes of every slab link to the previous slab
+  while ( m_pvSlabs ) {
+    pvNextSlab = *((tc_void**) m_pvSlabs);
+    free(m_pvSlabs);
+    recordSystemFree(TC_ALLOC_ALIGNMENT + TC_POOL_SLAB_SIZE);
+    m_pvSlabs = pvNextSlab;
+  }
+}
+
+
+// Smallest size class holding ui64Bytes, -1 for the buffers larger than TC_POOL_MAX_CLASS_SIZE
+tc_int TeracadaPoolAllocator::getSizeClass ( tc_uint64 ui64Bytes ) {
+  tc_int iSizeClass = 0;
+
+  if ( ui64Bytes > TC_POOL_MAX_CLASS_SIZE )
+    return -1;
+
+  while ( getSizeClassBytes(iSizeClass) < ui64Bytes )
+    iSizeClass++;
+
+  return iSizeClass;
+}
+
+
+tc_void* TeracadaPoolAllocator::allocateFromClass ( tc_int iSizeClass ) {
+  tc_uint64 ui64ClassBytes = getSizeClassBytes(iSizeClass);
+  tc_void* pvBuffer = m_apvFreeLists[iSizeClass];
+  tc_void* pvSlab = nullptr;
+
+  // Recycled buffer, the free list is linked through the first bytes of the free buffers
+  if ( pvBuffer ) {
+    m_apvFreeLists[iSizeClass] = *((tc_void**) pvBuffer);
+    return pvBuffer;
+  }
+
+  // New slab when the current one is used up, its remaining space is left unused
+  if ( (tc_uint64) (m_pb8SlabEnd - m_pb8SlabCursor) < ui64ClassBytes ) {
+    pvSlab = malloc(TC_ALLOC_ALIGNMENT + TC_POOL_SLAB_SIZE);
+
+    if ( ! pvSlab ) {
+      TC_LOG(LOG_ERR, "TeracadaPoolAllocator::allocateFromClass(): Failed to allocate a pool slab [ SIZE: %d ]", TC_POOL_SLAB_SIZE);
+      return nullptr;
+    }
+
+    *((tc_void**) pvSlab) = m_pvSlabs;
+    m_pvSlabs = pvSlab;
+    m_pb8SlabCursor = (tc_byte*) pvSlab + TC_ALLOC_ALIGNMENT;
+    m_pb8SlabEnd = m_pb8SlabCursor + TC_POOL_SLAB_SIZE;
+
+    recordSystemAlloc(TC_ALLOC_ALIGNMENT + TC_POOL_SLAB_SIZE);
+  }
+
+  pvBuffer = m_pb8SlabCursor;
+  m_pb8SlabCursor += ui64ClassBytes;
+
+  return pvBuffer;
+}
+
+
+tc_void* TeracadaPoolAllocator::allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill ) {
+  tc_int iSizeClass = getSizeClass(ui64Bytes);
+  tc_void* pvBuffer = nullptr;
+
+  m_aui64NumAllocs.fetch_add(1, std::memory_order_relaxed);
+
+  if ( iSizeClass < 0 ) {
+    pvBuffer = bZeroFill ? calloc(ui64Bytes, 1) : malloc(ui64Bytes);
+
+    if ( pvBuffer )
+      recordSystemAlloc(ui64Bytes);
+
+    return pvBuffer;
+  }
+
+  pvBuffer = allocateFromClass(iSizeClass);
+
+  if ( pvBuffer && bZeroFill )
+    memset(pvBuffer, 0, ui64Bytes);
+
+  return pvBuffer;
+}
+
+
+tc_void* TeracadaPoolAllocator::reallocate ( tc_void* pvBuffer, tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes ) {
+  tc_int iPreSizeClass = getSizeClass(ui64PreBytes);
+  tc_int iNewSizeClass = getSizeClass(ui64NewBytes);
+  tc_void* pvNewBuffer = nullptr;
+
+  m_aui64NumReallocs.fetch_add(1, std::memory_order_relaxed);
+
+  // Still fits its size class
+  if ( pvBuffer && iPreSizeClass >= 0 && iPreSizeClass == iNewSizeClass )
+    return pvBuffer;
+
+  // Both sizes are out of the pool
+  if ( iPreSizeClass < 0 && iNewSizeClass < 0 ) {
+    pvNewBuffer = realloc(pvBuffer, ui64NewBytes);
+
+    if ( pvNewBuffer ) {
+      recordSystemAlloc(ui64NewBytes);
+      recordSystemFree(ui64PreBytes);
+    }
+
+    return pvNewBuffer;
+  }
+
+  // Moving between the pool and the heap, or between size classes
+  if ( iNewSizeClass < 0 ) {
+    pvNewBuffer = malloc(ui64NewBytes);
+
+    if ( pvNewBuffer )
+      recordSystemAlloc(ui64NewBytes);
+
+  } else {
+    pvNewBuffer = allocateFromClass(iNewSizeClass);
+  }
+
+  if ( ! pvNewBuffer )
+    return nullptr;
+
+  if ( pvBuffer ) {
+    memcpy(pvNewBuffer, pvBuffer, std::min(ui64PreBytes, ui64NewBytes));
+
+    if ( iPreSizeClass < 0 ) {
+      free(pvBuffer);
+      recordSystemFree(ui64PreBytes);
+
+    } else {
+      *((tc_void**) pvBuffer) = m_apvFreeLists[iPreSizeClass];
+      m_apvFreeLists[iPreSizeClass] = pvBuffer;
+    }
+  }
+
+  return pvNewBuffer;
+}
+
+
+tc_void TeracadaPoolAllocator::deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) {
+  tc_int iSizeClass = getSizeClass(ui64Bytes);
+
+  if ( ! pvBuffer )
+    return;
+
+  m_aui64NumFrees.fetch_add(1, std::memory_order_relaxed);
+
+  if ( iSizeClass < 0 ) {
+    free(pvBuffer);
+    recordSystemFree(ui64Bytes);
+    return;
+  }
+
+  *((tc_void**) pvBuffer) = m_apvFreeLists[iSizeClass];
+  m_apvFreeLists[iSizeClass] = pvBuffer;
+}
+
+
+/* TeracadaHugePageAllocator */
+
+// Mapping starting at a huge page boundary: one more huge page is mapped and the mapping is trimmed
+tc_byte* TeracadaHugePageAllocator::mapAligned ( tc_uint64 ui64MappingBytes ) {
+  tc_byte* pb8Mapping = (tc_byte*) mmap(nullptr, (ui64MappingBytes + TC_HUGE_PAGE_SIZE), (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+  tc_byte* pb8Buffer = nullptr;
+
+  if ( pb8Mapping == MAP_FAILED )
+    return nullptr;
+
+  pb8Buffer = (tc_byte*) ((((uintptr_t) pb8Mapping) + TC_HUGE_PAGE_SIZE - 1) & ~((uintptr_t) TC_HUGE_PAGE_SIZE - 1));
+
+  if ( pb8Buffer > pb8Mapping )
+    munmap(pb8Mapping, (pb8Buffer - pb8Mapping));
+
+  if ( (pb8Mapping + ui64MappingBytes + TC_HUGE_PAGE_SIZE) > (pb8Buffer + ui64MappingBytes) )
+    munmap((pb8Buffer + ui64MappingBytes), ((pb8Mapping + ui64MappingBytes + TC_HUGE_PAGE_SIZE) - (pb8Buffer + ui64MappingBytes)));
+
+  madvise(pb8Buffer, ui64MappingBytes, MADV_HUGEPAGE);
+
+  return pb8Buffer;
+}
+
+
+tc_void* TeracadaHugePageAllocator::allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill ) {
+  tc_uint64 ui64MappingBytes = getMappingBytes(std::max<tc_uint64>(ui64Bytes, 1));
+  tc_byte* pb8Buffer = nullptr;
+
+  (tc_void) bZeroFill;
+
+  m_aui64NumAllocs.fetch_add(1, std::memory_order_relaxed);
+
+  pb8Buffer = mapAligned(ui64MappingBytes);
+
+  if ( ! pb8Buffer ) {
+    TC_LOG(LOG_ERR, "TeracadaHugePageAllocator::allocate(): Failed to map the buffer [ SIZE: %lu ]", ui64MappingBytes);
+    return nullptr;
+  }
+
+  recordSystemAlloc(ui64MappingBytes);
+
+  return pb8Buffer;
+}
+
+
+/*
+  The mapping is resized in place when possible (always when shrinking, when the pages after it are free when growing).
+  Otherwise the buffer is copied to a new aligned mapping, as mremap() with MREMAP_MAYMOVE can move the mapping to
+  an address that is not huge page aligned.
+*/
+tc_void* TeracadaHugePageAllocator::reallocate ( tc_void* pvBuffer, tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes ) {
+  tc_uint64 ui64PreMappingBytes = getMappingBytes(std::max<tc_uint64>(ui64PreBytes, 1));
+  tc_uint64 ui64NewMappingBytes = getMappingBytes(std::max<tc_uint64>(ui64NewBytes, 1));
+  tc_void* pvNewBuffer = nullptr;
+
+  if ( ! pvBuffer )
+    return allocate(ui64NewBytes);
+
+  m_aui64NumReallocs.fetch_add(1, std::memory_order_relaxed);
+
+  if ( ui64PreMappingBytes == ui64NewMappingBytes )
+    return pvBuffer;
+
+  pvNewBuffer = mremap(pvBuffer, ui64PreMappingBytes, ui64NewMappingBytes, 0);
+
+  if ( pvNewBuffer != MAP_FAILED ) {
+    madvise(pvNewBuffer, ui64NewMappingBytes, MADV_HUGEPAGE);
+
+  } else {
+    pvNewBuffer = mapAligned(ui64NewMappingBytes);
+
+    if ( ! pvNewBuffer ) {
+      TC_LOG(LOG_ERR, "TeracadaHugePageAllocator::reallocate(): Failed to remap the buffer [ SIZE: %lu ]", ui64NewMappingBytes);
+      return nullptr;
+    }
+
+    memcpy(pvNewBuffer, pvBuffer, std::min(ui64PreBytes, ui64NewBytes));
+    munmap(pvBuffer, ui64PreMappingBytes);
+  }
+
+  recordSystemAlloc(ui64NewMappingBytes);
+  recordSystemFree(ui64PreMappingBytes);
+
+  return pvNewBuffer;
+}
+
+
+tc_void TeracadaHugePageAllocator::deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) {
+  tc_uint64 ui64MappingBytes = getMappingBytes(std::max<tc_uint64>(ui64Bytes, 1));
+
+  if ( ! pvBuffer )
+    return;
+
+  munmap(pvBuffer, ui64MappingBytes);
+
+  m_aui64NumFrees.fetch_add(1, std::memory_order_relaxed);
+  recordSystemFree(ui64MappingBytes);
+}
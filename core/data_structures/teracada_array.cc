@@ -18,9 +18,12 @@
 
 #include <iostream>
 #include <cstring>
-#include <fstream>
 #include <algorithm>
 #include <type_traits>
+#include <limits>
+
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "teracada_array.h"
 
@@ -41,6 +44,14 @@
   @param[in]
     iNumElements The number of array elements, the default is 100
 
+  @param[in]
+    bZeroFill If the array buffer is zero filled up front (the default), otherwise the capacity is left uninitialized
+    and only materialized (touched) as the elements are inserted, elements skipped by an insert are still zeroed
+
+  @param[in]
+    pobjAllocator The allocator of the array buffer (see teracada_allocator.h), it has to outlive the array,
+    the process-wide heap allocator (TeracadaAllocator::getDefault()) is used when it is nullptr
+
   @par Returns
     None.
 
@@ -54,6 +65,8 @@
     TeracadaArray<tc_decimal> arrayObject(10);
     TeracadaArray<tc_char> arrayObject(10);
     TeracadaArray<tc_str> arrayObject(10);
+    TeracadaArray<tc_decimal> arrayObject(100000000, false);
+    TeracadaArray<tc_int> arrayObject(10, true, &objPoolAllocator);
     @endcode
 
   @par Errors/Exceptions
@@ -61,18 +74,37 @@
     - ERR_TA_INIT_FAILED
 */
 template <typename tDataType>
-TeracadaArray<tDataType>::TeracadaArray ( tc_int iNumElements ) :
+TeracadaArray<tDataType>::TeracadaArray ( tc_index iNumElements, tc_bool bZeroFill, TeracadaAllocator* pobjAllocator ) :
   m_b8DataType(TC_NONE), // TC_INT is the default data type
   m_pvArray(nullptr),
+  m_pobjAllocator(pobjAllocator ? pobjAllocator : TeracadaAllocator::getDefault()),
   m_bIsInitSuccess(false),
+  m_bZeroFill(bZeroFill),
   m_iMaxNumArrayElements(iNumElements),
   m_iArrayLastIndex(TA_NONE_INDEX),
   m_b8ResizeAlgo(TA_RESIZE_ALGO_5PERCENT),
   m_b8ResizePaddingAlgo(TA_RESIZE_ALGO_STATIC10),
+  m_dResizeGrowthFactor(TA_RESIZE_GROWTH_FACTOR_DEFAULT),
+  m_iResizeGrowthCap(TA_RESIZE_GROWTH_CAP_NONE),
   m_bOverwrite(false),
-  m_uliTotalReallocAttempts(0),
+  m_aui64ReallocAttempts(0),
+  m_aui64BytesMoved(0),
+  m_aui64PeakCapacityBytes(0),
   m_iErrno(0),
-  m_bEnableExceptions(true)
+  m_bEnableExceptions(true),
+  m_b8StorageMode(TA_STORAGE_CONTIGUOUS),
+  m_iGapIndex(0),
+  m_pstRopeChunks(nullptr),
+  m_iNumRopeChunks(0),
+  m_iMaxRopeChunks(0),
+  m_iRopeCursorChunk(0),
+  m_iRopeCursorIndex(0),
+  m_iHeadIndex(0),
+  m_ui64RingPushSeq(0),
+  m_ldRingWindowSum(0),
+  m_iRingAggCapacity(0),
+  m_stRingMinDeque{nullptr, 0, 0},
+  m_stRingMaxDeque{nullptr, 0, 0}
 {
   tc_void* pvBuff = nullptr;
 
@@ -87,15 +119,22 @@ TeracadaArray<tDataType>::TeracadaArray ( tc_int iNumElements ) :
     goto ERREXIT;
   }
 
-  TC_LOG(LOG_INFO, "TeracadaArray::TeracadaArray(): Initializing TeracadaArray [ DATA_TYPE: %s | NUM_ELEMENTS: %d ]", acDataTypeStr[getDataType()], getMaxNumElements());
+  TC_LOG(LOG_INFO, "TeracadaArray::TeracadaArray(): Initializing TeracadaArray [ DATA_TYPE: %s | NUM_ELEMENTS: %ld ]", acDataTypeStr[getDataType()], getMaxNumElements());
 
   if ( getMaxNumElements() <= 0 ) {
     setArrayInitFailure();
-    TC_LOG(LOG_ERR, "TeracadaArray::TeracadaArray(): Invalid size requested, minimum size of one array element is required [ ELEMENTS_REQUESTED: %d ]", getMaxNumElements());
+    TC_LOG(LOG_ERR, "TeracadaArray::TeracadaArray(): Invalid size requested, minimum size of one array element is required [ ELEMENTS_REQUESTED: %ld ]", getMaxNumElements());
     goto ERREXIT;
   }
 
-  pvBuff = calloc((getMaxNumElements() * getElementSize()), getElementSize());
+  if ( getMaxNumElements() > getMaxAllocNumElements() ) {
+    setArrayInitFailure();
+    TC_LOG(LOG_ERR, "TeracadaArray::TeracadaArray(): Invalid size requested, exceeds the maximum number of array elements [ ELEMENTS_REQUESTED: %ld ]", getMaxNumElements());
+    goto ERREXIT;
+  }
+
+  // getMaxAllocNumElements() keeps the buffer size in bytes from overflowing
+  pvBuff = getAllocator()->allocate(getArraySize(), isZeroFill());
 
   if ( ! pvBuff ) {
     setArrayInitFailure();
@@ -107,17 +146,26 @@ TeracadaArray<tDataType>::TeracadaArray ( tc_int iNumElements ) :
   setArray(pvBuff);
   setArrayInitSuccess();
 
+  // Empty string for the uninitialized TC_CHAR buffer
+  if constexpr ( std::is_same_v<tDataType, tc_char> ) {
+    if ( ! isZeroFill() )
+      *((tDataType*) getArray()) = '\0';
+  }
+
+  m_aui64PeakCapacityBytes.store(getArraySize(), std::memory_order_relaxed);
+  TeracadaMetrics::recordAlloc(getArraySize());
+
   EXIT:
     /* Log array start/end address and length */
 
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wpointer-arith"
 
-    TC_LOG(LOG_INFO, "TeracadaArray::TeracadaArray(): Allocated buffer of length %d bytes for the array [ TYPE: %s | START_ADDR: %p | END_ADDR: %p ]",
-            (getMaxNumElements() * getDataType()),
+    TC_LOG(LOG_INFO, "TeracadaArray::TeracadaArray(): Allocated buffer of length %lu bytes for the array [ TYPE: %s | START_ADDR: %p | END_ADDR: %p ]",
+            getArraySize(),
             acDataTypeStr[getDataType()],
             getArray(),
-            ((getArray() - 1) + (getMaxNumElements() * getDataType())));
+            ((getArray() - 1) + getArraySize()));
 
     #pragma GCC diagnostic pop
 
@@ -131,11 +179,325 @@ TeracadaArray<tDataType>::TeracadaArray ( tc_int iNumElements ) :
 }
 
 
+template <typename tDataType>
+TeracadaArray<tDataType>::TeracadaArray ( TeracadaArray<tDataType>&& objOther ) noexcept {
+  moveFrom(objOther);
+}
+
+
+template <typename tDataType>
+TeracadaArray<tDataType>& TeracadaArray<tDataType>::operator= ( TeracadaArray<tDataType>&& objOther ) noexcept {
+  if ( this != &objOther ) {
+    freeBuffers();
+    moveFrom(objOther);
+  }
+
+  return *this;
+}
+
+
 template <typename tDataType>
 TeracadaArray<tDataType>::~TeracadaArray ( void ) {
+  freeBuffers();
+}
+
+
+// Free the main array buffer and the storage mode buffers
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::freeBuffers ( void ) {
+  ropeFree();
+  ringFreeAggregates();
+
   if ( getArray() ) {
-    free(getArray());
+    getAllocator()->deallocate(getArray(), getArraySize());
+    TeracadaMetrics::recordFree(getArraySize());
+  }
+
+  setArray(nullptr);
+  setArrayInitFailure();
+  setMaxNumElements(0);
+  setLastElementIndex(TA_NONE_INDEX);
+}
+
+
+/*
+  Take over all the buffers and state of the other array, the other array is left uninitialized without any buffer.
+  No buffer is allocated or copied, the process-wide buffer metrics don't change.
+*/
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::moveFrom ( TeracadaArray<tDataType>& objOther ) {
+  m_b8DataType = objOther.m_b8DataType;
+  m_pvArray = objOther.m_pvArray;
+  m_pobjAllocator = objOther.m_pobjAllocator;
+  m_bIsInitSuccess = objOther.m_bIsInitSuccess;
+  m_bZeroFill = objOther.m_bZeroFill;
+  m_iMaxNumArrayElements = objOther.m_iMaxNumArrayElements;
+  m_iArrayLastIndex = objOther.m_iArrayLastIndex;
+  m_b8ResizeAlgo = objOther.m_b8ResizeAlgo;
+  m_b8ResizePaddingAlgo = objOther.m_b8ResizePaddingAlgo;
+  m_dResizeGrowthFactor = objOther.m_dResizeGrowthFactor;
+  m_iResizeGrowthCap = objOther.m_iResizeGrowthCap;
+  m_bOverwrite = objOther.m_bOverwrite;
+
+  // std::atomic is neither copyable nor movable
+  m_aui64ReallocAttempts.store(objOther.m_aui64ReallocAttempts.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  m_aui64BytesMoved.store(objOther.m_aui64BytesMoved.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  m_aui64PeakCapacityBytes.store(objOther.m_aui64PeakCapacityBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+  m_iErrno = objOther.m_iErrno;
+  m_bEnableExceptions = objOther.m_bEnableExceptions;
+
+  m_b8StorageMode = objOther.m_b8StorageMode;
+  m_iGapIndex = objOther.m_iGapIndex;
+  m_pstRopeChunks = objOther.m_pstRopeChunks;
+  m_iNumRopeChunks = objOther.m_iNumRopeChunks;
+  m_iMaxRopeChunks = objOther.m_iMaxRopeChunks;
+  m_iRopeCursorChunk = objOther.m_iRopeCursorChunk;
+  m_iRopeCursorIndex = objOther.m_iRopeCursorIndex;
+  m_iHeadIndex = objOther.m_iHeadIndex;
+  m_ui64RingPushSeq = objOther.m_ui64RingPushSeq;
+  m_ldRingWindowSum = objOther.m_ldRingWindowSum;
+  m_iRingAggCapacity = objOther.m_iRingAggCapacity;
+  m_stRingMinDeque = objOther.m_stRingMinDeque;
+  m_stRingMaxDeque = objOther.m_stRingMaxDeque;
+
+  /* Leave the other array without any buffer */
+
+  objOther.m_pvArray = nullptr;
+  objOther.m_bIsInitSuccess = false;
+  objOther.m_iMaxNumArrayElements = 0;
+  objOther.m_iArrayLastIndex = TA_NONE_INDEX;
+  objOther.m_b8StorageMode = TA_STORAGE_CONTIGUOUS;
+  objOther.m_pstRopeChunks = nullptr;
+  objOther.m_stRingMinDeque = objOther.m_stRingMaxDeque = { nullptr, 0, 0 };
+  objOther.resetStorageState();
+}
+
+
+// Storage mode state for elements contiguous at the start of the main array buffer
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::resetStorageState ( void ) {
+  m_iGapIndex = getNumElements();
+  m_iNumRopeChunks = 0;
+  m_iMaxRopeChunks = 0;
+  m_iRopeCursorChunk = 0;
+  m_iRopeCursorIndex = 0;
+  m_iHeadIndex = 0;
+  m_ui64RingPushSeq = getNumElements();
+  m_ldRingWindowSum = 0;
+  m_iRingAggCapacity = 0;
+}
+
+
+/*!
+  @brief
+    Deep copy of the array
+
+  @details
+    - The copy has the same capacity, elements and settings (resize algorithms, overwrite, exceptions, storage mode).
+    - The array is compacted first, so the elements are copied with a single memcpy.
+    - For TC_STRING/TC_DICT arrays only the pointers are copied, same as insert().
+
+  @par Parameters
+    None.
+
+  @retval
+    Array The copy, uninitialized (isInitSuccess() is false) on failure
+
+  @par Examples
+    @code{.cpp}
+    tca_int objCopy = objArray.clone();
+    @endcode
+*/
+template <typename tDataType>
+TeracadaArray<tDataType> TeracadaArray<tDataType>::clone ( void ) {
+  TeracadaArray<tDataType> objClone(std::max<tc_index>(getMaxNumElements(), 1), isZeroFill(), getAllocator());
+  tDataType* ptArray = nullptr;
+
+  if ( ! isInitSuccess() || ! objClone.isInitSuccess() )
+    goto ERREXIT;
+
+  ptArray = data();
+
+  if ( ! ptArray )
+    goto ERREXIT;
+
+  memcpy(objClone.getArray(), ptArray, ((getNumElements() + getNullTermSize()) * sizeof(tDataType)));
+  objClone.setLastElementIndex(getLastElementIndex());
+
+  objClone.m_b8ResizeAlgo = m_b8ResizeAlgo;
+  objClone.m_b8ResizePaddingAlgo = m_b8ResizePaddingAlgo;
+  objClone.m_dResizeGrowthFactor = m_dResizeGrowthFactor;
+  objClone.m_iResizeGrowthCap = m_iResizeGrowthCap;
+  objClone.m_bOverwrite = m_bOverwrite;
+  objClone.m_bEnableExceptions = m_bEnableExceptions;
+
+  if ( ! objClone.setStorageMode(getStorageMode()) )
+    goto ERREXIT;
+
+  EXIT:
+    return objClone;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::clone(): Failed to clone the array");
+    objClone.freeBuffers();
+    return objClone;
+}
+
+
+/*!
+  @brief
+    Take ownership of an existing buffer, without copying it
+
+  @details
+    - The current buffer of the array is freed, the array keeps its settings and storage mode.
+    - The buffer is owned by the array afterwards (reallocated/freed by it), it has to be allocated with malloc()/calloc()/realloc().
+    - Only supported by the arrays with a malloc() compatible allocator (TeracadaAllocator::isMallocCompatible()).
+    - For TC_CHAR arrays, the buffer needs space for the null terminator after the elements.
+
+  @param[in]
+    pvBuffer The buffer holding the elements from its start
+
+  @param[in]
+    iNumElements The number of elements in the buffer
+
+  @param[in]
+    iMaxNumElements The capacity of the buffer, in number of elements
+
+  @retval
+    true Successfully adopted the buffer
+
+  @retval
+    false Invalid parameters or allocator, or failed to allocate the ring window aggregates, the array is not changed
+
+  @par Errors/Exceptions
+    - ERR_TA_INVALID_PARAM
+    - ERR_TA_MEMALLOC_FAILED
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::adopt ( tc_void* pvBuffer, tc_index iNumElements, tc_index iMaxNumElements ) {
+  tc_uint64* pui64MinSeqs = nullptr;
+  tc_uint64* pui64MaxSeqs = nullptr;
+  tc_bool bRing = (getStorageMode() == TA_STORAGE_RING);
+
+  if ( ! pvBuffer || iNumElements < 0 || iMaxNumElements <= 0 || (iNumElements + getNullTermSize()) > iMaxNumElements ||
+       (bRing && iMaxNumElements <= getNullTermSize()) ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::adopt(): Invalid buffer parameters [ NUM_ELEMENTS: %ld | MAX_NUM_ELEMENTS: %ld ]", iNumElements, iMaxNumElements);
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
+  }
+
+  if ( ! getAllocator()->isMallocCompatible() ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::adopt(): The allocator of the array can't take over malloc() buffers");
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
+  }
+
+  // The window min/max deques of the ring are the only allocation, taken before the current buffers are let go
+  if constexpr ( std::is_arithmetic_v<tDataType> ) {
+    if ( bRing ) {
+      pui64MinSeqs = (tc_uint64*) malloc((iMaxNumElements - getNullTermSize()) * sizeof(tc_uint64));
+      pui64MaxSeqs = (tc_uint64*) malloc((iMaxNumElements - getNullTermSize()) * sizeof(tc_uint64));
+
+      if ( ! pui64MinSeqs || ! pui64MaxSeqs ) {
+        free(pui64MinSeqs);
+        free(pui64MaxSeqs);
+
+        TC_LOG(LOG_ERR, "TeracadaArray::adopt(): Failed to allocate the window min/max deque");
+        throwException(ERR_TA_MEMALLOC_FAILED);
+        goto ERREXIT;
+      }
+    }
+  }
+
+  freeBuffers();
+
+  setArray(pvBuffer);
+  setMaxNumElements(iMaxNumElements);
+  setLastElementIndex(iNumElements - 1);
+  setArrayInitSuccess();
+  resetStorageState();
+
+  if ( bRing ) {
+    m_stRingMinDeque.pui64Seqs = pui64MinSeqs;
+    m_stRingMaxDeque.pui64Seqs = pui64MaxSeqs;
+    m_iRingAggCapacity = std::is_arithmetic_v<tDataType> ? getRingCapacity() : 0;
+  }
+
+  if constexpr ( std::is_same_v<tDataType, tc_char> ) {
+    *((tDataType*) getArray() + iNumElements) = '\0';
+  }
+
+  TeracadaMetrics::recordAlloc(getArraySize());
+
+  if ( getArraySize() > m_aui64PeakCapacityBytes.load(std::memory_order_relaxed) )
+    m_aui64PeakCapacityBytes.store(getArraySize(), std::memory_order_relaxed);
+
+  // The deques already have the ring capacity, the rebuild doesn't allocate and can't fail
+  if ( bRing )
+    ringRebuildAggregates();
+
+  EXIT:
+    TC_LOG(LOG_INFO, "TeracadaArray::adopt(): Adopted the buffer [ NUM_ELEMENTS: %ld | MAX_NUM_ELEMENTS: %ld ]", iNumElements, iMaxNumElements);
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+/*!
+  @brief
+    Hand off the main array buffer to the caller, without copying it
+
+  @details
+    The array is compacted first, so the elements are contiguous from the start of the buffer.
+    The array is left uninitialized without any buffer, use adopt() to reuse it.
+
+  @param[out]
+    piNumElements The number of elements in the buffer (optional)
+
+  @param[out]
+    piMaxNumElements The capacity of the buffer, in number of elements (optional)
+
+  @retval
+    Buffer The buffer, to be freed by the caller with free()
+
+  @retval
+    nullptr Failed to compact the array, the array is not initialized,
+    or its allocator doesn't hand out malloc() buffers (TeracadaAllocator::isMallocCompatible())
+*/
+template <typename tDataType>
+tc_void* TeracadaArray<tDataType>::release ( tc_index* piNumElements, tc_index* piMaxNumElements ) {
+  tc_void* pvBuffer = nullptr;
+
+  if ( ! isInitSuccess() || ! compact() )
+    goto ERREXIT;
+
+  if ( ! getAllocator()->isMallocCompatible() ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::release(): The buffer of the array is not a malloc() buffer, it can't be released");
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
   }
+
+  pvBuffer = getArray();
+
+  if ( piNumElements )
+    *piNumElements = getNumElements();
+
+  if ( piMaxNumElements )
+    *piMaxNumElements = getMaxNumElements();
+
+  // The buffer is not owned by the array anymore
+  TeracadaMetrics::recordFree(getArraySize());
+  setArray(nullptr);
+  freeBuffers();
+
+  EXIT:
+    return pvBuffer;
+
+  ERREXIT:
+    return nullptr;
 }
 
 
@@ -218,8 +580,8 @@ tc_bool TeracadaArray<tDataType>::setDataType ( void ) {
     - ERR_TA_INVALID_POSITION_OR_INDEX
 */
 template <typename tDataType>
-tc_int TeracadaArray<tDataType>::positionToIndex ( tc_int iPosition ) {
-  tc_int iIndex = TA_NONE_INDEX;
+tc_index TeracadaArray<tDataType>::positionToIndex ( tc_index iPosition ) {
+  tc_index iIndex = TA_NONE_INDEX;
 
   // Position value 0 represents index after the last array element
   if ( iPosition == 0 ) {
@@ -250,13 +612,131 @@ tc_int TeracadaArray<tDataType>::positionToIndex ( tc_int iPosition ) {
 }
 
 
+/*!
+  @brief
+    Reallocate the main array buffer to hold exactly the requested number of elements
+
+  @details
+    - All the resize operations (resize(), reserve(), shrinkToFit()) end up here.
+    - Every reallocation attempt, and the bytes of the successful ones, are recorded in the array and process-wide
+      metrics (getMetrics(), TeracadaMetrics).
+    - The added capacity of the zero filled arrays (isZeroFill()) is zeroed.
+
+  @param[in]
+    iNewNumElements The total number of elements the array buffer should hold
+
+  @retval
+    true Successfully reallocated the array buffer
+
+  @retval
+    false Failed to reallocate the array buffer, the previous buffer is left untouched
+
+  @par Errors/Exceptions
+    - ERR_TA_INVALID_PARAM (also when iNewNumElements exceeds getMaxAllocNumElements())
+    - ERR_TA_MEMALLOC_FAILED
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::reallocArray ( tc_index iNewNumElements ) {
+  tc_void* pvReallocArray = nullptr;
+  tc_uint64 ui64PreBytes = getArraySize();
+
+  // Only the address value of the previous buffer is compared, to know if realloc had to move the buffer
+  uintptr_t uiPreArrayAddr = (uintptr_t) getArray();
+
+  // Every attempt is counted, even the ones failing the validation checks
+  recordReallocAttempt();
+
+  // Bounding the number of elements keeps the buffer size in bytes from overflowing
+  if ( iNewNumElements <= 0 || iNewNumElements > getMaxAllocNumElements() ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::reallocArray(): Invalid number of elements requested [ NUM_ELEMENTS: %ld ]", iNewNumElements);
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
+  }
+
+  pvReallocArray = getAllocator()->reallocate(getArray(), getArraySize(), (iNewNumElements * sizeof(tDataType)));
+
+  if ( ! pvReallocArray ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::reallocArray(): Failed to reallocate main array buffer [ SIZE: %lu ]", (iNewNumElements * sizeof(tDataType)));
+    throwException(ERR_TA_MEMALLOC_FAILED);
+    goto ERREXIT;
+  }
+
+  // The capacity added by realloc() or reused by the pool/arena allocators is not zeroed by the allocator
+  if ( isZeroFill() && (iNewNumElements * sizeof(tDataType)) > ui64PreBytes )
+    memset(((tc_byte*) pvReallocArray + ui64PreBytes), 0, ((iNewNumElements * sizeof(tDataType)) - ui64PreBytes));
+
+  EXIT:
+    recordRealloc(ui64PreBytes, (iNewNumElements * sizeof(tDataType)), ((uintptr_t) pvReallocArray != uiPreArrayAddr));
+
+    setArray(pvReallocArray);
+    setMaxNumElements(iNewNumElements);
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+/*!
+  @brief
+    Calculate the new number of array elements for the geometric resize algorithms
+
+  @details
+    - TA_RESIZE_ALGO_GROWTH_1_5X and TA_RESIZE_ALGO_GROWTH_2X grow the array by 1.5x and 2x of its current size.
+    - TA_RESIZE_ALGO_GROWTH_CUSTOM grows the array by getResizeGrowthFactor().
+    - Growth per resize is limited to getResizeGrowthCap() elements, unless it is TA_RESIZE_GROWTH_CAP_NONE.
+    - The returned size always accomodates at least iNumElements more elements.
+
+  @param[in]
+    iNumElements The minimum number of new elements to be accomodated after resize
+
+  @retval
+    NumElements The total number of array elements after resize
+
+  @note
+    Growing by a constant factor makes a sequence of insertBack() calls amortized O(1).
+*/
+template <typename tDataType>
+tc_index TeracadaArray<tDataType>::getGeometricResizeTarget ( tc_index iNumElements ) const {
+  tc_double dGrowthFactor = getResizeGrowthFactor();
+  tc_double dGrowth = 0;
+  tc_index iMaxGrowth = getMaxAllocNumElements() - getMaxNumElements();
+
+  switch ( getResizeAlgo() ) {
+
+    case TA_RESIZE_ALGO_GROWTH_1_5X:
+      dGrowthFactor = 1.5;
+      break;
+
+    case TA_RESIZE_ALGO_GROWTH_2X:
+      dGrowthFactor = 2.0;
+      break;
+
+    default:
+      break;
+  }
+
+  dGrowth = std::max<tc_double>((getMaxNumElements() * (dGrowthFactor - 1.0)), 1);
+
+  if ( getResizeGrowthCap() != TA_RESIZE_GROWTH_CAP_NONE )
+    dGrowth = std::min<tc_double>(dGrowth, getResizeGrowthCap());
+
+  // Don't grow past the maximum number of array elements
+  dGrowth = std::min<tc_double>(std::max<tc_double>(dGrowth, iNumElements), iMaxGrowth);
+
+  return getMaxNumElements() + (tc_index) dGrowth;
+}
+
+
 /*!
   @brief
     Resize the main array by reallocating the array buffer
 
   @details
-    - Resize the array according to the value passed in the parameter iNumElements.
-    - Add extra padding on the right, according to the value of m_b8ResizePaddingAlgo, when iNumElements != 0.
+    - For the geometric resize algorithms (TA_RESIZE_ALGO_GROWTH_*), grow the array by a factor of its current size,
+      but at least by iNumElements (see getGeometricResizeTarget()).
+    - Otherwise, resize the array according to the value passed in the parameter iNumElements,
+      and add extra padding on the right, according to the value of m_b8ResizePaddingAlgo, when iNumElements != 0.
     - If iNumElements == 0 (no specific size requested), then resize according to the pre-defined resize algorithm (m_b8ResizeAlgo).
 
   @param[in]
@@ -271,35 +751,27 @@ tc_int TeracadaArray<tDataType>::positionToIndex ( tc_int iPosition ) {
   @note
     - Always pass minumum space required in the parameter iNumElements, let this function decide on padding.
     - This function is automatically called when needed during insertion, hence protected access specifier.
-
-  @todo
-    Shrink the array if iNumElements < 0
+    - Use shrinkToFit() to shrink the array.
 */
 template <typename tDataType>
-bool TeracadaArray<tDataType>::resize ( tc_int iNumElements ) {
-  tc_void* pvReallocArray = nullptr;
-  tc_int iNewNumElements = 0;
-  tc_int iPreNumElements = getMaxNumElements();
-
-  /* Log total reallocation attempts to the designated file (even before validation checks) */
-
-  incrementTotalReallocAttempts();
-
-  std::ofstream objFd;
-  objFd.open(TA_REALLOC_ATTEMPTS_DUMP_FPATH, std::ios::out | std::ios::trunc);
+bool TeracadaArray<tDataType>::resize ( tc_index iNumElements ) {
+  tc_index iNewNumElements = 0;
+  tc_index iPaddingNumElements = 0;
+  tc_index iPreNumElements = getMaxNumElements();
 
-  if ( ! objFd.fail() ) {
-    objFd << getTotalReallocAttempts();
-    objFd.flush();
-    objFd.close();
-  }
-
-  if ( iNumElements <= 0 ) {
-    TC_LOG(LOG_ERR, "TeracadaArray::resize(): Invalid number of elements requested for resize [ NUM_ELEMENTS: %d ]", iNumElements);
+  if ( iNumElements < 0 || iNumElements > (getMaxAllocNumElements() - iPreNumElements) ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::resize(): Invalid number of elements requested for resize [ NUM_ELEMENTS: %ld ]", iNumElements);
     throwException(ERR_TA_INVALID_PARAM);
     goto ERREXIT;
   }
 
+  /* Geometric resize algorithms decide on both the growth and padding */
+
+  if ( isGeometricResizeAlgo() ) {
+    iNewNumElements = getGeometricResizeTarget(iNumElements);
+    goto REALLOC;
+  }
+
   /* If we have been requested to resize to a cerain size (iNumElements > 0) */
 
   if ( iNumElements ) {
@@ -310,15 +782,15 @@ bool TeracadaArray<tDataType>::resize ( tc_int iNumElements ) {
     switch ( getResizePaddingAlgo() ) {
 
       case TA_RESIZE_ALGO_STATIC10:
-        iNewNumElements += 10;
+        iPaddingNumElements = 10;
         break;
 
       case TA_RESIZE_ALGO_STATIC100:
-        iNewNumElements += 100;
+        iPaddingNumElements = 100;
         break;
 
       case TA_RESIZE_ALGO_STATIC1000:
-        iNewNumElements += 1000;
+        iPaddingNumElements = 1000;
         break;
 
       default:
@@ -326,15 +798,9 @@ bool TeracadaArray<tDataType>::resize ( tc_int iNumElements ) {
         goto ERREXIT;
     }
 
-    pvReallocArray = realloc(getArray(), (iNewNumElements * sizeof(tDataType)));
-
-    if ( ! pvReallocArray ) {
-      TC_LOG(LOG_ERR, "TeracadaArray::resize(): Failed to reallocate main array buffer [ SIZE: %d ]", (iNewNumElements * sizeof(tDataType)));
-      throwException(ERR_TA_MEMALLOC_FAILED);
-      goto ERREXIT;
-    }
+    iNewNumElements += std::min<tc_index>(iPaddingNumElements, (getMaxAllocNumElements() - iNewNumElements));
 
-    goto EXIT;
+    goto REALLOC;
   }
 
   /* If we have "not "been requested to resize to a cerain size (iNumElements = 0) */
@@ -344,11 +810,11 @@ bool TeracadaArray<tDataType>::resize ( tc_int iNumElements ) {
     /** Decide on resize bounds **/
 
     case TA_RESIZE_ALGO_5PERCENT:
-      iNewNumElements = iPreNumElements + std::max<tc_int>(((iPreNumElements * 5) / 100), 1);
+      iNewNumElements = iPreNumElements + std::max<tc_index>(((iPreNumElements * 5) / 100), 1);
       break;
 
     case TA_RESIZE_ALGO_10PERCENT:
-      iNewNumElements = iPreNumElements + std::max<tc_int>(((iPreNumElements * 10) / 100), 1);
+      iNewNumElements = iPreNumElements + std::max<tc_index>(((iPreNumElements * 10) / 100), 1);
       break;
 
     default:
@@ -356,20 +822,12 @@ bool TeracadaArray<tDataType>::resize ( tc_int iNumElements ) {
       goto ERREXIT;
   }
 
-  pvReallocArray = realloc(getArray(), (iNewNumElements * sizeof(tDataType)));
-
-  if ( ! pvReallocArray ) {
-    TC_LOG(LOG_ERR, "TeracadaArray::resize(): Failed to reallocate main array buffer [ SIZE: %d ]", (iNewNumElements * sizeof(tDataType)));
-    throwException(ERR_TA_MEMALLOC_FAILED);
-    goto ERREXIT;
-  }
+  REALLOC:
+    if ( ! reallocArray(iNewNumElements) )
+      goto ERREXIT;
 
   EXIT:
-    // Don't move setArray() out of EXIT label
-    setArray(pvReallocArray);
-    setMaxNumElements(iNewNumElements);
-
-    TC_LOG(LOG_INFO, "TeracadaArray::resize(): Resized the array [ PRE_NUM_ELEMENTS: %d | NUM_ELEMENTS_REQUESTED: %d | NEW_NUM_ELEMENTS: %d | REALLOCATION_ATTEMPT: %d ]",
+    TC_LOG(LOG_INFO, "TeracadaArray::resize(): Resized the array [ PRE_NUM_ELEMENTS: %ld | NUM_ELEMENTS_REQUESTED: %ld | NEW_NUM_ELEMENTS: %ld | REALLOCATION_ATTEMPT: %lu ]",
               iPreNumElements, iNumElements, iNewNumElements, getTotalReallocAttempts());
 
     #pragma GCC diagnostic push
@@ -383,12 +841,193 @@ bool TeracadaArray<tDataType>::resize ( tc_int iNumElements ) {
     return true;
 
   ERREXIT:
-    TC_LOG(LOG_ERR, "TeracadaArray::resize(): Failed to resize the array [ CURRENT_NUM_ELEMENTS: %d ]", iPreNumElements);
+    TC_LOG(LOG_ERR, "TeracadaArray::resize(): Failed to resize the array [ CURRENT_NUM_ELEMENTS: %ld ]", iPreNumElements);
+    throwException(ERR_TA_RESIZE_FAILED);
+    return false;
+}
+
+
+/*!
+  @brief
+    Reserve space for at least the requested number of array elements
+
+  @details
+    - Grow the array buffer to hold iNumElements elements, without any padding.
+    - Does nothing if the array buffer can already hold iNumElements elements.
+    - For tc_char, space for the null terminator is reserved in addition to iNumElements.
+
+  @param[in]
+    iNumElements The total number of array elements to reserve space for
+
+  @retval
+    true Successfully reserved the space (or no reallocation was required)
+
+  @retval
+    false Failed to reserve the space
+
+  @note
+    Reserving the final size upfront avoids all the intermediate reallocations while inserting.
+
+  @par Errors/Exceptions
+    - ERR_TA_INVALID_PARAM
+    - ERR_TA_RESIZE_FAILED
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::reserve ( tc_index iNumElements ) {
+  tc_byte b8NullTermByte = 0;
+
+  if constexpr ( std::is_same_v<tDataType, tc_char> ) {
+    b8NullTermByte = 1;
+  }
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  // Only the contiguous elements are kept by a reallocation
+  if ( ! compact() )
+    goto ERREXIT;
+
+  if ( iNumElements <= 0 || iNumElements > (getMaxAllocNumElements() - b8NullTermByte) ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::reserve(): Invalid number of elements requested [ NUM_ELEMENTS: %ld ]", iNumElements);
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
+  }
+
+  if ( (iNumElements + b8NullTermByte) <= getMaxNumElements() )
+    goto EXIT;
+
+  if ( ! reallocArray(iNumElements + b8NullTermByte) )
+    goto ERREXIT;
+
+  EXIT:
+    TC_LOG(LOG_INFO, "TeracadaArray::reserve(): Reserved space for the array elements [ NUM_ELEMENTS: %ld | MAX_NUM_ELEMENTS: %ld ]", iNumElements, getMaxNumElements());
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::reserve(): Failed to reserve space for the array elements [ NUM_ELEMENTS: %ld ]", iNumElements);
+    throwException(ERR_TA_RESIZE_FAILED);
+    return false;
+}
+
+
+/*!
+  @brief
+    Shrink the array buffer to the number of elements in the array
+
+  @details
+    - Release the unused space at the end of the array buffer.
+    - A minimum of one array element (and the null terminator for tc_char) is always kept.
+
+  @par Parameters
+    None.
+
+  @retval
+    true Successfully shrunk the array buffer (or no reallocation was required)
+
+  @retval
+    false Failed to shrink the array buffer
+
+  @par Errors/Exceptions
+    - ERR_TA_RESIZE_FAILED
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::shrinkToFit ( void ) {
+  tc_index iNewNumElements = 0;
+  tc_byte b8NullTermByte = 0;
+
+  if constexpr ( std::is_same_v<tDataType, tc_char> ) {
+    b8NullTermByte = 1;
+  }
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  if ( ! compact() )
+    goto ERREXIT;
+
+  iNewNumElements = std::max<tc_index>((getNumElements() + b8NullTermByte), 1);
+
+  if ( iNewNumElements == getMaxNumElements() )
+    goto EXIT;
+
+  if ( ! reallocArray(iNewNumElements) )
+    goto ERREXIT;
+
+  EXIT:
+    TC_LOG(LOG_INFO, "TeracadaArray::shrinkToFit(): Shrunk the array buffer [ MAX_NUM_ELEMENTS: %ld ]", getMaxNumElements());
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::shrinkToFit(): Failed to shrink the array buffer");
     throwException(ERR_TA_RESIZE_FAILED);
     return false;
 }
 
 
+/*!
+  @brief
+    Report the memory footprint of the array
+
+  @details
+    - Storage bytes are the buffers of the rope chunks and the ring window aggregates, besides the main array buffer.
+    - Resident bytes are found with mincore() over the pages of the main array buffer, so they are page granular
+      (the first and last page may be shared with other allocations) and 0 if mincore() is not supported.
+
+  @par Parameters
+    None.
+
+  @retval
+    stdTeracadaArrayFootprint The footprint snapshot, only the object size is set for an uninitialized array
+*/
+template <typename tDataType>
+stdTeracadaArrayFootprint TeracadaArray<tDataType>::getFootprint ( void ) const {
+  stdTeracadaArrayFootprint stFootprint = {};
+  tc_uint64 ui64PageSize = (tc_uint64) sysconf(_SC_PAGESIZE);
+  uintptr_t uiFirstPageAddr = 0;
+  tc_uint64 ui64NumPages = 0;
+  tc_byte ab8PageResidency[4096];
+
+  stFootprint.ui64ObjectBytes = sizeof(*this);
+
+  if ( ! isInitSuccess() )
+    goto EXIT;
+
+  stFootprint.ui64CapacityBytes = getArraySize();
+  stFootprint.ui64UsedBytes = (getNumElements() + getNullTermSize()) * sizeof(tDataType);
+
+  if ( m_pstRopeChunks )
+    stFootprint.ui64StorageBytes += (m_iMaxRopeChunks * sizeof(stdTeracadaArrayRopeChunk)) + (m_iNumRopeChunks * getRopeChunkNumElements() * sizeof(tDataType));
+
+  if ( m_stRingMinDeque.pui64Seqs )
+    stFootprint.ui64StorageBytes += 2 * m_iRingAggCapacity * sizeof(tc_uint64);
+
+  stFootprint.ui64SlackBytes = (stFootprint.ui64CapacityBytes + stFootprint.ui64StorageBytes) - std::min(stFootprint.ui64UsedBytes, (stFootprint.ui64CapacityBytes + stFootprint.ui64StorageBytes));
+
+  /* Resident pages of the main array buffer, a window of pages at a time */
+
+  uiFirstPageAddr = ((uintptr_t) getArray()) & ~((uintptr_t) ui64PageSize - 1);
+  ui64NumPages = ((((uintptr_t) getArray()) + getArraySize() - uiFirstPageAddr) + ui64PageSize - 1) / ui64PageSize;
+
+  for ( tc_uint64 ui64Page = 0; ui64Page < ui64NumPages; ui64Page += sizeof(ab8PageResidency) ) {
+    tc_uint64 ui64NumWindowPages = std::min<tc_uint64>((ui64NumPages - ui64Page), sizeof(ab8PageResidency));
+
+    if ( mincore((tc_void*) (uiFirstPageAddr + (ui64Page * ui64PageSize)), (ui64NumWindowPages * ui64PageSize), (unsigned char*) ab8PageResidency) ) {
+      stFootprint.ui64ResidentBytes = 0;
+      break;
+    }
+
+    for ( tc_uint64 ui64Iter = 0; ui64Iter < ui64NumWindowPages; ui64Iter++ )
+      stFootprint.ui64ResidentBytes += (ab8PageResidency[ui64Iter] & 1) * ui64PageSize;
+  }
+
+  stFootprint.ui64ResidentBytes = std::min(stFootprint.ui64ResidentBytes, stFootprint.ui64CapacityBytes);
+
+  EXIT:
+    stFootprint.ui64TotalBytes = stFootprint.ui64ObjectBytes + stFootprint.ui64CapacityBytes + stFootprint.ui64StorageBytes;
+    return stFootprint;
+}
+
+
 /*!
   @brief
     Check if resizing of the main array is required.
@@ -420,9 +1059,9 @@ bool TeracadaArray<tDataType>::resize ( tc_int iNumElements ) {
     Shrink the array if iNumElements < 0
 */
 template <typename tDataType>
-tc_int TeracadaArray<tDataType>::resizeBeforeInsert ( tc_int iInsertIndex, tc_int iNumElements ) {
-  tc_int iResizeNumElements = 0;
-  tc_int iLastIndexPostInsert = 0;
+tc_index TeracadaArray<tDataType>::resizeBeforeInsert ( tc_index iInsertIndex, tc_index iNumElements ) {
+  tc_index iResizeNumElements = 0;
+  tc_index iLastIndexPostInsert = 0;
   tc_byte b8NullTermByte = 0;
 
   // Important: Althought we are considering here null terminator byte as part of
@@ -432,14 +1071,14 @@ tc_int TeracadaArray<tDataType>::resizeBeforeInsert ( tc_int iInsertIndex, tc_in
     b8NullTermByte = 1;
   }
 
-  if ( iInsertIndex < 0 || iNumElements <= 0 ) {
-    TC_LOG(LOG_ERR, "TeracadaArray::resizeBeforeInsert(): Invalid function parameters [ INDEX: %d | NUM_ELEMENTS: %d ]", iInsertIndex, iNumElements);
+  if ( iInsertIndex < 0 || iNumElements <= 0 || iNumElements > (getMaxAllocNumElements() - iInsertIndex - b8NullTermByte) ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::resizeBeforeInsert(): Invalid function parameters [ INDEX: %ld | NUM_ELEMENTS: %ld ]", iInsertIndex, iNumElements);
     throwException(ERR_TA_INVALID_POSITION_OR_INDEX);
     goto ERREXIT;
   }
 
   if ( isOverwriteEnabled() || iInsertIndex > getLastElementIndex() ) {
-    iLastIndexPostInsert = std::max((tc_int) ((iInsertIndex - 1) + iNumElements + b8NullTermByte), getLastElementIndex());
+    iLastIndexPostInsert = std::max((tc_index) ((iInsertIndex - 1) + iNumElements + b8NullTermByte), getLastElementIndex());
 
   } else {
     iLastIndexPostInsert = (getLastElementIndex() + iNumElements + b8NullTermByte);
@@ -462,6 +1101,78 @@ tc_int TeracadaArray<tDataType>::resizeBeforeInsert ( tc_int iInsertIndex, tc_in
 }
 
 
+/*!
+  @brief
+    Move a block of array elements to another index of the main array
+
+  @details
+    - Source and destination blocks may overlap, as it is used for shifting the array tail during insert/remove.
+    - Trivially copyable data types (all the Teracada data types) are moved as one block with memmove,
+      other data types are moved element by element in the overlap safe direction.
+
+  @param[in]
+    iFromIndex The index of the first element to be moved
+
+  @param[in]
+    iToIndex The index the first element should be moved to
+
+  @param[in]
+    iNumElements The number of elements to be moved
+
+  @par Returns
+    None.
+
+  @note
+    No bounds checking is done, the caller must make sure both blocks are within the array buffer.
+*/
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::shiftElements ( tc_index iFromIndex, tc_index iToIndex, tc_index iNumElements ) {
+  tDataType* ptArray = (tDataType *) getArray();
+
+  if ( iNumElements <= 0 || iFromIndex == iToIndex )
+    return;
+
+  if constexpr ( std::is_trivially_copyable_v<tDataType> ) {
+    memmove((ptArray + iToIndex), (ptArray + iFromIndex), (iNumElements * sizeof(tDataType)));
+
+  } else {
+    if ( iToIndex > iFromIndex ) {
+      for ( tc_index iIter = iNumElements - 1; iIter >= 0; iIter-- )
+        *(ptArray + iToIndex + iIter) = *(ptArray + iFromIndex + iIter);
+
+    } else {
+      for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+        *(ptArray + iToIndex + iIter) = *(ptArray + iFromIndex + iIter);
+    }
+  }
+}
+
+
+/*!
+  @brief
+    Zero the elements skipped by an insert after the last array element
+
+  @details
+    - Only needed for the arrays that are not zero filled (isZeroFill()), their capacity is left uninitialized.
+    - Zero filled arrays are left as they are.
+
+  @param[in]
+    iInsertIndex The index of the first inserted element, after the last array element
+
+  @par Returns
+    None.
+*/
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::zeroSkippedElements ( tc_index iInsertIndex ) {
+  tc_index iFirstSkippedIndex = getLastElementIndex() + 1;
+
+  if ( isZeroFill() || iInsertIndex <= iFirstSkippedIndex )
+    return;
+
+  memset(((tDataType *) getArray() + iFirstSkippedIndex), 0, ((iInsertIndex - iFirstSkippedIndex) * sizeof(tDataType)));
+}
+
+
 /*!
   @brief
     Insert a single value of the template argument type
@@ -484,8 +1195,8 @@ tc_int TeracadaArray<tDataType>::resizeBeforeInsert ( tc_int iInsertIndex, tc_in
     -1 On failure
 */
 template <typename tDataType>
-tc_int TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType tValue ) {
-  tc_int iIndex = TA_NONE_INDEX;
+tc_index TeracadaArray<tDataType>::insert ( tc_index iPosition, tDataType tValue ) {
+  tc_index iIndex = TA_NONE_INDEX;
 
   if ( ! isInitSuccess() )
     goto ERREXIT;
@@ -495,6 +1206,13 @@ tc_int TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType tValue ) {
   if ( iIndex < 0 )
     goto ERREXIT;
 
+  if ( getStorageMode() != TA_STORAGE_CONTIGUOUS ) {
+    if ( ! storageInsert(iIndex, &tValue, 1) )
+      goto ERREXIT;
+
+    goto EXIT;
+  }
+
   // Resize the Teracada array if required
   if ( resizeBeforeInsert(iIndex, 1) < 0 )
     goto ERREXIT;
@@ -502,6 +1220,7 @@ tc_int TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType tValue ) {
   /* Insert the value to a index after the last array value */
 
   if ( iIndex > getLastElementIndex() ) {
+    zeroSkippedElements(iIndex);
     *((tDataType *) getArray() + iIndex) = tValue;
     setLastElementIndex(iIndex);
     goto EXIT;
@@ -513,9 +1232,7 @@ tc_int TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType tValue ) {
     *((tDataType *) getArray() + iIndex) = tValue;
 
   } else {
-    for ( tc_int iIter = getLastElementIndex(); iIter >= iIndex; iIter-- ) {
-      *((tDataType *) getArray() + iIter + 1) = *((tDataType *) getArray() + iIter);
-    }
+    shiftElements(iIndex, (iIndex + 1), (getLastElementIndex() - iIndex + 1));
 
     *((tDataType *) getArray() + iIndex) = tValue;
     incrementLastElementIndexBy(1);
@@ -524,23 +1241,25 @@ tc_int TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType tValue ) {
   EXIT:
     // Set the null terminator for array type TC_CHAR
     // Don't move this out of goto label
+    // Non contiguous storage modes get the null terminator on compact()
     if constexpr ( std::is_same_v<tDataType, tc_char> ) {
-      *((tDataType*) getArray() + getLastElementIndex() + 1) = '\0';
+      if ( isContiguous() )
+        *((tDataType*) getArray() + getLastElementIndex() + 1) = '\0';
 
       // Null terminator byte for TC_CHAR array is not part of getLastElementIndex()
       // So we will not incrementLastElementIndexBy() here
     }
 
     if constexpr ( std::is_same_v<tDataType, tc_str> ) {
-      TC_LOG(LOG_INFO, "TeracadaArray::insert(): Array insertion operation success [ POSITION: %d | VALUE: %s ]", iPosition, tValue);
+      TC_LOG(LOG_INFO, "TeracadaArray::insert(): Array insertion operation success [ POSITION: %ld | VALUE: %s ]", iPosition, tValue);
     } else {
-      TC_LOG(LOG_INFO, "TeracadaArray::insert(): Array insertion operation success [ POSITION: %d ]", iPosition);
+      TC_LOG(LOG_INFO, "TeracadaArray::insert(): Array insertion operation success [ POSITION: %ld ]", iPosition);
     }
 
     return iIndex + 1;
 
   ERREXIT:
-    TC_LOG(LOG_ERR, "TeracadaArray::insert(): Array insertion operation failure [ POSITION: %d ]", iPosition);
+    TC_LOG(LOG_ERR, "TeracadaArray::insert(): Array insertion operation failure [ POSITION: %ld ]", iPosition);
     throwException(ERR_TA_INSERTION_FAILURE);
     return TA_NONE_INDEX;
 }
@@ -566,9 +1285,9 @@ tc_int TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType tValue ) {
     false Failed to insert the values in the array
 */
 template <typename tDataType>
-bool TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType* ptValue, tc_int iLength ) {
+bool TeracadaArray<tDataType>::insert ( tc_index iPosition, tDataType* ptValue, tc_index iLength ) {
 
-  tc_int iIndex = TA_NONE_INDEX;
+  tc_index iIndex = TA_NONE_INDEX;
 
   // Check if the Teracada array was successfully initialized
   if ( ! isInitSuccess() )
@@ -586,11 +1305,18 @@ bool TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType* ptValue, tc
   }
 
   if ( iLength <= 0 ) {
-    TC_LOG(LOG_ERR, "TeracadaArray::insert(): Invalid length value for the element list [ LENGTH: %d ]", iLength);
+    TC_LOG(LOG_ERR, "TeracadaArray::insert(): Invalid length value for the element list [ LENGTH: %ld ]", iLength);
     throwException(ERR_TA_INVALID_PARAM);
     goto ERREXIT;
   }
 
+  if ( getStorageMode() != TA_STORAGE_CONTIGUOUS ) {
+    if ( ! storageInsert(iIndex, ptValue, iLength) )
+      goto ERREXIT;
+
+    goto EXIT;
+  }
+
   // Resize the array if required
   if ( resizeBeforeInsert(iIndex, iLength) < 0 )
     goto ERREXIT;
@@ -598,6 +1324,7 @@ bool TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType* ptValue, tc
   /* Insert the value to a index after the last array value */
 
   if ( iIndex > getLastElementIndex() ) {
+    zeroSkippedElements(iIndex);
     memcpy((tDataType *) getArray() + iIndex, ptValue, (iLength * sizeof(tDataType)));
     setLastElementIndex((iIndex - 1) + iLength); // -1 because we start inserting "at" the iIndex
     goto EXIT;
@@ -609,9 +1336,7 @@ bool TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType* ptValue, tc
     memcpy(((tDataType *) getArray() + iIndex), ptValue, (iLength * sizeof(tDataType)));
 
   } else {
-    for ( tc_int iIter = getLastElementIndex() + iLength; iIter >= (iIndex + iLength); iIter-- ) {
-      *((tDataType *) getArray() + iIter) = *((tDataType *) getArray() + (iIter - iLength));
-    }
+    shiftElements(iIndex, (iIndex + iLength), (getLastElementIndex() - iIndex + 1));
 
     memcpy(((tDataType *) getArray() + iIndex), ptValue, (iLength * sizeof(tDataType)));
     incrementLastElementIndexBy(iLength);
@@ -621,26 +1346,28 @@ bool TeracadaArray<tDataType>::insert ( tc_int iPosition, tDataType* ptValue, tc
   EXIT:
     // Set the null terminator for array type TC_CHAR
     // Don't move this out of goto label
+    // Non contiguous storage modes get the null terminator on compact()
     if constexpr ( std::is_same_v<tDataType, tc_char> ) {
-      *((tDataType*) getArray() + getLastElementIndex() + 1) = '\0';
+      if ( isContiguous() )
+        *((tDataType*) getArray() + getLastElementIndex() + 1) = '\0';
 
       // Null terminator byte for TC_CHAR array is not part of getLastElementIndex()
       // So we will not incrementLastElementIndexBy() here
     }
 
-    TC_LOG(LOG_INFO, "TeracadaArray::insert(): Array insertion operation success [ POSITION: %d | LENGTH: %d | POST_LAST_ELEMENT_INDEX: %d ]", iPosition, iLength, getLastElementIndex());
+    TC_LOG(LOG_INFO, "TeracadaArray::insert(): Array insertion operation success [ POSITION: %ld | LENGTH: %ld | POST_LAST_ELEMENT_INDEX: %ld ]", iPosition, iLength, getLastElementIndex());
     return true;
 
   ERREXIT:
-    TC_LOG(LOG_INFO, "TeracadaArray::insert(): Array insertion operation failure [ POSITION: %d | LENGTH: %d ]", iPosition, iLength);
+    TC_LOG(LOG_INFO, "TeracadaArray::insert(): Array insertion operation failure [ POSITION: %ld | LENGTH: %ld ]", iPosition, iLength);
     throwException(ERR_TA_INSERTION_FAILURE);
     return false;
 }
 
 
 template <typename tDataType>
-bool TeracadaArray<tDataType>::remove ( tc_int iPosition, tc_int iNumElements ) {
-  tc_int iIndex = TA_NONE_INDEX;
+bool TeracadaArray<tDataType>::remove ( tc_index iPosition, tc_index iNumElements ) {
+  tc_index iIndex = TA_NONE_INDEX;
 
   // Check if the Teracada array was successfully initialized
   if ( ! isInitSuccess() )
@@ -661,12 +1388,17 @@ bool TeracadaArray<tDataType>::remove ( tc_int iPosition, tc_int iNumElements )
     goto ERREXIT;
   }
 
-  /* Remove value(s) */
+  if ( getStorageMode() != TA_STORAGE_CONTIGUOUS ) {
+    if ( ! storageRemove(iIndex, iNumElements) )
+      goto ERREXIT;
 
-  for ( tc_int iIter = iIndex; iIter <= (getLastElementIndex() - iNumElements); iIter++ ) {
-    *((tDataType *) getArray() + iIter) = *((tDataType *) getArray() + iIter + iNumElements);
+    goto EXIT;
   }
 
+  /* Remove value(s) */
+
+  shiftElements((iIndex + iNumElements), iIndex, (getLastElementIndex() - (iIndex + iNumElements) + 1));
+
   decrementLastElementIndexBy(iNumElements);
 
   // Set the free space created to '0', to clean it up
@@ -674,11 +1406,17 @@ bool TeracadaArray<tDataType>::remove ( tc_int iPosition, tc_int iNumElements )
   memset(((tDataType *) getArray() + getLastElementIndex() + 1), 0, (iNumElements * sizeof(tDataType)));
 
   EXIT:
-    TC_LOG(LOG_INFO, "TeracadaArray::remove(): Array element removal success [ POSITION: %d | NUM_ELEMENTS: %d ]", iPosition, iNumElements);
+    // Non contiguous storage modes get the null terminator on compact()
+    if constexpr ( std::is_same_v<tDataType, tc_char> ) {
+      if ( getStorageMode() != TA_STORAGE_CONTIGUOUS && isContiguous() )
+        *((tDataType*) getArray() + getLastElementIndex() + 1) = '\0';
+    }
+
+    TC_LOG(LOG_INFO, "TeracadaArray::remove(): Array element removal success [ POSITION: %ld | NUM_ELEMENTS: %ld ]", iPosition, iNumElements);
     return true;
 
   ERREXIT:
-    TC_LOG(LOG_INFO, "TeracadaArray::remove(): Array element removal failure [ POSITION: %d | NUM_ELEMENTS: %d ]", iPosition, iNumElements);
+    TC_LOG(LOG_INFO, "TeracadaArray::remove(): Array element removal failure [ POSITION: %ld | NUM_ELEMENTS: %ld ]", iPosition, iNumElements);
     throwException(ERR_TA_REMOVE_FAILURE);
     return false;
 }
@@ -689,9 +1427,21 @@ tc_bool TeracadaArray<tDataType>::reset ( void ) {
   if ( ! isInitSuccess() ) 
     goto ERREXIT;
 
-  memset(getArray(), 0, (m_iMaxNumArrayElements * sizeof(tDataType)));
+  ropeFree();
+  m_iGapIndex = 0;
+  m_iHeadIndex = 0;
+
+  // Uninitialized capacity is not touched, only the TC_CHAR null terminator is needed
+  if ( isZeroFill() )
+    memset(getArray(), 0, (m_iMaxNumArrayElements * sizeof(tDataType)));
+  else if constexpr ( std::is_same_v<tDataType, tc_char> )
+    *((tDataType*) getArray()) = '\0';
+
   setLastElementIndex(-1);
 
+  if ( getStorageMode() == TA_STORAGE_RING && ! ringRebuildAggregates() )
+    goto ERREXIT;
+
   EXIT:
     return true;
 
@@ -713,8 +1463,8 @@ tc_bool TeracadaArray<tDataType>::reset ( void ) {
     (None)
 */
 template <typename tDataType>
-tc_void* TeracadaArray<tDataType>::get ( tc_int iPosition ) {
-  tc_int iIndex = TA_NONE_INDEX;
+tc_void* TeracadaArray<tDataType>::get ( tc_index iPosition ) {
+  tc_index iIndex = TA_NONE_INDEX;
   tc_void* pvValue = nullptr;
 
   // Check if the Teracada array was successfully initialized
@@ -727,6 +1477,11 @@ tc_void* TeracadaArray<tDataType>::get ( tc_int iPosition ) {
   if ( iIndex < 0 || iIndex > getLastElementIndex() )
     goto ERREXIT;
 
+  if ( getStorageMode() != TA_STORAGE_CONTIGUOUS ) {
+    pvValue = storageGet(iIndex);
+    goto EXIT;
+  }
+
   #pragma GCC dignostics push
   #pragma GCC diagnostic ignored "-Wpointer-arith"
 
@@ -746,6 +1501,72 @@ tc_void* TeracadaArray<tDataType>::get ( tc_int iPosition ) {
 }
 
 
+/*!
+  @brief
+    Get a typed view over the array elements between two positions (both included)
+
+  @details
+    The positions are converted once, the view is plain pointer access without any checks.
+    The array is compacted first for the non contiguous storage modes.
+
+  @param[in]
+    iFirstPosition The position of the first element of the view (default: first array element)
+
+  @param[in]
+    iLastPosition The position of the last element of the view (default: last array element)
+
+  @retval
+    View The view over the elements, empty view if the array is empty or on failure
+
+  @par Examples
+    @code{.cpp}
+    tc_int64 i64Sum = 0;
+
+    for ( tc_int iValue : objArray.view() )
+      i64Sum += iValue;
+    @endcode
+
+  @note
+    The view is invalidated by the next insert/remove/resize of the array.
+
+  @par Errors/Exceptions
+    - ERR_TA_INVALID_POSITION_OR_INDEX
+*/
+template <typename tDataType>
+TeracadaArrayView<tDataType> TeracadaArray<tDataType>::view ( tc_index iFirstPosition, tc_index iLastPosition ) {
+  tc_index iFirstIndex = TA_NONE_INDEX;
+  tc_index iLastIndex = TA_NONE_INDEX;
+  tDataType* ptArray = nullptr;
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  // Whole view of an empty array
+  if ( getNumElements() == 0 && iFirstPosition == 1 && iLastPosition == -1 )
+    return TeracadaArrayView<tDataType>();
+
+  iFirstIndex = positionToIndex(iFirstPosition);
+  iLastIndex = positionToIndex(iLastPosition);
+
+  if ( iFirstIndex < 0 || iLastIndex < iFirstIndex || iLastIndex > getLastElementIndex() ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::view(): Invalid view positions [ FIRST_POSITION: %ld | LAST_POSITION: %ld ]", iFirstPosition, iLastPosition);
+    throwException(ERR_TA_INVALID_POSITION_OR_INDEX);
+    goto ERREXIT;
+  }
+
+  ptArray = data();
+
+  if ( ! ptArray )
+    goto ERREXIT;
+
+  EXIT:
+    return TeracadaArrayView<tDataType>((ptArray + iFirstIndex), (iLastIndex - iFirstIndex + 1));
+
+  ERREXIT:
+    return TeracadaArrayView<tDataType>();
+}
+
+
 template <typename tDataType>
 tc_void TeracadaArray<tDataType>::print ( void ) {
 
@@ -753,22 +1574,20 @@ tc_void TeracadaArray<tDataType>::print ( void ) {
   if ( ! isInitSuccess() )
     return;
 
-  TeracadaArray<tc_char>* ptcaBuff = new TeracadaArray<tc_char>(20);
+  TeracadaArray<tc_char> tcaBuff(20);
 
-  if ( ! ptcaBuff->isInitSuccess() ) {
+  if ( ! tcaBuff.isInitSuccess() ) {
     TC_LOG(LOG_ERR, "TeracadaArray::print(): Failed to initialize print buffer array");
     return;
   }
 
-  ptcaBuff->setResizePaddingAlgo(TA_RESIZE_ALGO_STATIC1000);
+  tcaBuff.setResizePaddingAlgo(TA_RESIZE_ALGO_STATIC1000);
 
-  if ( printToBuff(ptcaBuff) ) {
-    printf("%s\n", (tc_str) ptcaBuff->getArray());
+  if ( printToBuff(&tcaBuff) ) {
+    printf("%s\n", (tc_str) tcaBuff.getArray());
     fflush(stdout);
   }
 
-  delete ptcaBuff;
-
   return;
 }
 
@@ -800,25 +1619,25 @@ TeracadaArray<tc_char>* TeracadaArray<tDataType>::printToBuff ( TeracadaArray<tc
 
   if constexpr ( std::is_same_v<tDataType, tc_str> ) {
     if ( std::is_same_v<tDataType, tc_str> ) {
-      for ( tc_int iIter = 1; iIter <= getNumElements(); iIter++ ) {
-        ptcaBuff->insertBack((tDataType) get(iIter));
+      for ( tDataType tValue : view() ) {
+        ptcaBuff->insertBack(tValue);
         ptcaBuff->insertBack(",\n");
       }
     }
 
   } else {
-    for ( tc_int iIter = 1; iIter <= getNumElements(); iIter++ ) {
+    for ( tDataType tValue : view() ) {
       if constexpr (std::is_same_v<tDataType, tc_byte>)
-        snprintf(pcIntStr, sizeof(caIntStr), "%d ", *((tc_byte*) get(iIter)));
+        snprintf(pcIntStr, sizeof(caIntStr), "%d ", tValue);
 
       if constexpr (std::is_same_v<tDataType, tc_int>)
-        snprintf(pcIntStr, sizeof(caIntStr), "%ld ", *((tc_int*) get(iIter)));
+        snprintf(pcIntStr, sizeof(caIntStr), "%ld ", tValue);
 
       if constexpr (std::is_same_v<tDataType, tc_decimal>)
-        snprintf(pcIntStr, sizeof(caIntStr), "%lf ", *((tc_decimal*) get(iIter)));
+        snprintf(pcIntStr, sizeof(caIntStr), "%lf ", tValue);
 
       if constexpr (std::is_same_v<tDataType, tc_char>)
-        snprintf(pcIntStr, sizeof(caIntStr), "%c", *((tc_char*) get(iIter)));
+        snprintf(pcIntStr, sizeof(caIntStr), "%c", tValue);
 
       ptcaBuff->insertBack(pcIntStr);
       memset(pcIntStr, 0, sizeof(caIntStr));
@@ -0,0 +1,1011 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <map>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "teracada.h"
+
+
+static char acTERACADA_ERRSTR_BUFFER[TC_ERRORSTR_LENGTH];
+char* pcTERACADA_ERRSTR = &acTERACADA_ERRSTR_BUFFER[0];
+
+
+using namespace std;
+
+typedef chrono::steady_clock tc_clock;
+
+struct stdBenchmarkResizeAlgo {
+  tc_byte   b8ResizeAlgo;
+  tc_byte   b8ResizePaddingAlgo;
+  const tc_char* pcName;
+};
+
+static const stdBenchmarkResizeAlgo astBENCHMARK_RESIZE_ALGOS[] = {
+  { TA_RESIZE_ALGO_5PERCENT,      TA_RESIZE_ALGO_STATIC10,   "STATIC10" },
+  { TA_RESIZE_ALGO_5PERCENT,      TA_RESIZE_ALGO_STATIC100,  "STATIC100" },
+  { TA_RESIZE_ALGO_5PERCENT,      TA_RESIZE_ALGO_STATIC1000, "STATIC1000" },
+  { TA_RESIZE_ALGO_GROWTH_1_5X,   TA_RESIZE_ALGO_STATIC10,   "GROWTH_1_5X" },
+  { TA_RESIZE_ALGO_GROWTH_2X,     TA_RESIZE_ALGO_STATIC10,   "GROWTH_2X" },
+  { TA_RESIZE_ALGO_GROWTH_CUSTOM, TA_RESIZE_ALGO_STATIC10,   "GROWTH_1_25X_CAP1M" }
+};
+
+
+static tc_double elapsedMilliSeconds ( tc_clock::time_point objStart ) {
+  return chrono::duration<tc_double, milli>(tc_clock::now() - objStart).count();
+}
+
+
+template <typename tDataType>
+static tc_void benchmarkAppend ( const stdBenchmarkResizeAlgo& stResizeAlgo, tc_int iNumAppends, const tc_char* pcTypeName ) {
+  TeracadaArray<tDataType> objArray(100);
+  objArray.disableExceptions();
+  objArray.setResizeAlgo(stResizeAlgo.b8ResizeAlgo);
+  objArray.setResizePaddingAlgo(stResizeAlgo.b8ResizePaddingAlgo);
+
+  if ( stResizeAlgo.b8ResizeAlgo == TA_RESIZE_ALGO_GROWTH_CUSTOM ) {
+    objArray.setResizeGrowthFactor(1.25);
+    objArray.setResizeGrowthCap(1000000);
+  }
+
+  tc_clock::time_point objStart = tc_clock::now();
+
+  for ( tc_int iIter = 0; iIter < iNumAppends; iIter++ )
+    objArray.insertBack((tDataType) iIter);
+
+  tc_double dElapsedMs = elapsedMilliSeconds(objStart);
+  stdTeracadaArrayMetrics stMetrics = objArray.getMetrics();
+
+  printf("  %-12s %-20s appends: %-10ld reallocs: %-10ld bytes moved: %-12lu time: %10.2f ms\n",
+          pcTypeName, stResizeAlgo.pcName, (long) objArray.getNumElements(),
+          (long) objArray.getTotalReallocAttempts(), (unsigned long) stMetrics.ui64BytesMoved, dElapsedMs);
+}
+
+
+tc_void BenchmarkTeracadaArrayResizeAlgo ( tc_int iNumAppends ) {
+
+  cout << ">>> Benchmarking TeracadaArray resize algorithms [ APPENDS: " << iNumAppends << " ]" << endl;
+
+  for ( const stdBenchmarkResizeAlgo& stResizeAlgo : astBENCHMARK_RESIZE_ALGOS )
+    benchmarkAppend<tc_int>(stResizeAlgo, iNumAppends, "TC_INT");
+
+  for ( const stdBenchmarkResizeAlgo& stResizeAlgo : astBENCHMARK_RESIZE_ALGOS )
+    benchmarkAppend<tc_decimal>(stResizeAlgo, iNumAppends, "TC_DECIMAL");
+
+  return;
+}
+
+
+static tc_void benchmarkInsertBackByte ( tc_int iNumInserts, const tc_char* pcLabel ) {
+  TeracadaArray<tc_byte> objArray(iNumInserts + 1);
+  objArray.disableExceptions();
+
+  tc_clock::time_point objStart = tc_clock::now();
+
+  for ( tc_int iIter = 0; iIter < iNumInserts; iIter++ )
+    objArray.insertBack((tc_byte) iIter);
+
+  tc_double dElapsedMs = elapsedMilliSeconds(objStart);
+
+  printf("  %-40s inserts: %-10ld time: %10.2f ms   per insert: %8.2f ns\n",
+          pcLabel, (long) objArray.getNumElements(), dElapsedMs, (dElapsedMs * 1000000) / iNumInserts);
+}
+
+
+/*
+  Per-insert cost of insertBack() of a single byte, dominated by TC_LOG when logging is compiled in.
+  Compare the output of <benchmarks> and <benchmarks>_nolog (built with _TERACADA_LOG_LEVEL=LOG_WARNING).
+*/
+tc_void BenchmarkTeracadaArrayInsertLogging ( tc_int iNumInserts ) {
+  tc_int iPreLogLevel = tc_getLogLevel();
+
+  cout << ">>> Benchmarking TeracadaArray insertBack() logging cost [ INSERTS: " << iNumInserts
+       << " | COMPILED_IN_LOG_LEVEL: " << _TERACADA_LOG_LEVEL << " ]" << endl;
+
+  if constexpr ( LOG_INFO > _TERACADA_LOG_LEVEL ) {
+    benchmarkInsertBackByte(iNumInserts, "LOG_INFO compiled out");
+
+  } else {
+    tc_setLogLevel(LOG_DEBUG);
+    benchmarkInsertBackByte(iNumInserts, "LOG_INFO compiled in, enabled");
+
+    tc_setLogLevel(LOG_WARNING);
+    benchmarkInsertBackByte(iNumInserts, "LOG_INFO compiled in, runtime disabled");
+  }
+
+  tc_setLogLevel(iPreLogLevel);
+
+  return;
+}
+
+
+template <typename tDataType>
+static tc_void benchmarkShift ( tc_int iNumElements, tc_int iNumOperations, const tc_char* pcTypeName ) {
+  TeracadaArray<tDataType> objArray(iNumElements + iNumOperations + 1);
+  objArray.disableExceptions();
+
+  for ( tc_int iIter = 0; iIter < iNumElements; iIter++ )
+    objArray.insertBack((tDataType) iIter);
+
+  struct {
+    const tc_char* pcName;
+    tc_int iPosition;
+  } astOperations[] = {
+    { "insertFront", 1 },
+    { "insert middle", iNumElements / 2 }
+  };
+
+  for ( auto& stOperation : astOperations ) {
+    tc_clock::time_point objStart = tc_clock::now();
+
+    for ( tc_int iIter = 0; iIter < iNumOperations; iIter++ )
+      objArray.insert(stOperation.iPosition, (tDataType) iIter);
+
+    tc_double dElapsedMs = elapsedMilliSeconds(objStart);
+
+    printf("  %-12s %-16s elements: %-10ld ops: %-8ld time: %10.2f ms   per op: %8.2f us\n",
+            pcTypeName, stOperation.pcName, (long) iNumElements, (long) iNumOperations,
+            dElapsedMs, (dElapsedMs * 1000) / iNumOperations);
+
+    objStart = tc_clock::now();
+
+    for ( tc_int iIter = 0; iIter < iNumOperations; iIter++ )
+      objArray.remove(stOperation.iPosition, 1);
+
+    dElapsedMs = elapsedMilliSeconds(objStart);
+
+    printf("  %-12s %-16s elements: %-10ld ops: %-8ld time: %10.2f ms   per op: %8.2f us\n",
+            pcTypeName, (stOperation.iPosition == 1 ? "remove front" : "remove middle"),
+            (long) iNumElements, (long) iNumOperations, dElapsedMs, (dElapsedMs * 1000) / iNumOperations);
+  }
+}
+
+
+/*
+  Front/middle insert and remove on large arrays, each one shifts the array tail with a single memmove
+*/
+tc_void BenchmarkTeracadaArrayShift ( tc_int iNumElements ) {
+
+  cout << ">>> Benchmarking TeracadaArray front/middle insert and remove [ ELEMENTS: " << iNumElements << " ]" << endl;
+
+  benchmarkShift<tc_byte>(iNumElements, 1000, "TC_BYTE");
+  benchmarkShift<tc_int>(iNumElements, 1000, "TC_INT");
+  benchmarkShift<tc_decimal>(iNumElements, 1000, "TC_DECIMAL");
+  benchmarkShift<tc_char>(iNumElements, 1000, "TC_CHAR");
+
+  return;
+}
+
+
+/*
+  Text buffer editing on TeracadaArray<tc_char> for each storage mode
+    typing: single characters typed at a cursor moving slowly through the text
+    backspace: single characters removed before the cursor
+    scattered: words inserted at random positions
+  followed by compact() of the edited text
+*/
+static const tc_char* apcSTORAGE_MODE_NAMES[] = { "CONTIGUOUS", "GAP_BUFFER", "ROPE", "DEQUE", "RING" };
+
+static tc_void benchmarkStorageMode ( tc_byte b8StorageMode, tc_int iNumElements, tc_int iNumEdits ) {
+  TeracadaArray<tc_char> objText(iNumElements + 1);
+  objText.disableExceptions();
+
+  for ( tc_int iIter = 0; iIter < iNumElements; iIter++ )
+    objText.insertBack((tc_char) ('a' + (iIter % 26)));
+
+  objText.setStorageMode(b8StorageMode);
+
+  tc_int iCursor = iNumElements / 3;
+  tc_clock::time_point objStart = tc_clock::now();
+
+  for ( tc_int iIter = 0; iIter < iNumEdits; iIter++ ) {
+    objText.insert(iCursor + 1, (tc_char) 'x');
+    iCursor += ((iIter % 64) ? 1 : 100);
+  }
+
+  tc_double dTypingMs = elapsedMilliSeconds(objStart);
+  objStart = tc_clock::now();
+
+  for ( tc_int iIter = 0; iIter < iNumEdits; iIter++ )
+    objText.remove(iCursor--, 1);
+
+  tc_double dBackspaceMs = elapsedMilliSeconds(objStart);
+  srand(1);
+  objStart = tc_clock::now();
+
+  for ( tc_int iIter = 0; iIter < iNumEdits; iIter++ )
+    objText.insert((rand() % objText.getNumElements()) + 1, (tc_char*) "word ", 5);
+
+  tc_double dScatteredMs = elapsedMilliSeconds(objStart);
+  objStart = tc_clock::now();
+
+  objText.compact();
+
+  tc_double dCompactMs = elapsedMilliSeconds(objStart);
+
+  printf("  %-12s typing: %10.2f ms   backspace: %10.2f ms   scattered: %10.2f ms   compact: %8.2f ms\n",
+          apcSTORAGE_MODE_NAMES[b8StorageMode], dTypingMs, dBackspaceMs, dScatteredMs, dCompactMs);
+}
+
+
+tc_void BenchmarkTeracadaArrayStorageModes ( tc_int iNumElements ) {
+
+  cout << ">>> Benchmarking TeracadaArray storage modes, text editing [ ELEMENTS: " << iNumElements << " | EDITS: 10000 ]" << endl;
+
+  benchmarkStorageMode(TA_STORAGE_CONTIGUOUS, iNumElements, 10000);
+  benchmarkStorageMode(TA_STORAGE_GAP_BUFFER, iNumElements, 10000);
+  benchmarkStorageMode(TA_STORAGE_ROPE, iNumElements, 10000);
+  benchmarkStorageMode(TA_STORAGE_DEQUE, iNumElements, 10000);
+
+  return;
+}
+
+
+static tc_void benchmarkQueue ( tc_byte b8StorageMode, tc_int iNumElements ) {
+  TeracadaArray<tc_int> objQueue(100);
+  objQueue.disableExceptions();
+  objQueue.setStorageMode(b8StorageMode);
+
+  tc_clock::time_point objStart = tc_clock::now();
+
+  for ( tc_int iIter = 0; iIter < iNumElements; iIter++ )
+    objQueue.insertFront(iIter);
+
+  tc_double dInsertFrontMs = elapsedMilliSeconds(objStart);
+  objStart = tc_clock::now();
+
+  // FIFO work queue with a steady backlog of iNumElements
+  for ( tc_int iIter = 0; iIter < iNumElements; iIter++ ) {
+    objQueue.insertBack(iIter);
+    objQueue.remove(1, 1);
+  }
+
+  tc_double dFifoMs = elapsedMilliSeconds(objStart);
+
+  printf("  %-12s insertFront: %10.2f ms (%8.2f ns/op)   FIFO push/pop: %10.2f ms (%8.2f ns/op)   reallocs: %ld\n",
+          apcSTORAGE_MODE_NAMES[b8StorageMode], dInsertFrontMs, (dInsertFrontMs * 1000000) / iNumElements,
+          dFifoMs, (dFifoMs * 1000000) / iNumElements, (long) objQueue.getTotalReallocAttempts());
+}
+
+
+/*
+  insertFront() and FIFO queue (insertBack() + remove(1, 1)), contiguous storage shifts the whole array on each operation
+*/
+tc_void BenchmarkTeracadaArrayDeque ( tc_int iNumElements ) {
+
+  cout << ">>> Benchmarking TeracadaArray deque storage [ ELEMENTS: " << iNumElements << " ]" << endl;
+
+  benchmarkQueue(TA_STORAGE_CONTIGUOUS, iNumElements);
+  benchmarkQueue(TA_STORAGE_DEQUE, iNumElements);
+
+  return;
+}
+
+
+/*
+  Rolling sum/mean/min/max over the last iWindowSize samples, one new sample per tick
+    CONTIGUOUS: insertBack() + remove(1, 1) and a scan of the window on every tick
+    RING: insertBack() only, with the incremental window aggregates
+*/
+tc_void BenchmarkTeracadaArrayWindow ( tc_int iWindowSize ) {
+  tc_int iNumTicks = 1000000;
+  tc_double dChecksum = 0;
+
+  cout << ">>> Benchmarking TeracadaArray sliding window aggregates [ WINDOW: " << iWindowSize << " | TICKS: " << iNumTicks << " ]" << endl;
+
+  TeracadaArray<tc_decimal> objWindow(iWindowSize + 1);
+  objWindow.disableExceptions();
+  srand(1);
+
+  tc_clock::time_point objStart = tc_clock::now();
+
+  for ( tc_int iIter = 0; iIter < iNumTicks; iIter++ ) {
+    objWindow.insertBack((tc_decimal) (rand() % 1000));
+
+    if ( objWindow.getNumElements() > iWindowSize )
+      objWindow.remove(1, 1);
+
+    tc_decimal* pdWindow = (tc_decimal*) objWindow.getArray();
+    tc_decimal dSum = 0, dMin = pdWindow[0], dMax = pdWindow[0];
+
+    for ( tc_int iElement = 0; iElement < objWindow.getNumElements(); iElement++ ) {
+      dSum += pdWindow[iElement];
+      dMin = std::min(dMin, pdWindow[iElement]);
+      dMax = std::max(dMax, pdWindow[iElement]);
+    }
+
+    dChecksum += (dSum / objWindow.getNumElements()) + dMin + dMax;
+  }
+
+  printf("  %-12s time: %10.2f ms   per tick: %8.2f ns   checksum: %.0f\n",
+          "CONTIGUOUS", elapsedMilliSeconds(objStart), (elapsedMilliSeconds(objStart) * 1000000) / iNumTicks, dChecksum);
+
+  TeracadaArray<tc_decimal> objRing(iWindowSize);
+  objRing.disableExceptions();
+  objRing.setStorageMode(TA_STORAGE_RING);
+  dChecksum = 0;
+  srand(1);
+
+  objStart = tc_clock::now();
+
+  for ( tc_int iIter = 0; iIter < iNumTicks; iIter++ ) {
+    objRing.insertBack((tc_decimal) (rand() % 1000));
+    dChecksum += objRing.getWindowMean() + objRing.getWindowMin() + objRing.getWindowMax();
+  }
+
+  printf("  %-12s time: %10.2f ms   per tick: %8.2f ns   checksum: %.0f\n",
+          "RING", elapsedMilliSeconds(objStart), (elapsedMilliSeconds(objStart) * 1000000) / iNumTicks, dChecksum);
+
+  return;
+}
+
+
+template <typename tDataType>
+static tc_void benchmarkSum ( tc_int iNumElements, const tc_char* pcTypeName ) {
+  TeracadaArray<tDataType> objArray(iNumElements);
+  objArray.disableExceptions();
+
+  for ( tc_int iIter = 0; iIter < iNumElements; iIter++ )
+    objArray.insertBack((tDataType) (iIter % 100));
+
+  tDataType tSum = 0;
+  tc_clock::time_point objStart = tc_clock::now();
+
+  for ( tc_int iIter = 1; iIter <= objArray.getNumElements(); iIter++ )
+    tSum += *((tDataType*) objArray.get(iIter));
+
+  tc_double dGetMs = elapsedMilliSeconds(objStart);
+  tDataType tViewSum = 0;
+  objStart = tc_clock::now();
+
+  for ( tDataType tValue : objArray.view() )
+    tViewSum += tValue;
+
+  tc_double dViewMs = elapsedMilliSeconds(objStart);
+
+  printf("  %-12s get(): %10.2f ms   view(): %10.2f ms   speedup: %6.1fx   sums: %.0f %.0f\n",
+          pcTypeName, dGetMs, dViewMs, (dGetMs / dViewMs), (tc_double) tSum, (tc_double) tViewSum);
+}
+
+
+/*
+  Sum over the array, position based get() per element vs. the typed view (plain pointer loop, vectorizable)
+*/
+tc_void BenchmarkTeracadaArrayView ( tc_int iNumElements ) {
+
+  cout << ">>> Benchmarking TeracadaArray get() vs. view() sum [ ELEMENTS: " << iNumElements << " ]" << endl;
+
+  benchmarkSum<tc_int>(iNumElements, "TC_INT");
+  benchmarkSum<tc_decimal>(iNumElements, "TC_DECIMAL");
+
+  return;
+}
+
+
+/*
+  Hand off a built array from one pipeline stage to another: deep copy (clone()) vs. move vs. release()/adopt()
+*/
+tc_void BenchmarkTeracadaArrayHandoff ( tc_int iNumElements ) {
+
+  cout << ">>> Benchmarking TeracadaArray hand off between stages [ ELEMENTS: " << iNumElements << " ]" << endl;
+
+  tca_decimal objStage1(iNumElements);
+  objStage1.disableExceptions();
+
+  for ( tc_int iIter = 0; iIter < iNumElements; iIter++ )
+    objStage1.insertBack((tc_decimal) iIter);
+
+  tc_clock::time_point objStart = tc_clock::now();
+  tca_decimal objCopy = objStage1.clone();
+  printf("  %-20s time: %10.3f ms\n", "clone()", elapsedMilliSeconds(objStart));
+
+  objStart = tc_clock::now();
+  tca_decimal objStage2(std::move(objStage1));
+  printf("  %-20s time: %10.3f ms\n", "move", elapsedMilliSeconds(objStart));
+
+  tc_index iNumReleased = 0, iMaxNumReleased = 0;
+  tca_decimal objStage3(1);
+
+  objStart = tc_clock::now();
+  tc_void* pvBuffer = objStage2.release(&iNumReleased, &iMaxNumReleased);
+  objStage3.adopt(pvBuffer, iNumReleased, iMaxNumReleased);
+  printf("  %-20s time: %10.3f ms   elements: %ld %ld\n", "release()/adopt()", elapsedMilliSeconds(objStart),
+          (long) objCopy.getNumElements(), (long) objStage3.getNumElements());
+
+  return;
+}
+
+
+/*
+  Construct arrays with zero filled vs. uninitialized capacity and fill 10% of it,
+  for one large array (mmap'ed by malloc, lazily zeroed by the kernel anyway) and many small arrays (zeroed by calloc)
+*/
+static tc_void benchmarkZeroFill ( tc_index iNumArrays, tc_index iNumElements, tc_bool bZeroFill ) {
+  tc_uint64 ui64ResidentBytes = 0, ui64TotalBytes = 0;
+  tca_decimal* pobjArrays = nullptr;
+
+  tc_clock::time_point objStart = tc_clock::now();
+
+  pobjArrays = (tca_decimal*) malloc(iNumArrays * sizeof(tca_decimal));
+
+  for ( tc_index iArray = 0; iArray < iNumArrays; iArray++ ) {
+    new (&pobjArrays[iArray]) tca_decimal(iNumElements, bZeroFill);
+
+    for ( tc_index iIter = 0; iIter < (iNumElements / 10); iIter++ )
+      pobjArrays[iArray].insertBack((tc_decimal) iIter);
+  }
+
+  tc_double dElapsedMs = elapsedMilliSeconds(objStart);
+
+  for ( tc_index iArray = 0; iArray < iNumArrays; iArray++ ) {
+    stdTeracadaArrayFootprint stFootprint = pobjArrays[iArray].getFootprint();
+    ui64ResidentBytes += stFootprint.ui64ResidentBytes;
+    ui64TotalBytes += stFootprint.ui64TotalBytes;
+    pobjArrays[iArray].~tca_decimal();
+  }
+
+  free(pobjArrays);
+
+  printf("  %6ld x %-10ld %-12s time: %10.3f ms   resident: %8.2f MB   total: %8.2f MB\n", (long) iNumArrays, (long) iNumElements,
+          (bZeroFill ? "zero filled" : "lazy"), dElapsedMs, (ui64ResidentBytes / 1048576.0), (ui64TotalBytes / 1048576.0));
+}
+
+
+tc_void BenchmarkTeracadaArrayZeroFill ( tc_int iNumElements ) {
+
+  cout << ">>> Benchmarking TeracadaArray zero filled vs. lazy capacity [ ELEMENTS: " << iNumElements << " ]" << endl;
+
+  benchmarkZeroFill(1, iNumElements, true);
+  benchmarkZeroFill(1, iNumElements, false);
+
+  benchmarkZeroFill((iNumElements / 4096), 4096, true);
+  benchmarkZeroFill((iNumElements / 4096), 4096, false);
+
+  return;
+}
+
+
+/*
+  Build a column of short strings and scan it (total length, lookup of the last string):
+  tca_str of individually strdup()'ed strings vs. the string column (one character buffer + offsets)
+*/
+tc_void BenchmarkTeracadaStringArray ( tc_int iNumStrings ) {
+  tc_char acString[32] = {0};
+  tc_uint64 ui64Length = 0;
+  tc_index iFound = TA_NONE_INDEX;
+
+  cout << ">>> Benchmarking TeracadaArray<tc_str> vs. TeracadaStringArray [ STRINGS: " << iNumStrings << " ]" << endl;
+
+  {
+    tca_str objStrings(100);
+    objStrings.disableExceptions();
+    objStrings.setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
+
+    tc_clock::time_point objStart = tc_clock::now();
+
+    for ( tc_int iIter = 0; iIter < iNumStrings; iIter++ ) {
+      snprintf(acString, sizeof(acString), "string-%d", (tc_int32) iIter);
+      objStrings.insertBack(strdup(acString));
+    }
+
+    tc_double dBuildMs = elapsedMilliSeconds(objStart);
+    objStart = tc_clock::now();
+
+    for ( tc_str pcString : objStrings.view() )
+      ui64Length += strlen(pcString);
+
+    for ( tc_index iIndex = 0; iIndex < objStrings.getNumElements(); iIndex++ ) {
+      if ( ! strcmp(objStrings[iIndex], acString) ) {
+        iFound = iIndex + 1;
+        break;
+      }
+    }
+
+    tc_double dScanMs = elapsedMilliSeconds(objStart);
+
+    printf("  %-20s build: %10.3f ms   scan: %10.3f ms   allocs: %10ld   chars: %lu   found: %ld\n", "tca_str + strdup()",
+            dBuildMs, dScanMs, (long) iNumStrings, ui64Length, (long) iFound);
+
+    for ( tc_str pcString : objStrings.view() )
+      free(pcString);
+  }
+
+  {
+    TeracadaHeapAllocator objHeap;
+    tca_strings objStrings(100, 0, &objHeap);
+    objStrings.disableExceptions();
+
+    ui64Length = 0;
+    tc_clock::time_point objStart = tc_clock::now();
+
+    for ( tc_int iIter = 0; iIter < iNumStrings; iIter++ )
+      objStrings.insertBack(string_view(acString, snprintf(acString, sizeof(acString), "string-%d", (tc_int32) iIter)));
+
+    tc_double dBuildMs = elapsedMilliSeconds(objStart);
+    objStart = tc_clock::now();
+
+    for ( tc_index iIndex = 0; iIndex < objStrings.getNumElements(); iIndex++ )
+      ui64Length += objStrings[iIndex].size();
+
+    iFound = objStrings.find(acString);
+
+    tc_double dScanMs = elapsedMilliSeconds(objStart);
+    stdTeracadaAllocatorStats stStats = objHeap.getStats();
+
+    printf("  %-20s build: %10.3f ms   scan: %10.3f ms   allocs: %10lu   chars: %lu   found: %ld\n", "tca_strings",
+            dBuildMs, dScanMs, (stStats.ui64NumAllocs + stStats.ui64NumReallocs), ui64Length, (long) iFound);
+  }
+
+  return;
+}
+
+
+/*
+  Column of repeated labels (iNumDistinct distinct values): every label copied to the string column
+  vs. interned once in the string pool, counting the labels equal to one value (memcmp vs. pointer comparison)
+*/
+tc_void BenchmarkTeracadaStringPool ( tc_int iNumStrings, tc_int iNumDistinct ) {
+  tc_char acString[32] = {0};
+  tc_int iNumEqual = 0;
+
+  cout << ">>> Benchmarking TeracadaStringArray vs. TeracadaStringPool interning [ STRINGS: " << iNumStrings << " | DISTINCT: " << iNumDistinct << " ]" << endl;
+
+  {
+    tca_strings objStrings(100);
+    objStrings.disableExceptions();
+
+    tc_clock::time_point objStart = tc_clock::now();
+
+    for ( tc_int iIter = 0; iIter < iNumStrings; iIter++ )
+      objStrings.insertBack(string_view(acString, snprintf(acString, sizeof(acString), "category-%d", (tc_int32) (iIter % iNumDistinct))));
+
+    tc_double dBuildMs = elapsedMilliSeconds(objStart);
+    string_view svValue("category-7");
+    objStart = tc_clock::now();
+
+    for ( tc_index iIndex = 0; iIndex < objStrings.getNumElements(); iIndex++ )
+      iNumEqual += (objStrings[iIndex] == svValue);
+
+    tc_double dScanMs = elapsedMilliSeconds(objStart);
+
+    printf("  %-20s build: %10.3f ms   count equal: %8.3f ms (%d)   MB: %8.2f\n", "tca_strings", dBuildMs, dScanMs, iNumEqual,
+            (objStrings.getArraySize() / 1048576.0));
+  }
+
+  {
+    TeracadaStringPool objPool;
+    tca_str objLabels(100);
+    objLabels.disableExceptions();
+    objLabels.setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
+
+    iNumEqual = 0;
+    tc_clock::time_point objStart = tc_clock::now();
+
+    for ( tc_int iIter = 0; iIter < iNumStrings; iIter++ )
+      objLabels.insertBack((tc_str) objPool.internCStr(string_view(acString, snprintf(acString, sizeof(acString), "category-%d", (tc_int32) (iIter % iNumDistinct)))));
+
+    tc_double dBuildMs = elapsedMilliSeconds(objStart);
+    const tc_char* pcValue = objPool.internCStr("category-7");
+    objStart = tc_clock::now();
+
+    for ( tc_str pcLabel : objLabels.view() )
+      iNumEqual += (pcLabel == pcValue);
+
+    tc_double dScanMs = elapsedMilliSeconds(objStart);
+    stdTeracadaStringPoolStats stStats = objPool.getStats();
+
+    printf("  %-20s build: %10.3f ms   count equal: %8.3f ms (%d)   MB: %8.2f   hit rate: %.4f   MB saved: %8.2f\n", "tca_str + pool",
+            dBuildMs, dScanMs, iNumEqual, ((objLabels.getArraySize() + stStats.ui64TotalBytes) / 1048576.0), objPool.getHitRate(),
+            (stStats.ui64BytesSaved / 1048576.0));
+  }
+
+  return;
+}
+
+
+tc_void BenchmarkTeracadaCategoricalArray ( tc_int iNumStrings, tc_int iNumDistinct ) {
+  tc_char acString[32] = {0};
+  tc_int iNumEqual = 0;
+
+  cout << ">>> Benchmarking tca_str vs. TeracadaCategoricalArray [ STRINGS: " << iNumStrings << " | DISTINCT: " << iNumDistinct << " ]" << endl;
+
+  {
+    tca_str objLabels(100);
+    objLabels.disableExceptions();
+    objLabels.setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
+
+    for ( tc_int iIter = 0; iIter < iNumStrings; iIter++ ) {
+      snprintf(acString, sizeof(acString), "category-%d", (tc_int32) (iIter % iNumDistinct));
+      objLabels.insertBack(strdup(acString));
+    }
+
+    tc_clock::time_point objStart = tc_clock::now();
+
+    for ( tc_str pcLabel : objLabels.view() )
+      iNumEqual += ! strcmp(pcLabel, "category-7");
+
+    tc_double dScanMs = elapsedMilliSeconds(objStart);
+
+    // Group-by through a map of the distinct strings
+    map<string, tc_int> mapCounts;
+    objStart = tc_clock::now();
+
+    for ( tc_str pcLabel : objLabels.view() )
+      mapCounts[pcLabel]++;
+
+    tc_double dGroupMs = elapsedMilliSeconds(objStart);
+    tc_uint64 ui64Bytes = objLabels.getArraySize();
+
+    for ( tc_str pcLabel : objLabels.view() ) {
+      ui64Bytes += strlen(pcLabel) + 1;
+      free(pcLabel);
+    }
+
+    printf("  %-20s count equal: %8.3f ms (%d)   group count: %8.3f ms (%zu)   MB: %8.2f\n", "tca_str + strcmp", dScanMs, iNumEqual,
+            dGroupMs, mapCounts.size(), (ui64Bytes / 1048576.0));
+  }
+
+  {
+    tca_categorical objLabels(100);
+    objLabels.disableExceptions();
+
+    for ( tc_int iIter = 0; iIter < iNumStrings; iIter++ )
+      objLabels.insertBack(string_view(acString, snprintf(acString, sizeof(acString), "category-%d", (tc_int32) (iIter % iNumDistinct))));
+
+    tc_clock::time_point objStart = tc_clock::now();
+    iNumEqual = objLabels.countEqual("category-7");
+    tc_double dScanMs = elapsedMilliSeconds(objStart);
+
+    tca_int objCounts(1);
+    objStart = tc_clock::now();
+    objLabels.groupCount(&objCounts);
+    tc_double dGroupMs = elapsedMilliSeconds(objStart);
+
+    printf("  %-20s count equal: %8.3f ms (%d)   group count: %8.3f ms (%ld)   MB: %8.2f   code size: %d\n", "tca_categorical", dScanMs, iNumEqual,
+            dGroupMs, (tc_int64) objCounts.getNumElements(), (objLabels.getArraySize() / 1048576.0), (tc_int) objLabels.getCodeSize());
+  }
+
+  return;
+}
+
+
+// The stats functions before the reduction kernels: a loop per function, pow() per element, two passes for the range
+template <typename tDataType>
+static tc_double legacyStats ( const tDataType* ptElements, tc_index iNumElements ) {
+  tDataType tMin = 0, tMax = 0, tRangeMin = 0, tRangeMax = 0;
+  tc_decimal dMean = 0, dVarianceMean = 0, dVariance = 0;
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    tMin = (ptElements[iIter] < tMin) ? ptElements[iIter] : tMin;
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    tMax = (ptElements[iIter] > tMax) ? ptElements[iIter] : tMax;
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    dMean += ptElements[iIter];
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    dVarianceMean += ptElements[iIter];
+
+  dVarianceMean /= iNumElements;
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    dVariance += pow((ptElements[iIter] - dVarianceMean), 2);
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    tRangeMax = (ptElements[iIter] > tRangeMax) ? ptElements[iIter] : tRangeMax;
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    tRangeMin = (ptElements[iIter] < tRangeMin) ? ptElements[iIter] : tRangeMin;
+
+  return (tMin + tMax + (dMean / iNumElements) + (dVariance / iNumElements) + (tRangeMax - tRangeMin));
+}
+
+
+template <typename tDataType>
+static tc_void benchmarkStats ( tc_index iNumElements, const tc_char* pcTypeName ) {
+  TeracadaArray<tDataType> objArray(iNumElements, false);
+  stdTeracadaStatsSummary<tDataType> stSummary;
+  tc_index iNumRuns = max<tc_index>(1, 100000000 / iNumElements);
+  tc_double dChecksum = 0;
+
+  objArray.disableExceptions();
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    objArray.insertBack((tDataType) ((iIter * 7919) % 251));
+
+  tc_clock::time_point objStart = tc_clock::now();
+
+  for ( tc_index iRun = 0; iRun < iNumRuns; iRun++ )
+    dChecksum += legacyStats(objArray.data(), iNumElements);
+
+  tc_double dLegacyMs = elapsedMilliSeconds(objStart) / iNumRuns;
+
+  printf("  %-10s elements: %10ld   legacy: %10.4f ms", pcTypeName, (tc_int64) iNumElements, dLegacyMs);
+
+  for ( tc_byte b8SimdLevel = TS_SIMD_SCALAR; b8SimdLevel <= TeracadaStats::getMaxSimdLevel(); b8SimdLevel++ ) {
+    TeracadaStats::setSimdLevel(b8SimdLevel);
+    objStart = tc_clock::now();
+
+    for ( tc_index iRun = 0; iRun < iNumRuns; iRun++ ) {
+      objArray.summarize(&stSummary);
+      dChecksum += stSummary.dSum;
+    }
+
+    tc_double dFusedMs = elapsedMilliSeconds(objStart) / iNumRuns;
+
+    printf("   %s: %10.4f ms (%5.1fx)", TeracadaStats::getSimdLevelName(b8SimdLevel), dFusedMs, (dLegacyMs / dFusedMs));
+  }
+
+  TeracadaStats::setSimdLevel(TS_SIMD_AVX512);
+
+  // Single pass mean, M2, M3 and M4 (skewness/kurtosis) at the best SIMD level
+  TeracadaStatsMoments<tDataType> objMoments;
+  objStart = tc_clock::now();
+
+  for ( tc_index iRun = 0; iRun < iNumRuns; iRun++ ) {
+    objMoments.reset();
+    objArray.moments(&objMoments);
+    dChecksum += objMoments.getKurtosis();
+  }
+
+  tc_double dMomentsMs = elapsedMilliSeconds(objStart) / iNumRuns;
+
+  printf("   MOMENTS: %10.4f ms (%5.1fx)", dMomentsMs, (dLegacyMs / dMomentsMs));
+
+  // Keeps the loops from being optimized away
+  printf("%s\n", (dChecksum ? "" : "   (checksum 0)"));
+}
+
+
+/*
+  min/max/mean/variance/range as separate scalar loops (7 passes) vs. a single fused summarize() pass per SIMD level,
+  and vs. the higher moments (TeracadaStatsMoments) in a single pass, from 1K elements to iMaxNumElements, the sizes that don't fit in half the memory are skipped
+*/
+tc_void BenchmarkTeracadaArrayStats ( tc_index iMaxNumElements ) {
+  tc_uint64 ui64MemoryBytes = (tc_uint64) sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+
+  cout << ">>> Benchmarking TeracadaArray stats, legacy loops vs. fused reduction kernels [ MAX ELEMENTS: " << iMaxNumElements
+       << " | SIMD: " << TeracadaStats::getSimdLevelName(TeracadaStats::getMaxSimdLevel()) << " ]" << endl;
+
+  for ( tc_index iNumElements = 1000; iNumElements <= iMaxNumElements; iNumElements *= 10 ) {
+    if ( (iNumElements * sizeof(tc_decimal)) > (ui64MemoryBytes / 2) ) {
+      printf("  elements: %10ld   skipped, more than half the memory\n", (tc_int64) iNumElements);
+      continue;
+    }
+
+    benchmarkStats<tc_byte>(iNumElements, "TC_BYTE");
+    benchmarkStats<tc_int>(iNumElements, "TC_INT");
+    benchmarkStats<tc_decimal>(iNumElements, "TC_DECIMAL");
+  }
+
+  return;
+}
+
+
+template <typename tDataType>
+static tc_void benchmarkArgStats ( tc_index iNumElements, tc_int iNumValues, const tc_char* pcTypeName ) {
+  TeracadaArray<tDataType> objArray(iNumElements, false);
+  TeracadaArray<tc_int> objPositions(iNumElements, false);
+  tc_index iNumRuns = max<tc_index>(1, 100000000 / iNumElements);
+  tc_double dChecksum = 0;
+
+  objArray.disableExceptions();
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    objArray.insertBack((tDataType) ((iIter * 7919) % iNumValues));
+
+  // Reduce the min, then a second scan inserting the positions one by one
+  tc_clock::time_point objStart = tc_clock::now();
+
+  for ( tc_index iRun = 0; iRun < iNumRuns; iRun++ ) {
+    tDataType tMin = objArray.min();
+
+    objPositions.reset();
+
+    for ( tc_index iIter = 0; iIter < iNumElements; iIter++ ) {
+      if ( objArray[iIter] == tMin )
+        objPositions.insertBack((tc_int) (iIter + 1));
+    }
+
+    dChecksum += objPositions.getNumElements();
+  }
+
+  tc_double dTwoPassMs = elapsedMilliSeconds(objStart) / iNumRuns;
+
+  printf("  %-10s elements: %10ld   min positions: %9ld   two passes: %9.4f ms", pcTypeName, (tc_int64) iNumElements,
+         (tc_int64) objPositions.getNumElements(), dTwoPassMs);
+
+  for ( tc_byte b8SimdLevel = TS_SIMD_SCALAR; b8SimdLevel <= TeracadaStats::getMaxSimdLevel(); b8SimdLevel++ ) {
+    TeracadaStats::setSimdLevel(b8SimdLevel);
+    objStart = tc_clock::now();
+
+    for ( tc_index iRun = 0; iRun < iNumRuns; iRun++ ) {
+      objPositions.reset();
+      dChecksum += objArray.min(&objPositions) + objPositions.getNumElements();
+    }
+
+    tc_double dSinglePassMs = elapsedMilliSeconds(objStart) / iNumRuns;
+
+    printf("   %s: %9.4f ms (%5.1fx)", TeracadaStats::getSimdLevelName(b8SimdLevel), dSinglePassMs, (dTwoPassMs / dSinglePassMs));
+  }
+
+  TeracadaStats::setSimdLevel(TS_SIMD_AVX512);
+
+  printf("%s\n", (dChecksum ? "" : "   (checksum 0)"));
+}
+
+
+/*
+  min() with the positions: the min then a second scan inserting the positions one by one vs. the single pass search
+  kernels per SIMD level, for a rare min (every 1000003 elements, 256 for the bytes) and for a min repeated every 4 elements
+*/
+tc_void BenchmarkTeracadaArrayArgStats ( tc_index iNumElements ) {
+  cout << ">>> Benchmarking TeracadaArray min positions, two passes vs. single pass search kernels [ ELEMENTS: " << iNumElements
+       << " | SIMD: " << TeracadaStats::getSimdLevelName(TeracadaStats::getMaxSimdLevel()) << " ]" << endl;
+
+  for ( tc_int iNumValues : { 1000003, 4 } ) {
+    benchmarkArgStats<tc_byte>(iNumElements, min<tc_int>(iNumValues, 256), "TC_BYTE");
+    benchmarkArgStats<tc_int>(iNumElements, iNumValues, "TC_INT");
+    benchmarkArgStats<tc_decimal>(iNumElements, iNumValues, "TC_DECIMAL");
+  }
+
+  return;
+}
+
+
+/*
+  mean()/variance() (summarize()) and moments() of iNumElements decimals with 1, 2, 4, ... threads, up to the threads of the cpu
+  (2 at least), the bandwidth is the element bytes read per second
+*/
+tc_void BenchmarkTeracadaArrayStatsParallel ( tc_index iNumElements ) {
+  tc_uint64 ui64MemoryBytes = (tc_uint64) sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+  tc_uint32 ui32MaxNumThreads = max(thread::hardware_concurrency(), 2u);
+  tc_index iNumRuns = max<tc_index>(5, 1000000000 / iNumElements);
+  tc_double dSummarizeMs1Thread = 0, dMomentsMs1Thread = 0, dChecksum = 0;
+
+  cout << ">>> Benchmarking TeracadaArray parallel stats [ ELEMENTS: " << iNumElements << " | CPU THREADS: " << thread::hardware_concurrency()
+       << " | MIN CHUNK: " << TeracadaStats::getMinChunkSize() << " ]" << endl;
+
+  if ( (iNumElements * sizeof(tc_decimal)) > (ui64MemoryBytes / 2) ) {
+    printf("  elements: %10ld   skipped, more than half the memory\n", (tc_int64) iNumElements);
+    return;
+  }
+
+  TeracadaArray<tc_decimal> objArray(iNumElements, false);
+  stdTeracadaStatsSummary<tc_decimal> stSummary;
+  TeracadaStatsMoments<tc_decimal> objMoments;
+
+  objArray.disableExceptions();
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ )
+    objArray.insertBack((tc_decimal) ((iIter * 7919) % 251));
+
+  for ( tc_uint32 ui32NumThreads = 1; ui32NumThreads <= ui32MaxNumThreads; ui32NumThreads *= 2 ) {
+    TeracadaStats::setNumThreads(ui32NumThreads);
+
+    tc_clock::time_point objStart = tc_clock::now();
+
+    for ( tc_index iRun = 0; iRun < iNumRuns; iRun++ ) {
+      objArray.summarize(&stSummary);
+      dChecksum += stSummary.dSum;
+    }
+
+    tc_double dSummarizeMs = elapsedMilliSeconds(objStart) / iNumRuns;
+    objStart = tc_clock::now();
+
+    for ( tc_index iRun = 0; iRun < iNumRuns; iRun++ ) {
+      objMoments.reset();
+      objArray.moments(&objMoments);
+      dChecksum += objMoments.getVariance();
+    }
+
+    tc_double dMomentsMs = elapsedMilliSeconds(objStart) / iNumRuns;
+
+    if ( ui32NumThreads == 1 ) {
+      dSummarizeMs1Thread = dSummarizeMs;
+      dMomentsMs1Thread = dMomentsMs;
+    }
+
+    printf("  threads: %4u   summarize: %10.4f ms (%5.1fx, %6.2f GB/s)   moments: %10.4f ms (%5.1fx, %6.2f GB/s)%s\n", ui32NumThreads,
+           dSummarizeMs, (dSummarizeMs1Thread / dSummarizeMs), ((iNumElements * sizeof(tc_decimal)) / (dSummarizeMs * 1e6)),
+           dMomentsMs, (dMomentsMs1Thread / dMomentsMs), ((iNumElements * sizeof(tc_decimal)) / (dMomentsMs * 1e6)),
+           (dChecksum ? "" : "   (checksum 0)"));
+  }
+
+  TeracadaStats::setNumThreads(1);
+
+  return;
+}
+
+
+/*
+  Usage: <benchmarks> [BENCHMARK_NAME] [NUM_ELEMENTS]
+    Runs all the benchmarks when BENCHMARK_NAME is not given (or is "all")
+*/
+int main ( int argc, char* argv[] ) {
+  const tc_char* pcBenchmark = (argc > 1) ? argv[1] : "all";
+  tc_int iNumElements = (argc > 2) ? atol(argv[2]) : 0;
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "resize") ) {
+    BenchmarkTeracadaArrayResizeAlgo(iNumElements ? iNumElements : 10000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "shift") ) {
+    BenchmarkTeracadaArrayShift(iNumElements ? iNumElements : 1000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "logging") ) {
+    BenchmarkTeracadaArrayInsertLogging(iNumElements ? iNumElements : 1000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "storage") ) {
+    BenchmarkTeracadaArrayStorageModes(iNumElements ? iNumElements : 10000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "deque") ) {
+    BenchmarkTeracadaArrayDeque(iNumElements ? iNumElements : 100000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "window") ) {
+    BenchmarkTeracadaArrayWindow(iNumElements ? iNumElements : 1000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "view") ) {
+    BenchmarkTeracadaArrayView(iNumElements ? iNumElements : 10000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "handoff") ) {
+    BenchmarkTeracadaArrayHandoff(iNumElements ? iNumElements : 10000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "zerofill") ) {
+    BenchmarkTeracadaArrayZeroFill(iNumElements ? iNumElements : 50000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "strings") ) {
+    BenchmarkTeracadaStringArray(iNumElements ? iNumElements : 10000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "interning") ) {
+    BenchmarkTeracadaStringPool((iNumElements ? iNumElements : 10000000), 1000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "categorical") ) {
+    BenchmarkTeracadaCategoricalArray((iNumElements ? iNumElements : 10000000), 100);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "stats") ) {
+    BenchmarkTeracadaArrayStats(iNumElements ? iNumElements : 1000000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "argstats") ) {
+    BenchmarkTeracadaArrayArgStats(iNumElements ? iNumElements : 10000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "parallel") ) {
+    BenchmarkTeracadaArrayStatsParallel(iNumElements ? iNumElements : 100000000);
+    cout << endl;
+  }
+
+  return 0;
+}
@@ -7,7 +7,7 @@
 
 static uint8_t _b8DATA_TYPE = TC_NONE;
 
-EXTERN_C stdTeraArray* ta_arrayInit ( tc_int iDataType, tc_int iNumElements ) {
+EXTERN_C stdTeraArray* ta_arrayInit ( tc_int iDataType, tc_index iNumElements ) {
   if ( ! (iDataType >= TC_BYTE && iDataType <= TC_ARRAY) )
     return nullptr;
 
@@ -84,7 +84,7 @@ EXTERN_C void* ta_getArray ( stdTeraArray* pstiTeraArray ) {
 }
 
 
-EXTERN_C tc_int ta_getNumElements ( stdTeraArray* pstiTeraArray ) {
+EXTERN_C tc_index ta_getNumElements ( stdTeraArray* pstiTeraArray ) {
   if ( ! pstiTeraArray )
     return -1;
 
@@ -92,7 +92,7 @@ EXTERN_C tc_int ta_getNumElements ( stdTeraArray* pstiTeraArray ) {
 }
 
 
-EXTERN_C tc_bool ta_insertByte ( stdTeraArray* pstiTeraArray, tc_int iPosition, const tc_byte b8Value ) {
+EXTERN_C tc_bool ta_insertByte ( stdTeraArray* pstiTeraArray, tc_index iPosition, const tc_byte b8Value ) {
   if ( ! pstiTeraArray )
     return false;
 
@@ -103,7 +103,7 @@ EXTERN_C tc_bool ta_insertByte ( stdTeraArray* pstiTeraArray, tc_int iPosition,
 }
 
 
-EXTERN_C tc_bool ta_insertInt ( stdTeraArray* pstiTeraArray, tc_int iPosition, const tc_int iValue ) {
+EXTERN_C tc_bool ta_insertInt ( stdTeraArray* pstiTeraArray, tc_index iPosition, const tc_int iValue ) {
   if ( ! pstiTeraArray )
     return false;
 
@@ -114,7 +114,7 @@ EXTERN_C tc_bool ta_insertInt ( stdTeraArray* pstiTeraArray, tc_int iPosition, c
 }
 
 
-EXTERN_C tc_bool ta_insertDecimal ( stdTeraArray* pstiTeraArray, tc_int iPosition, const tc_decimal dValue ) {
+EXTERN_C tc_bool ta_insertDecimal ( stdTeraArray* pstiTeraArray, tc_index iPosition, const tc_decimal dValue ) {
   if ( ! pstiTeraArray )
     return false;
 
@@ -157,7 +157,7 @@ EXTERN_C tc_bool ta_insertDecimal ( stdTeraArray* pstiTeraArray, tc_int iPositio
 // }
 
 
-EXTERN_C void* ta_get ( stdTeraArray* pstiTeraArray, tc_int iPosition ) {
+EXTERN_C void* ta_get ( stdTeraArray* pstiTeraArray, tc_index iPosition ) {
   if ( ! pstiTeraArray )
     return nullptr;
 
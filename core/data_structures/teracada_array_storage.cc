@@ -0,0 +1,1023 @@
+/*!
+  @file
+  @author Rishabh Soni (Prevalent Dynamics)
+
+  @brief
+    Implementation of the TeracadaArray storage modes
+
+  @details
+    The position based api functions (insert(), remove(), get()) dispatch here for the storage modes other than
+    TA_STORAGE_CONTIGUOUS. Position and bounds validation is always done by the api functions themselves.
+
+    - TA_STORAGE_GAP_BUFFER: The elements before the gap are at the start of the main array buffer and the elements
+      after the gap are at the end of it. Inserts/removes move the gap to the edit position first, so consecutive
+      edits around the same position only move the elements in between.
+    - TA_STORAGE_ROPE: The elements are split over small chunks (TA_ROPE_CHUNK_SIZE bytes), inserts/removes only move
+      elements within a single chunk. The rope is built from the main array buffer on the first edit and flattened
+      back into it by compact().
+    - TA_STORAGE_DEQUE: The elements are in order in the main array buffer, starting at m_iHeadIndex. Inserts/removes
+      move the shorter side of the array, towards the free space at the start or at the end of the buffer.
+    - TA_STORAGE_RING: The elements are in a circular buffer of the array capacity, starting at m_iHeadIndex.
+      Only inserts after the last element are allowed, overwriting the oldest element when full. The window
+      aggregates (sum, mean, min, max) are updated on every insert/remove.
+
+  @attention
+    For the non contiguous storage modes, the main array buffer (getArray()) doesn't hold the elements in order.
+    Call compact() before using getArray(), or the TC_CHAR null terminator.
+*/
+
+
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <type_traits>
+
+#include "teracada_array.h"
+
+
+/*!
+  @brief
+    Set the storage mode of the array elements
+
+  @details
+    The array is compacted first, so the elements are always contiguous right after changing the storage mode.
+    For TA_STORAGE_RING, the window size is the array capacity (set on initialization, or with reserve()).
+
+  @param[in]
+    b8StorageMode The storage mode (TA_STORAGE_CONTIGUOUS, TA_STORAGE_GAP_BUFFER, TA_STORAGE_ROPE, TA_STORAGE_DEQUE or TA_STORAGE_RING)
+
+  @retval
+    true Successfully set the storage mode
+
+  @retval
+    false Failed to set the storage mode
+
+  @par Examples
+    @code{.cpp}
+    TeracadaArray<tc_char> objText(1000);
+    objText.setStorageMode(TA_STORAGE_GAP_BUFFER);
+    @endcode
+
+  @par Errors/Exceptions
+    - ERR_TA_INVALID_PARAM
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::setStorageMode ( tc_byte b8StorageMode ) {
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  if ( b8StorageMode != TA_STORAGE_CONTIGUOUS && b8StorageMode != TA_STORAGE_GAP_BUFFER &&
+       b8StorageMode != TA_STORAGE_ROPE && b8StorageMode != TA_STORAGE_DEQUE && b8StorageMode != TA_STORAGE_RING ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::setStorageMode(): Invalid storage mode [ STORAGE_MODE: %d ]", b8StorageMode);
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
+  }
+
+  if ( ! compact() )
+    goto ERREXIT;
+
+  if ( getStorageMode() == TA_STORAGE_RING )
+    ringFreeAggregates();
+
+  m_b8StorageMode = b8StorageMode;
+  m_iGapIndex = getNumElements();
+
+  if ( b8StorageMode == TA_STORAGE_RING ) {
+    m_ui64RingPushSeq = getNumElements();
+
+    if ( getRingCapacity() <= 0 || ! ringRebuildAggregates() ) {
+      m_b8StorageMode = TA_STORAGE_CONTIGUOUS;
+      goto ERREXIT;
+    }
+  }
+
+  EXIT:
+    TC_LOG(LOG_INFO, "TeracadaArray::setStorageMode(): Storage mode set [ STORAGE_MODE: %d ]", b8StorageMode);
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::setStorageMode(): Failed to set the storage mode [ STORAGE_MODE: %d ]", b8StorageMode);
+    return false;
+}
+
+
+/*!
+  @brief
+    Make the array elements contiguous in the main array buffer
+
+  @details
+    - TA_STORAGE_GAP_BUFFER: Move the gap to the end of the array.
+    - TA_STORAGE_ROPE: Flatten all the chunks back into the main array buffer.
+    - TA_STORAGE_DEQUE: Move the elements to the start of the main array buffer.
+    - TA_STORAGE_RING: Rotate the circular buffer, so the oldest element is at the start of the main array buffer.
+    - TA_STORAGE_CONTIGUOUS: Nothing to be done.
+
+    The storage mode is not changed, the next edit continues with the same storage mode.
+
+  @par Parameters
+    None.
+
+  @retval
+    true The array elements are contiguous in the main array buffer (getArray())
+
+  @retval
+    false Failed to compact the array
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::compact ( void ) {
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  if ( isContiguous() )
+    goto EXIT;
+
+  switch ( getStorageMode() ) {
+
+    case TA_STORAGE_GAP_BUFFER:
+      moveGapTo(getNumElements());
+      break;
+
+    case TA_STORAGE_ROPE:
+      if ( ! ropeFlatten() )
+        goto ERREXIT;
+
+      break;
+
+    case TA_STORAGE_DEQUE:
+      shiftElements(m_iHeadIndex, 0, getNumElements());
+      m_iHeadIndex = 0;
+      break;
+
+    case TA_STORAGE_RING:
+      std::rotate((tDataType*) getArray(), ((tDataType*) getArray() + m_iHeadIndex), ((tDataType*) getArray() + getRingCapacity()));
+      m_iHeadIndex = 0;
+      break;
+
+    default:
+      break;
+  }
+
+  EXIT:
+    // Also written for an already contiguous array, a removal from the tail leaves the old null terminator behind
+    if constexpr ( std::is_same_v<tDataType, tc_char> ) {
+      *((tDataType*) getArray() + getLastElementIndex() + 1) = '\0';
+    }
+
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::compact(): Failed to compact the array");
+    throwException(ERR_TA_RUNTIME);
+    return false;
+}
+
+
+/*!
+  @brief
+    Insert values for the non contiguous storage modes
+
+  @details
+    - With overwrite enabled, the existing elements are replaced (removed first, then inserted).
+    - Inserting after the index next to the last element leaves zero elements in between, same as contiguous storage.
+
+  @param[in]
+    iIndex The index to insert the first value at (already validated)
+
+  @param[in]
+    ptValue The pointer to the values to be inserted
+
+  @param[in]
+    iLength The number of values to be inserted
+
+  @retval
+    true Successfully inserted the values
+
+  @retval
+    false Failed to insert the values
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::storageInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength ) {
+  tDataType atZero[64] = {};
+  tc_index iPadLength = 0;
+
+  if ( getStorageMode() == TA_STORAGE_RING )
+    return ringInsert(iIndex, ptValue, iLength);
+
+  auto insertElements = [&] ( tc_index iInsertIndex, tDataType* ptElements, tc_index iNumElements ) -> tc_bool {
+    switch ( getStorageMode() ) {
+      case TA_STORAGE_GAP_BUFFER:
+        return gapInsert(iInsertIndex, ptElements, iNumElements);
+
+      case TA_STORAGE_DEQUE:
+        return dequeInsert(iInsertIndex, ptElements, iNumElements);
+
+      default:
+        return ropeInsert(iInsertIndex, ptElements, iNumElements);
+    }
+  };
+
+  if ( isOverwriteEnabled() && iIndex < getNumElements() ) {
+    if ( ! storageRemove(iIndex, std::min<tc_index>(iLength, (getNumElements() - iIndex))) )
+      goto ERREXIT;
+  }
+
+  while ( iIndex > getNumElements() ) {
+    iPadLength = std::min<tc_index>((iIndex - getNumElements()), (sizeof(atZero) / sizeof(tDataType)));
+
+    if ( ! insertElements(getNumElements(), atZero, iPadLength) )
+      goto ERREXIT;
+  }
+
+  if ( ! insertElements(iIndex, ptValue, iLength) )
+    goto ERREXIT;
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::storageRemove ( tc_index iIndex, tc_index iNumElements ) {
+  switch ( getStorageMode() ) {
+    case TA_STORAGE_GAP_BUFFER:
+      return gapRemove(iIndex, iNumElements);
+
+    case TA_STORAGE_DEQUE:
+      return dequeRemove(iIndex, iNumElements);
+
+    case TA_STORAGE_RING:
+      return ringRemove(iIndex, iNumElements);
+
+    default:
+      return ropeRemove(iIndex, iNumElements);
+  }
+}
+
+
+/*!
+  @brief
+    Get the pointer to the element at the index, for the non contiguous storage modes
+
+  @param[in]
+    iIndex The array index (already validated)
+
+  @retval
+    Pointer Pointer to the element, or the element itself for the pointer data types (same as get())
+*/
+template <typename tDataType>
+tc_void* TeracadaArray<tDataType>::storageGet ( tc_index iIndex ) {
+  tDataType* ptElement = nullptr;
+  tc_index iOffset = 0;
+  tc_index iChunk = 0;
+
+  switch ( getStorageMode() ) {
+
+    case TA_STORAGE_GAP_BUFFER:
+      ptElement = (tDataType*) getArray() + ((iIndex < m_iGapIndex) ? iIndex : (iIndex + getGapLength()));
+      break;
+
+    case TA_STORAGE_ROPE:
+      if ( ! m_pstRopeChunks ) {
+        ptElement = (tDataType*) getArray() + iIndex;
+        break;
+      }
+
+      iChunk = ropeLocate(iIndex, &iOffset);
+      ptElement = (tDataType*) m_pstRopeChunks[iChunk].pvElements + iOffset;
+      break;
+
+    case TA_STORAGE_DEQUE:
+      ptElement = (tDataType*) getArray() + m_iHeadIndex + iIndex;
+      break;
+
+    case TA_STORAGE_RING:
+      ptElement = ringElement(iIndex);
+      break;
+
+    default:
+      ptElement = (tDataType*) getArray() + iIndex;
+      break;
+  }
+
+  if constexpr ( std::is_pointer_v<tDataType> ) {
+    return *ptElement;
+  } else {
+    return ptElement;
+  }
+}
+
+
+/* TA_STORAGE_GAP_BUFFER */
+
+// The gap always starts at m_iGapIndex, its length is the free space of the buffer (getGapLength())
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::moveGapTo ( tc_index iIndex ) {
+  tc_index iGapLength = getGapLength();
+
+  if ( iIndex < m_iGapIndex ) {
+    shiftElements(iIndex, (iIndex + iGapLength), (m_iGapIndex - iIndex));
+
+  } else if ( iIndex > m_iGapIndex ) {
+    shiftElements((m_iGapIndex + iGapLength), m_iGapIndex, (iIndex - m_iGapIndex));
+  }
+
+  m_iGapIndex = iIndex;
+}
+
+
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::gapInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength ) {
+  tc_index iNumTailElements = 0;
+  tc_index iPreTailEndIndex = 0;
+  tc_index iGrowNumElements = 0;
+
+  /*
+    Grow the buffer when the gap is too small, the elements after the gap go to the new buffer end
+    The gap grows by at least half the number of elements, so the tail is moved amortized O(1) times per element
+  */
+
+  if ( iLength > getGapLength() ) {
+    iNumTailElements = getNumElements() - m_iGapIndex;
+    iPreTailEndIndex = getMaxNumElements() - getNullTermSize();
+    iGrowNumElements = std::max<tc_index>((iLength - getGapLength()),
+                                          std::min<tc_index>((getNumElements() / 2), (getMaxAllocNumElements() - getMaxNumElements())));
+
+    if ( ! resize(iGrowNumElements) )
+      goto ERREXIT;
+
+    shiftElements((iPreTailEndIndex - iNumTailElements), (getMaxNumElements() - getNullTermSize() - iNumTailElements), iNumTailElements);
+  }
+
+  moveGapTo(iIndex);
+
+  memcpy(((tDataType*) getArray() + m_iGapIndex), ptValue, (iLength * sizeof(tDataType)));
+  m_iGapIndex += iLength;
+  incrementLastElementIndexBy(iLength);
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::gapInsert(): Failed to insert in the gap buffer [ INDEX: %ld | LENGTH: %ld ]", iIndex, iLength);
+    return false;
+}
+
+
+// Removed elements just become part of the gap
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::gapRemove ( tc_index iIndex, tc_index iNumElements ) {
+  moveGapTo(iIndex);
+  decrementLastElementIndexBy(iNumElements);
+
+  return true;
+}
+
+
+/* TA_STORAGE_ROPE */
+
+// Split the main array buffer elements into chunks, the main array buffer is kept for ropeFlatten()
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::ropeBuild ( void ) {
+  stdTeracadaArrayRopeChunk* pstChunk = nullptr;
+  tc_index iChunkNumElements = getRopeChunkNumElements();
+  tc_index iNumChunks = std::max<tc_index>(((getNumElements() + iChunkNumElements - 1) / iChunkNumElements), 1);
+
+  m_iMaxRopeChunks = iNumChunks * 2;
+  m_iNumRopeChunks = 0;
+  m_iRopeCursorChunk = 0;
+  m_iRopeCursorIndex = 0;
+
+  m_pstRopeChunks = (stdTeracadaArrayRopeChunk*) calloc(m_iMaxRopeChunks, sizeof(stdTeracadaArrayRopeChunk));
+
+  if ( ! m_pstRopeChunks ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::ropeBuild(): Failed to allocate the rope chunk list");
+    throwException(ERR_TA_MEMALLOC_FAILED);
+    goto ERREXIT;
+  }
+
+  for ( tc_index iChunk = 0; iChunk < iNumChunks; iChunk++ ) {
+    pstChunk = ropeInsertChunk(iChunk);
+
+    if ( ! pstChunk )
+      goto ERREXIT;
+
+    pstChunk->iNumElements = std::min<tc_index>(iChunkNumElements, (getNumElements() - (iChunk * iChunkNumElements)));
+    memcpy(pstChunk->pvElements, ((tDataType*) getArray() + (iChunk * iChunkNumElements)), (pstChunk->iNumElements * sizeof(tDataType)));
+  }
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    ropeFree();
+    return false;
+}
+
+
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::ropeFlatten ( void ) {
+  tDataType* ptArray = nullptr;
+
+  if ( (getNumElements() + getNullTermSize()) > getMaxNumElements() ) {
+    if ( ! reallocArray(getNumElements() + getNullTermSize()) )
+      goto ERREXIT;
+  }
+
+  ptArray = (tDataType*) getArray();
+
+  for ( tc_index iChunk = 0; iChunk < m_iNumRopeChunks; iChunk++ ) {
+    memcpy(ptArray, m_pstRopeChunks[iChunk].pvElements, (m_pstRopeChunks[iChunk].iNumElements * sizeof(tDataType)));
+    ptArray += m_pstRopeChunks[iChunk].iNumElements;
+  }
+
+  ropeFree();
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::ropeFlatten(): Failed to flatten the rope chunks");
+    return false;
+}
+
+
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::ropeFree ( void ) {
+  if ( ! m_pstRopeChunks )
+    return;
+
+  for ( tc_index iChunk = 0; iChunk < m_iNumRopeChunks; iChunk++ )
+    free(m_pstRopeChunks[iChunk].pvElements);
+
+  free(m_pstRopeChunks);
+
+  m_pstRopeChunks = nullptr;
+  m_iNumRopeChunks = 0;
+  m_iMaxRopeChunks = 0;
+  m_iRopeCursorChunk = 0;
+  m_iRopeCursorIndex = 0;
+}
+
+
+/*!
+  @brief
+    Find the chunk holding the element at the index
+
+  @details
+    The search starts from the chunk located last time, so sequential access doesn't walk the chunk list.
+    The index after the last element is located in the last chunk.
+
+  @param[in]
+    iIndex The array index
+
+  @param[out]
+    piOffset The offset of the element within the chunk
+
+  @retval
+    Chunk The index of the chunk in the chunk list
+*/
+template <typename tDataType>
+tc_index TeracadaArray<tDataType>::ropeLocate ( tc_index iIndex, tc_index* piOffset ) {
+  tc_index iChunk = m_iRopeCursorChunk;
+  tc_index iChunkStartIndex = m_iRopeCursorIndex;
+
+  if ( iChunk >= m_iNumRopeChunks ) {
+    iChunk = 0;
+    iChunkStartIndex = 0;
+  }
+
+  while ( iIndex < iChunkStartIndex ) {
+    iChunk--;
+    iChunkStartIndex -= m_pstRopeChunks[iChunk].iNumElements;
+  }
+
+  while ( iChunk < (m_iNumRopeChunks - 1) && iIndex >= (iChunkStartIndex + m_pstRopeChunks[iChunk].iNumElements) ) {
+    iChunkStartIndex += m_pstRopeChunks[iChunk].iNumElements;
+    iChunk++;
+  }
+
+  m_iRopeCursorChunk = iChunk;
+  m_iRopeCursorIndex = iChunkStartIndex;
+
+  *piOffset = iIndex - iChunkStartIndex;
+  return iChunk;
+}
+
+
+// Insert a new empty chunk at the position in the chunk list, existing chunk pointers are invalidated
+template <typename tDataType>
+stdTeracadaArrayRopeChunk* TeracadaArray<tDataType>::ropeInsertChunk ( tc_index iChunk ) {
+  stdTeracadaArrayRopeChunk* pstReallocChunks = nullptr;
+  tc_void* pvElements = nullptr;
+
+  if ( m_iNumRopeChunks == m_iMaxRopeChunks ) {
+    pstReallocChunks = (stdTeracadaArrayRopeChunk*) realloc(m_pstRopeChunks, (2 * m_iMaxRopeChunks * sizeof(stdTeracadaArrayRopeChunk)));
+
+    if ( ! pstReallocChunks )
+      goto ERREXIT;
+
+    m_pstRopeChunks = pstReallocChunks;
+    m_iMaxRopeChunks *= 2;
+  }
+
+  pvElements = malloc(getRopeChunkNumElements() * sizeof(tDataType));
+
+  if ( ! pvElements )
+    goto ERREXIT;
+
+  memmove((m_pstRopeChunks + iChunk + 1), (m_pstRopeChunks + iChunk), ((m_iNumRopeChunks - iChunk) * sizeof(stdTeracadaArrayRopeChunk)));
+
+  m_pstRopeChunks[iChunk].pvElements = pvElements;
+  m_pstRopeChunks[iChunk].iNumElements = 0;
+  m_iNumRopeChunks++;
+
+  EXIT:
+    return &m_pstRopeChunks[iChunk];
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::ropeInsertChunk(): Failed to allocate a new rope chunk");
+    throwException(ERR_TA_MEMALLOC_FAILED);
+    return nullptr;
+}
+
+
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::ropeDeleteChunk ( tc_index iChunk ) {
+  free(m_pstRopeChunks[iChunk].pvElements);
+
+  memmove((m_pstRopeChunks + iChunk), (m_pstRopeChunks + iChunk + 1), ((m_iNumRopeChunks - iChunk - 1) * sizeof(stdTeracadaArrayRopeChunk)));
+  m_iNumRopeChunks--;
+}
+
+
+/*!
+  @brief
+    Insert values in the rope
+
+  @details
+    - If the chunk at the insert index has enough free space, the values are inserted within the chunk.
+    - Otherwise the chunk is split at the insert index, the values fill the free space of the left part
+      and the remaining values go to new chunks in between.
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::ropeInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength ) {
+  stdTeracadaArrayRopeChunk* pstChunk = nullptr;
+  stdTeracadaArrayRopeChunk* pstNewChunk = nullptr;
+  tc_index iChunkNumElements = getRopeChunkNumElements();
+  tc_index iChunk = 0, iOffset = 0, iNumCopied = 0;
+
+  if ( ! m_pstRopeChunks && ! ropeBuild() )
+    goto ERREXIT;
+
+  iChunk = ropeLocate(iIndex, &iOffset);
+  pstChunk = &m_pstRopeChunks[iChunk];
+
+  /* Enough free space in the chunk */
+
+  if ( (pstChunk->iNumElements + iLength) <= iChunkNumElements ) {
+    memmove(((tDataType*) pstChunk->pvElements + iOffset + iLength), ((tDataType*) pstChunk->pvElements + iOffset), ((pstChunk->iNumElements - iOffset) * sizeof(tDataType)));
+    memcpy(((tDataType*) pstChunk->pvElements + iOffset), ptValue, (iLength * sizeof(tDataType)));
+    pstChunk->iNumElements += iLength;
+    goto EXIT;
+  }
+
+  /* Split the chunk at the insert offset, the right part goes to a new chunk */
+
+  if ( iOffset < pstChunk->iNumElements ) {
+    pstNewChunk = ropeInsertChunk(iChunk + 1);
+
+    if ( ! pstNewChunk )
+      goto ERREXIT;
+
+    // Chunk list may have been reallocated
+    pstChunk = &m_pstRopeChunks[iChunk];
+
+    pstNewChunk->iNumElements = pstChunk->iNumElements - iOffset;
+    memcpy(pstNewChunk->pvElements, ((tDataType*) pstChunk->pvElements + iOffset), (pstNewChunk->iNumElements * sizeof(tDataType)));
+    pstChunk->iNumElements = iOffset;
+  }
+
+  /* Fill the free space of the chunk first, then new chunks after it */
+
+  iNumCopied = std::min<tc_index>(iLength, (iChunkNumElements - pstChunk->iNumElements));
+  memcpy(((tDataType*) pstChunk->pvElements + pstChunk->iNumElements), ptValue, (iNumCopied * sizeof(tDataType)));
+  pstChunk->iNumElements += iNumCopied;
+
+  while ( iNumCopied < iLength ) {
+    pstNewChunk = ropeInsertChunk(++iChunk);
+
+    if ( ! pstNewChunk ) {
+      incrementLastElementIndexBy(iNumCopied);
+      goto ERREXIT;
+    }
+
+    pstNewChunk->iNumElements = std::min<tc_index>((iLength - iNumCopied), iChunkNumElements);
+    memcpy(pstNewChunk->pvElements, (ptValue + iNumCopied), (pstNewChunk->iNumElements * sizeof(tDataType)));
+    iNumCopied += pstNewChunk->iNumElements;
+  }
+
+  EXIT:
+    incrementLastElementIndexBy(iLength);
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::ropeInsert(): Failed to insert in the rope [ INDEX: %ld | LENGTH: %ld ]", iIndex, iLength);
+    return false;
+}
+
+
+/*!
+  @brief
+    Remove elements from the rope
+
+  @details
+    Empty chunks are deleted, and the chunk at the remove index is merged with the next one
+    if both together fill less than half a chunk, so the rope doesn't fragment into tiny chunks.
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::ropeRemove ( tc_index iIndex, tc_index iNumElements ) {
+  stdTeracadaArrayRopeChunk* pstChunk = nullptr;
+  tc_index iChunkNumElements = getRopeChunkNumElements();
+  tc_index iChunk = 0, iFirstChunk = 0, iOffset = 0, iNumRemaining = iNumElements, iNumRemoved = 0;
+
+  if ( ! m_pstRopeChunks && ! ropeBuild() )
+    goto ERREXIT;
+
+  iFirstChunk = iChunk = ropeLocate(iIndex, &iOffset);
+
+  while ( iNumRemaining > 0 ) {
+    pstChunk = &m_pstRopeChunks[iChunk];
+    iNumRemoved = std::min<tc_index>(iNumRemaining, (pstChunk->iNumElements - iOffset));
+
+    memmove(((tDataType*) pstChunk->pvElements + iOffset), ((tDataType*) pstChunk->pvElements + iOffset + iNumRemoved),
+              ((pstChunk->iNumElements - iOffset - iNumRemoved) * sizeof(tDataType)));
+
+    pstChunk->iNumElements -= iNumRemoved;
+    iNumRemaining -= iNumRemoved;
+    iOffset = 0;
+
+    if ( pstChunk->iNumElements == 0 && m_iNumRopeChunks > 1 ) {
+      ropeDeleteChunk(iChunk);
+    } else {
+      iChunk++;
+    }
+  }
+
+  /* Merge the chunk with the next one if they are both almost empty */
+
+  if ( (iFirstChunk + 1) < m_iNumRopeChunks &&
+       (m_pstRopeChunks[iFirstChunk].iNumElements + m_pstRopeChunks[iFirstChunk + 1].iNumElements) <= (iChunkNumElements / 2) ) {
+
+    pstChunk = &m_pstRopeChunks[iFirstChunk];
+
+    memcpy(((tDataType*) pstChunk->pvElements + pstChunk->iNumElements), m_pstRopeChunks[iFirstChunk + 1].pvElements,
+            (m_pstRopeChunks[iFirstChunk + 1].iNumElements * sizeof(tDataType)));
+
+    pstChunk->iNumElements += m_pstRopeChunks[iFirstChunk + 1].iNumElements;
+    ropeDeleteChunk(iFirstChunk + 1);
+  }
+
+  EXIT:
+    decrementLastElementIndexBy(iNumElements);
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::ropeRemove(): Failed to remove from the rope [ INDEX: %ld | NUM_ELEMENTS: %ld ]", iIndex, iNumElements);
+    return false;
+}
+
+
+/* TA_STORAGE_DEQUE */
+
+/*!
+  @brief
+    Make space for an insert on the shorter side of the array
+
+  @details
+    Called when there isn't enough free space on the side the elements are moved towards.
+    The buffer is grown so the free space is at least half the number of elements (plus TA_DEQUE_MIN_FREE_NUM_ELEMENTS),
+    then the elements are moved so the free space is split evenly on both sides after the insert.
+    Each recenter is followed by O(n) inserts/removes at either end before the next one, so they stay O(1) amortized.
+
+  @param[in]
+    iInsertIndex The index the values will be inserted at
+
+  @param[in]
+    iLength The number of values to be inserted
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::dequeRecenter ( tc_index iInsertIndex, tc_index iLength ) {
+  tc_index iMinFreeNumElements = iLength + (getNumElements() / 2) + TA_DEQUE_MIN_FREE_NUM_ELEMENTS;
+  tc_index iFreeNumElements = getMaxNumElements() - getNullTermSize() - getNumElements();
+  tc_index iNewHeadIndex = 0;
+
+  if ( iFreeNumElements < iMinFreeNumElements ) {
+    if ( ! resize(iMinFreeNumElements - iFreeNumElements) )
+      goto ERREXIT;
+
+    iFreeNumElements = getMaxNumElements() - getNullTermSize() - getNumElements();
+  }
+
+  // The inserted values take their space from the side the elements are moved towards
+  iNewHeadIndex = (iFreeNumElements - iLength) / 2;
+
+  if ( iInsertIndex < (getNumElements() - iInsertIndex) )
+    iNewHeadIndex += iLength;
+
+  shiftElements(m_iHeadIndex, iNewHeadIndex, getNumElements());
+  m_iHeadIndex = iNewHeadIndex;
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::dequeRecenter(): Failed to make space for the insert [ INDEX: %ld | LENGTH: %ld ]", iInsertIndex, iLength);
+    return false;
+}
+
+
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::dequeInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength ) {
+  tc_bool bMoveFront = (iIndex < (getNumElements() - iIndex));
+  tc_index iTailFreeNumElements = getMaxNumElements() - getNullTermSize() - m_iHeadIndex - getNumElements();
+
+  if ( (bMoveFront && m_iHeadIndex < iLength) || (! bMoveFront && iTailFreeNumElements < iLength) ) {
+    if ( ! dequeRecenter(iIndex, iLength) )
+      goto ERREXIT;
+  }
+
+  if ( bMoveFront ) {
+    shiftElements(m_iHeadIndex, (m_iHeadIndex - iLength), iIndex);
+    m_iHeadIndex -= iLength;
+  } else {
+    shiftElements((m_iHeadIndex + iIndex), (m_iHeadIndex + iIndex + iLength), (getNumElements() - iIndex));
+  }
+
+  memcpy(((tDataType*) getArray() + m_iHeadIndex + iIndex), ptValue, (iLength * sizeof(tDataType)));
+  incrementLastElementIndexBy(iLength);
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaArray::dequeInsert(): Failed to insert in the deque [ INDEX: %ld | LENGTH: %ld ]", iIndex, iLength);
+    return false;
+}
+
+
+// Removing from the front only moves the head, no elements are shifted
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::dequeRemove ( tc_index iIndex, tc_index iNumElements ) {
+  tc_index iNumTailElements = getNumElements() - iIndex - iNumElements;
+
+  if ( iIndex < iNumTailElements ) {
+    shiftElements(m_iHeadIndex, (m_iHeadIndex + iNumElements), iIndex);
+    m_iHeadIndex += iNumElements;
+  } else {
+    shiftElements((m_iHeadIndex + iIndex + iNumElements), (m_iHeadIndex + iIndex), iNumTailElements);
+  }
+
+  decrementLastElementIndexBy(iNumElements);
+
+  // Empty deque starts over at the start of the buffer
+  if ( getNumElements() == 0 )
+    m_iHeadIndex = 0;
+
+  return true;
+}
+
+
+/* TA_STORAGE_RING */
+
+/*!
+  @brief
+    Insert values after the last element of the ring
+
+  @details
+    When the ring is full, every inserted value overwrites the oldest element (the window slides by one).
+    Inserting at any other index is not allowed, as the ring holds the most recent values in insertion order.
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::ringInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength ) {
+
+  if ( iIndex != getNumElements() || getRingCapacity() <= 0 ) {
+    TC_LOG(LOG_ERR, "TeracadaArray::ringInsert(): Only inserts after the last element are allowed for the ring [ INDEX: %ld | NUM_ELEMENTS: %ld ]", iIndex, getNumElements());
+    throwException(ERR_TA_INVALID_POSITION_OR_INDEX);
+    goto ERREXIT;
+  }
+
+  // Capacity changed by reserve()/shrinkToFit()
+  if ( m_iRingAggCapacity != getRingCapacity() && ! ringRebuildAggregates() )
+    goto ERREXIT;
+
+  for ( tc_index iIter = 0; iIter < iLength; iIter++ ) {
+    if ( getNumElements() == getRingCapacity() )
+      ringEvictFront(1);
+
+    *ringElement(getNumElements()) = ptValue[iIter];
+    incrementLastElementIndexBy(1);
+
+    ringPushAggregates(m_ui64RingPushSeq++);
+  }
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+/*!
+  @brief
+    Remove elements from the ring
+
+  @details
+    Removing from the front (oldest elements) is O(1) per element. Removing from any other index rotates
+    the ring to the start of the main array buffer, shifts the elements and rebuilds the window aggregates.
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::ringRemove ( tc_index iIndex, tc_index iNumElements ) {
+
+  if ( iIndex == 0 ) {
+    ringEvictFront(iNumElements);
+    goto EXIT;
+  }
+
+  if ( ! compact() )
+    goto ERREXIT;
+
+  shiftElements((iIndex + iNumElements), iIndex, (getNumElements() - iIndex - iNumElements));
+  decrementLastElementIndexBy(iNumElements);
+  m_ui64RingPushSeq -= iNumElements;
+
+  if ( ! ringRebuildAggregates() )
+    goto ERREXIT;
+
+  EXIT:
+    if ( getNumElements() == 0 )
+      m_iHeadIndex = 0;
+
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::ringEvictFront ( tc_index iNumElements ) {
+  tc_uint64 ui64FirstSeq = 0;
+
+  for ( tc_index iIter = 0; iIter < iNumElements; iIter++ ) {
+    if constexpr ( std::is_arithmetic_v<tDataType> ) {
+      m_ldRingWindowSum -= *ringElement(0);
+    }
+
+    m_iHeadIndex = (m_iHeadIndex + 1) % getRingCapacity();
+    decrementLastElementIndexBy(1);
+  }
+
+  if constexpr ( std::is_arithmetic_v<tDataType> ) {
+    ui64FirstSeq = m_ui64RingPushSeq - getNumElements();
+
+    for ( stdTeracadaArrayMonoDeque* pstDeque : { &m_stRingMinDeque, &m_stRingMaxDeque } ) {
+      while ( pstDeque->iNumSeqs && pstDeque->pui64Seqs[pstDeque->iFront] < ui64FirstSeq ) {
+        pstDeque->iFront = (pstDeque->iFront + 1) % m_iRingAggCapacity;
+        pstDeque->iNumSeqs--;
+      }
+    }
+  }
+}
+
+
+// Add the element with the sequence number to the sum and the min/max deques (the element has to be in the ring already)
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::ringPushAggregates ( tc_uint64 ui64Seq ) {
+  tDataType tValue {};
+  stdTeracadaArrayMonoDeque* pstDeque = nullptr;
+
+  if constexpr ( std::is_arithmetic_v<tDataType> ) {
+    tValue = *ringSeqElement(ui64Seq);
+    m_ldRingWindowSum += tValue;
+
+    // Elements that can never be the window min/max again are dropped from the back
+    pstDeque = &m_stRingMinDeque;
+
+    while ( pstDeque->iNumSeqs && *ringSeqElement(pstDeque->pui64Seqs[(pstDeque->iFront + pstDeque->iNumSeqs - 1) % m_iRingAggCapacity]) >= tValue )
+      pstDeque->iNumSeqs--;
+
+    pstDeque->pui64Seqs[(pstDeque->iFront + pstDeque->iNumSeqs++) % m_iRingAggCapacity] = ui64Seq;
+
+    pstDeque = &m_stRingMaxDeque;
+
+    while ( pstDeque->iNumSeqs && *ringSeqElement(pstDeque->pui64Seqs[(pstDeque->iFront + pstDeque->iNumSeqs - 1) % m_iRingAggCapacity]) <= tValue )
+      pstDeque->iNumSeqs--;
+
+    pstDeque->pui64Seqs[(pstDeque->iFront + pstDeque->iNumSeqs++) % m_iRingAggCapacity] = ui64Seq;
+  }
+}
+
+
+// Recompute the window aggregates from the elements in the ring, O(n)
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::ringRebuildAggregates ( void ) {
+  tc_uint64* pui64Seqs = nullptr;
+
+  m_ldRingWindowSum = 0;
+
+  if constexpr ( std::is_arithmetic_v<tDataType> ) {
+    if ( m_iRingAggCapacity != getRingCapacity() ) {
+      for ( stdTeracadaArrayMonoDeque* pstDeque : { &m_stRingMinDeque, &m_stRingMaxDeque } ) {
+        pui64Seqs = (tc_uint64*) realloc(pstDeque->pui64Seqs, (getRingCapacity() * sizeof(tc_uint64)));
+
+        if ( ! pui64Seqs ) {
+          TC_LOG(LOG_ERR, "TeracadaArray::ringRebuildAggregates(): Failed to allocate the window min/max deque");
+          throwException(ERR_TA_MEMALLOC_FAILED);
+          return false;
+        }
+
+        pstDeque->pui64Seqs = pui64Seqs;
+      }
+
+      m_iRingAggCapacity = getRingCapacity();
+    }
+
+    m_stRingMinDeque.iFront = m_stRingMinDeque.iNumSeqs = 0;
+    m_stRingMaxDeque.iFront = m_stRingMaxDeque.iNumSeqs = 0;
+
+    for ( tc_index iIter = 0; iIter < getNumElements(); iIter++ )
+      ringPushAggregates(m_ui64RingPushSeq - getNumElements() + iIter);
+
+  } else {
+    m_iRingAggCapacity = getRingCapacity();
+  }
+
+  return true;
+}
+
+
+template <typename tDataType>
+tc_void TeracadaArray<tDataType>::ringFreeAggregates ( void ) {
+  free(m_stRingMinDeque.pui64Seqs);
+  free(m_stRingMaxDeque.pui64Seqs);
+
+  m_stRingMinDeque = m_stRingMaxDeque = { nullptr, 0, 0 };
+  m_iRingAggCapacity = 0;
+  m_ldRingWindowSum = 0;
+}
+
+
+/*!
+  @brief
+    Sum of the elements in the ring window
+
+  @details
+    The window aggregates are updated incrementally by every insert/remove, the getters are O(1).
+
+  @retval
+    Sum The sum of the elements, 0 if the storage mode is not TA_STORAGE_RING (or the data type is not a number)
+*/
+template <typename tDataType>
+tc_decimal TeracadaArray<tDataType>::getWindowSum ( void ) const {
+  if ( getStorageMode() != TA_STORAGE_RING )
+    return 0;
+
+  return (tc_decimal) m_ldRingWindowSum;
+}
+
+
+template <typename tDataType>
+tc_decimal TeracadaArray<tDataType>::getWindowMean ( void ) const {
+  if ( getStorageMode() != TA_STORAGE_RING || getNumElements() == 0 )
+    return 0;
+
+  return (tc_decimal) (m_ldRingWindowSum / getNumElements());
+}
+
+
+template <typename tDataType>
+tDataType TeracadaArray<tDataType>::getWindowMin ( void ) const {
+  if constexpr ( std::is_arithmetic_v<tDataType> ) {
+    if ( getStorageMode() == TA_STORAGE_RING && m_stRingMinDeque.iNumSeqs )
+      return *ringSeqElement(m_stRingMinDeque.pui64Seqs[m_stRingMinDeque.iFront]);
+  }
+
+  return tDataType {};
+}
+
+
+template <typename tDataType>
+tDataType TeracadaArray<tDataType>::getWindowMax ( void ) const {
+  if constexpr ( std::is_arithmetic_v<tDataType> ) {
+    if ( getStorageMode() == TA_STORAGE_RING && m_stRingMaxDeque.iNumSeqs )
+      return *ringSeqElement(m_stRingMaxDeque.pui64Seqs[m_stRingMaxDeque.iFront]);
+  }
+
+  return tDataType {};
+}
@@ -1,4 +1,16 @@
 #include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 
 #include "teracada.h"
 
@@ -240,15 +252,1844 @@ void UnitTestsTeracadaArrayTypeString ( void ) {
 }
 
 
+void UnitTestsTeracadaArrayResizeGrowth ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [RESIZE_ALGO_GROWTH]: ";
+
+  TeracadaArray<tc_int> objTeracadaArrayInt(5);
+  objTeracadaArrayInt.disableExceptions();
+  objTeracadaArrayInt.setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
+
+  for ( tc_int iIter = 1; iIter <= 10000; iIter++ )
+    objTeracadaArrayInt.insertBack(iIter);
+
+  // 5 * 2^11 > 10000, so geometric growth needs no more than 11 reallocations
+  assert(objTeracadaArrayInt.getNumElements() == 10000);
+  assert(objTeracadaArrayInt.getTotalReallocAttempts() <= 11);
+  assert(*(tc_int*) objTeracadaArrayInt.get(1) == 1);
+  assert(*(tc_int*) objTeracadaArrayInt.get(-1) == 10000);
+
+  objTeracadaArrayInt.shrinkToFit();
+  assert(objTeracadaArrayInt.getMaxNumElements() == 10000);
+  assert(*(tc_int*) objTeracadaArrayInt.get(-1) == 10000);
+
+  // Growth cap limits the number of elements added per resize
+  objTeracadaArrayInt.setResizeAlgo(TA_RESIZE_ALGO_GROWTH_CUSTOM);
+  objTeracadaArrayInt.setResizeGrowthFactor(3.0);
+  objTeracadaArrayInt.setResizeGrowthCap(100);
+  objTeracadaArrayInt.insertBack(10001);
+  assert(objTeracadaArrayInt.getMaxNumElements() == 10100);
+
+  // Reserve never shrinks and doesn't reallocate when there is enough space
+  tc_uint64 ui64ReallocAttempts = objTeracadaArrayInt.getTotalReallocAttempts();
+  objTeracadaArrayInt.reserve(50);
+  assert(objTeracadaArrayInt.getTotalReallocAttempts() == ui64ReallocAttempts);
+
+  objTeracadaArrayInt.reserve(20000);
+  assert(objTeracadaArrayInt.getMaxNumElements() == 20000);
+  assert(objTeracadaArrayInt.getNumElements() == 10001);
+
+  tc_char acDigits[] = "0123456789";
+  TeracadaArray<tc_char> objTeracadaArrayChar(2);
+  objTeracadaArrayChar.disableExceptions();
+  objTeracadaArrayChar.reserve(10);
+  objTeracadaArrayChar.insertBack(acDigits);
+  assert(objTeracadaArrayChar.getMaxNumElements() == 11);
+  assert(strcmp((char *) objTeracadaArrayChar.get(), "0123456789") == 0);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayMetrics ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [METRICS]: ";
+
+  stdTeracadaArrayMetrics stPreGlobalMetrics = TeracadaMetrics::getArrayMetrics();
+
+  {
+    TeracadaArray<tc_int> objTeracadaArrayInt(10);
+    objTeracadaArrayInt.disableExceptions();
+    objTeracadaArrayInt.setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
+
+    for ( tc_int iIter = 1; iIter <= 100; iIter++ )
+      objTeracadaArrayInt.insertBack(iIter);
+
+    // 10 -> 20 -> 40 -> 80 -> 160
+    stdTeracadaArrayMetrics stMetrics = objTeracadaArrayInt.getMetrics();
+    assert(stMetrics.ui64ReallocAttempts == 4);
+    assert(stMetrics.ui64CapacityBytes == 160 * sizeof(tc_int));
+    assert(stMetrics.ui64PeakCapacityBytes == 160 * sizeof(tc_int));
+
+    objTeracadaArrayInt.shrinkToFit();
+    stMetrics = objTeracadaArrayInt.getMetrics();
+    assert(stMetrics.ui64CapacityBytes == 100 * sizeof(tc_int));
+    assert(stMetrics.ui64PeakCapacityBytes == 160 * sizeof(tc_int));
+
+    stdTeracadaArrayMetrics stGlobalMetrics = TeracadaMetrics::getArrayMetrics();
+    assert(stGlobalMetrics.ui64ReallocAttempts - stPreGlobalMetrics.ui64ReallocAttempts == 5);
+    assert(stGlobalMetrics.ui64CapacityBytes - stPreGlobalMetrics.ui64CapacityBytes == 100 * sizeof(tc_int));
+  }
+
+  // Buffer capacity is released with the array
+  assert(TeracadaMetrics::getArrayMetrics().ui64CapacityBytes == stPreGlobalMetrics.ui64CapacityBytes);
+
+  // Failed reallocations are counted as attempts too
+  {
+    class TeracadaFailingAllocator : public TeracadaAllocator {
+      public:
+        tc_void* allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill = true ) override {
+          return TeracadaAllocator::getDefault()->allocate(ui64Bytes, bZeroFill);
+        }
+
+        tc_void* reallocate ( tc_void*, tc_uint64, tc_uint64 ) override {
+          return nullptr;
+        }
+
+        tc_void deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) override {
+          TeracadaAllocator::getDefault()->deallocate(pvBuffer, ui64Bytes);
+        }
+    };
+
+    TeracadaFailingAllocator objFailingAllocator;
+    stdTeracadaArrayMetrics stPreFailMetrics = TeracadaMetrics::getArrayMetrics();
+
+    tca_int objTeracadaArrayInt(10, true, &objFailingAllocator);
+    objTeracadaArrayInt.disableExceptions();
+
+    tc_bool bReserved = objTeracadaArrayInt.reserve(1000);
+    assert(! bReserved);
+    assert(objTeracadaArrayInt.getMaxNumElements() == 10);
+    assert(objTeracadaArrayInt.getTotalReallocAttempts() == 1);
+    assert(objTeracadaArrayInt.getMetrics().ui64ReallocAttempts == 1);
+    assert(TeracadaMetrics::getArrayMetrics().ui64ReallocAttempts - stPreFailMetrics.ui64ReallocAttempts == 1);
+  }
+
+  // Exporter writes the final values when stopped
+  const tc_char* pcMetricsFilePath = "/tmp/teracada_metrics_unit_tests";
+  tc_char acLine[100] = {0};
+
+  tc_bool bStarted = TeracadaMetrics::startExporter(pcMetricsFilePath, 10);
+  assert(bStarted);
+  bStarted = TeracadaMetrics::startExporter(pcMetricsFilePath, 10);
+  assert(! bStarted);
+  TeracadaMetrics::stopExporter();
+  assert(! TeracadaMetrics::isExporterRunning());
+
+  FILE* pFile = fopen(pcMetricsFilePath, "r");
+  assert(pFile);
+  tc_char* pcLine = fgets(acLine, sizeof(acLine), pFile);
+  assert(pcLine);
+  assert(strncmp(acLine, "realloc_attempts ", 17) == 0);
+  fclose(pFile);
+
+  // Exporter started and stopped from racing threads, a start never replaces the thread a stop is joining
+  {
+    std::vector<std::thread> vecThreads;
+
+    for ( tc_int iThread = 0; iThread < 4; iThread++ ) {
+      vecThreads.emplace_back([pcMetricsFilePath] ( void ) {
+        for ( tc_int iIter = 0; iIter < 50; iIter++ ) {
+          TeracadaMetrics::startExporter(pcMetricsFilePath, 1);
+          TeracadaMetrics::stopExporter();
+        }
+      });
+    }
+
+    for ( std::thread& objThread : vecThreads )
+      objThread.join();
+
+    assert(! TeracadaMetrics::isExporterRunning());
+  }
+
+  // Exporter still running at process exit is stopped and joined, instead of terminating the process
+  {
+    pid_t iPid = fork();
+    assert(iPid >= 0);
+
+    if ( iPid == 0 ) {
+      TeracadaMetrics::startExporter(pcMetricsFilePath, 1000);
+      exit(0);
+    }
+
+    int iStatus = 0;
+    waitpid(iPid, &iStatus, 0);
+    assert(WIFEXITED(iStatus) && WEXITSTATUS(iStatus) == 0);
+  }
+
+  remove(pcMetricsFilePath);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayShift ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [SHIFT]: ";
+
+  TeracadaArray<tc_int> objTeracadaArrayInt(1000);
+  objTeracadaArrayInt.disableExceptions();
+
+  for ( tc_int iIter = 1; iIter <= 1000; iIter++ )
+    objTeracadaArrayInt.insertBack(iIter);
+
+  tc_int aiArray[10] = { -1, -2, -3, -4, -5, -6, -7, -8, -9, -10 };
+  objTeracadaArrayInt.insert(501, aiArray, 10);
+  objTeracadaArrayInt.insertFront((tc_int) 0);
+  objTeracadaArrayInt.insert(-1, -11);
+
+  // 0, 1 .. 500, -1 .. -10, 501 .. 999, -11, 1000
+  assert(objTeracadaArrayInt.getNumElements() == 1012);
+  assert(*(tc_int*) objTeracadaArrayInt.get(1) == 0);
+  assert(*(tc_int*) objTeracadaArrayInt.get(501) == 500);
+  assert(*(tc_int*) objTeracadaArrayInt.get(502) == -1);
+  assert(*(tc_int*) objTeracadaArrayInt.get(511) == -10);
+  assert(*(tc_int*) objTeracadaArrayInt.get(512) == 501);
+  assert(*(tc_int*) objTeracadaArrayInt.get(-2) == -11);
+  assert(*(tc_int*) objTeracadaArrayInt.get(-1) == 1000);
+
+  objTeracadaArrayInt.remove(502, 10);
+  objTeracadaArrayInt.remove(1, 1);
+  objTeracadaArrayInt.remove(-2, 1);
+
+  assert(objTeracadaArrayInt.getNumElements() == 1000);
+
+  for ( tc_int iIter = 1; iIter <= 1000; iIter++ )
+    assert(*(tc_int*) objTeracadaArrayInt.get(iIter) == iIter);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayStorageModes ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [STORAGE_MODES]: ";
+
+  tc_byte ab8StorageModes[4] = { TA_STORAGE_CONTIGUOUS, TA_STORAGE_GAP_BUFFER, TA_STORAGE_ROPE, TA_STORAGE_DEQUE };
+  tc_char acWord[] = "teracada ";
+
+  for ( tc_byte b8StorageMode : ab8StorageModes ) {
+    TeracadaArray<tc_char> objTeracadaArrayChar(16);
+    objTeracadaArrayChar.disableExceptions();
+    tc_bool bSet = objTeracadaArrayChar.setStorageMode(b8StorageMode);
+    assert(bSet);
+
+    string strReference;
+    srand(1);
+
+    // Random edits, large enough for the rope to have several chunks
+    for ( tc_int iIter = 0; iIter < 20000; iIter++ ) {
+      tc_int iIndex = rand() % (strReference.size() + 1);
+
+      switch ( rand() % 4 ) {
+        case 0:
+        case 1:
+          objTeracadaArrayChar.insert((iIndex + 1), (tc_char) ('a' + (iIter % 26)));
+          strReference.insert(iIndex, 1, (tc_char) ('a' + (iIter % 26)));
+          break;
+
+        case 2:
+          objTeracadaArrayChar.insert((iIndex + 1), acWord, 9);
+          strReference.insert(iIndex, acWord);
+          break;
+
+        case 3:
+          if ( iIndex < (tc_int) strReference.size() ) {
+            tc_int iNumElements = std::min<tc_int>(((rand() % 12) + 1), (strReference.size() - iIndex));
+            objTeracadaArrayChar.remove((iIndex + 1), iNumElements);
+            strReference.erase(iIndex, iNumElements);
+          }
+          break;
+      }
+
+      assert(objTeracadaArrayChar.getNumElements() == (tc_int) strReference.size());
+
+      if ( strReference.size() && ! (iIter % 97) ) {
+        assert(*(tc_char*) objTeracadaArrayChar.get(1) == strReference.front());
+        assert(*(tc_char*) objTeracadaArrayChar.get(-1) == strReference.back());
+        assert(*(tc_char*) objTeracadaArrayChar.get(iIndex / 2 + 1) == strReference[iIndex / 2]);
+      }
+    }
+
+    tc_bool bCompacted = objTeracadaArrayChar.compact();
+    assert(bCompacted);
+    assert(objTeracadaArrayChar.isContiguous());
+    assert(! strcmp((tc_str) objTeracadaArrayChar.getArray(), strReference.c_str()));
+
+    // Edits continue in the same storage mode after compact()
+    objTeracadaArrayChar.insertFront((tc_char) '>');
+    strReference.insert(0, 1, '>');
+    assert(objTeracadaArrayChar.getStorageMode() == b8StorageMode);
+    bCompacted = objTeracadaArrayChar.compact();
+    assert(bCompacted);
+    assert(! strcmp((tc_str) objTeracadaArrayChar.getArray(), strReference.c_str()));
+  }
+
+  /* Typing in the middle of a gap buffer, the gap grows geometrically so the reallocations stay logarithmic */
+
+  {
+    TeracadaArray<tc_char> objTeracadaArrayChar(16);
+    objTeracadaArrayChar.disableExceptions();
+    objTeracadaArrayChar.setStorageMode(TA_STORAGE_GAP_BUFFER);
+    objTeracadaArrayChar.insertBack(acWord, 9);
+
+    for ( tc_int iIter = 0; iIter < 100000; iIter++ )
+      objTeracadaArrayChar.insert(5 + iIter, (tc_char) ('a' + (iIter % 26)));
+
+    assert(objTeracadaArrayChar.getNumElements() == 100009);
+    assert(objTeracadaArrayChar.getTotalReallocAttempts() < 64);
+    assert(*(tc_char*) objTeracadaArrayChar.get(5) == 'a' && *(tc_char*) objTeracadaArrayChar.get(-6) == 'a' + (99999 % 26));
+    assert(*(tc_char*) objTeracadaArrayChar.get(-5) == 'c' && *(tc_char*) objTeracadaArrayChar.get(4) == 'a');
+  }
+
+  /* Removing from the tail leaves the gap at the end, the array stays contiguous and null terminated */
+
+  {
+    tc_char acText[] = "abc";
+    TeracadaArray<tc_char> objTeracadaArrayChar(8);
+    objTeracadaArrayChar.disableExceptions();
+    objTeracadaArrayChar.setStorageMode(TA_STORAGE_GAP_BUFFER);
+    objTeracadaArrayChar.insertBack(acText, 3);
+
+    tc_bool bRemoved = objTeracadaArrayChar.remove(3, 1);
+    assert(bRemoved);
+    assert(objTeracadaArrayChar.getNumElements() == 2);
+    assert(objTeracadaArrayChar.isContiguous());
+    assert(! strcmp((tc_str) objTeracadaArrayChar.getArray(), "ab"));
+
+    tc_bool bCompacted = objTeracadaArrayChar.compact();
+    assert(bCompacted);
+    assert(! strcmp((tc_str) objTeracadaArrayChar.getArray(), "ab"));
+  }
+
+  /* Overwrite and insert after the last element (zero elements in between) */
+
+  TeracadaArray<tc_int> objTeracadaArrayInt(4);
+  objTeracadaArrayInt.disableExceptions();
+  objTeracadaArrayInt.setStorageMode(TA_STORAGE_GAP_BUFFER);
+
+  for ( tc_int iIter = 1; iIter <= 4; iIter++ )
+    objTeracadaArrayInt.insertBack(iIter);
+
+  objTeracadaArrayInt.enableOverwrite();
+  tc_int aiArray[3] = { 20, 30, 50 };
+  objTeracadaArrayInt.insert(2, aiArray, 3);
+  objTeracadaArrayInt.disableOverwrite();
+  objTeracadaArrayInt.insert(7, 7);
+
+  // 1, 20, 30, 50, 0, 0, 7
+  assert(objTeracadaArrayInt.getNumElements() == 7);
+  assert(*(tc_int*) objTeracadaArrayInt.get(2) == 20);
+  assert(*(tc_int*) objTeracadaArrayInt.get(4) == 50);
+  assert(*(tc_int*) objTeracadaArrayInt.get(5) == 0);
+  assert(*(tc_int*) objTeracadaArrayInt.get(-1) == 7);
+
+  tc_bool bSet = objTeracadaArrayInt.setStorageMode(TA_STORAGE_CONTIGUOUS);
+  assert(bSet);
+  assert(((tc_int*) objTeracadaArrayInt.getArray())[3] == 50);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayDeque ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [DEQUE]: ";
+
+  TeracadaArray<tc_int> objTeracadaArrayInt(10);
+  objTeracadaArrayInt.disableExceptions();
+  tc_bool bSet = objTeracadaArrayInt.setStorageMode(TA_STORAGE_DEQUE);
+  assert(bSet);
+
+  // -100000 .. -1, 0 .. 99999
+  for ( tc_int iIter = 0; iIter < 100000; iIter++ ) {
+    objTeracadaArrayInt.insertBack(iIter);
+    objTeracadaArrayInt.insertFront(-(iIter + 1));
+  }
+
+  assert(objTeracadaArrayInt.getNumElements() == 200000);
+  assert(*(tc_int*) objTeracadaArrayInt.get(1) == -100000);
+  assert(*(tc_int*) objTeracadaArrayInt.get(100001) == 0);
+  assert(*(tc_int*) objTeracadaArrayInt.get(-1) == 99999);
+
+  // Recentering keeps free space proportional to the number of elements, so reallocations stay logarithmic
+  assert(objTeracadaArrayInt.getTotalReallocAttempts() < 100);
+
+  /* FIFO queue, remove from the front only moves the head */
+
+  for ( tc_int iIter = 0; iIter < 200000; iIter++ ) {
+    assert(*(tc_int*) objTeracadaArrayInt.get(1) == (iIter - 100000));
+    objTeracadaArrayInt.remove(1, 1);
+    objTeracadaArrayInt.insertBack(iIter + 100000);
+  }
+
+  assert(objTeracadaArrayInt.getNumElements() == 200000);
+  assert(! objTeracadaArrayInt.isContiguous());
+
+  tc_bool bCompacted = objTeracadaArrayInt.compact();
+  assert(bCompacted);
+
+  for ( tc_int iIter = 0; iIter < 200000; iIter++ )
+    assert(((tc_int*) objTeracadaArrayInt.getArray())[iIter] == (iIter + 100000));
+
+  /* Removing from the tail only moves the null terminator */
+
+  {
+    tc_char acText[] = "abc";
+    TeracadaArray<tc_char> objTeracadaArrayChar(8);
+    objTeracadaArrayChar.disableExceptions();
+    objTeracadaArrayChar.setStorageMode(TA_STORAGE_DEQUE);
+    objTeracadaArrayChar.insertBack(acText, 3);
+
+    tc_bool bRemoved = objTeracadaArrayChar.remove(3, 1);
+    assert(bRemoved);
+    assert(objTeracadaArrayChar.getNumElements() == 2);
+    assert(! strcmp((tc_str) objTeracadaArrayChar.data(), "ab"));
+
+    // Removing from the front moves the head, compact() moves the elements back and terminates them
+    objTeracadaArrayChar.insertBack(acText, 3);
+    bRemoved = objTeracadaArrayChar.remove(1, 1) && objTeracadaArrayChar.remove(-1, 1);
+    assert(bRemoved);
+    assert(! strcmp((tc_str) objTeracadaArrayChar.data(), "bab"));
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayRing ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [RING]: ";
+
+  TeracadaArray<tc_int> objTeracadaArrayInt(50);
+  objTeracadaArrayInt.disableExceptions();
+  tc_bool bSet = objTeracadaArrayInt.setStorageMode(TA_STORAGE_RING);
+  assert(bSet);
+  assert(objTeracadaArrayInt.getRingCapacity() == 50);
+
+  deque<tc_int> objReference;
+  srand(1);
+
+  for ( tc_int iIter = 0; iIter < 10000; iIter++ ) {
+    tc_int iValue = (rand() % 2001) - 1000;
+
+    objTeracadaArrayInt.insertBack(iValue);
+    objReference.push_back(iValue);
+
+    if ( objReference.size() > 50 )
+      objReference.pop_front();
+
+    // Drop a few of the oldest elements now and then
+    if ( ! (iIter % 37) && objReference.size() > 3 ) {
+      objTeracadaArrayInt.remove(1, 3);
+      objReference.erase(objReference.begin(), objReference.begin() + 3);
+    }
+
+    assert(objTeracadaArrayInt.getNumElements() == (tc_int) objReference.size());
+    assert(*(tc_int*) objTeracadaArrayInt.get(1) == objReference.front());
+    assert(*(tc_int*) objTeracadaArrayInt.get(-1) == objReference.back());
+
+    if ( objReference.size() > 1 )
+      assert(*(tc_int*) objTeracadaArrayInt.get(-2) == objReference[objReference.size() - 2]);
+
+    tc_int64 i64Sum = 0;
+
+    for ( tc_int iElement : objReference )
+      i64Sum += iElement;
+
+    assert(objTeracadaArrayInt.getWindowSum() == i64Sum);
+    assert(objTeracadaArrayInt.getWindowMin() == *min_element(objReference.begin(), objReference.end()));
+    assert(objTeracadaArrayInt.getWindowMax() == *max_element(objReference.begin(), objReference.end()));
+  }
+
+  // Only inserts after the last element are allowed
+  tc_index iPosition = objTeracadaArrayInt.insert(1, 7);
+  assert(iPosition == TA_NONE_INDEX);
+
+  // Removing from the middle keeps the aggregates valid
+  objTeracadaArrayInt.remove(10, 5);
+  objReference.erase(objReference.begin() + 9, objReference.begin() + 14);
+  assert(objTeracadaArrayInt.getWindowMin() == *min_element(objReference.begin(), objReference.end()));
+
+  tc_bool bCompacted = objTeracadaArrayInt.compact();
+  assert(bCompacted);
+
+  for ( tc_int iIter = 0; iIter < objTeracadaArrayInt.getNumElements(); iIter++ )
+    assert(((tc_int*) objTeracadaArrayInt.getArray())[iIter] == objReference[iIter]);
+
+  /* Window mean for TC_DECIMAL */
+
+  TeracadaArray<tc_decimal> objTeracadaArrayDecimal(4);
+  objTeracadaArrayDecimal.disableExceptions();
+  objTeracadaArrayDecimal.setStorageMode(TA_STORAGE_RING);
+
+  for ( tc_int iIter = 1; iIter <= 10; iIter++ )
+    objTeracadaArrayDecimal.insertBack((tc_decimal) iIter);
+
+  // 7, 8, 9, 10
+  assert(objTeracadaArrayDecimal.getWindowMean() == (tc_decimal) 8.5);
+  assert(objTeracadaArrayDecimal.getWindowMin() == (tc_decimal) 7);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayView ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [VIEW]: ";
+
+  TeracadaArray<tc_int> objTeracadaArrayInt(10);
+  objTeracadaArrayInt.disableExceptions();
+
+  assert(objTeracadaArrayInt.view().empty());
+
+  for ( tc_int iIter = 1; iIter <= 100; iIter++ )
+    objTeracadaArrayInt.insertBack(iIter);
+
+  assert(objTeracadaArrayInt[0] == 1);
+  assert(objTeracadaArrayInt[99] == 100);
+
+  objTeracadaArrayInt[49] = -50;
+  assert(*(tc_int*) objTeracadaArrayInt.get(50) == -50);
+  objTeracadaArrayInt[49] = 50;
+
+  tc_int64 i64Sum = 0;
+
+  for ( tc_int iValue : objTeracadaArrayInt )
+    i64Sum += iValue;
+
+  assert(i64Sum == 5050);
+
+  // [first, last] positions, including negative positions
+  TeracadaArrayView<tc_int> objView = objTeracadaArrayInt.view(11, -11);
+  assert(objView.size() == 80);
+  assert(objView[0] == 11);
+  assert(objView[79] == 90);
+  assert(objView.subview(10, 5).size() == 5);
+  assert(objView.subview(10, 5)[0] == 21);
+
+  i64Sum = 0;
+
+  for ( tc_int iValue : objView )
+    i64Sum += iValue;
+
+  assert(i64Sum == (5050 - 55 - 955));
+
+  // Invalid positions
+  assert(objTeracadaArrayInt.view(50, 10).empty());
+  assert(objTeracadaArrayInt.view(1, 101).empty());
+
+  // Non contiguous storage is compacted by data()/view()
+  objTeracadaArrayInt.setStorageMode(TA_STORAGE_DEQUE);
+  objTeracadaArrayInt.insertFront((tc_int) 0);
+  assert(! objTeracadaArrayInt.isContiguous());
+  assert(objTeracadaArrayInt.view(1, 3)[2] == 2);
+  assert(objTeracadaArrayInt.isContiguous());
+  assert(objTeracadaArrayInt.data()[100] == 100);
+
+  /* TC_STRING */
+
+  TeracadaArray<tc_str> objTeracadaArrayString(3);
+  objTeracadaArrayString.disableExceptions();
+  objTeracadaArrayString.insertBack((tc_str) "tera");
+  objTeracadaArrayString.insertBack((tc_str) "cada");
+
+  assert(! strcmp(objTeracadaArrayString[1], "cada"));
+  assert(! strcmp(objTeracadaArrayString.view(-1, -1)[0], "cada"));
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+static tca_int buildTeracadaArrayInt ( tc_int iNumElements ) {
+  tca_int objTeracadaArrayInt(iNumElements);
+
+  for ( tc_int iIter = 1; iIter <= iNumElements; iIter++ )
+    objTeracadaArrayInt.insertBack(iIter);
+
+  return objTeracadaArrayInt;
+}
+
+
+void UnitTestsTeracadaArrayOwnership ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [OWNERSHIP]: ";
+
+  tc_uint64 ui64PreCapacityBytes = TeracadaMetrics::getArrayMetrics().ui64CapacityBytes;
+
+  {
+    /* Move construction/assignment */
+
+    tca_int objTeracadaArrayInt = buildTeracadaArrayInt(100);
+    tc_void* pvBuffer = objTeracadaArrayInt.getArray();
+
+    tca_int objMoved(std::move(objTeracadaArrayInt));
+    assert(objMoved.getArray() == pvBuffer);
+    assert(objMoved.getNumElements() == 100);
+    assert(! objTeracadaArrayInt.isInitSuccess());
+    assert(objTeracadaArrayInt.getArray() == nullptr);
+
+    objTeracadaArrayInt = std::move(objMoved);
+    assert(objTeracadaArrayInt.getArray() == pvBuffer);
+    assert(*(tc_int*) objTeracadaArrayInt.get(-1) == 100);
+
+    // Arrays in STL containers, moved on reallocation
+    vector<tca_int> vecArrays;
+
+    for ( tc_int iIter = 1; iIter <= 20; iIter++ )
+      vecArrays.push_back(buildTeracadaArrayInt(iIter));
+
+    for ( tc_int iIter = 1; iIter <= 20; iIter++ )
+      assert(vecArrays[iIter - 1].getNumElements() == iIter);
+
+    /* Clone */
+
+    objTeracadaArrayInt.setStorageMode(TA_STORAGE_DEQUE);
+    objTeracadaArrayInt.insertFront((tc_int) 0);
+
+    tca_int objClone = objTeracadaArrayInt.clone();
+    assert(objClone.getArray() != objTeracadaArrayInt.getArray());
+    assert(objClone.getNumElements() == 101);
+    assert(objClone.getStorageMode() == TA_STORAGE_DEQUE);
+
+    objClone[0] = -1;
+    assert(objTeracadaArrayInt[0] == 0);
+
+    for ( tc_int iIter = 2; iIter <= 101; iIter++ )
+      assert(*(tc_int*) objClone.get(iIter) == (iIter - 1));
+
+    /* Release/adopt */
+
+    tc_index iNumElements = 0, iMaxNumElements = 0;
+    tc_int* piBuffer = (tc_int*) objClone.release(&iNumElements, &iMaxNumElements);
+
+    assert(piBuffer && iNumElements == 101 && iMaxNumElements >= 101);
+    assert(! objClone.isInitSuccess());
+    assert(piBuffer[0] == -1 && piBuffer[100] == 100);
+
+    tca_int objAdopter(1);
+    tc_bool bAdopted = objAdopter.adopt(piBuffer, iNumElements, iMaxNumElements);
+    assert(bAdopted);
+    assert(objAdopter.getArray() == piBuffer);
+    assert(*(tc_int*) objAdopter.get(-1) == 100);
+    objAdopter.insertBack(101);
+    assert(*(tc_int*) objAdopter.get(-1) == 101);
+
+    // Moved-from array can be reused
+    tc_int* piNewBuffer = (tc_int*) malloc(10 * sizeof(tc_int));
+    piNewBuffer[0] = 7;
+    bAdopted = objClone.adopt(piNewBuffer, 1, 10);
+    assert(bAdopted);
+    assert(*(tc_int*) objClone.get(1) == 7);
+
+    /* Ring storage, the window aggregates are rebuilt for the adopted buffer */
+
+    tca_int objRing(4);
+    objRing.disableExceptions();
+    tc_bool bSet = objRing.setStorageMode(TA_STORAGE_RING);
+    assert(bSet);
+    objRing.insertBack(100);
+
+    tc_int* piRingBuffer = (tc_int*) malloc(8 * sizeof(tc_int));
+    tc_int aiRingElements[5] = { 4, -2, 9, 3, 1 };
+    memcpy(piRingBuffer, aiRingElements, sizeof(aiRingElements));
+
+    bAdopted = objRing.adopt(piRingBuffer, 5, 8);
+    assert(bAdopted && objRing.getRingCapacity() == 8);
+    assert(objRing.getWindowMin() == -2 && objRing.getWindowMax() == 9 && objRing.getWindowSum() == 15);
+
+    // Rejected buffers leave the array as it was
+    bAdopted = objRing.adopt(piRingBuffer, 5, 4);
+    assert(! bAdopted && objRing.getArray() == piRingBuffer && objRing.getWindowMax() == 9);
+
+    /* TC_CHAR buffer with the null terminator */
+
+    tc_str pcText = strdup("teracada");
+    tc_char acSuffix[] = " array";
+    tca_char objTeracadaArrayChar(1);
+    objTeracadaArrayChar.disableExceptions();
+    bAdopted = objTeracadaArrayChar.adopt(pcText, 8, 9);
+    assert(bAdopted);
+    objTeracadaArrayChar.insertBack(acSuffix);
+    assert(! strcmp((tc_str) objTeracadaArrayChar.getArray(), "teracada array"));
+
+    bAdopted = objTeracadaArrayChar.adopt(pcText, 8, 8);
+    assert(! bAdopted);
+  }
+
+  // Every buffer allocated or adopted has been freed
+  assert(TeracadaMetrics::getArrayMetrics().ui64CapacityBytes == ui64PreCapacityBytes);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayZeroFill ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [ZERO_FILL]: ";
+
+  // Zero filled by default
+  {
+    tca_int objTeracadaArrayInt(10);
+    assert(objTeracadaArrayInt.isZeroFill());
+    assert(((tc_int*) objTeracadaArrayInt.getArray())[9] == 0);
+  }
+
+  // Skipped elements are zeroed on insert
+  {
+    tca_decimal objTeracadaArrayDecimal(16, false);
+    assert(! objTeracadaArrayDecimal.isZeroFill());
+
+    for ( tc_int iIter = 0; iIter < 16; iIter++ )
+      ((tc_decimal*) objTeracadaArrayDecimal.getArray())[iIter] = -1;
+
+    objTeracadaArrayDecimal.insertBack((tc_decimal) 1.5);
+    tc_index iPosition = objTeracadaArrayDecimal.insert(10, (tc_decimal) 2.5);
+    assert(iPosition == 10);
+    assert(objTeracadaArrayDecimal.getNumElements() == 10);
+
+    for ( tc_int iIter = 2; iIter <= 9; iIter++ )
+      assert(*(tc_decimal*) objTeracadaArrayDecimal.get(iIter) == 0);
+
+    tc_decimal adValues[2] = { 3.5, 4.5 };
+    tc_bool bInserted = objTeracadaArrayDecimal.insert(14, adValues, 2);
+    assert(bInserted);
+    assert(*(tc_decimal*) objTeracadaArrayDecimal.get(11) == 0 && *(tc_decimal*) objTeracadaArrayDecimal.get(13) == 0);
+    assert(*(tc_decimal*) objTeracadaArrayDecimal.get(-1) == (tc_decimal) 4.5);
+
+    tca_decimal objClone = objTeracadaArrayDecimal.clone();
+    assert(! objClone.isZeroFill());
+    assert(objClone.getNumElements() == 15);
+  }
+
+  // Capacity added by a reallocation is zeroed, even when the allocator reuses a dirty buffer
+  {
+    TeracadaPoolAllocator objPool;
+
+    for ( tc_uint64 ui64Bytes = 64; ui64Bytes <= 4096; ui64Bytes *= 2 ) {
+      tc_void* pvDirty = objPool.allocate(ui64Bytes, false);
+      memset(pvDirty, 0xff, ui64Bytes);
+      objPool.deallocate(pvDirty, ui64Bytes);
+    }
+
+    tca_int objTeracadaArrayInt(4, true, &objPool);
+    objTeracadaArrayInt.disableExceptions();
+    objTeracadaArrayInt.insertBack(1);
+
+    tc_index iPosition = objTeracadaArrayInt.insert(500, 2);
+    assert(iPosition == 500);
+
+    for ( tc_int iIter = 2; iIter < 500; iIter++ )
+      assert(*(tc_int*) objTeracadaArrayInt.get(iIter) == 0);
+
+    for ( tc_index iIndex = 500; iIndex < objTeracadaArrayInt.getMaxNumElements(); iIndex++ )
+      assert(((tc_int*) objTeracadaArrayInt.getArray())[iIndex] == 0);
+  }
+
+  // TC_CHAR keeps the null terminator
+  {
+    tc_char acText[] = "teracada";
+    tca_char objTeracadaArrayChar(32, false);
+    assert(! strcmp((tc_str) objTeracadaArrayChar.getArray(), ""));
+
+    objTeracadaArrayChar.insertBack(acText);
+    assert(! strcmp((tc_str) objTeracadaArrayChar.getArray(), "teracada"));
+
+    objTeracadaArrayChar.reset();
+    assert(! strcmp((tc_str) objTeracadaArrayChar.getArray(), ""));
+  }
+
+  /* Footprint */
+
+  {
+    tca_int objTeracadaArrayInt(100);
+    objTeracadaArrayInt.insertBack(1);
+    objTeracadaArrayInt.insertBack(2);
+
+    stdTeracadaArrayFootprint stFootprint = objTeracadaArrayInt.getFootprint();
+    assert(stFootprint.ui64ObjectBytes == sizeof(tca_int));
+    assert(stFootprint.ui64CapacityBytes == (100 * sizeof(tc_int)));
+    assert(stFootprint.ui64UsedBytes == (2 * sizeof(tc_int)));
+    assert(stFootprint.ui64StorageBytes == 0);
+    assert(stFootprint.ui64SlackBytes == (98 * sizeof(tc_int)));
+    assert(stFootprint.ui64TotalBytes == (sizeof(tca_int) + (100 * sizeof(tc_int))));
+    assert(stFootprint.ui64ResidentBytes > 0 && stFootprint.ui64ResidentBytes <= stFootprint.ui64CapacityBytes);
+
+    // Ring window aggregates are storage buffers
+    objTeracadaArrayInt.setStorageMode(TA_STORAGE_RING);
+    objTeracadaArrayInt.insertBack(3);
+    stFootprint = objTeracadaArrayInt.getFootprint();
+    assert(stFootprint.ui64StorageBytes > 0);
+    assert(stFootprint.ui64TotalBytes == (stFootprint.ui64ObjectBytes + stFootprint.ui64CapacityBytes + stFootprint.ui64StorageBytes));
+
+    // Capacity that was never written to is not resident
+    tca_byte objTeracadaArrayByte((64 << 20), false);
+    objTeracadaArrayByte.insertBack((tc_byte) 1);
+    stFootprint = objTeracadaArrayByte.getFootprint();
+    assert(stFootprint.ui64ResidentBytes < (stFootprint.ui64CapacityBytes / 2));
+
+    // Uninitialized array
+    tca_int objMoved = std::move(objTeracadaArrayInt);
+    stFootprint = objTeracadaArrayInt.getFootprint();
+    assert(stFootprint.ui64CapacityBytes == 0 && stFootprint.ui64TotalBytes == sizeof(tca_int));
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayLargeSizes ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [LARGE_SIZES]: ";
+
+  assert(sizeof(tc_index) == 8);
+
+  /*
+    Sizes beyond the tc_int range of the teracada32 build (the pages are only touched where written)
+    Reserves more than 2 GB of address space, only run when TERACADA_UNIT_TESTS_LARGE is set in the environment
+  */
+  if ( getenv("TERACADA_UNIT_TESTS_LARGE") ) {
+    const tc_index iNumElements = ((tc_index) 1 << 31) + 64;
+
+    tca_byte objTeracadaArrayByte(iNumElements);
+    objTeracadaArrayByte.disableExceptions();
+
+    assert(objTeracadaArrayByte.isInitSuccess());
+    assert(objTeracadaArrayByte.getArraySize() == (tc_uint64) iNumElements);
+
+    tc_index iPosition = objTeracadaArrayByte.insert(iNumElements, (tc_byte) 42);
+    assert(iPosition == iNumElements);
+    assert(objTeracadaArrayByte.getNumElements() == iNumElements);
+    assert(*(tc_byte*) objTeracadaArrayByte.get(-1) == 42);
+    assert(*(tc_byte*) objTeracadaArrayByte.get(iNumElements) == 42);
+    assert(objTeracadaArrayByte[iNumElements - 2] == 0);
+
+    tc_bool bRemoved = objTeracadaArrayByte.remove(iNumElements - 1);
+    assert(bRemoved);
+    assert(objTeracadaArrayByte.getNumElements() == (iNumElements - 1));
+    assert(objTeracadaArrayByte.view(-2).size() == 2);
+  }
+
+  // Sizes whose buffer length in bytes overflows are rejected, the array is left untouched
+  {
+    tca_decimal objTeracadaArrayDecimal(10);
+    objTeracadaArrayDecimal.disableExceptions();
+    objTeracadaArrayDecimal.insertBack((tc_decimal) 1.5);
+
+    tc_bool bReserved = objTeracadaArrayDecimal.reserve(INT64_MAX / 4);
+    assert(! bReserved);
+    bReserved = objTeracadaArrayDecimal.reserve(INT64_MAX);
+    assert(! bReserved);
+    assert(objTeracadaArrayDecimal.getNumElements() == 1);
+    assert(objTeracadaArrayDecimal.getArraySize() == (10 * sizeof(tc_decimal)));
+    assert(*(tc_decimal*) objTeracadaArrayDecimal.get(1) == (tc_decimal) 1.5);
+
+    tc_decimal adValues[2] = { 2.5, 3.5 };
+    tc_bool bInserted = objTeracadaArrayDecimal.insert(1, adValues, INT64_MAX / 2);
+    assert(! bInserted);
+    bInserted = objTeracadaArrayDecimal.insertBack(adValues, 2);
+    assert(bInserted);
+    assert(objTeracadaArrayDecimal.getNumElements() == 3);
+
+    tc_bool bInitFailed = false;
+
+    try {
+      tca_decimal objOverflow(INT64_MAX / 4);
+    } catch ( TeracadaException& objException ) {
+      bInitFailed = true;
+    }
+
+    assert(bInitFailed);
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayAllocators ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [ALLOCATORS]: ";
+
+  // Default heap allocator
+  {
+    tca_int objTeracadaArrayInt(10);
+    assert(objTeracadaArrayInt.getAllocator() == TeracadaAllocator::getDefault());
+    assert(objTeracadaArrayInt.getAllocator()->isMallocCompatible());
+  }
+
+  /* Arena */
+
+  {
+    TeracadaArenaAllocator objArena(65536);
+
+    {
+      tca_int objTeracadaArrayInt(10, true, &objArena);
+      objTeracadaArrayInt.disableExceptions();
+      objTeracadaArrayInt.setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
+      assert(objTeracadaArrayInt.getAllocator() == &objArena);
+
+      // The last buffer of the block grows in place
+      tc_void* pvArray = objTeracadaArrayInt.getArray();
+
+      for ( tc_int iIter = 0; iIter < 100; iIter++ )
+        objTeracadaArrayInt.insertBack(iIter);
+
+      assert(objTeracadaArrayInt.getArray() == pvArray);
+
+      // Larger than a quarter of the block, moved to the heap
+      for ( tc_int iIter = 100; iIter < 10000; iIter++ )
+        objTeracadaArrayInt.insertBack(iIter);
+
+      for ( tc_int iIter = 0; iIter < 10000; iIter++ )
+        assert(objTeracadaArrayInt[iIter] == iIter);
+
+      // Buffers of the arena can't be handed off to malloc()/free()
+      tc_void* pvReleased = objTeracadaArrayInt.release();
+      assert(pvReleased == nullptr);
+      assert(objTeracadaArrayInt.getNumElements() == 10000);
+
+      tca_int objClone = objTeracadaArrayInt.clone();
+      assert(objClone.getAllocator() == &objArena);
+      assert(objClone[9999] == 9999);
+
+      // Small arrays filling up more than one block
+      vector<tca_int> vecArrays;
+
+      for ( tc_int iIter = 0; iIter < 20; iIter++ )
+        vecArrays.emplace_back(1000, true, &objArena);
+    }
+
+    stdTeracadaAllocatorStats stStats = objArena.getStats();
+    assert(stStats.ui64NumAllocs == 22 && stStats.ui64NumFrees == 22);
+    assert(stStats.ui64NumReallocs > 0 && stStats.ui64NumSystemAllocs < stStats.ui64NumReallocs);
+
+    objArena.reset();
+    assert(objArena.getStats().ui64SystemBytes > 0 && objArena.getStats().ui64SystemBytes < stStats.ui64SystemBytes);
+  }
+
+  /* Pool */
+
+  {
+    TeracadaPoolAllocator objPool;
+    tc_void* pvFreedArray = nullptr;
+
+    {
+      vector<tca_decimal> vecArrays;
+
+      for ( tc_int iIter = 1; iIter <= 1000; iIter++ ) {
+        vecArrays.emplace_back((iIter % 16) + 1, true, &objPool);
+        vecArrays.back().insertBack((tc_decimal) iIter);
+      }
+
+      for ( tc_int iIter = 1; iIter <= 1000; iIter++ )
+        assert(*(tc_decimal*) vecArrays[iIter - 1].get(1) == (tc_decimal) iIter);
+
+      pvFreedArray = vecArrays.back().getArray();
+    }
+
+    // Freed buffers are recycled through the free list of their size class
+    tca_decimal objTeracadaArrayDecimal(((1000 % 16) + 1), true, &objPool);
+    assert(objTeracadaArrayDecimal.getArray() == pvFreedArray);
+
+    // Larger buffers than the size classes go to the heap, moving buffers between the two keeps the elements
+    objTeracadaArrayDecimal.insertBack((tc_decimal) 1.5);
+    tc_bool bResized = objTeracadaArrayDecimal.reserve(TC_POOL_MAX_CLASS_SIZE);
+    assert(bResized);
+    bResized = objTeracadaArrayDecimal.shrinkToFit();
+    assert(bResized);
+    assert(*(tc_decimal*) objTeracadaArrayDecimal.get(1) == (tc_decimal) 1.5);
+
+    stdTeracadaAllocatorStats stStats = objPool.getStats();
+    assert(stStats.ui64NumAllocs == 1001);
+    assert(stStats.ui64NumSystemAllocs < 10);
+  }
+
+  /* Huge pages */
+
+  {
+    TeracadaHugePageAllocator objHugePages;
+
+    {
+      tca_decimal objTeracadaArrayDecimal(1000, true, &objHugePages);
+      objTeracadaArrayDecimal.disableExceptions();
+
+      assert(((uintptr_t) objTeracadaArrayDecimal.getArray() % TC_HUGE_PAGE_SIZE) == 0);
+
+      // The pages after the buffer are taken, it can't grow in place and is copied to a new aligned mapping
+      tc_byte* pb8Blocker = (tc_byte*) objTeracadaArrayDecimal.getArray() + TC_HUGE_PAGE_SIZE;
+      tc_void* pvBlocker = mmap(pb8Blocker, 4096, PROT_READ, (MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE), -1, 0);
+
+      for ( tc_int iIter = 0; iIter < 1000000; iIter++ )
+        objTeracadaArrayDecimal.insertBack((tc_decimal) iIter);
+
+      if ( pvBlocker != MAP_FAILED )
+        munmap(pvBlocker, 4096);
+
+      assert(((uintptr_t) objTeracadaArrayDecimal.getArray() % TC_HUGE_PAGE_SIZE) == 0);
+      assert(objTeracadaArrayDecimal.getNumElements() == 1000000);
+      assert(objTeracadaArrayDecimal[999999] == (tc_decimal) 999999);
+      assert(objHugePages.getStats().ui64SystemBytes >= objTeracadaArrayDecimal.getFootprint().ui64CapacityBytes);
+      assert((objHugePages.getStats().ui64SystemBytes % TC_HUGE_PAGE_SIZE) == 0);
+    }
+
+    assert(objHugePages.getStats().ui64SystemBytes == 0);
+    assert(objHugePages.getStats().ui64NumFrees == 1);
+  }
+
+  /* Dict */
+
+  {
+    TeracadaArenaAllocator objArena;
+
+    {
+      TeracadaDict objDict(&objArena);
+      tc_char acParent[] = "parent";
+
+      tc_dict ptcdParent = objDict.update<tc_str, tc_int>(acParent, 1);
+
+      for ( tc_int iIter = 0; iIter < 100; iIter++ )
+        objDict.update<tc_int, tc_decimal>(ptcdParent, iIter, (tc_decimal) iIter / 2);
+
+      assert(*(tc_int*) objDict.get<tc_str>(acParent) == 1);
+      assert(*(tc_decimal*) objDict.get<tc_int>(42, ptcdParent) == (tc_decimal) 21);
+    }
+
+    // Nodes are carved from slabs, not allocated one by one
+    assert(objArena.getStats().ui64NumAllocs > 0 && objArena.getStats().ui64NumAllocs < 100);
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+// Checks the stats of the array against a reference computed element by element
+template <typename tDataType>
+static tc_void checkTeracadaArrayStats ( TeracadaArray<tDataType>& objArray, const vector<tDataType>& vecReference ) {
+  long double ldSum = 0, ldSumSquares = 0;
+  tDataType tMin = vecReference[0], tMax = vecReference[0];
+  tc_double dTolerance = (sizeof(tc_decimal) == 4) ? 1e-5 : 1e-9;
+
+  for ( tDataType tValue : vecReference ) {
+    ldSum += tValue;
+    tMin = std::min(tMin, tValue);
+    tMax = std::max(tMax, tValue);
+  }
+
+  long double ldMean = ldSum / vecReference.size();
+
+  for ( tDataType tValue : vecReference )
+    ldSumSquares += (tValue - ldMean) * (tValue - ldMean);
+
+  assert(objArray.min() == tMin);
+  assert(objArray.max() == tMax);
+  assert(objArray.range() == (tc_decimal) ((tc_double) tMax - (tc_double) tMin));
+  assert(fabs(objArray.mean() - (tc_double) ldMean) <= dTolerance * (1 + fabs((tc_double) ldMean)));
+  assert(fabs(objArray.variance() - (tc_double) (ldSumSquares / vecReference.size())) <= dTolerance * (1 + (tc_double) (ldSumSquares / vecReference.size())));
+
+  if ( vecReference.size() > 1 )
+    assert(fabs(objArray.standardDeviation(1) - sqrt((tc_double) (ldSumSquares / (vecReference.size() - 1)))) <= dTolerance * (1 + sqrt((tc_double) ldSumSquares)));
+}
+
+
+void UnitTestsTeracadaArrayStats ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [STATS]: ";
+
+  // Every SIMD level the cpu supports, sizes around the vector widths for the remaining elements
+  for ( tc_int iSimdLevel = TS_SIMD_SCALAR; iSimdLevel <= TeracadaStats::getMaxSimdLevel(); iSimdLevel++ ) {
+    tc_byte b8SimdLevel = TeracadaStats::setSimdLevel(iSimdLevel);
+    assert(b8SimdLevel == iSimdLevel);
+
+    for ( tc_int iNumElements : { 1, 7, 16, 17, 63, 64, 65, 1001 } ) {
+      TeracadaArray<tc_byte> objTeracadaArrayByte(iNumElements);
+      TeracadaArray<tc_int> objTeracadaArrayInt(iNumElements);
+      TeracadaArray<tc_decimal> objTeracadaArrayDecimal(iNumElements);
+      vector<tc_byte> vecBytes;
+      vector<tc_int> vecInts;
+      vector<tc_decimal> vecDecimals;
+
+      srand(iNumElements);
+
+      for ( tc_int iIter = 0; iIter < iNumElements; iIter++ ) {
+        vecBytes.push_back((tc_byte) (rand() % 256));
+        vecInts.push_back((tc_int) (rand() % 20001) - 10000);
+        vecDecimals.push_back((tc_decimal) ((rand() % 20001) - 10000) / 8);
+
+        objTeracadaArrayByte.insertBack(vecBytes.back());
+        objTeracadaArrayInt.insertBack(vecInts.back());
+        objTeracadaArrayDecimal.insertBack(vecDecimals.back());
+      }
+
+      checkTeracadaArrayStats(objTeracadaArrayByte, vecBytes);
+      checkTeracadaArrayStats(objTeracadaArrayInt, vecInts);
+      checkTeracadaArrayStats(objTeracadaArrayDecimal, vecDecimals);
+    }
+  }
+
+  TeracadaStats::setSimdLevel(TS_SIMD_AVX512);
+  assert(TeracadaStats::getSimdLevel() == TeracadaStats::getMaxSimdLevel());
+
+  // All positive/all negative elements, min/max positions
+  TeracadaArray<tc_int> objTeracadaArrayInt(10);
+  TeracadaArray<tc_int> objPositions(10);
+
+  for ( tc_int iValue : { 5, 3, 9, 3, 9, 4 } )
+    objTeracadaArrayInt.insertBack(iValue);
+
+  tc_int iExtreme = objTeracadaArrayInt.min(&objPositions);
+  assert(iExtreme == 3);
+  assert(objPositions.getNumElements() == 2 && objPositions[0] == 2 && objPositions[1] == 4);
+
+  objPositions.reset();
+  iExtreme = objTeracadaArrayInt.max(&objPositions);
+  assert(iExtreme == 9);
+  assert(objPositions.getNumElements() == 2 && objPositions[0] == 3 && objPositions[1] == 5);
+
+  objTeracadaArrayInt.reset();
+
+  for ( tc_int iValue : { -5, -3, -9 } )
+    objTeracadaArrayInt.insertBack(iValue);
+
+  assert(objTeracadaArrayInt.max() == -3 && objTeracadaArrayInt.range() == 6);
+
+  // Large elements with a small spread, 1e9 + (0 .. 9), variance 8.25
+  TeracadaArray<tc_int> objTeracadaArrayLarge(10000);
+
+  for ( tc_int iIter = 0; iIter < 10000; iIter++ )
+    objTeracadaArrayLarge.insertBack((tc_int) 1000000000 + (iIter % 10));
+
+  assert(fabs(objTeracadaArrayLarge.variance() - 8.25) < 1e-6);
+  assert(objTeracadaArrayLarge.mean() == (tc_decimal) 1000000004.5);
+
+  // Non contiguous storage modes are compacted
+  TeracadaArray<tc_decimal> objTeracadaArrayRing(4);
+  objTeracadaArrayRing.setStorageMode(TA_STORAGE_RING);
+
+  for ( tc_int iIter = 1; iIter <= 10; iIter++ )
+    objTeracadaArrayRing.insertBack((tc_decimal) iIter);
+
+  // 7, 8, 9, 10
+  assert(objTeracadaArrayRing.mean() == (tc_decimal) 8.5 && objTeracadaArrayRing.min() == 7 && objTeracadaArrayRing.variance() == (tc_decimal) 1.25);
+
+  // Empty arrays, too many degrees of freedom, non numeric arrays
+  TeracadaArray<tc_decimal> objTeracadaArrayEmpty(10);
+  stdTeracadaStatsSummary<tc_decimal> stSummary;
+
+  tc_bool bSummarized = objTeracadaArrayEmpty.summarize(&stSummary);
+  assert(! bSummarized && stSummary.iNumElements == 0);
+  assert(objTeracadaArrayEmpty.mean() == 0 && objTeracadaArrayEmpty.variance() < 0 && objTeracadaArrayEmpty.range() < 0);
+  assert(objTeracadaArrayRing.variance(4) < 0 && objTeracadaArrayRing.standardDeviation(4) < 0);
+
+  TeracadaArray<tc_str> objTeracadaArrayString(2);
+  objTeracadaArrayString.disableExceptions();
+  objTeracadaArrayString.insertBack((tc_str) "tera");
+  assert(objTeracadaArrayString.variance() < 0 && objTeracadaArrayString.getErrno() == ERR_TA_INVALID_DATA_TYPE);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+// Checks argMin(), argMax() and argWhere() of the array against a reference computed element by element
+template <typename tDataType>
+static tc_void checkTeracadaArrayArgStats ( TeracadaArray<tDataType>& objArray, const vector<tDataType>& vecReference ) {
+  tDataType tMin = *std::min_element(vecReference.begin(), vecReference.end());
+  tDataType tMax = *std::max_element(vecReference.begin(), vecReference.end());
+  vector<tc_int> vecMinPositions, vecMaxPositions, vecValuePositions;
+  TeracadaArray<tc_int> objPositions(10);
+
+  for ( size_t iIndex = 0; iIndex < vecReference.size(); iIndex++ ) {
+    if ( vecReference[iIndex] == tMin )
+      vecMinPositions.push_back((tc_int) iIndex + 1);
+
+    if ( vecReference[iIndex] == tMax )
+      vecMaxPositions.push_back((tc_int) iIndex + 1);
+
+    if ( vecReference[iIndex] == vecReference.back() )
+      vecValuePositions.push_back((tc_int) iIndex + 1);
+  }
+
+  tDataType tExtreme = objArray.min(&objPositions);
+  assert(tExtreme == tMin);
+  assert(vector<tc_int>(objPositions.begin(), objPositions.end()) == vecMinPositions);
+
+  objPositions.reset();
+  tc_index iPosition = objArray.argMax(&objPositions);
+  assert(iPosition == vecMaxPositions[0]);
+  assert(vector<tc_int>(objPositions.begin(), objPositions.end()) == vecMaxPositions);
+
+  objPositions.reset();
+  tc_index iNumMatches = objArray.argWhere(vecReference.back(), &objPositions);
+  assert(iNumMatches == (tc_index) vecValuePositions.size());
+  assert(vector<tc_int>(objPositions.begin(), objPositions.end()) == vecValuePositions);
+
+  assert(objArray.argMin() == vecMinPositions[0] && objArray.argWhere(vecReference.back()) == (tc_index) vecValuePositions.size());
+}
+
+
+void UnitTestsTeracadaArrayArgStats ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [ARG_STATS]: ";
+
+  // Every SIMD level the cpu supports, sizes around the vector widths, few distinct values so that the min/max repeat
+  for ( tc_int iSimdLevel = TS_SIMD_SCALAR; iSimdLevel <= TeracadaStats::getMaxSimdLevel(); iSimdLevel++ ) {
+    tc_byte b8SimdLevel = TeracadaStats::setSimdLevel(iSimdLevel);
+    assert(b8SimdLevel == iSimdLevel);
+
+    for ( tc_int iNumElements : { 1, 7, 16, 17, 63, 64, 65, 255, 256, 257, 1001, 5000 } ) {
+      TeracadaArray<tc_byte> objTeracadaArrayByte(iNumElements);
+      TeracadaArray<tc_int> objTeracadaArrayInt(iNumElements);
+      TeracadaArray<tc_decimal> objTeracadaArrayDecimal(iNumElements);
+      vector<tc_byte> vecBytes;
+      vector<tc_int> vecInts;
+      vector<tc_decimal> vecDecimals;
+
+      srand(iNumElements);
+
+      for ( tc_int iIter = 0; iIter < iNumElements; iIter++ ) {
+        vecBytes.push_back((tc_byte) (rand() % 256));
+        vecInts.push_back((tc_int) (rand() % 201) - 100);
+        vecDecimals.push_back((tc_decimal) ((rand() % 41) - 20) / 4);
+
+        objTeracadaArrayByte.insertBack(vecBytes.back());
+        objTeracadaArrayInt.insertBack(vecInts.back());
+        objTeracadaArrayDecimal.insertBack(vecDecimals.back());
+      }
+
+      checkTeracadaArrayArgStats(objTeracadaArrayByte, vecBytes);
+      checkTeracadaArrayArgStats(objTeracadaArrayInt, vecInts);
+      checkTeracadaArrayArgStats(objTeracadaArrayDecimal, vecDecimals);
+    }
+
+    // More positions of a min than TS_POSITIONS_BUFFER_SIZE, dropped once a smaller min comes after them
+    TeracadaArray<tc_int> objTeracadaArrayInt(5000);
+    TeracadaArray<tc_int> objPositions(10);
+    vector<tc_int> vecInts(3000, 5);
+
+    vecInts.push_back(1);
+    vecInts.insert(vecInts.end(), 1500, 7);
+    vecInts.push_back(1);
+
+    for ( tc_int iValue : vecInts )
+      objTeracadaArrayInt.insertBack(iValue);
+
+    // The positions array keeps its elements
+    objPositions.insertBack(-1);
+    tc_index iArgMin = objTeracadaArrayInt.argMin(&objPositions);
+    assert(iArgMin == 3001);
+    assert(objPositions.getNumElements() == 3 && objPositions[0] == -1 && objPositions[1] == 3001 && objPositions[2] == 4502);
+
+    objPositions.reset();
+    tc_index iNumMatches = objTeracadaArrayInt.argWhere(5, &objPositions);
+    assert(iNumMatches == 3000 && objPositions.getNumElements() == 3000 && objPositions[2999] == 3000);
+
+    checkTeracadaArrayArgStats(objTeracadaArrayInt, vecInts);
+
+    // A new min at every element, the positions of the previous ones are dropped from the scratch positions only
+    TeracadaArray<tc_int> objTeracadaArrayDescending(5000);
+    vector<tc_int> vecDescending;
+
+    for ( tc_int iValue = 5000; iValue > 0; iValue-- ) {
+      vecDescending.push_back(iValue);
+      objTeracadaArrayDescending.insertBack(iValue);
+    }
+
+    objPositions.reset();
+    objPositions.insertBack(-1);
+    iArgMin = objTeracadaArrayDescending.argMin(&objPositions);
+    assert(iArgMin == 5000 && objPositions.getNumElements() == 2 && objPositions[0] == -1 && objPositions[1] == 5000);
+
+    checkTeracadaArrayArgStats(objTeracadaArrayDescending, vecDescending);
+  }
+
+  TeracadaStats::setSimdLevel(TS_SIMD_AVX512);
+
+  // All positive/all negative elements, non contiguous storage modes are compacted
+  TeracadaArray<tc_decimal> objTeracadaArrayRing(4);
+  TeracadaArray<tc_int> objPositions(10);
+  objTeracadaArrayRing.setStorageMode(TA_STORAGE_RING);
+
+  for ( tc_int iIter = 1; iIter <= 10; iIter++ )
+    objTeracadaArrayRing.insertBack((tc_decimal) -(iIter % 3) - 1);
+
+  // -2, -3, -1, -2
+  tc_decimal dMax = objTeracadaArrayRing.max(&objPositions);
+  assert(dMax == -1 && objPositions.getNumElements() == 1 && objPositions[0] == 3);
+  assert(objTeracadaArrayRing.argMin() == 2 && objTeracadaArrayRing.argWhere(-2) == 2);
+
+  // Empty arrays, non numeric arrays
+  TeracadaArray<tc_int> objTeracadaArrayEmpty(10);
+  objTeracadaArrayEmpty.disableExceptions();
+  objPositions.reset();
+
+  tc_index iArgMin = objTeracadaArrayEmpty.argMin(&objPositions);
+  tc_index iNumMatches = objTeracadaArrayEmpty.argWhere(0, &objPositions);
+  assert(iArgMin == 0 && iNumMatches == 0);
+  tc_int iMin = objTeracadaArrayEmpty.min(&objPositions);
+  assert(iMin == 0 && objPositions.getNumElements() == 0);
+
+  TeracadaArray<tc_str> objTeracadaArrayString(2);
+  objTeracadaArrayString.disableExceptions();
+  objTeracadaArrayString.insertBack((tc_str) "tera");
+  assert(objTeracadaArrayString.argMax() == 0 && objTeracadaArrayString.getErrno() == ERR_TA_INVALID_DATA_TYPE);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayMoments ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [MOMENTS]: ";
+
+  // Skewed elements across several blocks (TS_MOMENTS_BLOCK_SIZE), against a two pass reference
+  TeracadaArray<tc_decimal> objTeracadaArrayDecimal(10000);
+  vector<tc_decimal> vecDecimals;
+  long double ldSum = 0, ldM2 = 0, ldM3 = 0, ldM4 = 0;
+
+  srand(10000);
+
+  for ( tc_int iIter = 0; iIter < 10000; iIter++ ) {
+    tc_decimal dValue = (tc_decimal) (rand() % 1000) / 10;
+
+    vecDecimals.push_back(dValue * dValue / 100);
+    objTeracadaArrayDecimal.insertBack(vecDecimals.back());
+    ldSum += vecDecimals.back();
+  }
+
+  long double ldMean = ldSum / vecDecimals.size();
+
+  for ( tc_decimal dValue : vecDecimals ) {
+    long double ldDeviation = dValue - ldMean;
+
+    ldM2 += ldDeviation * ldDeviation;
+    ldM3 += ldDeviation * ldDeviation * ldDeviation;
+    ldM4 += ldDeviation * ldDeviation * ldDeviation * ldDeviation;
+  }
+
+  tc_double dSkewness = (tc_double) (sqrtl(vecDecimals.size()) * ldM3 / powl(ldM2, 1.5));
+  tc_double dKurtosis = (tc_double) ((vecDecimals.size() * ldM4) / (ldM2 * ldM2)) - 3;
+
+  TeracadaStatsMoments<tc_decimal> objMoments;
+
+  tc_bool bMoments = objTeracadaArrayDecimal.moments(&objMoments);
+  assert(bMoments && objMoments.getNumElements() == 10000);
+  assert(fabs(objMoments.getMean() - (tc_double) ldMean) < 1e-9 * (tc_double) ldMean);
+  assert(fabs(objMoments.getVariance(1) - (tc_double) (ldM2 / 9999)) < 1e-9 * (tc_double) (ldM2 / 9999));
+  assert(fabs(objMoments.getSkewness() - dSkewness) < 1e-9 && fabs(objMoments.getKurtosis() - dKurtosis) < 1e-9);
+  assert(fabs(objTeracadaArrayDecimal.skewness() - dSkewness) < 1e-5 && fabs(objTeracadaArrayDecimal.kurtosis() - dKurtosis) < 1e-5);
+  assert(objMoments.getMin() == *std::min_element(vecDecimals.begin(), vecDecimals.end()));
+  assert(objMoments.getMax() == *std::max_element(vecDecimals.begin(), vecDecimals.end()));
+
+  // Merged chunks and element by element streams give the same moments
+  TeracadaStatsMoments<tc_decimal> objMerged, objStreamed;
+
+  for ( tc_int iChunk = 0; iChunk < 7; iChunk++ ) {
+    TeracadaStatsMoments<tc_decimal> objChunk;
+    tc_int iBegin = (iChunk * 10000) / 7, iEnd = ((iChunk + 1) * 10000) / 7;
+
+    objChunk.add(vecDecimals.data() + iBegin, iEnd - iBegin);
+    objMerged.merge(objChunk);
+  }
+
+  for ( tc_decimal dValue : vecDecimals )
+    objStreamed.add(dValue);
+
+  for ( TeracadaStatsMoments<tc_decimal>* pobjOther : { &objMerged, &objStreamed } ) {
+    assert(pobjOther->getNumElements() == 10000 && pobjOther->getMin() == objMoments.getMin() && pobjOther->getMax() == objMoments.getMax());
+    assert(fabs(pobjOther->getMean() - objMoments.getMean()) < 1e-9 * objMoments.getMean());
+    assert(fabs(pobjOther->getVariance() - objMoments.getVariance()) < 1e-9 * objMoments.getVariance());
+    assert(fabs(pobjOther->getSkewness() - dSkewness) < 1e-9 && fabs(pobjOther->getKurtosis() - dKurtosis) < 1e-9);
+  }
+
+  // Large elements with a small spread, 1e9 + (0 .. 9): variance 8.25, skewness 0, kurtosis 120.8625 / 8.25^2 - 3
+  TeracadaArray<tc_int> objTeracadaArrayLarge(10000);
+  TeracadaStatsMoments<tc_int> objMomentsLarge;
+
+  for ( tc_int iIter = 0; iIter < 10000; iIter++ )
+    objTeracadaArrayLarge.insertBack((tc_int) 1000000000 + (iIter % 10));
+
+  bMoments = objTeracadaArrayLarge.moments(&objMomentsLarge);
+  assert(bMoments);
+  assert(objMomentsLarge.getMean() == 1000000004.5 && fabs(objMomentsLarge.getVariance() - 8.25) < 1e-9);
+  // The means of the blocks are only exact to the precision of tc_double around 1e9
+  assert(fabs(objMomentsLarge.getSkewness()) < 1e-7 && fabs(objMomentsLarge.getKurtosis() - ((120.8625 / (8.25 * 8.25)) - 3)) < 1e-7);
+
+  // Adding the elements again accumulates, the count doubles and the variance stays the same
+  bMoments = objTeracadaArrayLarge.moments(&objMomentsLarge);
+  assert(bMoments && objMomentsLarge.getNumElements() == 20000);
+  assert(fabs(objMomentsLarge.getVariance() - 8.25) < 1e-9);
+
+  // Bytes, no elements, equal elements, non numeric arrays
+  TeracadaArray<tc_byte> objTeracadaArrayByte(4);
+  TeracadaStatsMoments<tc_byte> objMomentsByte;
+
+  bMoments = objTeracadaArrayByte.moments(&objMomentsByte);
+  assert(bMoments && objMomentsByte.getNumElements() == 0);
+  assert(objMomentsByte.getVariance() < 0 && objMomentsByte.getSkewness() == 0 && objTeracadaArrayByte.kurtosis() == 0);
+
+  for ( tc_int iIter = 0; iIter < 3; iIter++ )
+    objTeracadaArrayByte.insertBack((tc_byte) 200);
+
+  bMoments = objTeracadaArrayByte.moments(&objMomentsByte);
+  assert(bMoments && objMomentsByte.getMin() == 200 && objMomentsByte.getMean() == 200);
+  assert(objMomentsByte.getVariance() == 0 && objMomentsByte.getSkewness() == 0 && objMomentsByte.getKurtosis() == 0);
+  assert(objMomentsByte.getVariance(3) < 0 && objMomentsByte.getStandardDeviation(3) < 0);
+
+  objMomentsByte.reset();
+  assert(objMomentsByte.getNumElements() == 0 && objMomentsByte.getMean() == 0);
+
+  TeracadaArray<tc_str> objTeracadaArrayString(2);
+  objTeracadaArrayString.disableExceptions();
+  objTeracadaArrayString.insertBack((tc_str) "tera");
+  assert(objTeracadaArrayString.skewness() == 0 && objTeracadaArrayString.getErrno() == ERR_TA_INVALID_DATA_TYPE);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaArrayParallelStats ( void ) {
+
+  cout << ">>> Unit testing TeracadaArray [PARALLEL_STATS]: ";
+
+  TeracadaArray<tc_decimal> objTeracadaArrayDecimal(1000000);
+  TeracadaArray<tc_int> objTeracadaArrayInt(1000000);
+
+  srand(1000000);
+
+  for ( tc_int iIter = 0; iIter < 1000000; iIter++ ) {
+    objTeracadaArrayDecimal.insertBack((tc_decimal) ((rand() % 20001) - 10000) / 8);
+    objTeracadaArrayInt.insertBack((tc_int) (rand() % 20001) - 10000);
+  }
+
+  // Serial results first, 1 thread by default
+  assert(TeracadaStats::getNumThreads() == 1 && TeracadaStats::getNumChunks(1000000) == 1);
+
+  stdTeracadaStatsSummary<tc_decimal> stSerial, stParallel;
+  TeracadaStatsMoments<tc_decimal> objSerialMoments, objParallelMoments;
+  tc_decimal dSerialMean = objTeracadaArrayDecimal.mean(), dParallelMean = 0;
+  tc_int iSerialMin = objTeracadaArrayInt.min(), iSerialMax = objTeracadaArrayInt.max();
+
+  tc_bool bSummarized = objTeracadaArrayDecimal.summarize(&stSerial);
+  tc_bool bMoments = objTeracadaArrayDecimal.moments(&objSerialMoments);
+  assert(bSummarized && bMoments);
+
+  // Small chunks so that every thread gets some, more chunks than threads
+  tc_uint32 ui32NumThreads = TeracadaStats::setNumThreads(4);
+  tc_index iMinChunkSize = TeracadaStats::setMinChunkSize(10000);
+  assert(ui32NumThreads == 4 && iMinChunkSize == 10000);
+  assert(TeracadaStats::getNumChunks(1000000) == (4 * TS_PARALLEL_CHUNKS_PER_THREAD) && TeracadaStats::getNumChunks(25000) == 2);
+  assert(TeracadaStats::getNumChunks(19999) == 1);
+
+  bSummarized = objTeracadaArrayDecimal.summarize(&stParallel);
+  bMoments = objTeracadaArrayDecimal.moments(&objParallelMoments);
+  assert(bSummarized && bMoments);
+  assert(stParallel.iNumElements == 1000000 && stParallel.tMin == stSerial.tMin && stParallel.tMax == stSerial.tMax);
+  assert(fabs(stParallel.dSum - stSerial.dSum) < 1e-6 * (1 + fabs(stSerial.dSum)));
+  assert(fabs(stParallel.dSumSquares - stSerial.dSumSquares) < 1e-9 * stSerial.dSumSquares);
+  assert(objParallelMoments.getNumElements() == 1000000 && objParallelMoments.getMin() == objSerialMoments.getMin());
+  assert(fabs(objParallelMoments.getVariance() - objSerialMoments.getVariance()) < 1e-9 * objSerialMoments.getVariance());
+  assert(fabs(objParallelMoments.getKurtosis() - objSerialMoments.getKurtosis()) < 1e-9);
+  assert(objTeracadaArrayInt.min() == iSerialMin && objTeracadaArrayInt.max() == iSerialMax);
+
+  dParallelMean = objTeracadaArrayDecimal.mean();
+  assert(fabs(dParallelMean - dSerialMean) < 1e-4);
+
+  // The chunks are merged in order: the same results run after run, and when concurrent reductions
+  // find the workers busy and reduce the chunks on their own thread
+  std::thread objThreads[4];
+  tc_decimal adMeans[4];
+
+  for ( tc_int iThread = 0; iThread < 4; iThread++ )
+    objThreads[iThread] = std::thread([&, iThread] ( void ) { adMeans[iThread] = objTeracadaArrayDecimal.mean(); });
+
+  for ( tc_int iThread = 0; iThread < 4; iThread++ ) {
+    objThreads[iThread].join();
+    assert(adMeans[iThread] == dParallelMean);
+  }
+
+  // Fewer threads stop the extra workers, more start them again
+  ui32NumThreads = TeracadaStats::setNumThreads(2);
+  assert(ui32NumThreads == 2 && objTeracadaArrayDecimal.mean() == dParallelMean);
+  ui32NumThreads = TeracadaStats::setNumThreads(3);
+  assert(ui32NumThreads == 3 && objTeracadaArrayInt.max() == iSerialMax);
+
+  ui32NumThreads = TeracadaStats::setNumThreads(0);
+  assert(ui32NumThreads >= 1 && ui32NumThreads <= TS_MAX_NUM_THREADS);
+  ui32NumThreads = TeracadaStats::setNumThreads(TS_MAX_NUM_THREADS + 1);
+  assert(ui32NumThreads == TS_MAX_NUM_THREADS);
+  iMinChunkSize = TeracadaStats::setMinChunkSize(0);
+  assert(iMinChunkSize == 1);
+
+  TeracadaStats::setNumThreads(1);
+  TeracadaStats::setMinChunkSize(TS_PARALLEL_MIN_CHUNK_SIZE);
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaStringArray ( void ) {
+
+  cout << ">>> Unit testing TeracadaStringArray [STRINGS]: ";
+
+  {
+    tca_strings objStrings(2, 8);
+    objStrings.disableExceptions();
+
+    // Both buffers grow past their initial capacity
+    tc_index iPosition = objStrings.insertBack("tera");
+    assert(iPosition == 1);
+    iPosition = objStrings.insertBack("cada");
+    assert(iPosition == 2);
+    iPosition = objStrings.insertBack("");
+    assert(iPosition == 3);
+    iPosition = objStrings.insertBack(string_view("a\0b", 3));
+    assert(iPosition == 4);
+
+    assert(objStrings.getNumElements() == 4);
+    assert(objStrings.getNumChars() == 11);
+    assert(objStrings.get(1) == "tera");
+    assert(objStrings.get(-3) == "cada");
+    assert(objStrings.get(3).empty());
+    assert(objStrings.get(4).size() == 3 && objStrings.get(4)[2] == 'b');
+    assert(! strcmp(objStrings.getCStr(2), "cada"));
+
+    // Inserts in between move the following strings
+    iPosition = objStrings.insert(2, "teracada");
+    assert(iPosition == 2);
+    iPosition = objStrings.insertFront("first");
+    assert(iPosition == 1);
+    assert(objStrings[0] == "first" && objStrings[1] == "tera" && objStrings[2] == "teracada" && objStrings[3] == "cada");
+    assert(! strcmp(objStrings.getCStr(4), "cada"));
+
+    // Inserting a string of the column itself
+    iPosition = objStrings.insertBack(objStrings.get(3));
+    assert(iPosition == 7);
+    assert(objStrings.get(-2).size() == 3 && objStrings.get(-1) == "teracada");
+    assert(objStrings.getErrno() == 0);
+
+    assert(objStrings.find("teracada") == 3);
+    assert(objStrings.find("teracada", 4) == 7);
+    assert(objStrings.find("tera") == 2);
+    assert(objStrings.find("missing") == TA_NONE_INDEX);
+
+    tc_bool bRemoved = objStrings.remove(2, 2);
+    assert(bRemoved);
+    assert(objStrings.getNumElements() == 5);
+    assert(objStrings[0] == "first" && objStrings[1] == "cada" && objStrings[2] == "");
+    bRemoved = objStrings.remove();
+    assert(bRemoved);
+    assert(objStrings.get(-1).size() == 3);
+    assert(objStrings.getNumChars() == 12);
+
+    bRemoved = objStrings.remove(3, 3);
+    assert(! bRemoved);
+    assert(objStrings.getErrno() == ERR_TA_INVALID_POSITION_OR_INDEX);
+    assert(objStrings.get(5).empty() && objStrings.getCStr(5) == nullptr);
+
+    tc_bool bShrunk = objStrings.shrinkToFit();
+    assert(bShrunk);
+    assert(objStrings.getMaxNumElements() == 4 && objStrings.getMaxNumChars() == 16);
+    assert(objStrings.get(1) == "first");
+
+    // Rejected sizes are counted as reallocation attempts too
+    tc_uint64 ui64PreReallocAttempts = TeracadaMetrics::getArrayMetrics().ui64ReallocAttempts;
+    tc_bool bReserved = objStrings.reserve(INT64_MAX);
+    assert(! bReserved && TeracadaMetrics::getArrayMetrics().ui64ReallocAttempts == (ui64PreReallocAttempts + 1));
+    assert(objStrings.getMaxNumElements() == 4);
+  }
+
+  /* Bulk append */
+
+  {
+    tca_strings objStrings(1, 1);
+    const tc_char* pcLines = "alpha\nbeta\n\ngamma";
+
+    tc_index iNumAppended = objStrings.appendBulk(pcLines, strlen(pcLines));
+    assert(iNumAppended == 4);
+    assert(objStrings.get(1) == "alpha" && objStrings.get(3) == "" && objStrings.get(4) == "gamma");
+    assert(! strcmp(objStrings.getCStr(2), "beta"));
+
+    // A trailing delimiter doesn't add an empty string
+    iNumAppended = objStrings.appendBulk("x,y,", 4, ',');
+    assert(iNumAppended == 2);
+    assert(objStrings.getNumElements() == 6 && objStrings.get(-1) == "y");
+
+    tc_index aiLengths[3] = { 3, 0, 5 };
+    iNumAppended = objStrings.appendBulk("onetwo42", aiLengths, 3);
+    assert(iNumAppended == 3);
+    assert(objStrings.get(7) == "one" && objStrings.get(8) == "" && objStrings.get(9) == "two42");
+    assert(objStrings.getOffsets()[objStrings.getNumElements()] == (objStrings.getNumChars() + objStrings.getNumElements()));
+
+    // Scan of the raw buffers
+    tc_uint64 ui64TotalLength = 0;
+
+    for ( tc_index iIndex = 0; iIndex < objStrings.getNumElements(); iIndex++ )
+      ui64TotalLength += objStrings[iIndex].size();
+
+    assert(ui64TotalLength == objStrings.getNumChars());
+
+    tca_strings objMoved(std::move(objStrings));
+    assert(! objStrings.isInitSuccess() && objMoved.getNumElements() == 9);
+
+    tc_bool bReset = objMoved.reset();
+    assert(bReset);
+    assert(objMoved.getNumElements() == 0 && objMoved.getNumChars() == 0);
+    tc_index iPosition = objMoved.insertBack("again");
+    assert(iPosition == 1);
+  }
+
+  /* Allocator */
+
+  {
+    TeracadaArenaAllocator objArena;
+
+    {
+      tca_strings objStrings(1000, 0, &objArena);
+
+      for ( tc_int iIter = 0; iIter < 10000; iIter++ )
+        objStrings.insertBack(to_string(iIter));
+
+      assert(objStrings.get(10000) == "9999");
+    }
+
+    assert(objArena.getStats().ui64NumAllocs == 2);
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaStringPool ( void ) {
+
+  cout << ">>> Unit testing TeracadaStringPool [INTERNING]: ";
+
+  {
+    TeracadaStringPool objPool(4, nullptr, 256);
+    objPool.disableExceptions();
+
+    tc_index iId = objPool.intern("red");
+    assert(iId == 0);
+    iId = objPool.intern("green");
+    assert(iId == 1);
+    iId = objPool.intern("red");
+    assert(iId == 0);
+    iId = objPool.intern(string("gre") + "en");
+    assert(iId == 1);
+    iId = objPool.intern("");
+    assert(iId == 2);
+    iId = objPool.intern(string_view("a\0b", 3));
+    assert(iId == 3);
+    iId = objPool.intern(string_view("a\0c", 3));
+    assert(iId == 4);
+
+    assert(objPool.find("green") == 1 && objPool.find("blue") == TA_NONE_INDEX);
+    assert(objPool.get(1) == "green" && objPool.get(2).empty() && objPool.get(99).empty());
+    assert(! strcmp(objPool.getCStr(0), "red") && objPool.getCStr(-1) == nullptr);
+
+    // Interned copies are stable, equal strings share one copy
+    const tc_char* pcRed = objPool.internCStr("red");
+    assert(pcRed == objPool.getCStr(0));
+
+    // Grows the entries, the hash table and the blocks (including own blocks for large strings)
+    string strLarge(1000, 'x');
+    iId = objPool.intern(strLarge);
+    assert(iId == 5);
+
+    for ( tc_int iIter = 0; iIter < 10000; iIter++ ) {
+      iId = objPool.intern("value-" + to_string(iIter % 1000));
+      assert(iId == (6 + (iIter % 1000)));
+    }
+
+    assert(objPool.getNumElements() == 1006);
+    assert(objPool.getCStr(0) == pcRed && ! strcmp(pcRed, "red"));
+    assert(objPool.get(5) == strLarge);
+    iId = objPool.intern(strLarge);
+    assert(iId == 5);
+
+    stdTeracadaStringPoolStats stStats = objPool.getStats();
+    assert(stStats.ui64NumInterns == 10010 && stStats.ui64NumHits == (10010 - 1006));
+    assert(stStats.ui64NumStrings == 1006);
+    assert(stStats.ui64BytesSaved > stStats.ui64StoredBytes);
+    assert(objPool.getHitRate() > 0.89 && objPool.getHitRate() < 0.91);
+
+    objPool.resetStats();
+    assert(objPool.getStats().ui64NumHits == 0 && objPool.getStats().ui64NumStrings == 1006);
+  }
+
+  /* TeracadaArray<tc_str> of interned strings, compared by pointer */
+
+  {
+    TeracadaStringPool objPool;
+    tca_str objLabels(10);
+
+    const tc_char* apcLabels[3] = { "low", "medium", "high" };
+
+    for ( tc_int iIter = 0; iIter < 300; iIter++ )
+      objLabels.insertBack((tc_str) objPool.internCStr(apcLabels[iIter % 3]));
+
+    const tc_char* pcHigh = objPool.internCStr("high");
+    tc_int iNumHigh = 0;
+
+    for ( tc_str pcLabel : objLabels.view() )
+      iNumHigh += (pcLabel == pcHigh);
+
+    assert(iNumHigh == 100);
+    assert(objPool.getNumElements() == 3);
+  }
+
+  /* Dict keys */
+
+  {
+    TeracadaDict objDict;
+    tc_char acId[] = "id", acName[] = "name", acScore[] = "score", acMissing[] = "missing";
+    tc_char acRecord[] = "record";
+
+    for ( tc_int iIter = 0; iIter < 10; iIter++ ) {
+      tc_dict ptcdRecord = objDict.update<tc_int, tc_int>(iIter, iIter);
+
+      objDict.update<tc_str, tc_int>(ptcdRecord, acId, iIter);
+      objDict.update<tc_str, tc_str>(ptcdRecord, acName, acRecord);
+      objDict.update<tc_str, tc_decimal>(ptcdRecord, acScore, (tc_decimal) iIter / 4);
+
+      assert(*(tc_int*) objDict.get<tc_str>(acId, ptcdRecord) == iIter);
+      assert(! strcmp((tc_str) objDict.get<tc_str>(acName, ptcdRecord), "record"));
+      assert(objDict.get<tc_str>(acMissing, ptcdRecord) == nullptr);
+    }
+
+    assert(objDict.getKeyPool()->getNumElements() == 3);
+    assert(objDict.getKeyPool()->getStats().ui64NumHits == 27);
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaCategoricalArray ( void ) {
+
+  cout << ">>> Unit testing TeracadaCategoricalArray [CATEGORICAL]: ";
+
+  {
+    tca_categorical objLabels(4);
+    objLabels.disableExceptions();
+
+    const tc_char* apcLevels[3] = { "low", "medium", "high" };
+
+    for ( tc_int iIter = 0; iIter < 300; iIter++ ) {
+      tc_index iPosition = objLabels.insertBack(apcLevels[(iIter * iIter) % 3]);
+      assert(iPosition == (iIter + 1));
+    }
+
+    assert(objLabels.getNumElements() == 300 && objLabels.getNumCategories() == 2);
+    assert(objLabels.getCodeSize() == 1 && objLabels.getByteCodes() && ! objLabels.getIntCodes());
+
+    // (i * i) % 3 is 0 for every third i, 1 otherwise
+    assert(objLabels.countEqual("low") == 100 && objLabels.countEqual("medium") == 200);
+    assert(objLabels.countEqual("high") == 0 && objLabels.getCode("high") == TA_NONE_INDEX);
+
+    assert(objLabels.get(1) == "low" && objLabels.get(2) == "medium" && objLabels.get(-1) == "medium");
+    assert(objLabels.getCodeAt(4) == 0 && objLabels.getCodeAt(301) == TA_NONE_INDEX);
+
+    tca_int objPositions(1);
+    objPositions.disableExceptions();
+
+    tc_index iNumMatches = objLabels.filterEqual("low", &objPositions);
+    assert(iNumMatches == 100);
+    assert(objPositions.getNumElements() == 100 && objPositions[0] == 1 && objPositions[1] == 4 && objPositions[99] == 298);
+    iNumMatches = objLabels.filterEqual("high", &objPositions);
+    assert(iNumMatches == 0 && objPositions.getNumElements() == 0);
+
+    tca_int objCounts(1);
+    tc_bool bCounted = objLabels.groupCount(&objCounts);
+    assert(bCounted);
+    assert(objCounts.getNumElements() == 2 && objCounts[0] == 100 && objCounts[1] == 200);
+
+    tc_index iPosition = objLabels.insert(1, "high");
+    assert(iPosition == 1);
+    assert(objLabels.get(1) == "high" && objLabels.get(2) == "low" && objLabels.getNumCategories() == 3);
+
+    tc_bool bRemoved = objLabels.remove(1, 2);
+    assert(bRemoved);
+    assert(objLabels.get(1) == "medium" && objLabels.countEqual("high") == 0 && objLabels.getNumCategories() == 3);
+  }
+
+  /* Codes widened past TC_CATEGORICAL_MAX_BYTE_CATEGORIES categories */
+
+  {
+    tca_categorical objLabels(10);
+    tca_str objStrings(10);
+
+    for ( tc_int iIter = 0; iIter < 1000; iIter++ )
+      objLabels.insertBack("label-" + to_string(iIter % 300));
+
+    assert(objLabels.getNumCategories() == 300 && objLabels.getCodeSize() == sizeof(tc_int));
+    assert(! objLabels.getByteCodes() && objLabels.getIntCodes()->getNumElements() == 1000);
+    assert(objLabels.get(1) == "label-0" && objLabels.get(256) == "label-255" && objLabels.get(1000) == "label-99");
+    assert(objLabels.countEqual("label-299") == 3 && objLabels.countEqual("label-0") == 4);
+
+    tca_int objCounts(1);
+    tc_bool bCounted = objLabels.groupCount(&objCounts);
+    assert(bCounted && objCounts.getNumElements() == 300);
+    assert(objCounts[0] == 4 && objCounts[299] == 3);
+
+    // Encoding an existing string array
+    objStrings.insertBack((tc_str) "label-0");
+    objStrings.insertBack((tc_str) "new");
+
+    tc_index iNumAppended = objLabels.appendStrings(objStrings);
+    assert(iNumAppended == 2);
+    assert(objLabels.countEqual("label-0") == 5 && objLabels.getNumCategories() == 301);
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
 void unitTestsTeracadaDict ( void ) {
   tc_dict ptcdNode = nullptr;
   TeracadaDict objDict;
+  tc_char acKey1[] = "key1", acKey2[] = "key2", acKey3[] = "key3";
+  tc_char acValue1[] = "value1", acValue2[] = "value2";
 
-  objDict.update<tc_str, tc_str>("key1", "value1");
-  objDict.update<tc_str, tc_str>("key2", "value2");
-  objDict.update<tc_str, tc_int>("key3", 5);
+  objDict.update<tc_str, tc_str>(acKey1, acValue1);
+  objDict.update<tc_str, tc_str>(acKey2, acValue2);
+  objDict.update<tc_str, tc_int>(acKey3, 5);
 
-  printf("\n\n\n %s: %d", "key3", *((tc_int*) objDict.get<tc_str>("key3")));
+  printf("\n\n\n %s: %d", acKey3, *((tc_int*) objDict.get<tc_str>(acKey3)));
 }
 
 
@@ -275,6 +2116,60 @@ int main () {
   // UnitTestsTeracadaArrayTypeString();
   // cout << endl << endl;
 
+  UnitTestsTeracadaArrayResizeGrowth();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayMetrics();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayShift();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayStorageModes();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayDeque();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayRing();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayView();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayOwnership();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayLargeSizes();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayZeroFill();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayAllocators();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayStats();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayArgStats();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayMoments();
+  cout << endl << endl;
+
+  UnitTestsTeracadaArrayParallelStats();
+  cout << endl << endl;
+
+  UnitTestsTeracadaStringArray();
+  cout << endl << endl;
+
+  UnitTestsTeracadaStringPool();
+  cout << endl << endl;
+
+  UnitTestsTeracadaCategoricalArray();
+  cout << endl << endl;
+
   unitTestsTeracadaDict();
 
   return 0;
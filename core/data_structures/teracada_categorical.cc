@@ -0,0 +1,388 @@
+/*!
+  @file
+
+  @brief
+    Implementation of TeracadaCategoricalArray, the dictionary encoded string column
+*/
+
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include "teracada_categorical.h"
+
+
+/*!
+  @brief
+    The class constructor.
+
+  @param[in]
+    iNumElements The number of values the code column can hold before it grows, the default is 100
+
+  @param[in]
+    pobjAllocator The allocator of the code column and the categories (see teracada_allocator.h), it has to outlive the column,
+    the process-wide heap allocator (TeracadaAllocator::getDefault()) is used when it is nullptr
+
+  @par Examples
+    @code{.cpp}
+    TeracadaCategoricalArray objLabels(1000000);
+    objLabels.insertBack("low");
+    objLabels.countEqual("low");
+    @endcode
+
+  @par Errors/Exceptions
+    - ERR_TA_MEMALLOC_FAILED
+    - ERR_TA_INIT_FAILED
+*/
+TeracadaCategoricalArray::TeracadaCategoricalArray ( tc_index iNumElements, TeracadaAllocator* pobjAllocator ) :
+  m_pobjCategories(nullptr),
+  m_ptcaByteCodes(nullptr),
+  m_ptcaIntCodes(nullptr),
+  m_pobjAllocator(pobjAllocator ? pobjAllocator : TeracadaAllocator::getDefault()),
+  m_bEnableExceptions(true)
+{
+  // Owned by the guard until the code column is allocated, so the pool is not leaked if that throws
+  std::unique_ptr<TeracadaStringPool> pobjCategories(new TeracadaStringPool(TC_CATEGORICAL_MAX_BYTE_CATEGORIES, m_pobjAllocator));
+
+  m_ptcaByteCodes = new tca_byte(iNumElements, false, m_pobjAllocator);
+  m_pobjCategories = pobjCategories.release();
+
+  // The column is mostly appended to
+  m_ptcaByteCodes->setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
+
+  if ( ! isInitSuccess() )
+    TC_LOG(LOG_ERR, "TeracadaCategoricalArray::TeracadaCategoricalArray(): Failed to initialize the column [ NUM_ELEMENTS: %ld ]", iNumElements);
+}
+
+
+TeracadaCategoricalArray::~TeracadaCategoricalArray ( void ) {
+  delete m_ptcaByteCodes;
+  delete m_ptcaIntCodes;
+  delete m_pobjCategories;
+}
+
+
+tc_uint64 TeracadaCategoricalArray::getArraySize ( void ) const {
+  tc_uint64 ui64Bytes = m_pobjCategories->getStats().ui64TotalBytes;
+
+  if ( m_ptcaIntCodes )
+    return ui64Bytes + m_ptcaIntCodes->getArraySize();
+
+  return ui64Bytes + m_ptcaByteCodes->getArraySize();
+}
+
+
+// First error of the code column or the categories, 0 if none
+tc_int TeracadaCategoricalArray::getErrno ( void ) const {
+  tc_int iErrno = m_ptcaIntCodes ? m_ptcaIntCodes->getErrno() : m_ptcaByteCodes->getErrno();
+
+  return iErrno ? iErrno : m_pobjCategories->getErrno();
+}
+
+
+tc_void TeracadaCategoricalArray::enableExceptions ( void ) {
+  m_bEnableExceptions = true;
+
+  m_pobjCategories->enableExceptions();
+
+  if ( m_ptcaIntCodes )
+    m_ptcaIntCodes->enableExceptions();
+  else
+    m_ptcaByteCodes->enableExceptions();
+}
+
+
+tc_void TeracadaCategoricalArray::disableExceptions ( void ) {
+  m_bEnableExceptions = false;
+
+  m_pobjCategories->disableExceptions();
+
+  if ( m_ptcaIntCodes )
+    m_ptcaIntCodes->disableExceptions();
+  else
+    m_ptcaByteCodes->disableExceptions();
+}
+
+
+/*
+  Replace the tca_byte codes with tca_int codes, once the categories don't fit the byte codes anymore.
+  The byte codes are kept on failure.
+*/
+tc_bool TeracadaCategoricalArray::widenCodes ( void ) {
+  tc_index iNumElements = m_ptcaByteCodes->getNumElements();
+  tca_int* ptcaIntCodes = nullptr;
+
+  try {
+    ptcaIntCodes = new tca_int(std::max<tc_index>(m_ptcaByteCodes->getMaxNumElements(), 1), false, m_pobjAllocator);
+  } catch ( TeracadaException& objException ) {
+    ptcaIntCodes = nullptr;
+  }
+
+  if ( ! ptcaIntCodes || ! ptcaIntCodes->isInitSuccess() ) {
+    TC_LOG(LOG_ERR, "TeracadaCategoricalArray::widenCodes(): Failed to allocate the tca_int codes [ NUM_ELEMENTS: %ld ]", iNumElements);
+    delete ptcaIntCodes;
+    return false;
+  }
+
+  if ( ! m_bEnableExceptions )
+    ptcaIntCodes->disableExceptions();
+
+  ptcaIntCodes->setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
+
+  const tc_byte* pb8Codes = m_ptcaByteCodes->data();
+  tc_int* piCodes = ptcaIntCodes->data();
+
+  for ( tc_index iIndex = 0; iIndex < iNumElements; iIndex++ )
+    piCodes[iIndex] = pb8Codes[iIndex];
+
+  ptcaIntCodes->setNumElements(iNumElements);
+
+  TC_LOG(LOG_INFO, "TeracadaCategoricalArray::widenCodes(): Widened the codes to tca_int [ NUM_ELEMENTS: %ld | NUM_CATEGORIES: %ld ]", iNumElements, getNumCategories());
+
+  delete m_ptcaByteCodes;
+  m_ptcaByteCodes = nullptr;
+  m_ptcaIntCodes = ptcaIntCodes;
+
+  return true;
+}
+
+
+/*!
+  @brief
+    Insert a value, adding it to the categories if it is a new one
+
+  @param[in]
+    iPosition The position to insert the value at
+
+  @param[in]
+    svValue The value
+
+  @retval
+    iPosition On success, the position (from start/left) of the inserted value
+
+  @retval
+    -1 On failure
+
+  @note
+    The codes are widened to tca_int (a copy of the whole code column) when the value is category number
+    TC_CATEGORICAL_MAX_BYTE_CATEGORIES + 1.
+*/
+tc_index TeracadaCategoricalArray::insert ( tc_index iPosition, std::string_view svValue ) {
+  tc_index iCode = m_pobjCategories->intern(svValue);
+
+  if ( iCode < 0 )
+    return TA_NONE_INDEX;
+
+  if ( ! m_ptcaIntCodes && iCode >= TC_CATEGORICAL_MAX_BYTE_CATEGORIES ) {
+    if ( ! widenCodes() )
+      return TA_NONE_INDEX;
+  }
+
+  if ( m_ptcaIntCodes )
+    return m_ptcaIntCodes->insert(iPosition, (tc_int) iCode);
+
+  return m_ptcaByteCodes->insert(iPosition, (tc_byte) iCode);
+}
+
+
+// Encode all the strings of the array, returns the number of values inserted (TA_NONE_INDEX on failure)
+tc_index TeracadaCategoricalArray::appendStrings ( TeracadaArray<tc_str>& objStrings ) {
+  tc_index iNumInserted = 0;
+
+  for ( tc_str pcString : objStrings.view() ) {
+    if ( insertBack(pcString ? std::string_view(pcString) : std::string_view()) < 0 )
+      return TA_NONE_INDEX;
+
+    iNumInserted++;
+  }
+
+  return iNumInserted;
+}
+
+
+tc_index TeracadaCategoricalArray::appendStrings ( TeracadaStringArray& objStrings ) {
+  for ( tc_index iIndex = 0; iIndex < objStrings.getNumElements(); iIndex++ ) {
+    if ( insertBack(objStrings[iIndex]) < 0 )
+      return TA_NONE_INDEX;
+  }
+
+  return objStrings.getNumElements();
+}
+
+
+// The categories are kept, even when no value of a category is left
+tc_bool TeracadaCategoricalArray::remove ( tc_index iPosition, tc_index iNumElements ) {
+  if ( m_ptcaIntCodes )
+    return m_ptcaIntCodes->remove(iPosition, iNumElements);
+
+  return m_ptcaByteCodes->remove(iPosition, iNumElements);
+}
+
+
+// Code of the value at a position, TA_NONE_INDEX on failure
+tc_index TeracadaCategoricalArray::getCodeAt ( tc_index iPosition ) {
+  tc_void* pvCode = m_ptcaIntCodes ? m_ptcaIntCodes->get(iPosition) : m_ptcaByteCodes->get(iPosition);
+
+  if ( ! pvCode )
+    return TA_NONE_INDEX;
+
+  return m_ptcaIntCodes ? (tc_index) *((tc_int*) pvCode) : (tc_index) *((tc_byte*) pvCode);
+}
+
+
+// Value at a position, empty view on failure (the view stays valid for the lifetime of the column)
+std::string_view TeracadaCategoricalArray::get ( tc_index iPosition ) {
+  return m_pobjCategories->get(getCodeAt(iPosition));
+}
+
+
+template <typename tDataType>
+tc_index TeracadaCategoricalArray::countCode ( TeracadaArray<tDataType>* ptcaCodes, tc_index iCode ) const {
+  tDataType tCode = (tDataType) iCode;
+  tc_index iCount = 0;
+
+  for ( tDataType tValue : ptcaCodes->view() )
+    iCount += (tValue == tCode);
+
+  return iCount;
+}
+
+
+template <typename tDataType>
+tc_index TeracadaCategoricalArray::filterCode ( TeracadaArray<tDataType>* ptcaCodes, tc_index iCode, tca_int* ptcaPositions ) const {
+  TeracadaArrayView<tDataType> objCodes = ptcaCodes->view();
+  tDataType tCode = (tDataType) iCode;
+  tc_index iCount = countCode(ptcaCodes, iCode);
+  tc_int* piPositions = nullptr;
+
+  // Sized once by a counting pass, the positions are then written without any check
+  ptcaPositions->reset();
+
+  if ( iCount == 0 )
+    return 0;
+
+  if ( ! ptcaPositions->reserve(iCount) )
+    return TA_NONE_INDEX;
+
+  piPositions = ptcaPositions->data();
+
+  for ( tc_index iIndex = 0; iIndex < objCodes.size(); iIndex++ ) {
+    if ( objCodes[iIndex] == tCode )
+      *piPositions++ = (tc_int) (iIndex + 1);
+  }
+
+  ptcaPositions->setNumElements(iCount);
+
+  return iCount;
+}
+
+
+template <typename tDataType>
+tc_void TeracadaCategoricalArray::countCodes ( TeracadaArray<tDataType>* ptcaCodes, tc_int* piCounts ) const {
+  for ( tDataType tValue : ptcaCodes->view() )
+    piCounts[tValue]++;
+}
+
+
+// Number of values equal to the value, 0 if it is not a category of the column
+tc_index TeracadaCategoricalArray::countEqual ( std::string_view svValue ) {
+  tc_index iCode = getCode(svValue);
+
+  if ( iCode < 0 )
+    return 0;
+
+  return m_ptcaIntCodes ? countCode(m_ptcaIntCodes, iCode) : countCode(m_ptcaByteCodes, iCode);
+}
+
+
+/*!
+  @brief
+    Positions of the values equal to a value
+
+  @param[in]
+    svValue The value
+
+  @param[out]
+    ptcaPositions The array the positions are written to, in increasing order (it is reset first)
+
+  @retval
+    NumPositions The number of positions written
+
+  @retval
+    -1 On failure
+*/
+tc_index TeracadaCategoricalArray::filterEqual ( std::string_view svValue, tca_int* ptcaPositions ) {
+  tc_index iCode = getCode(svValue);
+
+  if ( ! ptcaPositions || ! ptcaPositions->isInitSuccess() ) {
+    TC_LOG(LOG_ERR, "TeracadaCategoricalArray::filterEqual(): Invalid positions array");
+    return TA_NONE_INDEX;
+  }
+
+  if ( iCode < 0 ) {
+    ptcaPositions->reset();
+    return 0;
+  }
+
+  return m_ptcaIntCodes ? filterCode(m_ptcaIntCodes, iCode, ptcaPositions) : filterCode(m_ptcaByteCodes, iCode, ptcaPositions);
+}
+
+
+/*!
+  @brief
+    Count the values of every category (group-by count)
+
+  @param[out]
+    ptcaCounts The array the counts are written to, the count of the category with code c at index c
+    (position c + 1), getNumCategories() counts in total (it is reset first)
+
+  @retval
+    true Successfully counted the values
+
+  @retval
+    false Failed to size the counts array
+*/
+tc_bool TeracadaCategoricalArray::groupCount ( tca_int* ptcaCounts ) {
+  tc_index iNumCategories = getNumCategories();
+
+  if ( ! ptcaCounts || ! ptcaCounts->isInitSuccess() ) {
+    TC_LOG(LOG_ERR, "TeracadaCategoricalArray::groupCount(): Invalid counts array");
+    return false;
+  }
+
+  ptcaCounts->reset();
+
+  if ( iNumCategories == 0 )
+    return true;
+
+  if ( ! ptcaCounts->reserve(iNumCategories) )
+    return false;
+
+  memset(ptcaCounts->data(), 0, (iNumCategories * sizeof(tc_int)));
+
+  if ( m_ptcaIntCodes )
+    countCodes(m_ptcaIntCodes, ptcaCounts->data());
+  else
+    countCodes(m_ptcaByteCodes, ptcaCounts->data());
+
+  ptcaCounts->setNumElements(iNumCategories);
+
+  return true;
+}
+
+
+tc_void TeracadaCategoricalArray::print ( void ) {
+  if ( ! isInitSuccess() )
+    return;
+
+  printf("categorical([ ");
+
+  for ( tc_index iPosition = 1; iPosition <= getNumElements(); iPosition++ ) {
+    std::string_view svValue = get(iPosition);
+    printf("%.*s ", (tc_int32) svValue.size(), svValue.data());
+  }
+
+  printf("] categories: %ld)\n", getNumCategories());
+  fflush(stdout);
+}
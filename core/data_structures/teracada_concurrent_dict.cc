@@ -0,0 +1,185 @@
+#include <new>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <type_traits>
+
+#include <teracada_concurrent_dict.h>
+
+
+// splitmix64 finalizer, the tc_int keys are often dense and would fill the shards unevenly otherwise
+static tc_uint64 mixKey ( tc_uint64 ui64Key ) {
+  ui64Key = (ui64Key ^ (ui64Key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  ui64Key = (ui64Key ^ (ui64Key >> 27)) * 0x94d049bb133111ebULL;
+
+  return (ui64Key ^ (ui64Key >> 31));
+}
+
+
+TeracadaConcurrentDict::TeracadaConcurrentDict ( tc_uint32 ui32NumShards, TeracadaAllocator* pobjAllocator ) :
+  m_pstShards(nullptr),
+  m_ui32NumShards(1),
+  m_pobjAllocator(pobjAllocator ? pobjAllocator : TeracadaAllocator::getDefault())
+{
+  while ( m_ui32NumShards < ui32NumShards && m_ui32NumShards < TD_CONCURRENT_MAX_NUM_SHARDS )
+    m_ui32NumShards *= 2;
+
+  m_pstShards = new (std::nothrow) stdDictShard[m_ui32NumShards];
+
+  if ( ! m_pstShards ) {
+    TC_LOG(LOG_ERR, "TeracadaConcurrentDict::TeracadaConcurrentDict(): Failed to allocate the shards [ NUM_SHARDS: %u ]", m_ui32NumShards);
+    return;
+  }
+
+  for ( tc_uint32 ui32Shard = 0; ui32Shard < m_ui32NumShards; ui32Shard++ )
+    m_pstShards[ui32Shard].ptdDict = new TeracadaDict(m_pobjAllocator, (tc_byte) ui32Shard);
+}
+
+
+TeracadaConcurrentDict::~TeracadaConcurrentDict ( void ) {
+  if ( ! m_pstShards )
+    return;
+
+  for ( tc_uint32 ui32Shard = 0; ui32Shard < m_ui32NumShards; ui32Shard++ )
+    delete m_pstShards[ui32Shard].ptdDict;
+
+  delete[] m_pstShards;
+}
+
+
+// Shard of a top level key
+template <typename tDataType>
+TeracadaConcurrentDict::stdDictShard& TeracadaConcurrentDict::getKeyShard ( tDataType tKey ) {
+  tc_uint64 ui64Hash = 0;
+
+  if constexpr ( std::is_same_v<tDataType, tc_int> )
+    ui64Hash = mixKey((tc_uint64) (tc_int64) tKey);
+
+  if constexpr ( std::is_same_v<tDataType, tc_decimal> )
+    ui64Hash = mixKey(TeracadaDictIndex::decimalKey(tKey));
+
+  if constexpr ( std::is_same_v<tDataType, tc_str> )
+    ui64Hash = mixKey(std::hash<std::string_view>()(std::string_view(tKey)));
+
+  return m_pstShards[ui64Hash & (m_ui32NumShards - 1)];
+}
+
+
+template <typename tDataTypeKey, typename tDataTypeVal>
+tc_dict TeracadaConcurrentDict::update ( tDataTypeKey tKey, tDataTypeVal tValue ) {
+  stdDictShard& stShard = getKeyShard(tKey);
+  std::unique_lock<std::shared_mutex> objLock(stShard.mtxLock);
+
+  return stShard.ptdDict->update(tKey, tValue);
+}
+
+template tc_dict TeracadaConcurrentDict::update<tc_int, tc_int> ( tc_int tKey, tc_int tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_int, tc_decimal> ( tc_int tKey, tc_decimal tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_int, tc_str> ( tc_int tKey, tc_str tValue );
+
+template tc_dict TeracadaConcurrentDict::update<tc_decimal, tc_int> ( tc_decimal tKey, tc_int tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_decimal, tc_decimal> ( tc_decimal tKey, tc_decimal tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_decimal, tc_str> ( tc_decimal tKey, tc_str tValue );
+
+template tc_dict TeracadaConcurrentDict::update<tc_str, tc_int> ( tc_str tKey, tc_int tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_str, tc_decimal> ( tc_str tKey, tc_decimal tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_str, tc_str> ( tc_str tKey, tc_str tValue );
+
+
+template <typename tDataTypeKey, typename tDataTypeVal>
+tc_dict TeracadaConcurrentDict::update ( tc_dict ptcdParentNode, tDataTypeKey tKey, tDataTypeVal tValue ) {
+  stdDictShard& stShard = getNodeShard(ptcdParentNode);
+  std::unique_lock<std::shared_mutex> objLock(stShard.mtxLock);
+
+  return stShard.ptdDict->update(ptcdParentNode, tKey, tValue);
+}
+
+template tc_dict TeracadaConcurrentDict::update<tc_int, tc_int> ( tc_dict ptcdParentNode, tc_int tKey, tc_int tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_int, tc_decimal> ( tc_dict ptcdParentNode, tc_int tKey, tc_decimal tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_int, tc_str> ( tc_dict ptcdParentNode, tc_int tKey, tc_str tValue );
+
+template tc_dict TeracadaConcurrentDict::update<tc_decimal, tc_int> ( tc_dict ptcdParentNode, tc_decimal tKey, tc_int tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_decimal, tc_decimal> ( tc_dict ptcdParentNode, tc_decimal tKey, tc_decimal tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_decimal, tc_str> ( tc_dict ptcdParentNode, tc_decimal tKey, tc_str tValue );
+
+template tc_dict TeracadaConcurrentDict::update<tc_str, tc_int> ( tc_dict ptcdParentNode, tc_str tKey, tc_int tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_str, tc_decimal> ( tc_dict ptcdParentNode, tc_str tKey, tc_decimal tValue );
+template tc_dict TeracadaConcurrentDict::update<tc_str, tc_str> ( tc_dict ptcdParentNode, tc_str tKey, tc_str tValue );
+
+
+template <typename tDataTypeKey, typename tDataTypeVal>
+tc_bool TeracadaConcurrentDict::get ( tDataTypeKey tKey, tDataTypeVal* ptValue, tc_dict ptcdParentNode ) {
+  stdDictShard& stShard = ptcdParentNode ? getNodeShard(ptcdParentNode) : getKeyShard(tKey);
+  std::shared_lock<std::shared_mutex> objLock(stShard.mtxLock);
+
+  tc_dict ptcdNode = stShard.ptdDict->find(tKey, ptcdParentNode);
+
+  if ( ! ptcdNode )
+    return false;
+
+  if constexpr ( std::is_same_v<tDataTypeVal, tc_int> ) {
+    if ( ptcdNode->b8DataTypeVal != TC_INT )
+      return false;
+
+    *ptValue = ptcdNode->unVal.iInt;
+  }
+
+  if constexpr ( std::is_same_v<tDataTypeVal, tc_decimal> ) {
+    if ( ptcdNode->b8DataTypeVal != TC_DECIMAL )
+      return false;
+
+    *ptValue = ptcdNode->unVal.dDecimal;
+  }
+
+  if constexpr ( std::is_same_v<tDataTypeVal, std::string> ) {
+    if ( ptcdNode->b8DataTypeVal != TC_STRING )
+      return false;
+
+    ptValue->assign((const tc_char*) stShard.ptdDict->getNodeValue(ptcdNode));
+  }
+
+  return true;
+}
+
+template tc_bool TeracadaConcurrentDict::get<tc_int, tc_int> ( tc_int tKey, tc_int* ptValue, tc_dict ptcdParentNode );
+template tc_bool TeracadaConcurrentDict::get<tc_int, tc_decimal> ( tc_int tKey, tc_decimal* ptValue, tc_dict ptcdParentNode );
+template tc_bool TeracadaConcurrentDict::get<tc_int, std::string> ( tc_int tKey, std::string* ptValue, tc_dict ptcdParentNode );
+
+template tc_bool TeracadaConcurrentDict::get<tc_decimal, tc_int> ( tc_decimal tKey, tc_int* ptValue, tc_dict ptcdParentNode );
+template tc_bool TeracadaConcurrentDict::get<tc_decimal, tc_decimal> ( tc_decimal tKey, tc_decimal* ptValue, tc_dict ptcdParentNode );
+template tc_bool TeracadaConcurrentDict::get<tc_decimal, std::string> ( tc_decimal tKey, std::string* ptValue, tc_dict ptcdParentNode );
+
+template tc_bool TeracadaConcurrentDict::get<tc_str, tc_int> ( tc_str tKey, tc_int* ptValue, tc_dict ptcdParentNode );
+template tc_bool TeracadaConcurrentDict::get<tc_str, tc_decimal> ( tc_str tKey, tc_decimal* ptValue, tc_dict ptcdParentNode );
+template tc_bool TeracadaConcurrentDict::get<tc_str, std::string> ( tc_str tKey, std::string* ptValue, tc_dict ptcdParentNode );
+
+
+template <typename tDataType>
+tc_dict TeracadaConcurrentDict::find ( tDataType tKey, tc_dict ptcdParentNode ) {
+  stdDictShard& stShard = ptcdParentNode ? getNodeShard(ptcdParentNode) : getKeyShard(tKey);
+  std::shared_lock<std::shared_mutex> objLock(stShard.mtxLock);
+
+  return stShard.ptdDict->find(tKey, ptcdParentNode);
+}
+
+template tc_dict TeracadaConcurrentDict::find<tc_int> ( tc_int tKey, tc_dict ptcdParentNode );
+
+template tc_dict TeracadaConcurrentDict::find<tc_decimal> ( tc_decimal tKey, tc_dict ptcdParentNode );
+
+template tc_dict TeracadaConcurrentDict::find<tc_str> ( tc_str tKey, tc_dict ptcdParentNode );
+
+
+template <typename tDataType>
+tc_bool TeracadaConcurrentDict::erase ( tDataType tKey, tc_dict ptcdParentNode ) {
+  stdDictShard& stShard = ptcdParentNode ? getNodeShard(ptcdParentNode) : getKeyShard(tKey);
+  std::unique_lock<std::shared_mutex> objLock(stShard.mtxLock);
+
+  return stShard.ptdDict->erase(tKey, ptcdParentNode);
+}
+
+template tc_bool TeracadaConcurrentDict::erase<tc_int> ( tc_int tKey, tc_dict ptcdParentNode );
+
+template tc_bool TeracadaConcurrentDict::erase<tc_decimal> ( tc_decimal tKey, tc_dict ptcdParentNode );
+
+template tc_bool TeracadaConcurrentDict::erase<tc_str> ( tc_str tKey, tc_dict ptcdParentNode );
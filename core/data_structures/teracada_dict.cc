@@ -1,104 +1,641 @@
+#include <algorithm>
 #include <type_traits>
+#include <new>
 
 #include <stdio.h>
+#include <string.h>
 
 #include <teracada_dict.h>
 
 
-TeracadaDict::TeracadaDict ( void ) :
+static_assert(sizeof(stdTeracadaDictNode) == TD_NODE_SIZE, "TeracadaDict nodes have to fit a single cache line");
+
+
+TeracadaDict::TeracadaDict ( TeracadaAllocator* pobjAllocator, tc_byte b8Shard ) :
   m_ptcaDictRoot(nullptr),
-  m_ptcaInt(nullptr),
-  m_ptcaDecimal(nullptr),
-  m_ptcaString(nullptr)
+  m_ptcaString(nullptr),
+  m_pstNodeSlab(nullptr),
+  m_ui64NumSlabNodesUsed(0),
+  m_ptcdFreeNodes(nullptr),
+  m_pobjKeyPool(nullptr),
+  m_iNumStringKeys(0),
+  m_iNumDeadKeys(0),
+  m_pobjAllocator(pobjAllocator ? pobjAllocator : TeracadaAllocator::getDefault()),
+  m_pobjRootIndex(nullptr),
+  m_bEnableIndex(true),
+  m_bEnableOrderedIndex(false),
+  m_iNumDeadStrings(0),
+  m_bEnableAutoCompact(true),
+  m_b8Shard(b8Shard)
 {
-  m_ptcaDictRoot = new TeracadaArray<tc_dict>(10);
-  m_ptcaInt = new TeracadaArray<tc_int>(10);
-  m_ptcaDecimal = new TeracadaArray<tc_decimal>(10);
-  m_ptcaString = new TeracadaArray<tc_str>(10);
+  m_ptcaDictRoot = new TeracadaArray<tc_dict>(10, true, m_pobjAllocator);
+  m_ptcaString = new TeracadaStringArray(10, 0, m_pobjAllocator);
+  m_pobjKeyPool = new TeracadaStringPool(64, m_pobjAllocator);
+
+  // The root level only grows, geometric growth keeps the reallocations (and the copies left behind in an arena) logarithmic
+  // The string column always grows geometrically
+  m_ptcaDictRoot->setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
 }
 
 
 TeracadaDict::~TeracadaDict ( void ) {
+  freeNodes(m_ptcaDictRoot);
+  deleteIndex(&m_pobjRootIndex);
+  freeSlabs();
 
+  delete m_ptcaDictRoot;
+  delete m_ptcaString;
+  delete m_pobjKeyPool;
 }
 
-template <typename tDataTypeKey, typename tDataTypeVal>
-tc_dict TeracadaDict::addNode ( tDataTypeKey ptKey, tDataTypeVal ptValue ) {
-  tc_dict ptcdNewNode = (tc_dict) malloc(sizeof(tc_dict));
 
-  ptcdNewNode->b8DataTypeKey = TC_NONE;
-  ptcdNewNode->iArrayPosKey = TA_NONE_INDEX;
-  ptcdNewNode->b8DataTypeVal = TC_NONE;
-  ptcdNewNode->iArrayPosVal = TA_NONE_INDEX;
-  ptcdNewNode->ptcaNext = nullptr;
+// Node from the free list, or carved from the current slab (a new slab is added when it is full), nullptr on allocation failure
+tc_dict TeracadaDict::newNode ( void ) {
+  tc_dict ptcdNode = m_ptcdFreeNodes;
 
+  if ( ptcdNode ) {
+    m_ptcdFreeNodes = (tc_dict) ptcdNode->ptcaNext;
+    return ptcdNode;
+  }
 
-  if constexpr ( std::is_same_v<tDataTypeKey, tc_int> ) {
-    ptcdNewNode->b8DataTypeKey = TC_INT;
-    ptcdNewNode->iArrayPosKey = m_ptcaInt->insertBack(ptKey);
+  if ( ! m_pstNodeSlab || m_ui64NumSlabNodesUsed == m_pstNodeSlab->ui64NumNodes ) {
+    tc_uint64 ui64NumNodes = m_pstNodeSlab ? std::min<tc_uint64>((m_pstNodeSlab->ui64NumNodes * 2), TD_NODE_SLAB_MAX_NUM_NODES) : TD_NODE_SLAB_MIN_NUM_NODES;
+    // Room to align the first node on a cache line
+    tc_uint64 ui64Size = sizeof(stdNodeSlab) + TD_NODE_SIZE + (ui64NumNodes * TD_NODE_SIZE);
+    stdNodeSlab* pstSlab = (stdNodeSlab*) m_pobjAllocator->allocate(ui64Size, false);
 
-    if ( ptcdNewNode->iArrayPosKey < 0 )
-      goto ERREXIT;
+    if ( ! pstSlab )
+      return nullptr;
+
+    pstSlab->pstPrev = m_pstNodeSlab;
+    pstSlab->ui64NumNodes = ui64NumNodes;
+    pstSlab->ui64Size = ui64Size;
+
+    m_pstNodeSlab = pstSlab;
+    m_ui64NumSlabNodesUsed = 0;
   }
 
-  if constexpr ( std::is_same_v<tDataTypeKey, tc_decimal> ) {
-    ptcdNewNode->b8DataTypeKey = TC_DECIMAL;
-    ptcdNewNode->iArrayPosKey = m_ptcaDecimal->insertBack(ptKey);
+  return (getSlabNodes(m_pstNodeSlab) + m_ui64NumSlabNodesUsed++);
+}
 
-    if ( ptcdNewNode->iArrayPosKey < 0 )
-      goto ERREXIT;
+
+tc_void TeracadaDict::freeNode ( tc_dict ptcdNode ) {
+  ptcdNode->ptcaNext = (tca_dict*) m_ptcdFreeNodes;
+  m_ptcdFreeNodes = ptcdNode;
+}
+
+
+tc_void TeracadaDict::freeSlabs ( void ) {
+  while ( m_pstNodeSlab ) {
+    stdNodeSlab* pstPrev = m_pstNodeSlab->pstPrev;
+
+    m_pobjAllocator->deallocate(m_pstNodeSlab, m_pstNodeSlab->ui64Size);
+    m_pstNodeSlab = pstPrev;
   }
 
-  if constexpr ( std::is_same_v<tDataTypeKey, tc_str> ) {
-    tc_str ptKeyHeap = (tc_str) malloc(strlen(ptKey) + 1);
+  m_ui64NumSlabNodesUsed = 0;
+  m_ptcdFreeNodes = nullptr;
+}
 
-    if ( ! ptKeyHeap )
-      goto ERREXIT;
 
-    strcpy(ptKeyHeap, ptKey);
+// Child node arrays are small and many, the array objects are taken from the allocator as well
+tca_dict* TeracadaDict::newChildArray ( void ) {
+  tc_void* pvArray = m_pobjAllocator->allocate(sizeof(tca_dict), false);
 
-    ptcdNewNode->b8DataTypeKey = TC_STRING;
-    ptcdNewNode->iArrayPosKey = m_ptcaString->insertBack(ptKeyHeap);
+  if ( ! pvArray )
+    return nullptr;
 
-    if ( ptcdNewNode->iArrayPosKey < 0 )
-      goto ERREXIT;
+  tca_dict* ptcaChildren = new (pvArray) tca_dict(1, true, m_pobjAllocator);
+  ptcaChildren->setResizeAlgo(TA_RESIZE_ALGO_GROWTH_2X);
+
+  return ptcaChildren;
+}
+
+
+tc_void TeracadaDict::deleteChildArray ( tca_dict* ptcaChildren ) {
+  ptcaChildren->~tca_dict();
+  m_pobjAllocator->deallocate(ptcaChildren, sizeof(tca_dict));
+}
+
+
+// Key of the node as the word it is indexed with (see TeracadaDictIndex)
+tc_bool TeracadaDict::getNodeKeyWord ( tc_dict ptcdNode, tc_uint64* pui64Key ) {
+  switch ( ptcdNode->b8DataTypeKey ) {
+    case TC_INT:
+      *pui64Key = (tc_uint64) (tc_int64) ptcdNode->unKey.iInt;
+      return true;
+
+    case TC_DECIMAL:
+      *pui64Key = TeracadaDictIndex::decimalKey(ptcdNode->unKey.dDecimal);
+      return true;
+
+    case TC_STRING:
+      // Pool id of the interned key
+      *pui64Key = (tc_uint64) ptcdNode->unKey.iStringId;
+      return true;
+
+    default:
+      return false;
   }
+}
 
-  if constexpr ( std::is_same_v<tDataTypeVal, tc_int> ) {
-    ptcdNewNode->b8DataTypeVal = TC_INT;
-    ptcdNewNode->iArrayPosVal = m_ptcaInt->insertBack(ptValue);
 
-    if ( ptcdNewNode->iArrayPosVal < 0 )
-      goto ERREXIT;
+// Index of all the nodes of a level, nullptr on allocation failure (the level is scanned then)
+TeracadaDictIndex* TeracadaDict::buildIndex ( tca_dict* ptcaNodes ) {
+  tc_uint64 ui64Key = 0;
+  tc_void* pvIndex = m_pobjAllocator->allocate(sizeof(TeracadaDictIndex), false);
+
+  if ( ! pvIndex )
+    return nullptr;
+
+  TeracadaDictIndex* pobjIndex = new (pvIndex) TeracadaDictIndex(m_pobjAllocator, ptcaNodes->getNumElements(), m_pobjKeyPool, m_bEnableOrderedIndex);
+
+  for ( tc_index iNodeIndex = 0; iNodeIndex < ptcaNodes->getNumElements(); iNodeIndex++ ) {
+    tc_dict ptcdNode = (*ptcaNodes)[iNodeIndex];
+
+    if ( ! ptcdNode || ! getNodeKeyWord(ptcdNode, &ui64Key) )
+      continue;
+
+    if ( ! pobjIndex->insert(ptcdNode->b8DataTypeKey, ui64Key, ptcdNode, iNodeIndex) ) {
+      deleteIndex(&pobjIndex);
+      break;
+    }
   }
 
-  if constexpr ( std::is_same_v<tDataTypeVal, tc_decimal> ) {
-    ptcdNewNode->b8DataTypeVal = TC_DECIMAL;
-    ptcdNewNode->iArrayPosVal = m_ptcaDecimal->insertBack(ptValue);
+  return pobjIndex;
+}
+
 
-    if ( ptcdNewNode->iArrayPosVal < 0 )
-      goto ERREXIT;
+tc_void TeracadaDict::deleteIndex ( TeracadaDictIndex** ppobjIndex ) {
+  if ( ! *ppobjIndex )
+    return;
+
+  (*ppobjIndex)->~TeracadaDictIndex();
+  m_pobjAllocator->deallocate(*ppobjIndex, sizeof(TeracadaDictIndex));
+  *ppobjIndex = nullptr;
+}
+
+
+// Index the node just added at the end of the level, the index of the level is built once it has more than TD_INDEX_MIN_NUM_NODES nodes
+tc_void TeracadaDict::indexNode ( tca_dict* ptcaNodes, TeracadaDictIndex** ppobjIndex, tc_dict ptcdNode ) {
+  tc_uint64 ui64Key = 0;
+
+  if ( ! m_bEnableIndex )
+    return;
+
+  if ( ! *ppobjIndex ) {
+    if ( ptcaNodes->getNumElements() > TD_INDEX_MIN_NUM_NODES )
+      *ppobjIndex = buildIndex(ptcaNodes);
+
+    return;
   }
 
-  if constexpr ( std::is_same_v<tDataTypeVal, tc_str> ) {
-    tc_str ptValueHeap = (tc_str) malloc(strlen(ptValue) + 1);
+  // On allocation failure the level falls back to the scan, until its next insert rebuilds the index
+  if ( ! getNodeKeyWord(ptcdNode, &ui64Key) || ! (*ppobjIndex)->insert(ptcdNode->b8DataTypeKey, ui64Key, ptcdNode, (ptcaNodes->getNumElements() - 1)) )
+    deleteIndex(ppobjIndex);
+}
 
-    if ( ! ptValueHeap )
-      goto ERREXIT;
 
-    strcpy(ptValueHeap, ptValue);
+// Build (m_bEnableIndex) or drop the indexes of the level and all its descendants
+tc_void TeracadaDict::rebuildIndexes ( tca_dict* ptcaNodes, TeracadaDictIndex** ppobjIndex ) {
+  deleteIndex(ppobjIndex);
+
+  if ( m_bEnableIndex && ptcaNodes->getNumElements() > TD_INDEX_MIN_NUM_NODES )
+    *ppobjIndex = buildIndex(ptcaNodes);
+
+  for ( tc_dict ptcdNode : ptcaNodes->view() ) {
+    if ( ptcdNode && ptcdNode->ptcaNext )
+      rebuildIndexes(ptcdNode->ptcaNext, &ptcdNode->pobjIndex);
+  }
+}
+
+
+tc_void TeracadaDict::enableIndex ( void ) {
+  if ( m_bEnableIndex )
+    return;
+
+  m_bEnableIndex = true;
+  rebuildIndexes(m_ptcaDictRoot, &m_pobjRootIndex);
+}
+
+
+tc_void TeracadaDict::disableIndex ( void ) {
+  if ( ! m_bEnableIndex )
+    return;
+
+  m_bEnableIndex = false;
+  rebuildIndexes(m_ptcaDictRoot, &m_pobjRootIndex);
+}
+
+
+tc_void TeracadaDict::enableOrderedIndex ( void ) {
+  if ( m_bEnableOrderedIndex )
+    return;
+
+  m_bEnableOrderedIndex = true;
+  rebuildIndexes(m_ptcaDictRoot, &m_pobjRootIndex);
+}
+
+
+tc_void TeracadaDict::disableOrderedIndex ( void ) {
+  if ( ! m_bEnableOrderedIndex )
+    return;
+
+  m_bEnableOrderedIndex = false;
+  rebuildIndexes(m_ptcaDictRoot, &m_pobjRootIndex);
+}
+
+
+/*
+  Sort the nodes from iFirstIndex by key, for the range queries on the levels without an ordered index and the snapshots
+  - The keys are computed once into a buffer and sorted with their nodes, so the sort doesn't chase the node pointers
+    and the string pool for every comparison
+*/
+tc_bool TeracadaDict::sortNodes ( tca_dict* ptcaNodes, tc_index iFirstIndex ) {
+  struct stdSortEntry {
+    stdTeracadaDictKey stKey;
+    tc_dict            ptcdNode;
+  };
+
+  tc_dict* pptcdNodes = ptcaNodes->data();
+  tc_uint64 ui64NumNodes = (tc_uint64) (ptcaNodes->getNumElements() - iFirstIndex);
+  stdSortEntry* pstEntries = nullptr;
+
+  if ( ! pptcdNodes )
+    return false;
+
+  if ( ui64NumNodes < 2 )
+    return true;
+
+  pptcdNodes += iFirstIndex;
+  pstEntries = (stdSortEntry*) m_pobjAllocator->allocate((ui64NumNodes * sizeof(stdSortEntry)), false);
+
+  if ( ! pstEntries ) {
+    TC_LOG(LOG_ERR, "TeracadaDict::sortNodes(): Failed to allocate the sort buffer [ NUM_NODES: %lu ]", ui64NumNodes);
+    return false;
+  }
+
+  for ( tc_uint64 ui64Node = 0; ui64Node < ui64NumNodes; ui64Node++ ) {
+    pstEntries[ui64Node].stKey = TeracadaDictIndex::sortKey(pptcdNodes[ui64Node], m_pobjKeyPool);
+    pstEntries[ui64Node].ptcdNode = pptcdNodes[ui64Node];
+  }
+
+  std::sort(pstEntries, (pstEntries + ui64NumNodes), [] ( const stdSortEntry& stEntryA, const stdSortEntry& stEntryB ) {
+    return TeracadaDictIndex::compareKeys(stEntryA.stKey, stEntryB.stKey) < 0;
+  });
+
+  for ( tc_uint64 ui64Node = 0; ui64Node < ui64NumNodes; ui64Node++ )
+    pptcdNodes[ui64Node] = pstEntries[ui64Node].ptcdNode;
+
+  m_pobjAllocator->deallocate(pstEntries, (ui64NumNodes * sizeof(stdSortEntry)));
+
+  return true;
+}
+
+
+// Nodes and index of the level below the parent node (the root level for nullptr), the child array is created if bCreate
+tc_bool TeracadaDict::getLevel ( tc_dict ptcdParentNode, tc_bool bCreate, tca_dict** pptcaNodes, TeracadaDictIndex*** pppobjIndex ) {
+  if ( ! ptcdParentNode ) {
+    *pptcaNodes = m_ptcaDictRoot;
+    *pppobjIndex = &m_pobjRootIndex;
+    return true;
+  }
+
+  if ( ! ptcdParentNode->ptcaNext && bCreate )
+    ptcdParentNode->ptcaNext = newChildArray();
+
+  if ( ! ptcdParentNode->ptcaNext )
+    return false;
+
+  *pptcaNodes = ptcdParentNode->ptcaNext;
+  *pppobjIndex = &ptcdParentNode->pobjIndex;
+  return true;
+}
+
+
+// Key as the word it is indexed with, false for a string key that was never interned (so is in no node)
+template <typename tDataType>
+tc_bool TeracadaDict::getKeyWord ( tDataType tKey, tc_byte* pb8DataType, tc_uint64* pui64Key ) {
+  if constexpr ( std::is_same_v<tDataType, tc_int> ) {
+    *pb8DataType = TC_INT;
+    *pui64Key = (tc_uint64) (tc_int64) tKey;
+  }
+
+  if constexpr ( std::is_same_v<tDataType, tc_decimal> ) {
+    *pb8DataType = TC_DECIMAL;
+    *pui64Key = TeracadaDictIndex::decimalKey(tKey);
+  }
+
+  if constexpr ( std::is_same_v<tDataType, tc_str> ) {
+    tc_index iKeyId = m_pobjKeyPool->find(tKey);
+
+    if ( iKeyId < 0 )
+      return false;
+
+    *pb8DataType = TC_STRING;
+    *pui64Key = (tc_uint64) iKeyId;
+  }
+
+  return true;
+}
+
+
+// Node with the key in the level, nullptr if there is none (its index in the level is returned in piNodeIndex)
+template <typename tDataType>
+tc_dict TeracadaDict::findNode ( tca_dict* ptcaNodes, TeracadaDictIndex* pobjIndex, tDataType tKey, tc_index* piNodeIndex ) {
+  tc_byte b8DataTypeKey = TC_NONE;
+  tc_uint64 ui64Key = 0;
+  tc_uint64 ui64NodeKey = 0;
+
+  if ( ! getKeyWord(tKey, &b8DataTypeKey, &ui64Key) )
+    return nullptr;
+
+  if ( pobjIndex )
+    return pobjIndex->find(b8DataTypeKey, ui64Key, piNodeIndex);
+
+  // Small (or unindexed) level
+  for ( tc_index iNodeIndex = 0; iNodeIndex < ptcaNodes->getNumElements(); iNodeIndex++ ) {
+    tc_dict ptcdNode = (*ptcaNodes)[iNodeIndex];
+
+    if ( ptcdNode->b8DataTypeKey == b8DataTypeKey && getNodeKeyWord(ptcdNode, &ui64NodeKey) && ui64NodeKey == ui64Key ) {
+      if ( piNodeIndex )
+        *piNodeIndex = iNodeIndex;
+
+      return ptcdNode;
+    }
+  }
+
+  return nullptr;
+}
+
+
+// Value of the node, short strings are copied into the node, the node is left untouched on failure
+template <typename tDataType>
+tc_bool TeracadaDict::storeNodeValue ( tc_dict ptcdNode, tDataType tValue ) {
+  if constexpr ( std::is_same_v<tDataType, tc_int> ) {
+    ptcdNode->b8DataTypeVal = TC_INT;
+    ptcdNode->unVal.iInt = tValue;
+  }
+
+  if constexpr ( std::is_same_v<tDataType, tc_decimal> ) {
+    ptcdNode->b8DataTypeVal = TC_DECIMAL;
+    ptcdNode->unVal.dDecimal = tValue;
+  }
+
+  if constexpr ( std::is_same_v<tDataType, tc_str> ) {
+    tc_uint64 ui64Length = strlen(tValue);
+
+    if ( ui64Length < TD_NODE_INLINE_STRING_SIZE ) {
+      memcpy(ptcdNode->unVal.acString, tValue, (ui64Length + 1));
+      ptcdNode->bInlineVal = true;
+    } else {
+      tc_index iArrayPos = m_ptcaString->insertBack(std::string_view(tValue, ui64Length));
+
+      if ( iArrayPos < 0 )
+        return false;
+
+      ptcdNode->unVal.iArrayPos = iArrayPos;
+      ptcdNode->bInlineVal = false;
+    }
+
+    ptcdNode->b8DataTypeVal = TC_STRING;
+  }
+
+  return true;
+}
+
+
+// Value of an existing node, the string column slot of a replaced long string becomes dead
+template <typename tDataType>
+tc_bool TeracadaDict::setNodeValue ( tc_dict ptcdNode, tDataType tValue ) {
+  tc_bool bStringSlot = (ptcdNode->b8DataTypeVal == TC_STRING && ! ptcdNode->bInlineVal);
+
+  if ( ! storeNodeValue(ptcdNode, tValue) )
+    return false;
+
+  if ( bStringSlot )
+    m_iNumDeadStrings++;
+
+  return true;
+}
+
+
+// Free the node and all its descendants, their string column slots become dead (their string keys until the key pool is rebuilt)
+tc_void TeracadaDict::releaseNode ( tc_dict ptcdNode ) {
+  if ( ptcdNode->ptcaNext ) {
+    for ( tc_dict ptcdChild : ptcdNode->ptcaNext->view() )
+      releaseNode(ptcdChild);
+
+    deleteChildArray(ptcdNode->ptcaNext);
+  }
+
+  deleteIndex(&ptcdNode->pobjIndex);
+
+  if ( ptcdNode->b8DataTypeVal == TC_STRING && ! ptcdNode->bInlineVal )
+    m_iNumDeadStrings++;
+
+  if ( ptcdNode->b8DataTypeKey == TC_STRING ) {
+    m_iNumStringKeys--;
+    m_iNumDeadKeys++;
+  }
+
+  freeNode(ptcdNode);
+}
+
+
+// Copy the live strings of the level and all its descendants to the new column, and point the nodes to the copies
+tc_void TeracadaDict::moveLiveStrings ( tca_dict* ptcaNodes, tca_strings* ptcaString ) {
+  for ( tc_dict ptcdNode : ptcaNodes->view() ) {
+    if ( ptcdNode->b8DataTypeVal == TC_STRING && ! ptcdNode->bInlineVal )
+      ptcdNode->unVal.iArrayPos = ptcaString->insertBack((*m_ptcaString)[ptcdNode->unVal.iArrayPos - 1]);
+
+    if ( ptcdNode->ptcaNext )
+      moveLiveStrings(ptcdNode->ptcaNext, ptcaString);
+  }
+}
+
+
+/*
+  Rebuild the string column with the live strings only
+  - The new column is reserved for all the live strings first, so that moving them can't fail half way.
+  - The column is left untouched if the new one can't be allocated.
+*/
+tc_bool TeracadaDict::compactStrings ( void ) {
+  tc_index iNumStrings = m_ptcaString->getNumElements() - m_iNumDeadStrings;
+
+  // Upper bound of the live characters, trimmed once the strings are moved
+  tca_strings* ptcaString = new TeracadaStringArray(std::max<tc_index>(iNumStrings, 10), m_ptcaString->getNumChars() + iNumStrings, m_pobjAllocator);
+
+  if ( ! ptcaString->isInitSuccess() ) {
+    delete ptcaString;
+    return false;
+  }
+
+  moveLiveStrings(m_ptcaDictRoot, ptcaString);
+  ptcaString->shrinkToFit();
+
+  delete m_ptcaString;
+
+  m_ptcaString = ptcaString;
+  m_iNumDeadStrings = 0;
+
+  return true;
+}
+
+
+// Intern the keys of the level and all its descendants in the new pool (piNewIds by old id), or point the nodes to the new ids (bAssign)
+tc_bool TeracadaDict::remapKeys ( tca_dict* ptcaNodes, TeracadaStringPool* pobjKeyPool, tc_index* piNewIds, tc_bool bAssign ) {
+  for ( tc_dict ptcdNode : ptcaNodes->view() ) {
+    if ( ptcdNode->b8DataTypeKey == TC_STRING && bAssign )
+      ptcdNode->unKey.iStringId = piNewIds[ptcdNode->unKey.iStringId];
+
+    if ( ptcdNode->b8DataTypeKey == TC_STRING && ! bAssign && piNewIds[ptcdNode->unKey.iStringId] == TA_NONE_INDEX ) {
+      piNewIds[ptcdNode->unKey.iStringId] = pobjKeyPool->intern(m_pobjKeyPool->get(ptcdNode->unKey.iStringId));
+
+      if ( piNewIds[ptcdNode->unKey.iStringId] < 0 )
+        return false;
+    }
+
+    if ( ptcdNode->ptcaNext && ! remapKeys(ptcdNode->ptcaNext, pobjKeyPool, piNewIds, bAssign) )
+      return false;
+  }
+
+  return true;
+}
+
+
+/*
+  Rebuild the key pool with the keys of the live nodes only
+  - All the live keys are interned in the new pool before any node is changed, the pool is left untouched if it fails.
+  - The indexes hash and order the string keys by their ids, they are rebuilt with the new pool.
+*/
+tc_bool TeracadaDict::compactKeys ( void ) {
+  tc_index iNumIds = m_pobjKeyPool->getNumElements();
+  tc_index* piNewIds = (tc_index*) m_pobjAllocator->allocate((std::max<tc_index>(iNumIds, 1) * sizeof(tc_index)), false);
+  TeracadaStringPool* pobjKeyPool = new TeracadaStringPool(std::max<tc_index>(m_iNumStringKeys, 64), m_pobjAllocator);
+  TeracadaStringPool* pobjPrevKeyPool = m_pobjKeyPool;
+  tc_bool bSuccess = false;
+
+  if ( ! piNewIds || ! pobjKeyPool->isInitSuccess() )
+    goto EXIT;
+
+  std::fill(piNewIds, (piNewIds + iNumIds), (tc_index) TA_NONE_INDEX);
+
+  pobjKeyPool->disableExceptions();
+
+  if ( ! remapKeys(m_ptcaDictRoot, pobjKeyPool, piNewIds, false) )
+    goto EXIT;
+
+  if ( m_pobjKeyPool->isExceptionsEnabled() )
+    pobjKeyPool->enableExceptions();
+
+  remapKeys(m_ptcaDictRoot, pobjKeyPool, piNewIds, true);
+
+  m_pobjKeyPool = pobjKeyPool;
+  m_iNumDeadKeys = 0;
+  rebuildIndexes(m_ptcaDictRoot, &m_pobjRootIndex);
+
+  pobjKeyPool = pobjPrevKeyPool;
+  bSuccess = true;
+
+  EXIT:
+    if ( piNewIds )
+      m_pobjAllocator->deallocate(piNewIds, (std::max<tc_index>(iNumIds, 1) * sizeof(tc_index)));
+
+    delete pobjKeyPool;
+
+    return bSuccess;
+}
+
+
+/*
+  Compaction is amortized over the updates/erases: the string column is rebuilt once at least half of its slots are dead,
+  the key pool once as many string key nodes were erased as are left
+*/
+tc_void TeracadaDict::compactIfSparse ( void ) {
+  if ( ! m_bEnableAutoCompact )
+    return;
+
+  if ( m_iNumDeadStrings >= TD_COMPACT_MIN_DEAD_SLOTS && (m_iNumDeadStrings * 2) >= m_ptcaString->getNumElements() )
+    compactStrings();
+
+  if ( m_iNumDeadKeys >= TD_COMPACT_MIN_DEAD_SLOTS && m_iNumDeadKeys >= m_iNumStringKeys )
+    compactKeys();
+}
+
+
+tc_bool TeracadaDict::compact ( void ) {
+  if ( getNumDeadSlots() && ! compactStrings() )
+    return false;
+
+  if ( getNumDeadKeys() && ! compactKeys() )
+    return false;
+
+  return true;
+}
+
+
+// Free the child arrays and indexes of the nodes of the array and all their descendants (the nodes go with their slabs)
+tc_void TeracadaDict::freeNodes ( tca_dict* ptcaNodes ) {
+  for ( tc_dict ptcdNode : ptcaNodes->view() ) {
+    if ( ! ptcdNode )
+      continue;
+
+    if ( ptcdNode->ptcaNext ) {
+      freeNodes(ptcdNode->ptcaNext);
+      deleteChildArray(ptcdNode->ptcaNext);
+    }
+
+    deleteIndex(&ptcdNode->pobjIndex);
+  }
+}
+
+template <typename tDataTypeKey, typename tDataTypeVal>
+tc_dict TeracadaDict::addNode ( tDataTypeKey ptKey, tDataTypeVal ptValue ) {
+  tc_dict ptcdNewNode = newNode();
+
+  if ( ! ptcdNewNode )
+    return nullptr;
+
+  memset(ptcdNewNode, 0, sizeof(stdTeracadaDictNode));
+  ptcdNewNode->b8DataTypeKey = TC_NONE;
+  ptcdNewNode->b8DataTypeVal = TC_NONE;
+  ptcdNewNode->b8Shard = m_b8Shard;
+
+  if constexpr ( std::is_same_v<tDataTypeKey, tc_int> ) {
+    ptcdNewNode->b8DataTypeKey = TC_INT;
+    ptcdNewNode->unKey.iInt = ptKey;
+  }
 
-    ptcdNewNode->b8DataTypeVal = TC_STRING;
-    ptcdNewNode->iArrayPosVal = m_ptcaString->insertBack(ptValueHeap);
+  if constexpr ( std::is_same_v<tDataTypeKey, tc_decimal> ) {
+    ptcdNewNode->b8DataTypeKey = TC_DECIMAL;
+    ptcdNewNode->unKey.dDecimal = ptKey;
+  }
 
-    if ( ptcdNewNode->iArrayPosVal < 0 )
+  // The value is stored first, a string key is interned last so it is never left in the key pool without a node
+  if ( ! storeNodeValue(ptcdNewNode, ptValue) )
+    goto ERREXIT;
+
+  if constexpr ( std::is_same_v<tDataTypeKey, tc_str> ) {
+    ptcdNewNode->b8DataTypeKey = TC_STRING;
+    ptcdNewNode->unKey.iStringId = m_pobjKeyPool->intern(ptKey);
+
+    if ( ptcdNewNode->unKey.iStringId < 0 )
       goto ERREXIT;
   }
 
+  if ( ptcdNewNode->b8DataTypeKey == TC_STRING )
+    m_iNumStringKeys++;
+
   EXIT:
     return ptcdNewNode;
 
   ERREXIT:
+    // Long string value already stored for the node is a dead slot of the string column
+    if ( ptcdNewNode->b8DataTypeVal == TC_STRING && ! ptcdNewNode->bInlineVal )
+      m_iNumDeadStrings++;
+
+    freeNode(ptcdNewNode);
     return nullptr;
 }
 
@@ -158,25 +695,55 @@ template tc_dict TeracadaDict::addNode<tc_str, tc_str> ( tc_str ptKey, tc_str pt
 // template tc_dict TeracadaDict::insertNode<tc_str> ( tc_dict pParentNode, tc_str tValue );
 
 
+/*
+  Insert or update the key in the level below the parent node (the root level for nullptr)
+  - An existing node keeps its children, only its value is replaced (see setNodeValue()).
+  - The replaced long string values are reclaimed by the compaction of the string column (compactIfSparse()).
+*/
 template <typename tDataTypeKey, typename tDataTypeVal>
-tc_dict TeracadaDict::update ( tDataTypeKey tKey, tDataTypeVal tValue ) {
-  tc_dict ptcdNewNode = nullptr;
+tc_dict TeracadaDict::upsert ( tc_dict ptcdParentNode, tDataTypeKey tKey, tDataTypeVal tValue ) {
+  tca_dict* ptcaNodes = nullptr;
+  TeracadaDictIndex** ppobjIndex = nullptr;
+  tc_dict ptcdNode = nullptr;
 
-  ptcdNewNode = addNode(tKey, tValue);
+  if ( ! getLevel(ptcdParentNode, true, &ptcaNodes, &ppobjIndex) )
+    goto ERREXIT;
 
-  if ( ! ptcdNewNode )
+  ptcdNode = findNode(ptcaNodes, *ppobjIndex, tKey);
+
+  if ( ptcdNode ) {
+    if ( ! setNodeValue(ptcdNode, tValue) )
+      goto ERREXIT;
+
+    compactIfSparse();
+    goto EXIT;
+  }
+
+  ptcdNode = addNode(tKey, tValue);
+
+  if ( ! ptcdNode )
+    goto ERREXIT;
+
+  if ( ptcaNodes->insertBack(ptcdNode) < 0 ) {
+    releaseNode(ptcdNode);
     goto ERREXIT;
+  }
 
-  m_ptcaDictRoot->insertBack(ptcdNewNode);
+  indexNode(ptcaNodes, ppobjIndex, ptcdNode);
 
   EXIT:
-    return ptcdNewNode;
+    return ptcdNode;
 
   ERREXIT:
     return nullptr;
 }
 
 
+template <typename tDataTypeKey, typename tDataTypeVal>
+tc_dict TeracadaDict::update ( tDataTypeKey tKey, tDataTypeVal tValue ) {
+  return upsert(nullptr, tKey, tValue);
+}
+
 template tc_dict TeracadaDict::update<tc_int, tc_int> ( tc_int tKey, tc_int tValue );
 template tc_dict TeracadaDict::update<tc_int, tc_decimal> ( tc_int tKey, tc_decimal tValue );
 template tc_dict TeracadaDict::update<tc_int, tc_str> ( tc_int tKey, tc_str tValue );
@@ -192,21 +759,7 @@ template tc_dict TeracadaDict::update<tc_str, tc_str> ( tc_str tKey, tc_str tVal
 
 template <typename tDataTypeKey, typename tDataTypeVal>
 tc_dict TeracadaDict::update ( tc_dict ptcdParentNode, tDataTypeKey tKey, tDataTypeVal tValue ) {
-  tc_dict ptcdNewNode = nullptr;
-
-  ptcdNewNode = addNode(tKey, tValue);
-
-  if ( ! ptcdParentNode->ptcaNext )
-    ptcdParentNode->ptcaNext = new TeracadaArray<tc_dict>(1);
-
-  ptcdParentNode->ptcaNext->insertBack(ptcdNewNode);
-
-
-  EXIT:
-    return ptcdNewNode;
-
-  ERREXIT:
-    return nullptr;
+  return upsert(ptcdParentNode, tKey, tValue);
 }
 
 template tc_dict TeracadaDict::update<tc_int, tc_int> ( tc_dict ptcdParentNode, tc_int tKey, tc_int tValue );
@@ -222,20 +775,188 @@ template tc_dict TeracadaDict::update<tc_str, tc_decimal> ( tc_dict ptcdParentNo
 template tc_dict TeracadaDict::update<tc_str, tc_str> ( tc_dict ptcdParentNode, tc_str tKey, tc_str tValue );
 
 
+/*
+  Remove the node with the key from the level below the parent node (the root level for nullptr), with all its descendants
+  - The last node of the level takes the place of the removed one (O(1), the order of the level changes).
+  - The long string values of the removed nodes are reclaimed by the compaction of the string column (compactIfSparse()).
+*/
+template <typename tDataType>
+tc_bool TeracadaDict::erase ( tDataType tKey, tc_dict ptcdParentNode ) {
+  tca_dict* ptcaNodes = nullptr;
+  TeracadaDictIndex** ppobjIndex = nullptr;
+  tc_dict ptcdNode = nullptr;
+  tc_dict ptcdLastNode = nullptr;
+  tc_index iNodeIndex = TA_NONE_INDEX;
+  tc_index iLastIndex = TA_NONE_INDEX;
+  tc_uint64 ui64Key = 0;
+
+  if ( ! getLevel(ptcdParentNode, false, &ptcaNodes, &ppobjIndex) )
+    goto ERREXIT;
+
+  ptcdNode = findNode(ptcaNodes, *ppobjIndex, tKey, &iNodeIndex);
+
+  if ( ! ptcdNode )
+    goto ERREXIT;
+
+  iLastIndex = ptcaNodes->getNumElements() - 1;
+  ptcdLastNode = (*ptcaNodes)[iLastIndex];
+
+  if ( *ppobjIndex && getNodeKeyWord(ptcdNode, &ui64Key) )
+    (*ppobjIndex)->erase(ptcdNode->b8DataTypeKey, ui64Key);
+
+  if ( iNodeIndex != iLastIndex ) {
+    (*ptcaNodes)[iNodeIndex] = ptcdLastNode;
+
+    if ( *ppobjIndex && getNodeKeyWord(ptcdLastNode, &ui64Key) )
+      (*ppobjIndex)->assign(ptcdLastNode->b8DataTypeKey, ui64Key, iNodeIndex);
+  }
+
+  ptcaNodes->remove(-1);
+  releaseNode(ptcdNode);
+
+  compactIfSparse();
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+template tc_bool TeracadaDict::erase<tc_int> ( tc_int tKey, tc_dict ptcdParentNode );
+
+template tc_bool TeracadaDict::erase<tc_decimal> ( tc_decimal tKey, tc_dict ptcdParentNode );
+
+template tc_bool TeracadaDict::erase<tc_str> ( tc_str tKey, tc_dict ptcdParentNode );
+
+
+template <typename tDataType>
+tc_dict TeracadaDict::lowerBound ( tDataType tKey, tc_dict ptcdParentNode ) {
+  tca_dict* ptcaNodes = nullptr;
+  TeracadaDictIndex** ppobjIndex = nullptr;
+  tc_dict ptcdBoundNode = nullptr;
+  stdTeracadaDictKey stKey = TeracadaDictIndex::sortKey(tKey);
+  stdTeracadaDictKey stBoundKey = stKey;
+
+  if ( ! getLevel(ptcdParentNode, false, &ptcaNodes, &ppobjIndex) )
+    goto ERREXIT;
+
+  if ( *ppobjIndex && (*ppobjIndex)->isOrdered() ) {
+    ptcdBoundNode = (*ppobjIndex)->lowerBound(stKey);
+    goto EXIT;
+  }
+
+  for ( tc_dict ptcdNode : ptcaNodes->view() ) {
+    stdTeracadaDictKey stNodeKey = TeracadaDictIndex::sortKey(ptcdNode, m_pobjKeyPool);
+
+    if ( stNodeKey.b8DataType == stKey.b8DataType && TeracadaDictIndex::compareKeys(stNodeKey, stKey) >= 0 && (! ptcdBoundNode || TeracadaDictIndex::compareKeys(stNodeKey, stBoundKey) < 0) ) {
+      ptcdBoundNode = ptcdNode;
+      stBoundKey = stNodeKey;
+    }
+  }
+
+  EXIT:
+    return ptcdBoundNode;
+
+  ERREXIT:
+    return nullptr;
+}
+
+template tc_dict TeracadaDict::lowerBound<tc_int> ( tc_int tKey, tc_dict ptcdParentNode );
+
+template tc_dict TeracadaDict::lowerBound<tc_decimal> ( tc_decimal tKey, tc_dict ptcdParentNode );
+
+template tc_dict TeracadaDict::lowerBound<tc_str> ( tc_str tKey, tc_dict ptcdParentNode );
+
+
+template <typename tDataType>
+tc_index TeracadaDict::range ( tDataType tLow, tDataType tHigh, tca_dict* ptcaNodes, tc_dict ptcdParentNode ) {
+  tca_dict* ptcaLevelNodes = nullptr;
+  TeracadaDictIndex** ppobjIndex = nullptr;
+  stdTeracadaDictKey stLow = TeracadaDictIndex::sortKey(tLow);
+  stdTeracadaDictKey stHigh = TeracadaDictIndex::sortKey(tHigh);
+
+  if ( ! ptcaNodes->reset() )
+    goto ERREXIT;
+
+  // No children, no nodes in the range
+  if ( ! getLevel(ptcdParentNode, false, &ptcaLevelNodes, &ppobjIndex) )
+    goto EXIT;
+
+  if ( *ppobjIndex && (*ppobjIndex)->isOrdered() )
+    return (*ppobjIndex)->range(stLow, stHigh, ptcaNodes);
+
+  for ( tc_dict ptcdNode : ptcaLevelNodes->view() ) {
+    stdTeracadaDictKey stNodeKey = TeracadaDictIndex::sortKey(ptcdNode, m_pobjKeyPool);
+
+    if ( TeracadaDictIndex::compareKeys(stNodeKey, stLow) >= 0 && TeracadaDictIndex::compareKeys(stNodeKey, stHigh) < 0 && ptcaNodes->insertBack(ptcdNode) < 0 )
+      goto ERREXIT;
+  }
+
+  if ( ! sortNodes(ptcaNodes) )
+    goto ERREXIT;
+
+  EXIT:
+    return ptcaNodes->getNumElements();
+
+  ERREXIT:
+    return TA_NONE_INDEX;
+}
+
+template tc_index TeracadaDict::range<tc_int> ( tc_int tLow, tc_int tHigh, tca_dict* ptcaNodes, tc_dict ptcdParentNode );
+
+template tc_index TeracadaDict::range<tc_decimal> ( tc_decimal tLow, tc_decimal tHigh, tca_dict* ptcaNodes, tc_dict ptcdParentNode );
+
+template tc_index TeracadaDict::range<tc_str> ( tc_str tLow, tc_str tHigh, tca_dict* ptcaNodes, tc_dict ptcdParentNode );
+
+
+tc_index TeracadaDict::prefix ( tc_str pcPrefix, tca_dict* ptcaNodes, tc_dict ptcdParentNode ) {
+  tca_dict* ptcaLevelNodes = nullptr;
+  TeracadaDictIndex** ppobjIndex = nullptr;
+  std::string_view svPrefix(pcPrefix);
+
+  if ( ! ptcaNodes->reset() )
+    goto ERREXIT;
+
+  if ( ! getLevel(ptcdParentNode, false, &ptcaLevelNodes, &ppobjIndex) )
+    goto EXIT;
+
+  if ( *ppobjIndex && (*ppobjIndex)->isOrdered() )
+    return (*ppobjIndex)->prefix(svPrefix, ptcaNodes);
+
+  for ( tc_dict ptcdNode : ptcaLevelNodes->view() ) {
+    if ( ptcdNode->b8DataTypeKey != TC_STRING || m_pobjKeyPool->get(ptcdNode->unKey.iStringId).substr(0, svPrefix.size()) != svPrefix )
+      continue;
+
+    if ( ptcaNodes->insertBack(ptcdNode) < 0 )
+      goto ERREXIT;
+  }
+
+  if ( ! sortNodes(ptcaNodes) )
+    goto ERREXIT;
+
+  EXIT:
+    return ptcaNodes->getNumElements();
+
+  ERREXIT:
+    return TA_NONE_INDEX;
+}
+
+
 tc_void* TeracadaDict::getNodeKey ( tc_dict ptcdNode ) {
   tc_void* pvKey = nullptr;
 
   switch ( ptcdNode->b8DataTypeKey ) {
     case TC_INT:
-      pvKey = m_ptcaInt->get(ptcdNode->iArrayPosKey);
+      pvKey = &ptcdNode->unKey.iInt;
       break;
 
     case TC_DECIMAL:
-      pvKey = m_ptcaDecimal->get(ptcdNode->iArrayPosKey);
+      pvKey = &ptcdNode->unKey.dDecimal;
       break;
 
     case TC_STRING:
-      pvKey = m_ptcaString->get(ptcdNode->iArrayPosKey);
+      pvKey = (tc_void*) m_pobjKeyPool->getCStr(ptcdNode->unKey.iStringId);
       break;
 
     default:
@@ -256,15 +977,18 @@ tc_void* TeracadaDict::getNodeValue ( tc_dict ptcdNode ) {
 
   switch ( ptcdNode->b8DataTypeVal ) {
     case TC_INT:
-      pvValue = m_ptcaInt->get(ptcdNode->iArrayPosVal);
+      pvValue = &ptcdNode->unVal.iInt;
       break;
 
     case TC_DECIMAL:
-      pvValue = m_ptcaDecimal->get(ptcdNode->iArrayPosVal);
+      pvValue = &ptcdNode->unVal.dDecimal;
       break;
 
     case TC_STRING:
-      pvValue = m_ptcaString->get(ptcdNode->iArrayPosVal);
+      if ( ptcdNode->bInlineVal )
+        pvValue = ptcdNode->unVal.acString;
+      else
+        pvValue = (tc_void*) m_ptcaString->getCStr(ptcdNode->unVal.iArrayPos);
       break;
 
     default:
@@ -282,52 +1006,20 @@ tc_void* TeracadaDict::getNodeValue ( tc_dict ptcdNode ) {
 
 template <typename tDataType>
 tc_void* TeracadaDict::get ( tDataType ptKey, tc_dict ptcdParentNode ) {
-  tc_void* pvKey = nullptr;
-  tc_void* pvValue = nullptr;
+  tca_dict* ptcaNodes = nullptr;
+  TeracadaDictIndex** ppobjIndex = nullptr;
   tc_dict ptcdNode = nullptr;
-  tca_dict* ptcaChildren = nullptr;
 
-  if ( ! ptcdParentNode ) {
-    ptcaChildren = m_ptcaDictRoot;
-  } else {
-    if ( ptcdParentNode->ptcaNext )
-      ptcaChildren = ptcdParentNode->ptcaNext;
-    else
-      goto ERREXIT;
-  }
-
-  m_ptcaInt->print();
-  m_ptcaString->print();
-
-  for ( int iIter = 1; iIter <= ptcaChildren->getNumElements(); iIter++ ) {
-    ptcdNode = (tc_dict) ptcaChildren->get(iIter);
-    pvKey = getNodeKey(ptcdNode);
-
-    if constexpr ( std::is_same_v<tDataType, tc_int> ) {
-      if ( *((tc_int*) pvKey) == ptKey ) {
-        pvValue = getNodeValue(ptcdNode);
-        break;
-      }
-    }
-
-    if constexpr ( std::is_same_v<tDataType, tc_decimal> ) {
-      if ( *((tc_decimal*) pvKey) == ptKey ) {
-        pvValue = getNodeValue(ptcdNode);
-        break;
-      }
-    }
+  if ( ! getLevel(ptcdParentNode, false, &ptcaNodes, &ppobjIndex) )
+    goto ERREXIT;
 
-    if constexpr ( std::is_same_v<tDataType, tc_str> ) {
-      if ( strcmp((tc_str) pvKey, ptKey) == 0 ) {
-        pvValue = getNodeValue(ptcdNode);
-        break;
-      }
-    }
+  ptcdNode = findNode(ptcaNodes, *ppobjIndex, ptKey);
 
-  }
+  if ( ! ptcdNode )
+    goto ERREXIT;
 
   EXIT:
-    return pvValue;
+    return getNodeValue(ptcdNode);
 
   ERREXIT:
     return nullptr;
@@ -339,3 +1031,20 @@ template tc_void* TeracadaDict::get<tc_decimal> ( tc_decimal ptKey, tc_dict ptcd
 
 template tc_void* TeracadaDict::get<tc_str> ( tc_str ptKey, tc_dict ptcdParentNode );
 
+
+template <typename tDataType>
+tc_dict TeracadaDict::find ( tDataType tKey, tc_dict ptcdParentNode ) {
+  tca_dict* ptcaNodes = nullptr;
+  TeracadaDictIndex** ppobjIndex = nullptr;
+
+  if ( ! getLevel(ptcdParentNode, false, &ptcaNodes, &ppobjIndex) )
+    return nullptr;
+
+  return findNode(ptcaNodes, *ppobjIndex, tKey);
+}
+
+template tc_dict TeracadaDict::find<tc_int> ( tc_int tKey, tc_dict ptcdParentNode );
+
+template tc_dict TeracadaDict::find<tc_decimal> ( tc_decimal tKey, tc_dict ptcdParentNode );
+
+template tc_dict TeracadaDict::find<tc_str> ( tc_str tKey, tc_dict ptcdParentNode );
@@ -0,0 +1,422 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "teracada.h"
+
+
+static char acTERACADA_ERRSTR_BUFFER[TC_ERRORSTR_LENGTH];
+char* pcTERACADA_ERRSTR = &acTERACADA_ERRSTR_BUFFER[0];
+
+
+using namespace std;
+
+typedef chrono::steady_clock tc_clock;
+
+// Number of children of every top level node in the benchmark dictionaries
+#define BENCHMARK_DICT_NUM_CHILDREN        3
+
+
+static tc_double elapsedMilliSeconds ( tc_clock::time_point objStart ) {
+  return chrono::duration<tc_double, milli>(tc_clock::now() - objStart).count();
+}
+
+
+/*
+  Build a two level dictionary of iNumNodes nodes: top level nodes with BENCHMARK_DICT_NUM_CHILDREN children each,
+  so there is one small child node array per top level node, then tear it down
+*/
+static tc_void benchmarkDictBuild ( TeracadaAllocator* pobjAllocator, tc_int iNumNodes, const tc_char* pcAllocatorName ) {
+  tc_int iNumParents = iNumNodes / (BENCHMARK_DICT_NUM_CHILDREN + 1);
+  stdTeracadaAllocatorStats stStats;
+  tc_double dBuildMs = 0, dTeardownMs = 0;
+
+  pobjAllocator->resetStats();
+
+  tc_clock::time_point objStart = tc_clock::now();
+
+  {
+    TeracadaDict objDict(pobjAllocator);
+
+    for ( tc_int iParent = 0; iParent < iNumParents; iParent++ ) {
+      tc_dict ptcdParent = objDict.update<tc_int, tc_int>(iParent, iParent);
+
+      for ( tc_int iChild = 0; iChild < BENCHMARK_DICT_NUM_CHILDREN; iChild++ )
+        objDict.update<tc_int, tc_decimal>(ptcdParent, iChild, (tc_decimal) iParent);
+    }
+
+    dBuildMs = elapsedMilliSeconds(objStart);
+    stStats = pobjAllocator->getStats();
+    objStart = tc_clock::now();
+  }
+
+  dTeardownMs = elapsedMilliSeconds(objStart);
+
+  printf("  %-10s build: %9.3f ms (%6.2f M nodes/s)   teardown: %9.3f ms   allocs: %8lu   reallocs: %8lu   system allocs: %8lu   system MB: %8.2f\n",
+          pcAllocatorName, dBuildMs, ((iNumParents * (BENCHMARK_DICT_NUM_CHILDREN + 1)) / (dBuildMs * 1000)), dTeardownMs,
+          stStats.ui64NumAllocs, stStats.ui64NumReallocs, stStats.ui64NumSystemAllocs, (stStats.ui64SystemBytes / 1048576.0));
+}
+
+
+tc_void BenchmarkTeracadaDictAllocators ( tc_int iNumNodes ) {
+
+  cout << ">>> Benchmarking TeracadaDict build with the allocators [ NODES: " << iNumNodes << " | CHILDREN_PER_NODE: " << BENCHMARK_DICT_NUM_CHILDREN << " ]" << endl;
+
+  TeracadaHeapAllocator objHeap;
+  benchmarkDictBuild(&objHeap, iNumNodes, "heap");
+
+  {
+    TeracadaArenaAllocator objArena;
+    benchmarkDictBuild(&objArena, iNumNodes, "arena");
+  }
+
+  {
+    TeracadaPoolAllocator objPool;
+    benchmarkDictBuild(&objPool, iNumNodes, "pool");
+  }
+
+  return;
+}
+
+
+/*
+  iNumLookups random hits on a dict of iNumKeys int keys (and of as many string keys), through the hash index and with
+  the index disabled (scan of the level). The scans are cut down to a number of lookups that finishes in seconds,
+  the times are compared per lookup.
+*/
+tc_void BenchmarkTeracadaDictLookup ( tc_int iNumKeys, tc_int iNumLookups ) {
+  tc_char acKey[32] = {0};
+  tc_int64 iSum = 0;
+  TeracadaDict objDict;
+  tca_strings objKeys(iNumKeys);
+
+  cout << ">>> Benchmarking TeracadaDict lookup, hash index vs. scan [ KEYS: " << iNumKeys << " | LOOKUPS: " << iNumLookups << " ]" << endl;
+
+  for ( tc_int iKey = 0; iKey < iNumKeys; iKey++ ) {
+    objKeys.insertBack(string_view(acKey, snprintf(acKey, sizeof(acKey), "key-%d", (tc_int32) iKey)));
+
+    objDict.update<tc_int, tc_int>(iKey, iKey);
+    objDict.update<tc_str, tc_int>((tc_str) objKeys.getCStr(-1), iKey);
+  }
+
+  for ( tc_int iPass = 0; iPass < 2; iPass++ ) {
+    // Keep the number of scanned nodes around 5 * 10^8
+    tc_int iNumRuns = iPass ? min<tc_int64>(iNumLookups, max<tc_int64>(1, 500000000LL / iNumKeys)) : iNumLookups;
+    tc_uint64 ui64Random = 88172645463325252ULL;
+
+    tc_clock::time_point objStart = tc_clock::now();
+
+    for ( tc_int iRun = 0; iRun < iNumRuns; iRun++ ) {
+      ui64Random ^= ui64Random << 13; ui64Random ^= ui64Random >> 7; ui64Random ^= ui64Random << 17;
+      iSum += *((tc_int*) objDict.get<tc_int>((tc_int) (ui64Random % iNumKeys)));
+    }
+
+    tc_double dIntNs = elapsedMilliSeconds(objStart) * 1000000 / iNumRuns;
+    objStart = tc_clock::now();
+
+    for ( tc_int iRun = 0; iRun < iNumRuns; iRun++ ) {
+      ui64Random ^= ui64Random << 13; ui64Random ^= ui64Random >> 7; ui64Random ^= ui64Random << 17;
+      iSum += *((tc_int*) objDict.get<tc_str>((tc_str) objKeys.getCStr((tc_index) (ui64Random % iNumKeys) + 1)));
+    }
+
+    tc_double dStrNs = elapsedMilliSeconds(objStart) * 1000000 / iNumRuns;
+
+    printf("  %-6s lookups: %8d   int key: %12.1f ns/lookup   string key: %12.1f ns/lookup\n", (iPass ? "scan" : "index"), iNumRuns, dIntNs, dStrNs);
+
+    objDict.disableIndex();
+  }
+
+  // Keeps the lookups from being optimized away
+  if ( ! iSum )
+    cout << "  (checksum 0)" << endl;
+
+  return;
+}
+
+
+/*
+  Counters (tc_int values) and statuses (string values) of iNumKeys keys updated iNumUpdates times in total,
+  the memory held by the dict stays bounded by the number of keys
+*/
+tc_void BenchmarkTeracadaDictUpdates ( tc_int iNumUpdates, tc_int iNumKeys ) {
+  tc_char acValue[32] = {0};
+  TeracadaHeapAllocator objHeap;
+
+  cout << ">>> Benchmarking TeracadaDict updates in place [ UPDATES: " << iNumUpdates << " | KEYS: " << iNumKeys << " ]" << endl;
+
+  {
+    TeracadaDict objDict(&objHeap);
+
+    tc_clock::time_point objStart = tc_clock::now();
+
+    for ( tc_int iIter = 0; iIter < iNumUpdates; iIter++ )
+      objDict.update<tc_int, tc_int>((iIter % iNumKeys), iIter);
+
+    tc_double dIntMs = elapsedMilliSeconds(objStart);
+    tc_double dIntMB = objHeap.getStats().ui64SystemBytes / 1048576.0;
+
+    objStart = tc_clock::now();
+
+    for ( tc_int iIter = 0; iIter < iNumUpdates; iIter++ ) {
+      snprintf(acValue, sizeof(acValue), "status-%d", (tc_int32) iIter);
+      objDict.update<tc_int, tc_str>((iNumKeys + (iIter % iNumKeys)), acValue);
+    }
+
+    tc_double dStrMs = elapsedMilliSeconds(objStart);
+
+    printf("  int values: %9.3f ms (%6.2f M updates/s)   MB: %8.2f   string values: %9.3f ms (%6.2f M updates/s)   MB: %8.2f   dead slots: %ld\n",
+            dIntMs, (iNumUpdates / (dIntMs * 1000)), dIntMB, dStrMs, (iNumUpdates / (dStrMs * 1000)),
+            (objHeap.getStats().ui64SystemBytes / 1048576.0), (tc_int64) objDict.getNumDeadSlots());
+  }
+
+  return;
+}
+
+
+/*
+  Time series style range queries: iNumKeys timestamp keys (tc_int) and "sensor-<n>/<metric>" string keys,
+  iNumQueries windows of iWindow keys and prefix scans, with the ordered index vs. the scan and sort of the level.
+  The scans are cut down like in the lookup benchmark, the times are compared per query.
+*/
+tc_void BenchmarkTeracadaDictRange ( tc_int iNumKeys, tc_int iNumQueries, tc_int iWindow ) {
+  tc_char acKey[32] = {0};
+  tc_int64 iSum = 0;
+  tca_dict tcaNodes(iWindow);
+
+  cout << ">>> Benchmarking TeracadaDict range queries, ordered index vs. scan [ KEYS: " << iNumKeys << " | QUERIES: " << iNumQueries << " | WINDOW: " << iWindow << " ]" << endl;
+
+  for ( tc_int iPass = 0; iPass < 2; iPass++ ) {
+    TeracadaDict objDict;
+    tc_int iNumRuns = iPass ? min<tc_int64>(iNumQueries, max<tc_int64>(1, 500000000LL / iNumKeys)) : iNumQueries;
+    tc_uint64 ui64Random = 88172645463325252ULL;
+
+    if ( ! iPass )
+      objDict.enableOrderedIndex();
+
+    tc_clock::time_point objStart = tc_clock::now();
+
+    // Timestamps arrive slightly out of order
+    for ( tc_int iKey = 0; iKey < iNumKeys; iKey++ ) {
+      objDict.update<tc_int, tc_int>((iKey ^ 7), iKey);
+
+      snprintf(acKey, sizeof(acKey), "sensor-%d/m%d", (tc_int32) (iKey / 10), (tc_int32) (iKey % 10));
+      objDict.update<tc_str, tc_int>(acKey, iKey);
+    }
+
+    tc_double dBuildMs = elapsedMilliSeconds(objStart);
+    objStart = tc_clock::now();
+
+    for ( tc_int iRun = 0; iRun < iNumRuns; iRun++ ) {
+      ui64Random ^= ui64Random << 13; ui64Random ^= ui64Random >> 7; ui64Random ^= ui64Random << 17;
+      tc_int iLow = (tc_int) (ui64Random % (iNumKeys - iWindow));
+
+      iSum += objDict.range<tc_int>(iLow, (iLow + iWindow), &tcaNodes);
+    }
+
+    tc_double dRangeUs = elapsedMilliSeconds(objStart) * 1000 / iNumRuns;
+    objStart = tc_clock::now();
+
+    for ( tc_int iRun = 0; iRun < iNumRuns; iRun++ ) {
+      ui64Random ^= ui64Random << 13; ui64Random ^= ui64Random >> 7; ui64Random ^= ui64Random << 17;
+      snprintf(acKey, sizeof(acKey), "sensor-%d/", (tc_int32) (ui64Random % (iNumKeys / 10)));
+
+      iSum += objDict.prefix(acKey, &tcaNodes);
+    }
+
+    tc_double dPrefixUs = elapsedMilliSeconds(objStart) * 1000 / iNumRuns;
+
+    printf("  %-7s build: %9.3f ms   queries: %8d   range: %12.2f us/query   prefix: %12.2f us/query\n",
+            (iPass ? "scan" : "ordered"), dBuildMs, iNumRuns, dRangeUs, dPrefixUs);
+  }
+
+  // Keeps the queries from being optimized away
+  if ( ! iSum )
+    cout << "  (checksum 0)" << endl;
+
+  return;
+}
+
+
+/*
+  iNumOps lookups/updates of iNumKeys int keys split over 1 to 64 threads, read heavy (95% reads) and write heavy (50%),
+  TeracadaConcurrentDict against a TeracadaDict behind a single mutex
+*/
+tc_void BenchmarkTeracadaDictConcurrent ( tc_int iNumOps, tc_int iNumKeys ) {
+  cout << ">>> Benchmarking TeracadaConcurrentDict vs. mutex guarded TeracadaDict [ OPS: " << iNumOps << " | KEYS: " << iNumKeys << " | CORES: " << thread::hardware_concurrency() << " ]" << endl;
+
+  for ( tc_int iReadPercent : { 95, 50 } ) {
+    for ( tc_int iNumThreads = 1; iNumThreads <= 64; iNumThreads *= 2 ) {
+      tc_double adMops[2] = {0};
+
+      for ( tc_int iPass = 0; iPass < 2; iPass++ ) {
+        TeracadaDict objDict;
+        TeracadaConcurrentDict objConcurrentDict;
+        mutex mtxDict;
+        vector<thread> vecThreads;
+
+        for ( tc_int iKey = 0; iKey < iNumKeys; iKey++ ) {
+          objDict.update<tc_int, tc_int>(iKey, iKey);
+          objConcurrentDict.update<tc_int, tc_int>(iKey, iKey);
+        }
+
+        tc_clock::time_point objStart = tc_clock::now();
+
+        for ( tc_int iThread = 0; iThread < iNumThreads; iThread++ ) {
+          vecThreads.emplace_back([&, iThread] ( void ) {
+            tc_uint64 ui64Random = 88172645463325252ULL + iThread;
+            tc_int iValue = 0;
+
+            for ( tc_int iOp = 0; iOp < iNumOps / iNumThreads; iOp++ ) {
+              ui64Random ^= ui64Random << 13; ui64Random ^= ui64Random >> 7; ui64Random ^= ui64Random << 17;
+              tc_int iKey = (tc_int) ((ui64Random >> 8) % iNumKeys);
+              tc_bool bRead = (tc_int) (ui64Random % 100) < iReadPercent;
+
+              if ( iPass ) {
+                if ( bRead )
+                  objConcurrentDict.get<tc_int, tc_int>(iKey, &iValue);
+                else
+                  objConcurrentDict.update<tc_int, tc_int>(iKey, iOp);
+              } else {
+                lock_guard<mutex> objLock(mtxDict);
+
+                if ( bRead )
+                  iValue = *((tc_int*) objDict.get<tc_int>(iKey));
+                else
+                  objDict.update<tc_int, tc_int>(iKey, iOp);
+              }
+            }
+          });
+        }
+
+        for ( thread& objThread : vecThreads )
+          objThread.join();
+
+        adMops[iPass] = iNumOps / (elapsedMilliSeconds(objStart) * 1000);
+      }
+
+      printf("  reads: %2d%%   threads: %2d   mutex: %8.2f M ops/s   concurrent: %8.2f M ops/s\n", iReadPercent, iNumThreads, adMops[0], adMops[1]);
+    }
+  }
+
+  return;
+}
+
+
+/*
+  Startup of a read mostly dictionary: iNumKeys string keys rebuilt with update() vs. saved once and mapped
+  with TeracadaDictSnapshot, then iNumLookups random lookups from the dict and from the mapped snapshot
+*/
+tc_void BenchmarkTeracadaDictSnapshot ( tc_int iNumKeys, tc_int iNumLookups ) {
+  const tc_char* pcSnapshotFilePath = "/tmp/teracada_dict_snapshot_benchmarks";
+  tc_char acKey[32] = {0};
+  tc_int64 iSum = 0;
+  tc_uint64 ui64Random = 88172645463325252ULL;
+  TeracadaDict objDict;
+  TeracadaDictSnapshot objSnapshot;
+
+  cout << ">>> Benchmarking TeracadaDict snapshots, rebuild vs. mmap [ KEYS: " << iNumKeys << " | LOOKUPS: " << iNumLookups << " ]" << endl;
+
+  tc_clock::time_point objStart = tc_clock::now();
+
+  for ( tc_int iKey = 0; iKey < iNumKeys; iKey++ ) {
+    snprintf(acKey, sizeof(acKey), "customer-%d", (tc_int32) iKey);
+    objDict.update<tc_str, tc_int>(acKey, iKey);
+  }
+
+  tc_double dBuildMs = elapsedMilliSeconds(objStart);
+  objStart = tc_clock::now();
+
+  if ( ! objDict.saveSnapshot(pcSnapshotFilePath) ) {
+    cout << "  Failed to save the snapshot" << endl;
+    return;
+  }
+
+  tc_double dSaveMs = elapsedMilliSeconds(objStart);
+  objStart = tc_clock::now();
+
+  if ( ! objSnapshot.open(pcSnapshotFilePath) ) {
+    cout << "  Failed to open the snapshot" << endl;
+    return;
+  }
+
+  tc_double dOpenMs = elapsedMilliSeconds(objStart);
+
+  printf("  rebuild: %9.3f ms   save: %9.3f ms   open: %9.3f ms\n", dBuildMs, dSaveMs, dOpenMs);
+
+  for ( tc_int iPass = 0; iPass < 2; iPass++ ) {
+    objStart = tc_clock::now();
+
+    for ( tc_int iLookup = 0; iLookup < iNumLookups; iLookup++ ) {
+      ui64Random ^= ui64Random << 13; ui64Random ^= ui64Random >> 7; ui64Random ^= ui64Random << 17;
+      snprintf(acKey, sizeof(acKey), "customer-%d", (tc_int32) (ui64Random % iNumKeys));
+
+      if ( iPass )
+        iSum += *((const tc_int*) objSnapshot.get<tc_str>(acKey));
+      else
+        iSum += *((tc_int*) objDict.get<tc_str>(acKey));
+    }
+
+    printf("  %-8s lookups: %8.1f ns/lookup\n", (iPass ? "snapshot" : "dict"), (elapsedMilliSeconds(objStart) * 1000000 / iNumLookups));
+  }
+
+  objSnapshot.close();
+  remove(pcSnapshotFilePath);
+
+  // Keeps the lookups from being optimized away
+  if ( ! iSum )
+    cout << "  (checksum 0)" << endl;
+
+  return;
+}
+
+
+/*
+  Usage: <benchmarks> [BENCHMARK_NAME] [NUM_NODES]
+    Runs all the benchmarks when BENCHMARK_NAME is not given (or is "all")
+*/
+int main ( int argc, char* argv[] ) {
+  const tc_char* pcBenchmark = (argc > 1) ? argv[1] : "all";
+  tc_int iNumNodes = (argc > 2) ? atol(argv[2]) : 0;
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "allocators") ) {
+    BenchmarkTeracadaDictAllocators(iNumNodes ? iNumNodes : 1000000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "lookup") ) {
+    if ( iNumNodes ) {
+      BenchmarkTeracadaDictLookup(iNumNodes, 1000000);
+    } else {
+      BenchmarkTeracadaDictLookup(10000, 1000000);
+      BenchmarkTeracadaDictLookup(1000000, 1000000);
+    }
+
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "updates") ) {
+    BenchmarkTeracadaDictUpdates((iNumNodes ? iNumNodes : 10000000), 1000);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "range") ) {
+    BenchmarkTeracadaDictRange((iNumNodes ? iNumNodes : 1000000), 100000, 100);
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "concurrent") ) {
+    BenchmarkTeracadaDictConcurrent(4000000, (iNumNodes ? iNumNodes : 100000));
+    cout << endl;
+  }
+
+  if ( ! strcmp(pcBenchmark, "all") || ! strcmp(pcBenchmark, "snapshot") ) {
+    BenchmarkTeracadaDictSnapshot((iNumNodes ? iNumNodes : 1000000), 1000000);
+    cout << endl;
+  }
+
+  return 0;
+}
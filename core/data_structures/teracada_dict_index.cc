@@ -0,0 +1,606 @@
+#include <cstring>
+
+#include <teracada_dict_index.h>
+
+
+TeracadaDictIndex::TeracadaDictIndex ( TeracadaAllocator* pobjAllocator, tc_uint64 ui64NumKeys,
+                                       const TeracadaStringPool* pobjKeyPool, tc_bool bOrdered ) :
+  m_pstSlots(nullptr),
+  m_ui64NumSlots(0),
+  m_ui64NumKeys(0),
+  m_pstTreeRoot(nullptr),
+  m_ui64NumTreeNodes(0),
+  m_bOrdered(bOrdered),
+  m_ui32NumSpareNodes(0),
+  m_pobjKeyPool(pobjKeyPool),
+  m_pobjAllocator(pobjAllocator ? pobjAllocator : TeracadaAllocator::getDefault())
+{
+  tc_uint64 ui64NumSlots = TD_INDEX_MIN_NUM_SLOTS;
+
+  // Room for ui64NumKeys keys without growing
+  while ( (ui64NumKeys * 8) > (ui64NumSlots * 7) )
+    ui64NumSlots *= 2;
+
+  m_pstSlots = (stdIndexSlot*) m_pobjAllocator->allocate(ui64NumSlots * sizeof(stdIndexSlot), true);
+
+  if ( m_pstSlots )
+    m_ui64NumSlots = ui64NumSlots;
+}
+
+
+TeracadaDictIndex::~TeracadaDictIndex ( void ) {
+  freeTree(m_pstTreeRoot);
+
+  if ( m_pstSlots )
+    m_pobjAllocator->deallocate(m_pstSlots, (m_ui64NumSlots * sizeof(stdIndexSlot)));
+}
+
+
+// Key words are mixed (splitmix64 finalizer), the tc_int keys and the pool ids are dense and would cluster otherwise
+tc_uint64 TeracadaDictIndex::hashKey ( tc_byte b8DataType, tc_uint64 ui64Key ) {
+  tc_uint64 ui64Hash = ui64Key + ((tc_uint64) b8DataType << 56) + 0x9e3779b97f4a7c15ULL;
+
+  ui64Hash = (ui64Hash ^ (ui64Hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  ui64Hash = (ui64Hash ^ (ui64Hash >> 27)) * 0x94d049bb133111ebULL;
+
+  return (ui64Hash ^ (ui64Hash >> 31));
+}
+
+
+tc_uint64 TeracadaDictIndex::decimalKey ( tc_decimal dKey ) {
+  if ( dKey == 0 )
+    return 0;
+
+  if constexpr ( sizeof(tc_decimal) == sizeof(tc_uint32) ) {
+    tc_uint32 ui32Key = 0;
+    memcpy(&ui32Key, &dKey, sizeof(ui32Key));
+
+    return ui32Key;
+  } else {
+    tc_uint64 ui64Key = 0;
+    memcpy(&ui64Key, &dKey, sizeof(ui64Key));
+
+    return ui64Key;
+  }
+}
+
+
+stdTeracadaDictKey TeracadaDictIndex::sortKey ( tc_int iKey ) {
+  return { TC_INT, ((tc_uint64) (tc_int64) iKey ^ (1ULL << 63)), std::string_view() };
+}
+
+
+// Positive decimals get the sign bit set, negative ones are inverted so that a larger magnitude sorts first
+stdTeracadaDictKey TeracadaDictIndex::sortKey ( tc_decimal dKey ) {
+  tc_double dValue = (dKey == 0) ? 0 : (tc_double) dKey;
+  tc_uint64 ui64Word = 0;
+
+  memcpy(&ui64Word, &dValue, sizeof(ui64Word));
+  ui64Word = (ui64Word >> 63) ? ~ui64Word : (ui64Word | (1ULL << 63));
+
+  return { TC_DECIMAL, ui64Word, std::string_view() };
+}
+
+
+stdTeracadaDictKey TeracadaDictIndex::sortKey ( std::string_view svKey ) {
+  tc_uint64 ui64Word = 0;
+
+  for ( tc_uint64 ui64Byte = 0; ui64Byte < 8; ui64Byte++ ) {
+    ui64Word <<= 8;
+
+    if ( ui64Byte < svKey.size() )
+      ui64Word |= (tc_byte) svKey[ui64Byte];
+  }
+
+  return { TC_STRING, ui64Word, svKey };
+}
+
+
+stdTeracadaDictKey TeracadaDictIndex::sortKey ( tc_dict ptcdNode, const TeracadaStringPool* pobjKeyPool ) {
+  switch ( ptcdNode->b8DataTypeKey ) {
+    case TC_INT:
+      return sortKey(ptcdNode->unKey.iInt);
+
+    case TC_DECIMAL:
+      return sortKey(ptcdNode->unKey.dDecimal);
+
+    case TC_STRING:
+      return sortKey(pobjKeyPool->get(ptcdNode->unKey.iStringId));
+
+    default:
+      return { TC_NONE, 0, std::string_view() };
+  }
+}
+
+
+tc_int TeracadaDictIndex::compareKeys ( const stdTeracadaDictKey& stKeyA, const stdTeracadaDictKey& stKeyB ) {
+  if ( stKeyA.b8DataType != stKeyB.b8DataType )
+    return (stKeyA.b8DataType < stKeyB.b8DataType) ? -1 : 1;
+
+  if ( stKeyA.ui64Word != stKeyB.ui64Word )
+    return (stKeyA.ui64Word < stKeyB.ui64Word) ? -1 : 1;
+
+  if ( stKeyA.b8DataType != TC_STRING )
+    return 0;
+
+  // Same first 8 bytes, char_traits<char> compares as unsigned bytes like the words
+  tc_int iCompare = stKeyA.svString.compare(stKeyB.svString);
+  return (iCompare < 0) ? -1 : (iCompare > 0);
+}
+
+
+tc_bool TeracadaDictIndex::growSlots ( void ) {
+  stdIndexSlot* pstPreSlots = m_pstSlots;
+  tc_uint64 ui64PreNumSlots = m_ui64NumSlots;
+  tc_uint64 ui64NewNumSlots = m_ui64NumSlots ? (m_ui64NumSlots * 2) : TD_INDEX_MIN_NUM_SLOTS;
+
+  stdIndexSlot* pstNewSlots = (stdIndexSlot*) m_pobjAllocator->allocate(ui64NewNumSlots * sizeof(stdIndexSlot), true);
+
+  if ( ! pstNewSlots )
+    return false;
+
+  m_pstSlots = pstNewSlots;
+  m_ui64NumSlots = ui64NewNumSlots;
+  m_ui64NumKeys = 0;
+
+  for ( tc_uint64 ui64Slot = 0; ui64Slot < ui64PreNumSlots; ui64Slot++ ) {
+    if ( pstPreSlots[ui64Slot].ui32Distance ) {
+      pstPreSlots[ui64Slot].ui32Distance = 1;
+      insertSlot(pstPreSlots[ui64Slot]);
+    }
+  }
+
+  if ( pstPreSlots )
+    m_pobjAllocator->deallocate(pstPreSlots, (ui64PreNumSlots * sizeof(stdIndexSlot)));
+
+  return true;
+}
+
+
+// Robin Hood insert of a key known not to be in the table, there is always a free slot
+tc_bool TeracadaDictIndex::insertSlot ( stdIndexSlot stSlot ) {
+  tc_uint64 ui64Mask = m_ui64NumSlots - 1;
+  tc_uint64 ui64Slot = hashKey(stSlot.b8DataType, stSlot.ui64Key) & ui64Mask;
+
+  while ( m_pstSlots[ui64Slot].ui32Distance ) {
+    // The resident is closer to its home slot, it gives its slot away and moves on
+    if ( m_pstSlots[ui64Slot].ui32Distance < stSlot.ui32Distance ) {
+      stdIndexSlot stResident = m_pstSlots[ui64Slot];
+      m_pstSlots[ui64Slot] = stSlot;
+      stSlot = stResident;
+    }
+
+    stSlot.ui32Distance++;
+    ui64Slot = (ui64Slot + 1) & ui64Mask;
+  }
+
+  m_pstSlots[ui64Slot] = stSlot;
+  m_ui64NumKeys++;
+
+  return true;
+}
+
+
+tc_bool TeracadaDictIndex::insert ( tc_byte b8DataType, tc_uint64 ui64Key, tc_dict ptcdNode, tc_index iNodeIndex ) {
+  if ( findSlot(b8DataType, ui64Key) != m_ui64NumSlots )
+    return true;
+
+  if ( ((m_ui64NumKeys + 1) * 8) > (m_ui64NumSlots * 7) ) {
+    if ( ! growSlots() )
+      return false;
+  }
+
+  if ( m_bOrdered && ! treeInsert(ptcdNode) )
+    return false;
+
+  return insertSlot({ ui64Key, ptcdNode, iNodeIndex, 1, b8DataType });
+}
+
+
+// Slot of the key, m_ui64NumSlots if the key is not in the table
+tc_uint64 TeracadaDictIndex::findSlot ( tc_byte b8DataType, tc_uint64 ui64Key ) const {
+  if ( ! m_ui64NumKeys )
+    return m_ui64NumSlots;
+
+  tc_uint64 ui64Mask = m_ui64NumSlots - 1;
+  tc_uint64 ui64Slot = hashKey(b8DataType, ui64Key) & ui64Mask;
+
+  // Past the first slot whose key is closer to its home than the searched key would be, the key can't be in the table
+  for ( tc_uint32 ui32Distance = 1; m_pstSlots[ui64Slot].ui32Distance >= ui32Distance; ui32Distance++ ) {
+    if ( m_pstSlots[ui64Slot].ui64Key == ui64Key && m_pstSlots[ui64Slot].b8DataType == b8DataType )
+      return ui64Slot;
+
+    ui64Slot = (ui64Slot + 1) & ui64Mask;
+  }
+
+  return m_ui64NumSlots;
+}
+
+
+tc_dict TeracadaDictIndex::find ( tc_byte b8DataType, tc_uint64 ui64Key, tc_index* piNodeIndex ) const {
+  tc_uint64 ui64Slot = findSlot(b8DataType, ui64Key);
+
+  if ( ui64Slot == m_ui64NumSlots )
+    return nullptr;
+
+  if ( piNodeIndex )
+    *piNodeIndex = m_pstSlots[ui64Slot].iNodeIndex;
+
+  return m_pstSlots[ui64Slot].ptcdNode;
+}
+
+
+tc_bool TeracadaDictIndex::assign ( tc_byte b8DataType, tc_uint64 ui64Key, tc_index iNodeIndex ) {
+  tc_uint64 ui64Slot = findSlot(b8DataType, ui64Key);
+
+  if ( ui64Slot == m_ui64NumSlots )
+    return false;
+
+  m_pstSlots[ui64Slot].iNodeIndex = iNodeIndex;
+  return true;
+}
+
+
+tc_bool TeracadaDictIndex::erase ( tc_byte b8DataType, tc_uint64 ui64Key ) {
+  tc_uint64 ui64Mask = m_ui64NumSlots - 1;
+  tc_uint64 ui64Slot = findSlot(b8DataType, ui64Key);
+
+  if ( ui64Slot == m_ui64NumSlots )
+    return false;
+
+  if ( m_bOrdered )
+    treeErase(m_pstSlots[ui64Slot].ptcdNode);
+
+  // Shift the following keys of the cluster one slot back, up to an empty slot or a key in its home slot
+  for ( tc_uint64 ui64Next = (ui64Slot + 1) & ui64Mask; m_pstSlots[ui64Next].ui32Distance > 1; ui64Next = (ui64Next + 1) & ui64Mask ) {
+    m_pstSlots[ui64Slot] = m_pstSlots[ui64Next];
+    m_pstSlots[ui64Slot].ui32Distance--;
+    ui64Slot = ui64Next;
+  }
+
+  m_pstSlots[ui64Slot].ui32Distance = 0;
+  m_ui64NumKeys--;
+
+  return true;
+}
+
+
+tc_void TeracadaDictIndex::clear ( void ) {
+  if ( m_pstSlots )
+    memset(m_pstSlots, 0, (m_ui64NumSlots * sizeof(stdIndexSlot)));
+
+  freeTree(m_pstTreeRoot);
+  m_pstTreeRoot = nullptr;
+
+  m_ui64NumKeys = 0;
+}
+
+
+TeracadaDictIndex::stdTreeNode* TeracadaDictIndex::newTreeNode ( tc_bool bLeaf ) {
+  stdTreeNode* pstNode = (stdTreeNode*) m_pobjAllocator->allocate(sizeof(stdTreeNode), true);
+
+  if ( ! pstNode )
+    return nullptr;
+
+  pstNode->bLeaf = bLeaf;
+  m_ui64NumTreeNodes++;
+
+  return pstNode;
+}
+
+
+tc_void TeracadaDictIndex::freeTree ( stdTreeNode* pstNode ) {
+  if ( ! pstNode )
+    return;
+
+  if ( ! pstNode->bLeaf ) {
+    for ( tc_uint32 ui32Entry = 0; ui32Entry < pstNode->ui32NumKeys; ui32Entry++ )
+      freeTree(pstNode->apstChildren[ui32Entry]);
+  }
+
+  m_pobjAllocator->deallocate(pstNode, sizeof(stdTreeNode));
+  m_ui64NumTreeNodes--;
+}
+
+
+// Compares the key with the key of an entry of the tree node, the string of the entry is only read when the words tie
+tc_int TeracadaDictIndex::compareEntry ( const stdTeracadaDictKey& stKey, const stdTreeNode* pstNode, tc_uint32 ui32Entry ) const {
+  if ( stKey.b8DataType != pstNode->ab8DataTypes[ui32Entry] )
+    return (stKey.b8DataType < pstNode->ab8DataTypes[ui32Entry]) ? -1 : 1;
+
+  if ( stKey.ui64Word != pstNode->aui64Words[ui32Entry] )
+    return (stKey.ui64Word < pstNode->aui64Words[ui32Entry]) ? -1 : 1;
+
+  if ( stKey.b8DataType != TC_STRING )
+    return 0;
+
+  tc_index iStringId = pstNode->bLeaf ? pstNode->aptcdNodes[ui32Entry]->unKey.iStringId : pstNode->aiStringIds[ui32Entry];
+  tc_int iCompare = stKey.svString.compare(m_pobjKeyPool->get(iStringId));
+
+  return (iCompare < 0) ? -1 : (iCompare > 0);
+}
+
+
+// Child of the inner node whose keys range covers the key: the last separator not greater than the key (the first child if none)
+tc_uint32 TeracadaDictIndex::findChild ( const stdTreeNode* pstNode, const stdTeracadaDictKey& stKey ) const {
+  tc_uint32 ui32Low = 1;
+  tc_uint32 ui32High = pstNode->ui32NumKeys;
+
+  // Binary search, a tie of the string words costs a string compare
+  while ( ui32Low < ui32High ) {
+    tc_uint32 ui32Mid = (ui32Low + ui32High) / 2;
+
+    if ( compareEntry(stKey, pstNode, ui32Mid) >= 0 )
+      ui32Low = ui32Mid + 1;
+    else
+      ui32High = ui32Mid;
+  }
+
+  return ui32Low - 1;
+}
+
+
+// First entry of the leaf with a key not less than the key (ui32NumKeys if none)
+tc_uint32 TeracadaDictIndex::findEntry ( const stdTreeNode* pstNode, const stdTeracadaDictKey& stKey ) const {
+  tc_uint32 ui32Low = 0;
+  tc_uint32 ui32High = pstNode->ui32NumKeys;
+
+  while ( ui32Low < ui32High ) {
+    tc_uint32 ui32Mid = (ui32Low + ui32High) / 2;
+
+    if ( compareEntry(stKey, pstNode, ui32Mid) > 0 )
+      ui32Low = ui32Mid + 1;
+    else
+      ui32High = ui32Mid;
+  }
+
+  return ui32Low;
+}
+
+
+// Moves the upper half of the full tree node to a new right sibling, taken from the nodes reserved by treeInsert()
+TeracadaDictIndex::stdTreeNode* TeracadaDictIndex::splitTreeNode ( stdTreeNode* pstNode ) {
+  stdTreeNode* pstRight = m_apstSpareNodes[--m_ui32NumSpareNodes];
+
+  pstRight->bLeaf = pstNode->bLeaf;
+
+  tc_uint32 ui32Half = pstNode->ui32NumKeys / 2;
+  tc_uint32 ui32NumMoved = pstNode->ui32NumKeys - ui32Half;
+
+  memcpy(pstRight->aui64Words, (pstNode->aui64Words + ui32Half), (ui32NumMoved * sizeof(tc_uint64)));
+  memcpy(pstRight->ab8DataTypes, (pstNode->ab8DataTypes + ui32Half), (ui32NumMoved * sizeof(tc_byte)));
+
+  if ( pstNode->bLeaf ) {
+    memcpy(pstRight->aptcdNodes, (pstNode->aptcdNodes + ui32Half), (ui32NumMoved * sizeof(tc_dict)));
+
+    pstRight->pstNext = pstNode->pstNext;
+    pstNode->pstNext = pstRight;
+  } else {
+    memcpy(pstRight->aiStringIds, (pstNode->aiStringIds + ui32Half), (ui32NumMoved * sizeof(tc_index)));
+    memcpy(pstRight->apstChildren, (pstNode->apstChildren + ui32Half), (ui32NumMoved * sizeof(stdTreeNode*)));
+  }
+
+  pstRight->ui32NumKeys = ui32NumMoved;
+  pstNode->ui32NumKeys = ui32Half;
+
+  return pstRight;
+}
+
+
+// Separator entry of the inner node for the child: the smallest key of the child
+tc_void TeracadaDictIndex::setSeparator ( stdTreeNode* pstNode, tc_uint32 ui32Entry, stdTreeNode* pstChild ) {
+  pstNode->aui64Words[ui32Entry] = pstChild->aui64Words[0];
+  pstNode->ab8DataTypes[ui32Entry] = pstChild->ab8DataTypes[0];
+  pstNode->aiStringIds[ui32Entry] = pstChild->bLeaf ? pstChild->aptcdNodes[0]->unKey.iStringId : pstChild->aiStringIds[0];
+  pstNode->apstChildren[ui32Entry] = pstChild;
+}
+
+
+/*
+  Insert an entry in the tree node, the key and dict node in a leaf, the separator of the child in an inner node,
+  the new right sibling is returned when the tree node had to be split (nullptr otherwise)
+*/
+TeracadaDictIndex::stdTreeNode* TeracadaDictIndex::insertEntry ( stdTreeNode* pstNode, tc_uint32 ui32Entry, const stdTeracadaDictKey& stKey, tc_dict ptcdNode, stdTreeNode* pstChild ) {
+  stdTreeNode* pstRight = nullptr;
+  stdTreeNode* pstTarget = pstNode;
+
+  if ( pstNode->ui32NumKeys == TD_BTREE_NODE_NUM_KEYS ) {
+    pstRight = splitTreeNode(pstNode);
+
+    if ( ui32Entry > pstNode->ui32NumKeys ) {
+      ui32Entry -= pstNode->ui32NumKeys;
+      pstTarget = pstRight;
+    }
+  }
+
+  tc_uint32 ui32NumMoved = pstTarget->ui32NumKeys - ui32Entry;
+
+  memmove((pstTarget->aui64Words + ui32Entry + 1), (pstTarget->aui64Words + ui32Entry), (ui32NumMoved * sizeof(tc_uint64)));
+  memmove((pstTarget->ab8DataTypes + ui32Entry + 1), (pstTarget->ab8DataTypes + ui32Entry), (ui32NumMoved * sizeof(tc_byte)));
+
+  if ( pstTarget->bLeaf ) {
+    memmove((pstTarget->aptcdNodes + ui32Entry + 1), (pstTarget->aptcdNodes + ui32Entry), (ui32NumMoved * sizeof(tc_dict)));
+
+    pstTarget->aui64Words[ui32Entry] = stKey.ui64Word;
+    pstTarget->ab8DataTypes[ui32Entry] = stKey.b8DataType;
+    pstTarget->aptcdNodes[ui32Entry] = ptcdNode;
+  } else {
+    memmove((pstTarget->aiStringIds + ui32Entry + 1), (pstTarget->aiStringIds + ui32Entry), (ui32NumMoved * sizeof(tc_index)));
+    memmove((pstTarget->apstChildren + ui32Entry + 1), (pstTarget->apstChildren + ui32Entry), (ui32NumMoved * sizeof(stdTreeNode*)));
+
+    setSeparator(pstTarget, ui32Entry, pstChild);
+  }
+
+  pstTarget->ui32NumKeys++;
+
+  return pstRight;
+}
+
+
+// Add the dict node (whose key is not in the tree) to the ordered index, false on allocation failure (the tree is left unchanged)
+tc_bool TeracadaDictIndex::treeInsert ( tc_dict ptcdNode ) {
+  stdTeracadaDictKey stKey = sortKey(ptcdNode, m_pobjKeyPool);
+  stdTreeNode* apstPath[TD_BTREE_MAX_DEPTH];
+  tc_uint32 aui32Entries[TD_BTREE_MAX_DEPTH];
+  stdTreeNode* pstNode = m_pstTreeRoot;
+  stdTreeNode* pstRight = nullptr;
+  tc_uint32 ui32NumSplits = 0;
+  tc_uint32 ui32Depth = 0;
+
+  if ( ! m_pstTreeRoot ) {
+    m_pstTreeRoot = newTreeNode(true);
+
+    if ( ! m_pstTreeRoot )
+      return false;
+
+    pstNode = m_pstTreeRoot;
+  }
+
+  // Path down to the leaf, with the entry to insert at in the leaf and the child followed in the inner nodes
+  for ( ; pstNode; ui32Depth++ ) {
+    apstPath[ui32Depth] = pstNode;
+    aui32Entries[ui32Depth] = pstNode->bLeaf ? findEntry(pstNode, stKey) : findChild(pstNode, stKey);
+
+    // Full nodes split bottom up from the leaf, up to the first one with room
+    ui32NumSplits = (pstNode->ui32NumKeys == TD_BTREE_NODE_NUM_KEYS) ? (ui32NumSplits + 1) : 0;
+    pstNode = pstNode->bLeaf ? nullptr : pstNode->apstChildren[aui32Entries[ui32Depth]];
+  }
+
+  // A split root also needs a new root
+  for ( m_ui32NumSpareNodes = 0; m_ui32NumSpareNodes < ui32NumSplits + (ui32NumSplits == ui32Depth); m_ui32NumSpareNodes++ ) {
+    m_apstSpareNodes[m_ui32NumSpareNodes] = newTreeNode(true);
+
+    if ( ! m_apstSpareNodes[m_ui32NumSpareNodes] ) {
+      while ( m_ui32NumSpareNodes )
+        freeTree(m_apstSpareNodes[--m_ui32NumSpareNodes]);
+
+      return false;
+    }
+  }
+
+  pstRight = insertEntry(apstPath[ui32Depth - 1], aui32Entries[ui32Depth - 1], stKey, ptcdNode, nullptr);
+
+  // The separator of a split node goes right after the child that was followed
+  for ( tc_uint32 ui32Level = ui32Depth - 1; pstRight && ui32Level > 0; ui32Level-- )
+    pstRight = insertEntry(apstPath[ui32Level - 1], (aui32Entries[ui32Level - 1] + 1), stKey, nullptr, pstRight);
+
+  if ( ! pstRight )
+    return true;
+
+  // The root was split, it gets a parent with the two halves as its children
+  stdTreeNode* pstRoot = m_apstSpareNodes[--m_ui32NumSpareNodes];
+
+  pstRoot->bLeaf = false;
+
+  setSeparator(pstRoot, 0, m_pstTreeRoot);
+  setSeparator(pstRoot, 1, pstRight);
+
+  pstRoot->ui32NumKeys = 2;
+  m_pstTreeRoot = pstRoot;
+
+  return true;
+}
+
+
+// Remove the dict node from its leaf, the separators stay valid bounds so the inner nodes are left as they are
+tc_void TeracadaDictIndex::treeErase ( tc_dict ptcdNode ) {
+  stdTreeNode* pstNode = m_pstTreeRoot;
+  stdTeracadaDictKey stKey = sortKey(ptcdNode, m_pobjKeyPool);
+
+  if ( ! pstNode )
+    return;
+
+  while ( ! pstNode->bLeaf )
+    pstNode = pstNode->apstChildren[findChild(pstNode, stKey)];
+
+  tc_uint32 ui32Entry = findEntry(pstNode, stKey);
+
+  if ( ui32Entry == pstNode->ui32NumKeys || pstNode->aptcdNodes[ui32Entry] != ptcdNode )
+    return;
+
+  tc_uint32 ui32NumMoved = pstNode->ui32NumKeys - ui32Entry - 1;
+
+  memmove((pstNode->aui64Words + ui32Entry), (pstNode->aui64Words + ui32Entry + 1), (ui32NumMoved * sizeof(tc_uint64)));
+  memmove((pstNode->ab8DataTypes + ui32Entry), (pstNode->ab8DataTypes + ui32Entry + 1), (ui32NumMoved * sizeof(tc_byte)));
+  memmove((pstNode->aptcdNodes + ui32Entry), (pstNode->aptcdNodes + ui32Entry + 1), (ui32NumMoved * sizeof(tc_dict)));
+
+  pstNode->ui32NumKeys--;
+}
+
+
+// Leaf and entry of the first key not less than the key, nullptr past the last key
+const TeracadaDictIndex::stdTreeNode* TeracadaDictIndex::treeLowerBound ( const stdTeracadaDictKey& stKey, tc_uint32* pui32Entry ) const {
+  const stdTreeNode* pstNode = m_pstTreeRoot;
+
+  if ( ! pstNode )
+    return nullptr;
+
+  while ( ! pstNode->bLeaf )
+    pstNode = pstNode->apstChildren[findChild(pstNode, stKey)];
+
+  tc_uint32 ui32Entry = findEntry(pstNode, stKey);
+
+  // Past the end of the leaf (or an emptied leaf), the key is the first one of the next non empty leaf
+  while ( pstNode && ui32Entry == pstNode->ui32NumKeys ) {
+    pstNode = pstNode->pstNext;
+    ui32Entry = 0;
+  }
+
+  *pui32Entry = ui32Entry;
+  return pstNode;
+}
+
+
+tc_dict TeracadaDictIndex::lowerBound ( const stdTeracadaDictKey& stKey ) const {
+  tc_uint32 ui32Entry = 0;
+  const stdTreeNode* pstNode = treeLowerBound(stKey, &ui32Entry);
+
+  // The keys of the next data type are not bounds
+  if ( ! pstNode || pstNode->ab8DataTypes[ui32Entry] != stKey.b8DataType )
+    return nullptr;
+
+  return pstNode->aptcdNodes[ui32Entry];
+}
+
+
+tc_index TeracadaDictIndex::range ( const stdTeracadaDictKey& stLow, const stdTeracadaDictKey& stHigh, tca_dict* ptcaNodes ) const {
+  tc_uint32 ui32Entry = 0;
+  tc_index iNumNodes = 0;
+
+  for ( const stdTreeNode* pstNode = treeLowerBound(stLow, &ui32Entry); pstNode; pstNode = pstNode->pstNext, ui32Entry = 0 ) {
+    for ( ; ui32Entry < pstNode->ui32NumKeys; ui32Entry++ ) {
+      if ( compareEntry(stHigh, pstNode, ui32Entry) <= 0 )
+        return iNumNodes;
+
+      if ( ptcaNodes->insertBack(pstNode->aptcdNodes[ui32Entry]) < 0 )
+        return TA_NONE_INDEX;
+
+      iNumNodes++;
+    }
+  }
+
+  return iNumNodes;
+}
+
+
+tc_index TeracadaDictIndex::prefix ( std::string_view svPrefix, tca_dict* ptcaNodes ) const {
+  tc_uint32 ui32Entry = 0;
+  tc_index iNumNodes = 0;
+
+  // The keys with the prefix follow the prefix itself in key order
+  for ( const stdTreeNode* pstNode = treeLowerBound(sortKey(svPrefix), &ui32Entry); pstNode; pstNode = pstNode->pstNext, ui32Entry = 0 ) {
+    for ( ; ui32Entry < pstNode->ui32NumKeys; ui32Entry++ ) {
+      tc_dict ptcdNode = pstNode->aptcdNodes[ui32Entry];
+
+      if ( ptcdNode->b8DataTypeKey != TC_STRING || m_pobjKeyPool->get(ptcdNode->unKey.iStringId).substr(0, svPrefix.size()) != svPrefix )
+        return iNumNodes;
+
+      if ( ptcaNodes->insertBack(ptcdNode) < 0 )
+        return TA_NONE_INDEX;
+
+      iNumNodes++;
+    }
+  }
+
+  return iNumNodes;
+}
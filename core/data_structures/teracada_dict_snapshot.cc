@@ -0,0 +1,464 @@
+/*!
+  @file
+    Implementation of the TeracadaDict snapshots
+
+  @details
+    File layout, all the references are offsets so the file is used as mapped, at any address:
+    - stdTeracadaDictSnapshotHeader
+    - String arena: the null terminated key and value strings, every distinct key string once
+    - Node table (aligned to TD_SNAPSHOT_ALIGNMENT): stdTeracadaDictSnapshotNode, level by level in breadth first order,
+      the root level first, the nodes of every level sorted by key so that a lookup is a binary search of its level
+*/
+
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <teracada_dict_snapshot.h>
+
+
+/*!
+  @brief
+    Write the dict to a snapshot file
+
+  @details
+    The nodes are laid out breadth first, each level sorted by key, the string keys are written once per distinct key.
+    The snapshot is written to <pcFilePath>.tmp, synced and renamed over pcFilePath, so the processes that still have
+    the previous snapshot mapped keep reading it and the path always holds a complete snapshot.
+    A failed write removes the temporary file and leaves the previous snapshot in place.
+
+  @param[in]
+    pcFilePath The file to write the snapshot to
+
+  @retval
+    true Successfully written the snapshot
+
+  @retval
+    false Failed to allocate the node table or to open/write/rename the file
+*/
+tc_bool TeracadaDict::saveSnapshot ( const tc_char* pcFilePath ) {
+  stdTeracadaDictSnapshotHeader stHeader;
+  stdTeracadaDictSnapshotNode* pstNodes = nullptr;
+  tc_uint64* pui64KeyOffsets = nullptr;
+  tc_uint64 ui64NumKeyIds = m_pobjKeyPool->getNumElements();
+  tc_uint64 ui64NumNodes = 0;
+  tc_uint64 ui64NextChild = 0;
+  tc_uint64 ui64Padding = 0;
+  tc_bool bSuccess = false;
+  tc_bool bTmpFile = false;
+  tc_int iFd = -1;
+  std::string strTmpFilePath = std::string(pcFilePath) + ".tmp";
+  tca_dict tcaOrder(m_ptcaDictRoot->getNumElements() + 1, false, m_pobjAllocator);
+  std::ofstream objFd;
+
+  static const tc_char acPadding[TD_SNAPSHOT_ALIGNMENT] = {0};
+
+  memset(&stHeader, 0, sizeof(stHeader));
+
+  // Breadth first order of the nodes, the children of every node are appended and sorted as a level
+  for ( tc_dict ptcdNode : m_ptcaDictRoot->view() ) {
+    if ( tcaOrder.insertBack(ptcdNode) < 0 )
+      goto EXIT;
+  }
+
+  if ( ! sortNodes(&tcaOrder) )
+    goto EXIT;
+
+  stHeader.ui64NumRootNodes = tcaOrder.getNumElements();
+
+  for ( tc_index iNodeIndex = 0; iNodeIndex < tcaOrder.getNumElements(); iNodeIndex++ ) {
+    tc_dict ptcdNode = tcaOrder[iNodeIndex];
+    tc_index iFirstChild = tcaOrder.getNumElements();
+
+    if ( ! ptcdNode->ptcaNext || ! ptcdNode->ptcaNext->getNumElements() )
+      continue;
+
+    for ( tc_dict ptcdChild : ptcdNode->ptcaNext->view() ) {
+      if ( tcaOrder.insertBack(ptcdChild) < 0 )
+        goto EXIT;
+    }
+
+    if ( ! sortNodes(&tcaOrder, iFirstChild) )
+      goto EXIT;
+  }
+
+  ui64NumNodes = tcaOrder.getNumElements();
+  pstNodes = (stdTeracadaDictSnapshotNode*) m_pobjAllocator->allocate((ui64NumNodes * sizeof(stdTeracadaDictSnapshotNode)), true);
+  pui64KeyOffsets = (tc_uint64*) m_pobjAllocator->allocate((ui64NumKeyIds * sizeof(tc_uint64)), false);
+
+  if ( (ui64NumNodes && ! pstNodes) || (ui64NumKeyIds && ! pui64KeyOffsets) ) {
+    TC_LOG(LOG_ERR, "TeracadaDict::saveSnapshot(): Failed to allocate the node table [ NUM_NODES: %lu ]", ui64NumNodes);
+    goto EXIT;
+  }
+
+  // Offset of every key string in the arena, once it is written
+  if ( pui64KeyOffsets )
+    memset(pui64KeyOffsets, 0xff, (ui64NumKeyIds * sizeof(tc_uint64)));
+
+  // The mapped snapshot file is never rewritten in place, a reader mapping it would fault on the truncated pages
+  objFd.open(strTmpFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if ( objFd.fail() ) {
+    TC_LOG(LOG_ERR, "TeracadaDict::saveSnapshot(): Failed to open the snapshot file [ FILE_PATH: %s ]", strTmpFilePath.c_str());
+    goto EXIT;
+  }
+
+  bTmpFile = true;
+
+  // Placeholder, the header is written once the file is complete
+  objFd.write((const tc_char*) &stHeader, sizeof(stHeader));
+  stHeader.ui64StringsOffset = sizeof(stHeader);
+
+  ui64NextChild = stHeader.ui64NumRootNodes;
+
+  for ( tc_uint64 ui64Node = 0; ui64Node < ui64NumNodes; ui64Node++ ) {
+    tc_dict ptcdNode = tcaOrder[ui64Node];
+    stdTeracadaDictSnapshotNode* pstNode = &pstNodes[ui64Node];
+
+    pstNode->ui64KeyWord = TeracadaDictIndex::sortKey(ptcdNode, m_pobjKeyPool).ui64Word;
+    pstNode->b8DataTypeKey = ptcdNode->b8DataTypeKey;
+    pstNode->b8DataTypeVal = ptcdNode->b8DataTypeVal;
+
+    if ( ptcdNode->b8DataTypeKey == TC_INT )
+      pstNode->unKey.iInt = ptcdNode->unKey.iInt;
+
+    if ( ptcdNode->b8DataTypeKey == TC_DECIMAL )
+      pstNode->unKey.dDecimal = ptcdNode->unKey.dDecimal;
+
+    if ( ptcdNode->b8DataTypeKey == TC_STRING ) {
+      std::string_view svKey = m_pobjKeyPool->get(ptcdNode->unKey.iStringId);
+
+      if ( pui64KeyOffsets[ptcdNode->unKey.iStringId] == (tc_uint64) -1 ) {
+        pui64KeyOffsets[ptcdNode->unKey.iStringId] = stHeader.ui64StringsSize;
+
+        objFd.write(svKey.data(), svKey.size()).put('\0');
+        stHeader.ui64StringsSize += svKey.size() + 1;
+      }
+
+      pstNode->unKey.ui64Offset = pui64KeyOffsets[ptcdNode->unKey.iStringId];
+      pstNode->ui32KeyLength = (tc_uint32) svKey.size();
+    }
+
+    if ( ptcdNode->b8DataTypeVal == TC_INT )
+      pstNode->unVal.iInt = ptcdNode->unVal.iInt;
+
+    if ( ptcdNode->b8DataTypeVal == TC_DECIMAL )
+      pstNode->unVal.dDecimal = ptcdNode->unVal.dDecimal;
+
+    if ( ptcdNode->b8DataTypeVal == TC_STRING ) {
+      const tc_char* pcValue = (const tc_char*) getNodeValue(ptcdNode);
+      tc_uint64 ui64Length = strlen(pcValue) + 1;
+
+      pstNode->unVal.ui64Offset = stHeader.ui64StringsSize;
+
+      objFd.write(pcValue, ui64Length);
+      stHeader.ui64StringsSize += ui64Length;
+    }
+
+    // The children follow the children of the previous nodes, in the order the levels were appended
+    pstNode->ui64FirstChild = ui64NextChild;
+    pstNode->ui32NumChildren = ptcdNode->ptcaNext ? (tc_uint32) ptcdNode->ptcaNext->getNumElements() : 0;
+    ui64NextChild += pstNode->ui32NumChildren;
+  }
+
+  stHeader.ui64NodesOffset = stHeader.ui64StringsOffset + stHeader.ui64StringsSize;
+  ui64Padding = (TD_SNAPSHOT_ALIGNMENT - (stHeader.ui64NodesOffset % TD_SNAPSHOT_ALIGNMENT)) % TD_SNAPSHOT_ALIGNMENT;
+  stHeader.ui64NodesOffset += ui64Padding;
+
+  objFd.write(acPadding, ui64Padding);
+  objFd.write((const tc_char*) pstNodes, (ui64NumNodes * sizeof(stdTeracadaDictSnapshotNode)));
+
+  memcpy(stHeader.acMagic, TD_SNAPSHOT_MAGIC, sizeof(TD_SNAPSHOT_MAGIC));
+  stHeader.ui32Version = TD_SNAPSHOT_VERSION;
+  stHeader.b8IntSize = sizeof(tc_int);
+  stHeader.b8DecimalSize = sizeof(tc_decimal);
+  stHeader.b8NodeSize = sizeof(stdTeracadaDictSnapshotNode);
+  stHeader.ui64NumNodes = ui64NumNodes;
+  stHeader.ui64FileSize = stHeader.ui64NodesOffset + (ui64NumNodes * sizeof(stdTeracadaDictSnapshotNode));
+
+  objFd.seekp(0);
+  objFd.write((const tc_char*) &stHeader, sizeof(stHeader));
+  objFd.close();
+
+  if ( objFd.fail() ) {
+    TC_LOG(LOG_ERR, "TeracadaDict::saveSnapshot(): Failed to write the snapshot file [ FILE_PATH: %s ]", strTmpFilePath.c_str());
+    goto EXIT;
+  }
+
+  // The data has to be on disk before the rename makes it visible under the snapshot path
+  iFd = ::open(strTmpFilePath.c_str(), O_RDONLY);
+
+  if ( iFd < 0 || fsync(iFd) != 0 ) {
+    TC_LOG(LOG_ERR, "TeracadaDict::saveSnapshot(): Failed to sync the snapshot file [ FILE_PATH: %s ]", strTmpFilePath.c_str());
+    goto EXIT;
+  }
+
+  if ( rename(strTmpFilePath.c_str(), pcFilePath) != 0 ) {
+    TC_LOG(LOG_ERR, "TeracadaDict::saveSnapshot(): Failed to rename the snapshot file [ FILE_PATH: %s ]", pcFilePath);
+    goto EXIT;
+  }
+
+  bSuccess = true;
+
+  EXIT:
+    if ( iFd >= 0 )
+      ::close(iFd);
+
+    if ( ! bSuccess && bTmpFile )
+      unlink(strTmpFilePath.c_str());
+
+    if ( pstNodes )
+      m_pobjAllocator->deallocate(pstNodes, (ui64NumNodes * sizeof(stdTeracadaDictSnapshotNode)));
+
+    if ( pui64KeyOffsets )
+      m_pobjAllocator->deallocate(pui64KeyOffsets, (ui64NumKeyIds * sizeof(tc_uint64)));
+
+    return bSuccess;
+}
+
+
+TeracadaDictSnapshot::TeracadaDictSnapshot ( void ) :
+  m_pb8Mapping(nullptr),
+  m_ui64MappingSize(0),
+  m_pstHeader(nullptr),
+  m_pstNodes(nullptr),
+  m_pcStrings(nullptr)
+{
+}
+
+
+TeracadaDictSnapshot::~TeracadaDictSnapshot ( void ) {
+  close();
+}
+
+
+/*!
+  @brief
+    Map a snapshot file written by TeracadaDict::saveSnapshot()
+
+  @details
+    The file is mapped read only and shared, only the header is read: the node table and the string arena
+    are paged in by the lookups, which check the children of the parent node and the strings of every node they read.
+    The string arena has to end with a null character, so every value string is terminated within the arena.
+    A snapshot already open is closed first.
+
+  @param[in]
+    pcFilePath The snapshot file
+
+  @retval
+    true Successfully mapped the snapshot
+
+  @retval
+    false Failed to open/map the file, or the file is not a complete snapshot written by a build with the same data type sizes
+*/
+tc_bool TeracadaDictSnapshot::open ( const tc_char* pcFilePath ) {
+  const stdTeracadaDictSnapshotHeader* pstHeader = nullptr;
+  struct stat stStat;
+  tc_int iFd = -1;
+
+  close();
+
+  iFd = ::open(pcFilePath, O_RDONLY);
+
+  if ( iFd < 0 || fstat(iFd, &stStat) != 0 || (tc_uint64) stStat.st_size < sizeof(stdTeracadaDictSnapshotHeader) ) {
+    TC_LOG(LOG_ERR, "TeracadaDictSnapshot::open(): Failed to open the snapshot file [ FILE_PATH: %s ]", pcFilePath);
+    goto ERREXIT;
+  }
+
+  m_ui64MappingSize = stStat.st_size;
+  m_pb8Mapping = (const tc_byte*) mmap(nullptr, m_ui64MappingSize, PROT_READ, MAP_SHARED, iFd, 0);
+
+  // The mapping keeps the file referenced
+  ::close(iFd);
+  iFd = -1;
+
+  if ( m_pb8Mapping == MAP_FAILED ) {
+    m_pb8Mapping = nullptr;
+    TC_LOG(LOG_ERR, "TeracadaDictSnapshot::open(): Failed to map the snapshot file [ FILE_PATH: %s ]", pcFilePath);
+    goto ERREXIT;
+  }
+
+  pstHeader = (const stdTeracadaDictSnapshotHeader*) m_pb8Mapping;
+
+  // The sections are compared as remaining sizes, so that a corrupt header can't wrap the sums around
+  if ( memcmp(pstHeader->acMagic, TD_SNAPSHOT_MAGIC, sizeof(TD_SNAPSHOT_MAGIC)) || pstHeader->ui32Version != TD_SNAPSHOT_VERSION ||
+       pstHeader->b8IntSize != sizeof(tc_int) || pstHeader->b8DecimalSize != sizeof(tc_decimal) ||
+       pstHeader->b8NodeSize != sizeof(stdTeracadaDictSnapshotNode) || pstHeader->ui64FileSize != m_ui64MappingSize ||
+       pstHeader->ui64NumRootNodes > pstHeader->ui64NumNodes ||
+       pstHeader->ui64StringsOffset < sizeof(stdTeracadaDictSnapshotHeader) ||
+       pstHeader->ui64NodesOffset < pstHeader->ui64StringsOffset || pstHeader->ui64NodesOffset > m_ui64MappingSize ||
+       (pstHeader->ui64NodesOffset % TD_SNAPSHOT_ALIGNMENT) != 0 ||
+       pstHeader->ui64StringsSize > (pstHeader->ui64NodesOffset - pstHeader->ui64StringsOffset) ||
+       pstHeader->ui64NumNodes > ((m_ui64MappingSize - pstHeader->ui64NodesOffset) / sizeof(stdTeracadaDictSnapshotNode)) ||
+       (pstHeader->ui64StringsSize && m_pb8Mapping[pstHeader->ui64StringsOffset + pstHeader->ui64StringsSize - 1] != '\0') ) {
+    TC_LOG(LOG_ERR, "TeracadaDictSnapshot::open(): Not a snapshot of this build [ FILE_PATH: %s ]", pcFilePath);
+    close();
+    goto ERREXIT;
+  }
+
+  m_pstHeader = pstHeader;
+  m_pstNodes = (const stdTeracadaDictSnapshotNode*) (m_pb8Mapping + pstHeader->ui64NodesOffset);
+  m_pcStrings = (const tc_char*) (m_pb8Mapping + pstHeader->ui64StringsOffset);
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    if ( iFd >= 0 )
+      ::close(iFd);
+
+    return false;
+}
+
+
+tc_void TeracadaDictSnapshot::close ( void ) {
+  if ( m_pb8Mapping )
+    munmap((tc_void*) m_pb8Mapping, m_ui64MappingSize);
+
+  m_pb8Mapping = nullptr;
+  m_ui64MappingSize = 0;
+  m_pstHeader = nullptr;
+  m_pstNodes = nullptr;
+  m_pcStrings = nullptr;
+}
+
+
+// The strings of the node are within the string arena (the file is not trusted), its children are checked as a parent by find()
+tc_bool TeracadaDictSnapshot::checkNode ( tc_dict_snapshot_node pstNode ) const {
+  tc_uint64 ui64StringsSize = m_pstHeader->ui64StringsSize;
+
+  if ( pstNode->b8DataTypeKey == TC_STRING &&
+       (pstNode->unKey.ui64Offset >= ui64StringsSize || pstNode->ui32KeyLength >= (ui64StringsSize - pstNode->unKey.ui64Offset)) )
+    return false;
+
+  if ( pstNode->b8DataTypeVal == TC_STRING && pstNode->unVal.ui64Offset >= ui64StringsSize )
+    return false;
+
+  return true;
+}
+
+
+// Compares the key with the key of the node, the key strings are only compared when the words tie (as in TeracadaDictIndex)
+tc_int TeracadaDictSnapshot::compareNode ( const stdTeracadaDictKey& stKey, tc_dict_snapshot_node pstNode ) const {
+  if ( stKey.b8DataType != pstNode->b8DataTypeKey )
+    return (stKey.b8DataType < pstNode->b8DataTypeKey) ? -1 : 1;
+
+  if ( stKey.ui64Word != pstNode->ui64KeyWord )
+    return (stKey.ui64Word < pstNode->ui64KeyWord) ? -1 : 1;
+
+  if ( stKey.b8DataType != TC_STRING )
+    return 0;
+
+  tc_int iCompare = stKey.svString.compare(std::string_view((m_pcStrings + pstNode->unKey.ui64Offset), pstNode->ui32KeyLength));
+  return (iCompare < 0) ? -1 : (iCompare > 0);
+}
+
+
+template <typename tDataType>
+tc_dict_snapshot_node TeracadaDictSnapshot::find ( tDataType tKey, tc_dict_snapshot_node pstParentNode ) const {
+  stdTeracadaDictKey stKey = TeracadaDictIndex::sortKey(tKey);
+  tc_uint64 ui64Low = 0;
+  tc_uint64 ui64End = 0;
+  tc_uint64 ui64High = 0;
+
+  if ( ! m_pstHeader )
+    return nullptr;
+
+  if ( pstParentNode && (pstParentNode->ui64FirstChild > m_pstHeader->ui64NumNodes ||
+                         pstParentNode->ui32NumChildren > (m_pstHeader->ui64NumNodes - pstParentNode->ui64FirstChild)) )
+    goto ERREXIT;
+
+  ui64Low = pstParentNode ? pstParentNode->ui64FirstChild : 0;
+  ui64End = pstParentNode ? (pstParentNode->ui64FirstChild + pstParentNode->ui32NumChildren) : m_pstHeader->ui64NumRootNodes;
+  ui64High = ui64End;
+
+  // First node of the level not less than the key
+  while ( ui64Low < ui64High ) {
+    tc_uint64 ui64Mid = ui64Low + (ui64High - ui64Low) / 2;
+
+    if ( ! checkNode(&m_pstNodes[ui64Mid]) )
+      goto ERREXIT;
+
+    if ( compareNode(stKey, &m_pstNodes[ui64Mid]) > 0 )
+      ui64Low = ui64Mid + 1;
+    else
+      ui64High = ui64Mid;
+  }
+
+  if ( ui64Low == ui64End )
+    return nullptr;
+
+  if ( ! checkNode(&m_pstNodes[ui64Low]) )
+    goto ERREXIT;
+
+  if ( compareNode(stKey, &m_pstNodes[ui64Low]) )
+    return nullptr;
+
+  return &m_pstNodes[ui64Low];
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaDictSnapshot::find(): Corrupt snapshot node [ NUM_NODES: %lu ]", m_pstHeader->ui64NumNodes);
+    return nullptr;
+}
+
+template tc_dict_snapshot_node TeracadaDictSnapshot::find<tc_int> ( tc_int tKey, tc_dict_snapshot_node pstParentNode ) const;
+
+template tc_dict_snapshot_node TeracadaDictSnapshot::find<tc_decimal> ( tc_decimal tKey, tc_dict_snapshot_node pstParentNode ) const;
+
+template tc_dict_snapshot_node TeracadaDictSnapshot::find<tc_str> ( tc_str tKey, tc_dict_snapshot_node pstParentNode ) const;
+
+
+template <typename tDataType>
+const tc_void* TeracadaDictSnapshot::get ( tDataType tKey, tc_dict_snapshot_node pstParentNode ) const {
+  tc_dict_snapshot_node pstNode = find(tKey, pstParentNode);
+
+  return pstNode ? getNodeValue(pstNode) : nullptr;
+}
+
+template const tc_void* TeracadaDictSnapshot::get<tc_int> ( tc_int tKey, tc_dict_snapshot_node pstParentNode ) const;
+
+template const tc_void* TeracadaDictSnapshot::get<tc_decimal> ( tc_decimal tKey, tc_dict_snapshot_node pstParentNode ) const;
+
+template const tc_void* TeracadaDictSnapshot::get<tc_str> ( tc_str tKey, tc_dict_snapshot_node pstParentNode ) const;
+
+
+const tc_void* TeracadaDictSnapshot::getNodeKey ( tc_dict_snapshot_node pstNode ) const {
+  switch ( pstNode->b8DataTypeKey ) {
+    case TC_INT:
+      return &pstNode->unKey.iInt;
+
+    case TC_DECIMAL:
+      return &pstNode->unKey.dDecimal;
+
+    case TC_STRING:
+      return (m_pcStrings + pstNode->unKey.ui64Offset);
+
+    default:
+      return nullptr;
+  }
+}
+
+
+const tc_void* TeracadaDictSnapshot::getNodeValue ( tc_dict_snapshot_node pstNode ) const {
+  switch ( pstNode->b8DataTypeVal ) {
+    case TC_INT:
+      return &pstNode->unVal.iInt;
+
+    case TC_DECIMAL:
+      return &pstNode->unVal.dDecimal;
+
+    case TC_STRING:
+      return (m_pcStrings + pstNode->unVal.ui64Offset);
+
+    default:
+      return nullptr;
+  }
+}
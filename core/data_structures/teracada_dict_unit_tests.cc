@@ -1,4 +1,634 @@
-#include <teracada_dict.h>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "teracada.h"
+
+extern "C" {
+#include <assert.h>
+}
+
+static char acTERACADA_ERRSTR_BUFFER[TC_ERRORSTR_LENGTH];
+char* pcTERACADA_ERRSTR = &acTERACADA_ERRSTR_BUFFER[0];
+
+
+using namespace std;
+
+void UnitTestsTeracadaDictIndex ( void ) {
+
+  cout << ">>> Unit testing TeracadaDict hash index [DICT_INDEX]: ";
+
+  {
+    TeracadaDictIndex objIndex;
+    stdTeracadaDictNode astNodes[3];
+    tc_index iNodeIndex = TA_NONE_INDEX;
+
+    tc_bool bInserted = objIndex.insert(TC_INT, 7, &astNodes[0], 0);
+    assert(bInserted);
+    bInserted = objIndex.insert(TC_INT, 7, &astNodes[1], 1);
+    assert(bInserted);
+    bInserted = objIndex.insert(TC_STRING, 7, &astNodes[2], 2);
+    assert(bInserted && objIndex.getNumKeys() == 2);
+
+    // A key already indexed keeps its node, the data type is part of the key
+    assert(objIndex.find(TC_INT, 7, &iNodeIndex) == &astNodes[0] && iNodeIndex == 0);
+    assert(objIndex.find(TC_STRING, 7, &iNodeIndex) == &astNodes[2] && iNodeIndex == 2);
+    assert(! objIndex.find(TC_DECIMAL, 7) && ! objIndex.find(TC_INT, 8));
+    assert(TeracadaDictIndex::decimalKey(-0.0) == TeracadaDictIndex::decimalKey(0.0));
+
+    for ( tc_int iIter = 0; iIter < 10000; iIter++ ) {
+      bInserted = objIndex.insert(TC_INT, (tc_uint64) iIter * 16, &astNodes[iIter % 3], iIter);
+      assert(bInserted);
+    }
+
+    assert(objIndex.getNumKeys() == 10002);
+
+    for ( tc_int iIter = 0; iIter < 10000; iIter++ ) {
+      assert(objIndex.find(TC_INT, (tc_uint64) iIter * 16, &iNodeIndex) == &astNodes[iIter % 3] && iNodeIndex == iIter);
+      assert(! objIndex.find(TC_INT, (tc_uint64) iIter * 16 + 1));
+    }
+
+    // Backward shift deletion keeps the rest of the clusters reachable
+    for ( tc_int iIter = 0; iIter < 10000; iIter += 2 ) {
+      tc_bool bErased = objIndex.erase(TC_INT, (tc_uint64) iIter * 16);
+      assert(bErased);
+    }
+
+    tc_bool bErased = objIndex.erase(TC_INT, 0);
+    assert(! bErased && objIndex.getNumKeys() == 5002);
+
+    for ( tc_int iIter = 0; iIter < 10000; iIter++ )
+      assert((objIndex.find(TC_INT, (tc_uint64) iIter * 16) != nullptr) == (iIter % 2));
+
+    tc_bool bAssigned = objIndex.assign(TC_INT, 16, 5);
+    assert(bAssigned && objIndex.find(TC_INT, 16, &iNodeIndex) && iNodeIndex == 5);
+    bAssigned = objIndex.assign(TC_INT, 32, 5);
+    assert(! bAssigned);
+
+    objIndex.clear();
+    assert(objIndex.getNumKeys() == 0 && ! objIndex.find(TC_INT, 16));
+  }
+
+  {
+    tc_char acKey[32] = {0};
+    TeracadaDict objDict;
+    tc_dict ptcdNode = nullptr;
+
+    for ( tc_int iIter = 0; iIter < 1000; iIter++ ) {
+      snprintf(acKey, sizeof(acKey), "key-%d", (tc_int32) iIter);
+
+      ptcdNode = objDict.update<tc_int, tc_int>(iIter, iIter * 2);
+      assert(ptcdNode);
+      ptcdNode = objDict.update<tc_decimal, tc_int>((tc_decimal) iIter + 0.5, iIter * 3);
+      assert(ptcdNode);
+      ptcdNode = objDict.update<tc_str, tc_int>(acKey, iIter * 4);
+      assert(ptcdNode);
+    }
+
+    // Existing key, the value is replaced
+    ptcdNode = objDict.update<tc_int, tc_int>(5, -1);
+    assert(ptcdNode);
+    ptcdNode = objDict.update<tc_int, tc_int>(5, 10);
+    assert(ptcdNode);
+
+    tc_dict ptcdParent = objDict.update<tc_str, tc_int>((tc_str) "parent", 0);
+
+    for ( tc_int iIter = 0; iIter < 20; iIter++ ) {
+      ptcdNode = objDict.update<tc_int, tc_decimal>(ptcdParent, iIter, (tc_decimal) iIter / 2);
+      assert(ptcdNode);
+    }
+
+    for ( tc_int iPass = 0; iPass < 2; iPass++ ) {
+      assert(objDict.isIndexEnabled() == ! iPass);
+
+      for ( tc_int iIter = 0; iIter < 1000; iIter++ ) {
+        snprintf(acKey, sizeof(acKey), "key-%d", (tc_int32) iIter);
+
+        assert(*((tc_int*) objDict.get<tc_int>(iIter)) == iIter * 2);
+        assert(*((tc_int*) objDict.get<tc_decimal>((tc_decimal) iIter + 0.5)) == iIter * 3);
+        assert(*((tc_int*) objDict.get<tc_str>(acKey)) == iIter * 4);
+      }
+
+      assert(*((tc_int*) objDict.get<tc_int>(5)) == 10);
+      assert(*((tc_decimal*) objDict.get<tc_int>(19, ptcdParent)) == (tc_decimal) 9.5);
+      assert(! objDict.get<tc_int>(1000) && ! objDict.get<tc_decimal>(0.25) && ! objDict.get<tc_str>((tc_str) "key-1000"));
+      assert(! objDict.get<tc_int>(20, ptcdParent));
+
+      objDict.disableIndex();
+    }
+
+    objDict.enableIndex();
+    assert(*((tc_int*) objDict.get<tc_str>((tc_str) "key-999")) == 3996);
+  }
+
+  /* Upsert, erase and compaction of the value pools */
+
+  {
+    tc_char acKey[64] = {0};
+    TeracadaDict objDict;
+    tc_dict ptcdNode = nullptr;
+    tc_bool bErased = false;
+
+    // Counters updated in place, no dead slots
+    for ( tc_int iIter = 0; iIter < 100000; iIter++ ) {
+      ptcdNode = objDict.update<tc_int, tc_int>(iIter % 100, iIter);
+      assert(ptcdNode);
+    }
+
+    assert(objDict.getNumDeadSlots() == 0 && *((tc_int*) objDict.get<tc_int>(42)) == 99942);
+
+    // Short string values are stored in the node, only the replaced long ones leave dead slots behind until compaction
+    objDict.disableAutoCompact();
+
+    const tc_char* pcInline = "31 characters, stored in a node";
+    const tc_char* pcLong = "32 characters, in string column.";
+
+    ptcdNode = objDict.update<tc_int, tc_str>(1, (tc_str) pcInline);
+    assert(ptcdNode);
+    ptcdNode = objDict.update<tc_int, tc_str>(1, (tc_str) pcLong);
+    assert(ptcdNode);
+    assert(objDict.getNumDeadSlots() == 0 && ! strcmp((tc_str) objDict.get<tc_int>(1), pcLong));
+
+    ptcdNode = objDict.update<tc_int, tc_str>(1, (tc_str) pcLong);
+    assert(ptcdNode);
+    ptcdNode = objDict.update<tc_int, tc_str>(1, (tc_str) "uno");
+    assert(ptcdNode);
+    ptcdNode = objDict.update<tc_int, tc_decimal>(2, 2.5);
+    assert(ptcdNode);
+    assert(objDict.getNumDeadSlots() == 2 && ! strcmp((tc_str) objDict.get<tc_int>(1), "uno"));
+
+    tc_dict ptcdParent = objDict.update<tc_int, tc_int>(3, 3);
+
+    for ( tc_int iIter = 0; iIter < 20; iIter++ ) {
+      ptcdNode = objDict.update<tc_int, tc_str>(ptcdParent, iIter, (tc_str) ((iIter % 2) ? pcLong : pcInline));
+      assert(ptcdNode);
+    }
+
+    // 10 long string values of the children of node 3
+    bErased = objDict.erase<tc_int>(3);
+    assert(bErased);
+    bErased = objDict.erase<tc_int>(3);
+    assert(! bErased && ! objDict.get<tc_int>(3));
+    bErased = objDict.erase<tc_str>((tc_str) "missing");
+    assert(! bErased && objDict.getNumDeadSlots() == 12);
+
+    for ( tc_int iIter = 4; iIter < 100; iIter++ ) {
+      bErased = objDict.erase<tc_int>(iIter);
+      assert(bErased && ! objDict.get<tc_int>(iIter));
+    }
+
+    assert(*((tc_int*) objDict.get<tc_int>(0)) == 99900 && *((tc_decimal*) objDict.get<tc_int>(2)) == (tc_decimal) 2.5);
+
+    // Erased nodes are reused
+    ptcdNode = objDict.update<tc_int, tc_str>(50, (tc_str) pcLong);
+    assert(ptcdNode);
+
+    tc_bool bCompacted = objDict.compact();
+    assert(bCompacted && objDict.getNumDeadSlots() == 0);
+    assert(*((tc_int*) objDict.get<tc_int>(0)) == 99900 && ! strcmp((tc_str) objDict.get<tc_int>(1), "uno"));
+    assert(*((tc_decimal*) objDict.get<tc_int>(2)) == (tc_decimal) 2.5 && ! strcmp((tc_str) objDict.get<tc_int>(50), pcLong));
+
+    // Long string values replaced over and over, the automatic compaction keeps the dead slots bounded
+    objDict.enableAutoCompact();
+
+    for ( tc_int iIter = 0; iIter < 100000; iIter++ ) {
+      snprintf(acKey, sizeof(acKey), "value-%d", (tc_int32) iIter);
+      ptcdNode = objDict.update<tc_str, tc_str>((tc_str) "status", acKey);
+      assert(ptcdNode);
+
+      snprintf(acKey, sizeof(acKey), "a status value not inlined %d", (tc_int32) iIter);
+      ptcdNode = objDict.update<tc_str, tc_str>((tc_str) "long status", acKey);
+      assert(ptcdNode);
+      assert(objDict.getNumDeadSlots() < 2 * TD_COMPACT_MIN_DEAD_SLOTS);
+    }
+
+    assert(! strcmp((tc_str) objDict.get<tc_str>((tc_str) "long status"), "a status value not inlined 99999"));
+    assert(! strcmp((tc_str) objDict.get<tc_str>((tc_str) "status"), "value-99999"));
+    assert(! strcmp((tc_str) objDict.get<tc_int>(1), "uno") && *((tc_int*) objDict.get<tc_int>(0)) == 99900);
+  }
+
+  /* Distinct string keys churned through the dict, the key pool is rebuilt with the live keys */
+
+  {
+    tc_char acKey[64] = {0};
+    TeracadaDict objDict;
+    tc_dict ptcdNode = nullptr;
+    tc_bool bErased = false;
+
+    objDict.enableOrderedIndex();
+
+    for ( tc_int iIter = 0; iIter < 100; iIter++ ) {
+      snprintf(acKey, sizeof(acKey), "user-%d", (tc_int32) iIter);
+      ptcdNode = objDict.update<tc_str, tc_int>(acKey, iIter);
+      assert(ptcdNode);
+    }
+
+    for ( tc_int iIter = 0; iIter < 100000; iIter++ ) {
+      snprintf(acKey, sizeof(acKey), "session-%d", (tc_int32) iIter);
+      ptcdNode = objDict.update<tc_str, tc_int>(acKey, iIter);
+      assert(ptcdNode);
+
+      // Same key string nested under the session, the two nodes share the id
+      ptcdNode = objDict.update<tc_str, tc_int>(ptcdNode, acKey, -iIter);
+      assert(ptcdNode);
+
+      bErased = objDict.erase<tc_str>(acKey);
+      assert(bErased);
+      assert(objDict.getKeyPool()->getNumElements() <= 100 + 2 * TD_COMPACT_MIN_DEAD_SLOTS + 1);
+    }
+
+    for ( tc_int iIter = 0; iIter < 100; iIter++ ) {
+      snprintf(acKey, sizeof(acKey), "user-%d", (tc_int32) iIter);
+      assert(*((tc_int*) objDict.get<tc_str>(acKey)) == iIter);
+    }
+
+    assert(! objDict.get<tc_str>((tc_str) "session-99999") && ! strcmp((tc_str) objDict.getNodeKey(objDict.lowerBound<tc_str>((tc_str) "user-5")), "user-5"));
+
+    bErased = objDict.compact();
+    assert(bErased && objDict.getNumDeadKeys() == 0 && objDict.getKeyPool()->getNumElements() == 100);
+    assert(*((tc_int*) objDict.get<tc_str>((tc_str) "user-42")) == 42);
+  }
+
+  /* A failed insertion leaves no key behind in the key pool */
+
+  {
+    class TeracadaFailingAllocator : public TeracadaAllocator {
+      public:
+        tc_void* allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill = true ) override {
+          return TeracadaAllocator::getDefault()->allocate(ui64Bytes, bZeroFill);
+        }
+
+        tc_void* reallocate ( tc_void*, tc_uint64, tc_uint64 ) override {
+          return nullptr;
+        }
+
+        tc_void deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) override {
+          TeracadaAllocator::getDefault()->deallocate(pvBuffer, ui64Bytes);
+        }
+    };
+
+    TeracadaFailingAllocator objFailingAllocator;
+    TeracadaDict objDict(&objFailingAllocator);
+    tc_char acKey[] = "key";
+    std::string strValue(4096, 'v');
+    tc_bool bInsertFailed = false;
+
+    // The long value does not fit the string column, which can't grow
+    try {
+      objDict.update<tc_str, tc_str>(acKey, strValue.data());
+    } catch ( TeracadaException& objException ) {
+      bInsertFailed = true;
+    }
+
+    assert(bInsertFailed);
+    assert(objDict.getKeyPool()->getNumElements() == 0 && ! objDict.get<tc_str>(acKey));
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaDictOrdered ( void ) {
+
+  cout << ">>> Unit testing TeracadaDict ordered index [DICT_ORDERED]: ";
+
+  {
+    tc_char acKey[64] = {0};
+    TeracadaDict objDict;
+    tc_dict ptcdNode = nullptr;
+    tc_bool bErased = false;
+    tca_dict tcaNodes(16);
+
+    objDict.enableOrderedIndex();
+
+    // Keys inserted out of order (7 is coprime with 5000)
+    for ( tc_int iIter = 0; iIter < 5000; iIter++ ) {
+      tc_int iKey = (iIter * 7) % 5000;
+      snprintf(acKey, sizeof(acKey), "sensor-%04d/temp", (tc_int32) iKey);
+
+      ptcdNode = objDict.update<tc_int, tc_int>(iKey, iKey * 2);
+      assert(ptcdNode);
+      ptcdNode = objDict.update<tc_decimal, tc_int>((tc_decimal) iKey - 2500.5, iKey);
+      assert(ptcdNode);
+      ptcdNode = objDict.update<tc_str, tc_int>(acKey, iKey);
+      assert(ptcdNode);
+    }
+
+    for ( tc_int iPass = 0; iPass < 3; iPass++ ) {
+      // Ordered index, then the hash index only (scan and sort), then no index at all
+      if ( iPass == 1 )
+        objDict.disableOrderedIndex();
+
+      if ( iPass == 2 )
+        objDict.disableIndex();
+
+      assert(objDict.range<tc_int>(100, 200, &tcaNodes) == 100);
+
+      for ( tc_int iIter = 0; iIter < 100; iIter++ )
+        assert(*((tc_int*) objDict.getNodeKey(tcaNodes[iIter])) == 100 + iIter);
+
+      // Only the keys of the data type of the bounds
+      assert(objDict.range<tc_int>(-1000, 1000000, &tcaNodes) == 5000);
+      assert(objDict.range<tc_int>(200, 100, &tcaNodes) == 0);
+
+      assert(objDict.range<tc_decimal>(-3, 3, &tcaNodes) == 6);
+      assert(*((tc_decimal*) objDict.getNodeKey(tcaNodes[0])) == (tc_decimal) -2.5 && *((tc_decimal*) objDict.getNodeKey(tcaNodes[5])) == (tc_decimal) 2.5);
+
+      assert(*((tc_int*) objDict.getNodeKey(objDict.lowerBound<tc_int>(-5))) == 0);
+      assert(*((tc_int*) objDict.getNodeKey(objDict.lowerBound<tc_int>(4999))) == 4999 && ! objDict.lowerBound<tc_int>(5000));
+
+      // The keys share their first 8 bytes, the whole strings decide
+      assert(objDict.prefix((tc_str) "sensor-12", &tcaNodes) == 100);
+      assert(! strcmp((tc_str) objDict.getNodeKey(tcaNodes[0]), "sensor-1200/temp") && ! strcmp((tc_str) objDict.getNodeKey(tcaNodes[99]), "sensor-1299/temp"));
+
+      assert(objDict.range<tc_str>((tc_str) "sensor-0010", (tc_str) "sensor-0012", &tcaNodes) == 2);
+      assert(! strcmp((tc_str) objDict.getNodeKey(objDict.lowerBound<tc_str>((tc_str) "sensor-0010/z")), "sensor-0011/temp"));
+      assert(objDict.prefix((tc_str) "sensor-5", &tcaNodes) == 0 && objDict.prefix((tc_str) "", &tcaNodes) == 5000);
+    }
+
+    objDict.enableIndex();
+    objDict.enableOrderedIndex();
+
+    // Erased keys leave the tree, emptied leaves are skipped
+    for ( tc_int iIter = 0; iIter < 5000; iIter++ ) {
+      if ( iIter % 3 || (iIter >= 1000 && iIter < 2000) ) {
+        bErased = objDict.erase<tc_int>(iIter);
+        assert(bErased);
+      }
+    }
+
+    assert(objDict.range<tc_int>(0, 5000, &tcaNodes) == 1334);
+
+    for ( tc_int iIter = 1; iIter < tcaNodes.getNumElements(); iIter++ )
+      assert(*((tc_int*) objDict.getNodeKey(tcaNodes[iIter - 1])) < *((tc_int*) objDict.getNodeKey(tcaNodes[iIter])));
+
+    assert(*((tc_int*) objDict.getNodeKey(objDict.lowerBound<tc_int>(1000))) == 2001);
+
+    // Keys added back after the erase
+    for ( tc_int iIter = 1000; iIter < 2000; iIter++ ) {
+      ptcdNode = objDict.update<tc_int, tc_int>(iIter, iIter);
+      assert(ptcdNode);
+    }
+
+    assert(objDict.range<tc_int>(999, 2002, &tcaNodes) == 1002);
+  }
+
+  {
+    TeracadaDict objDict;
+    tc_dict ptcdNode = nullptr;
+    tca_dict tcaNodes(16);
+
+    objDict.enableOrderedIndex();
+
+    tc_dict ptcdParent = objDict.update<tc_str, tc_int>((tc_str) "series", 0);
+
+    // A small level (scanned) and the same level once it is indexed
+    for ( tc_int iIter = 0; iIter < 100; iIter++ ) {
+      ptcdNode = objDict.update<tc_decimal, tc_int>(ptcdParent, (tc_decimal) (50 - iIter) / 4, iIter);
+      assert(ptcdNode);
+
+      assert(objDict.range<tc_decimal>(-100, 100, &tcaNodes, ptcdParent) == iIter + 1);
+      assert(*((tc_decimal*) objDict.getNodeKey(tcaNodes[0])) == (tc_decimal) (50 - iIter) / 4);
+    }
+
+    assert(*((tc_int*) objDict.getNodeValue(objDict.lowerBound<tc_decimal>((tc_decimal) -0.1, ptcdParent))) == 50);
+    assert(objDict.range<tc_int>(0, 10, &tcaNodes, ptcdParent) == 0 && ! objDict.lowerBound<tc_int>(0, ptcdParent));
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaConcurrentDict ( void ) {
+
+  cout << ">>> Unit testing TeracadaConcurrentDict [DICT_CONCURRENT]: ";
+
+  {
+    TeracadaConcurrentDict objDict(6);
+    tc_int iValue = 0;
+    tc_decimal dValue = 0;
+    string strValue;
+    tc_dict ptcdNode = nullptr;
+    tc_bool bErased = false;
+
+    // Rounded up to a power of two
+    assert(objDict.isInitSuccess() && objDict.getNumShards() == 8);
+
+    tc_dict ptcdParent = objDict.update<tc_str, tc_int>((tc_str) "parent", 1);
+
+    ptcdNode = objDict.update<tc_int, tc_str>(ptcdParent, 5, (tc_str) "five");
+    assert(ptcdNode);
+    assert((objDict.get<tc_int, string>(5, &strValue, ptcdParent)) && strValue == "five");
+    assert((objDict.get<tc_str, tc_int>((tc_str) "parent", &iValue)) && iValue == 1);
+
+    // Missing key, or a value of another data type
+    assert(! (objDict.get<tc_int, tc_int>(6, &iValue, ptcdParent)) && ! (objDict.get<tc_str, tc_decimal>((tc_str) "parent", &dValue)));
+    assert(objDict.find<tc_str>((tc_str) "parent") == ptcdParent && ! objDict.find<tc_int>(5));
+
+    vector<thread> vecThreads;
+
+    // Writers of their own top level keys and of the children of a shared parent, with readers of the same keys
+    for ( tc_int iThread = 0; iThread < 8; iThread++ ) {
+      vecThreads.emplace_back([&objDict, ptcdParent, iThread] ( void ) {
+        tc_int iRead = 0;
+        tc_dict ptcdNode = nullptr;
+
+        for ( tc_int iIter = 0; iIter < 2000; iIter++ ) {
+          tc_int iKey = iThread * 100000 + iIter;
+
+          if ( iThread % 2 ) {
+            ptcdNode = objDict.update<tc_int, tc_int>(iKey, iIter);
+            assert(ptcdNode);
+            ptcdNode = objDict.update<tc_int, tc_int>(ptcdParent, iKey, iIter * 2);
+            assert(ptcdNode);
+          } else {
+            // Written by the next thread, present or not yet
+            if ( objDict.get<tc_int, tc_int>((iKey + 100000), &iRead) )
+              assert(iRead == iIter);
+          }
+        }
+      });
+    }
+
+    for ( thread& objThread : vecThreads )
+      objThread.join();
+
+    for ( tc_int iThread = 1; iThread < 8; iThread += 2 ) {
+      for ( tc_int iIter = 0; iIter < 2000; iIter++ ) {
+        assert((objDict.get<tc_int, tc_int>((iThread * 100000 + iIter), &iValue)) && iValue == iIter);
+        assert((objDict.get<tc_int, tc_int>((iThread * 100000 + iIter), &iValue, ptcdParent)) && iValue == iIter * 2);
+      }
+    }
+
+    bErased = objDict.erase<tc_int>(100000);
+    assert(bErased);
+    bErased = objDict.erase<tc_int>(100000);
+    assert(! bErased && ! (objDict.get<tc_int, tc_int>(100000, &iValue)));
+    bErased = objDict.erase<tc_int>(100000, ptcdParent);
+    assert(bErased && ! (objDict.get<tc_int, tc_int>(100000, &iValue, ptcdParent)));
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
+
+
+void UnitTestsTeracadaDictSnapshot ( void ) {
+  const tc_char* pcSnapshotFilePath = "/tmp/teracada_dict_snapshot_unit_tests";
+
+  cout << ">>> Unit testing TeracadaDictSnapshot [DICT_SNAPSHOT]: ";
+
+  {
+    tc_char acKey[64] = {0};
+    tc_char acValue[64] = {0};
+    TeracadaDictSnapshot objSnapshot;
+
+    {
+      TeracadaDict objDict;
+      tc_dict ptcdNode = nullptr;
+      tc_bool bSaved = false;
+
+      for ( tc_int iIter = 0; iIter < 1000; iIter++ ) {
+        snprintf(acKey, sizeof(acKey), "key-%d", (tc_int32) iIter);
+        // Inline and long (string column) values
+        snprintf(acValue, sizeof(acValue), (iIter % 2) ? "v%d" : "a value too long to be inlined in a node %d", (tc_int32) iIter);
+
+        ptcdNode = objDict.update<tc_int, tc_int>(iIter, iIter * 2);
+        assert(ptcdNode);
+        ptcdNode = objDict.update<tc_decimal, tc_decimal>((tc_decimal) iIter - 500.5, (tc_decimal) iIter / 4);
+        assert(ptcdNode);
+        ptcdNode = objDict.update<tc_str, tc_str>(acKey, acValue);
+        assert(ptcdNode);
+      }
+
+      tc_dict ptcdParent = objDict.update<tc_str, tc_int>((tc_str) "parent", -1);
+
+      for ( tc_int iIter = 0; iIter < 50; iIter++ ) {
+        tc_dict ptcdChild = objDict.update<tc_int, tc_int>(ptcdParent, iIter, iIter + 7);
+
+        // Same key string at two levels
+        ptcdNode = objDict.update<tc_str, tc_str>(ptcdChild, (tc_str) "key-1", (tc_str) "nested");
+        assert(ptcdNode);
+      }
+
+      bSaved = objDict.saveSnapshot(pcSnapshotFilePath);
+      assert(bSaved);
+    }
+
+    // The dict is gone, the snapshot is used from the mapped file
+    tc_bool bOpened = objSnapshot.open(pcSnapshotFilePath);
+    assert(bOpened && objSnapshot.getNumNodes() == 3000 + 1 + 50 + 50);
+
+    for ( tc_int iIter = 0; iIter < 1000; iIter++ ) {
+      snprintf(acKey, sizeof(acKey), "key-%d", (tc_int32) iIter);
+      snprintf(acValue, sizeof(acValue), (iIter % 2) ? "v%d" : "a value too long to be inlined in a node %d", (tc_int32) iIter);
+
+      assert(*((const tc_int*) objSnapshot.get<tc_int>(iIter)) == iIter * 2);
+      assert(*((const tc_decimal*) objSnapshot.get<tc_decimal>((tc_decimal) iIter - 500.5)) == (tc_decimal) iIter / 4);
+      assert(! strcmp((const tc_char*) objSnapshot.get<tc_str>(acKey), acValue));
+    }
+
+    assert(! objSnapshot.get<tc_int>(1000) && ! objSnapshot.get<tc_int>(-1) && ! objSnapshot.get<tc_decimal>(0.25) && ! objSnapshot.get<tc_str>((tc_str) "key-"));
+
+    tc_dict_snapshot_node pstParent = objSnapshot.find<tc_str>((tc_str) "parent");
+    assert(pstParent && *((const tc_int*) objSnapshot.getNodeValue(pstParent)) == -1);
+
+    for ( tc_int iIter = 0; iIter < 50; iIter++ ) {
+      tc_dict_snapshot_node pstChild = objSnapshot.find<tc_int>(iIter, pstParent);
+
+      assert(pstChild && *((const tc_int*) objSnapshot.getNodeKey(pstChild)) == iIter && *((const tc_int*) objSnapshot.getNodeValue(pstChild)) == iIter + 7);
+      assert(! strcmp((const tc_char*) objSnapshot.get<tc_str>((tc_str) "key-1", pstChild), "nested"));
+    }
+
+    assert(! objSnapshot.get<tc_int>(50, pstParent) && ! objSnapshot.get<tc_int>(0, objSnapshot.find<tc_int>(0)));
+
+    // Corrupt snapshots: children out of the node table, and string sizes wrapping around in the header
+    {
+      stdTeracadaDictSnapshotHeader stHeader;
+      std::vector<stdTeracadaDictSnapshotNode> vecNodes;
+      tc_uint64 ui64ParentNode = 0;
+      ssize_t iNumBytes = 0;
+      tc_int iFd = -1;
+
+      objSnapshot.close();
+
+      iFd = open(pcSnapshotFilePath, O_RDWR);
+      assert(iFd >= 0);
+      iNumBytes = pread(iFd, &stHeader, sizeof(stHeader), 0);
+      assert(iNumBytes == sizeof(stHeader));
+
+      vecNodes.resize(stHeader.ui64NumNodes);
+      iNumBytes = pread(iFd, vecNodes.data(), (vecNodes.size() * sizeof(stdTeracadaDictSnapshotNode)), stHeader.ui64NodesOffset);
+      assert(iNumBytes > 0);
+
+      while ( vecNodes[ui64ParentNode].ui32NumChildren != 50 )
+        ui64ParentNode++;
+
+      vecNodes[ui64ParentNode].ui64FirstChild = (tc_uint64) -10;
+      iNumBytes = pwrite(iFd, &vecNodes[ui64ParentNode], sizeof(stdTeracadaDictSnapshotNode), (stHeader.ui64NodesOffset + ui64ParentNode * sizeof(stdTeracadaDictSnapshotNode)));
+      assert(iNumBytes > 0);
+
+      bOpened = objSnapshot.open(pcSnapshotFilePath);
+      assert(bOpened);
+
+      pstParent = objSnapshot.find<tc_str>((tc_str) "parent");
+      assert(pstParent && ! objSnapshot.find<tc_int>(0, pstParent) && *((const tc_int*) objSnapshot.get<tc_int>(7)) == 14);
+
+      stHeader.ui64StringsSize = (tc_uint64) -stHeader.ui64StringsOffset + 1;
+      iNumBytes = pwrite(iFd, &stHeader, sizeof(stHeader), 0);
+      assert(iNumBytes == sizeof(stHeader));
+      close(iFd);
+
+      bOpened = objSnapshot.open(pcSnapshotFilePath);
+      assert(! bOpened);
+    }
+
+    // An empty dict, written while the previous snapshot is still mapped
+    {
+      TeracadaDict objDict;
+      tc_bool bSaved = false;
+
+      bOpened = objSnapshot.open(pcSnapshotFilePath);
+      assert(! bOpened);
+
+      bSaved = objDict.update<tc_int, tc_int>(1, 1) && objDict.saveSnapshot(pcSnapshotFilePath);
+      bOpened = objSnapshot.open(pcSnapshotFilePath);
+      assert(bSaved && bOpened && objSnapshot.getNumNodes() == 1);
+
+      bSaved = objDict.erase<tc_int>(1) && objDict.saveSnapshot(pcSnapshotFilePath);
+      assert(bSaved && access((std::string(pcSnapshotFilePath) + ".tmp").c_str(), F_OK) != 0);
+
+      // The mapped snapshot still reads the file it was opened on
+      assert(objSnapshot.getNumNodes() == 1 && *((const tc_int*) objSnapshot.get<tc_int>(1)) == 1);
+
+      bOpened = objSnapshot.open(pcSnapshotFilePath);
+      assert(bOpened && ! objSnapshot.getNumNodes() && ! objSnapshot.get<tc_int>(0));
+    }
+
+    // A truncated snapshot, or no file at all
+    tc_int iTruncated = truncate(pcSnapshotFilePath, 40);
+    bOpened = objSnapshot.open(pcSnapshotFilePath);
+    assert(iTruncated == 0 && ! bOpened && ! objSnapshot.isOpen());
+
+    remove(pcSnapshotFilePath);
+    bOpened = objSnapshot.open(pcSnapshotFilePath);
+    assert(! bOpened);
+  }
+
+  cout << "(Passed)";
+
+  return;
+}
 
 
 void unitTestsTeracadaDict ( void ) {
@@ -10,5 +640,21 @@ void unitTestsTeracadaDict ( void ) {
 
 
 int main () {
+  cout << endl << endl;
+
+  UnitTestsTeracadaDictIndex();
+  cout << endl << endl;
+
+  UnitTestsTeracadaDictOrdered();
+  cout << endl << endl;
+
+  UnitTestsTeracadaConcurrentDict();
+  cout << endl << endl;
+
+  UnitTestsTeracadaDictSnapshot();
+  cout << endl << endl;
+
   unitTestsTeracadaDict();
-}
\ No newline at end of file
+
+  return 0;
+}
@@ -2,13 +2,14 @@
 #include <cstring>
 
 #include "teracada_error.h"
+#include "teracada_strings.h"
 
 
-template <typename tDataType>
-tc_char* TeracadaArray<tDataType>::getErrStr ( tc_int iErrno ) {
-  if ( ! iErrno )
-    iErrno = getErrno();
+std::atomic<tc_int> aiTERACADA_LOG_LEVEL(_TERACADA_LOG_LEVEL);
 
+
+// Format the error string of the error number in the shared error string buffer
+static tc_char* formatErrStr ( tc_int iErrno ) {
   if ( ! pcTERACADA_ERRSTR )
     goto ERREXIT;
 
@@ -40,6 +41,15 @@ tc_char* TeracadaArray<tDataType>::getErrStr ( tc_int iErrno ) {
     return NULL;
 }
 
+
+template <typename tDataType>
+tc_char* TeracadaArray<tDataType>::getErrStr ( tc_int iErrno ) {
+  if ( ! iErrno )
+    iErrno = getErrno();
+
+  return formatErrStr(iErrno);
+}
+
 // We don't overwrite previously set error
 template <typename tDataType>
 tc_void TeracadaArray<tDataType>::throwException ( tc_int iErrno ) {
@@ -55,3 +65,47 @@ tc_void TeracadaArray<tDataType>::throwException ( tc_int iErrno ) {
 
   return;
 }
+
+
+tc_char* TeracadaStringArray::getErrStr ( tc_int iErrno ) {
+  if ( ! iErrno )
+    iErrno = getErrno();
+
+  return formatErrStr(iErrno);
+}
+
+
+tc_void TeracadaStringArray::throwException ( tc_int iErrno ) {
+  // Error numbers are negative
+  if ( ! (iErrno <= TC_ERRNO_START && iErrno >= TC_ERRNO_END) )
+    setErrno(ERR_TA_RUNTIME);
+  else
+    setErrno(iErrno);
+
+  if ( isExceptionsEnabled() )
+    throw TeracadaException(getErrno(), getErrStr());
+
+  return;
+}
+
+
+tc_char* TeracadaStringPool::getErrStr ( tc_int iErrno ) {
+  if ( ! iErrno )
+    iErrno = getErrno();
+
+  return formatErrStr(iErrno);
+}
+
+
+tc_void TeracadaStringPool::throwException ( tc_int iErrno ) {
+  // Error numbers are negative
+  if ( ! (iErrno <= TC_ERRNO_START && iErrno >= TC_ERRNO_END) )
+    setErrno(ERR_TA_RUNTIME);
+  else
+    setErrno(iErrno);
+
+  if ( isExceptionsEnabled() )
+    throw TeracadaException(getErrno(), getErrStr());
+
+  return;
+}
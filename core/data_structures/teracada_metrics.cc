@@ -0,0 +1,230 @@
+/*!
+  @file
+  @author Rishabh Soni (Prevalent Dynamics)
+
+  @brief
+    Implementation of the process-wide TeracadaArray buffer metrics
+
+  @details
+    All the counters are relaxed atomics, they are only updated on buffer (re)allocation and
+    can be snapshotted from any thread. The optional background exporter periodically writes
+    the snapshot to a file, keeping the file I/O out of the insert/resize path.
+*/
+
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <algorithm>
+
+#include "teracada_metrics.h"
+
+
+std::atomic<tc_uint64> TeracadaMetrics::m_aui64ReallocAttempts(0);
+std::atomic<tc_uint64> TeracadaMetrics::m_aui64BytesMoved(0);
+std::atomic<tc_uint64> TeracadaMetrics::m_aui64CapacityBytes(0);
+std::atomic<tc_uint64> TeracadaMetrics::m_aui64PeakCapacityBytes(0);
+
+/* Background exporter state, only touched by start/stop, never by the counters */
+
+// Serializes startExporter()/stopExporter(), held across the join so a start never replaces a joinable thread
+static std::mutex objEXPORTER_CONTROL_MUTEX;
+static std::mutex objEXPORTER_MUTEX;
+static std::condition_variable objEXPORTER_CONDVAR;
+static std::thread objEXPORTER_THREAD;
+static tc_bool bEXPORTER_RUNNING = false;
+
+// Stops the exporter at process exit, destroying a still joinable objEXPORTER_THREAD would std::terminate()
+// Defined after the exporter state, so it is destroyed before it
+class TeracadaMetricsExporterOwner {
+  public:
+    ~TeracadaMetricsExporterOwner ( void ) {
+      TeracadaMetrics::stopExporter();
+    }
+};
+
+static TeracadaMetricsExporterOwner objEXPORTER_OWNER;
+
+
+static tc_void updatePeak ( std::atomic<tc_uint64>& aui64Peak, tc_uint64 ui64Value ) {
+  tc_uint64 ui64Peak = aui64Peak.load(std::memory_order_relaxed);
+
+  while ( ui64Value > ui64Peak &&
+          ! aui64Peak.compare_exchange_weak(ui64Peak, ui64Value, std::memory_order_relaxed) );
+}
+
+
+tc_void TeracadaMetrics::recordAlloc ( tc_uint64 ui64Bytes ) {
+  tc_uint64 ui64CapacityBytes = m_aui64CapacityBytes.fetch_add(ui64Bytes, std::memory_order_relaxed) + ui64Bytes;
+  updatePeak(m_aui64PeakCapacityBytes, ui64CapacityBytes);
+}
+
+
+tc_void TeracadaMetrics::recordReallocAttempt ( void ) {
+  m_aui64ReallocAttempts.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+// Bytes of a successful reallocation, the attempt is recorded by recordReallocAttempt()
+tc_void TeracadaMetrics::recordRealloc ( tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes, tc_bool bMoved ) {
+  if ( bMoved )
+    m_aui64BytesMoved.fetch_add(std::min(ui64PreBytes, ui64NewBytes), std::memory_order_relaxed);
+
+  if ( ui64NewBytes >= ui64PreBytes ) {
+    recordAlloc(ui64NewBytes - ui64PreBytes);
+  } else {
+    recordFree(ui64PreBytes - ui64NewBytes);
+  }
+}
+
+
+tc_void TeracadaMetrics::recordFree ( tc_uint64 ui64Bytes ) {
+  m_aui64CapacityBytes.fetch_sub(ui64Bytes, std::memory_order_relaxed);
+}
+
+
+stdTeracadaArrayMetrics TeracadaMetrics::getArrayMetrics ( void ) {
+  stdTeracadaArrayMetrics stMetrics;
+
+  stMetrics.ui64ReallocAttempts = m_aui64ReallocAttempts.load(std::memory_order_relaxed);
+  stMetrics.ui64BytesMoved = m_aui64BytesMoved.load(std::memory_order_relaxed);
+  stMetrics.ui64CapacityBytes = m_aui64CapacityBytes.load(std::memory_order_relaxed);
+  stMetrics.ui64PeakCapacityBytes = m_aui64PeakCapacityBytes.load(std::memory_order_relaxed);
+
+  return stMetrics;
+}
+
+
+// Current capacity is not reset, as it is still held by the live arrays
+tc_void TeracadaMetrics::resetArrayMetrics ( void ) {
+  m_aui64ReallocAttempts.store(0, std::memory_order_relaxed);
+  m_aui64BytesMoved.store(0, std::memory_order_relaxed);
+  m_aui64PeakCapacityBytes.store(m_aui64CapacityBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+
+/*!
+  @brief
+    Write a snapshot of the process-wide metrics to a file
+
+  @details
+    The file is truncated and one "name value" pair is written per line.
+
+  @param[in]
+    pcFilePath The file to write the metrics to
+
+  @retval
+    true Successfully written the metrics
+
+  @retval
+    false Failed to open/write the file
+*/
+tc_bool TeracadaMetrics::dumpArrayMetrics ( const tc_char* pcFilePath ) {
+  stdTeracadaArrayMetrics stMetrics = getArrayMetrics();
+  std::ofstream objFd;
+
+  objFd.open(pcFilePath, std::ios::out | std::ios::trunc);
+
+  if ( objFd.fail() ) {
+    TC_LOG(LOG_ERR, "TeracadaMetrics::dumpArrayMetrics(): Failed to open the metrics file [ FILE_PATH: %s ]", pcFilePath);
+    goto ERREXIT;
+  }
+
+  objFd << "realloc_attempts " << stMetrics.ui64ReallocAttempts << "\n"
+        << "bytes_moved " << stMetrics.ui64BytesMoved << "\n"
+        << "capacity_bytes " << stMetrics.ui64CapacityBytes << "\n"
+        << "peak_capacity_bytes " << stMetrics.ui64PeakCapacityBytes << "\n";
+
+  objFd.close();
+
+  if ( objFd.fail() )
+    goto ERREXIT;
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+/*!
+  @brief
+    Start the background thread exporting the process-wide metrics
+
+  @param[in]
+    pcFilePath The file to export the metrics to
+
+  @param[in]
+    iIntervalMs The interval between two exports in milliseconds
+
+  @retval
+    true Exporter started
+
+  @retval
+    false Exporter is already running or the parameters are invalid
+
+  @note
+    A last export is done when the exporter is stopped.
+*/
+tc_bool TeracadaMetrics::startExporter ( const tc_char* pcFilePath, tc_int iIntervalMs ) {
+  std::lock_guard<std::mutex> objControlLock(objEXPORTER_CONTROL_MUTEX);
+  std::lock_guard<std::mutex> objLock(objEXPORTER_MUTEX);
+
+  if ( bEXPORTER_RUNNING || ! pcFilePath || iIntervalMs <= 0 ) {
+    TC_LOG(LOG_ERR, "TeracadaMetrics::startExporter(): Failed to start the metrics exporter [ RUNNING: %d | INTERVAL_MS: %d ]", bEXPORTER_RUNNING, iIntervalMs);
+    return false;
+  }
+
+  bEXPORTER_RUNNING = true;
+
+  objEXPORTER_THREAD = std::thread([strFilePath = std::string(pcFilePath), iIntervalMs] ( void ) {
+    std::unique_lock<std::mutex> objLock(objEXPORTER_MUTEX);
+
+    // Export once more after being stopped, so the file has the final values
+    while ( true ) {
+      objEXPORTER_CONDVAR.wait_for(objLock, std::chrono::milliseconds(iIntervalMs), [] { return ! bEXPORTER_RUNNING; });
+      bool bRunning = bEXPORTER_RUNNING;
+
+      // The file I/O runs unlocked, so stopExporter() is never blocked behind a slow dump
+      objLock.unlock();
+      dumpArrayMetrics(strFilePath.c_str());
+      objLock.lock();
+
+      if ( ! bRunning )
+        break;
+    }
+  });
+
+  TC_LOG(LOG_INFO, "TeracadaMetrics::startExporter(): Started the metrics exporter [ FILE_PATH: %s | INTERVAL_MS: %d ]", pcFilePath, iIntervalMs);
+
+  return true;
+}
+
+
+tc_void TeracadaMetrics::stopExporter ( void ) {
+  std::lock_guard<std::mutex> objControlLock(objEXPORTER_CONTROL_MUTEX);
+
+  {
+    std::lock_guard<std::mutex> objLock(objEXPORTER_MUTEX);
+
+    if ( ! bEXPORTER_RUNNING )
+      return;
+
+    bEXPORTER_RUNNING = false;
+  }
+
+  objEXPORTER_CONDVAR.notify_all();
+  objEXPORTER_THREAD.join();
+
+  TC_LOG(LOG_INFO, "TeracadaMetrics::stopExporter(): Stopped the metrics exporter");
+}
+
+
+tc_bool TeracadaMetrics::isExporterRunning ( void ) {
+  std::lock_guard<std::mutex> objLock(objEXPORTER_MUTEX);
+  return bEXPORTER_RUNNING;
+}
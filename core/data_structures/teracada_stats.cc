@@ -1,175 +1,1523 @@
+/*!
+  @file
+  @author Rishabh Soni (Prevalent Dynamics)
+
+  @brief
+    Implementation of the TeracadaArray stats functions and their reduction kernels
+
+  @details
+    Every stats function is a single pass over the elements: min, max, sum and sum of squares are reduced together
+    (TeracadaStats::reduce()), the sums of the elements shifted by the first element so that the variance does not
+    cancel out. The kernels are written once with the vector extensions of the compiler, with as many elements per
+    vector as tc_double lanes in a register, and compiled for every SIMD level with the target attribute (SSE2, AVX2,
+    AVX-512), the level is picked at runtime from the cpu features. The sums are accumulated in tc_double for every data type.
+    The higher moments (TeracadaStatsMoments) are reduced by cache sized blocks and merged with the pairwise update formulas.
+    Large arrays are split in chunks reduced in parallel by a pool of worker threads, the summaries of the chunks share
+    the shift and are merged by adding them up.
+    The positions of the min/max (argMin(), argMax()) or of a value (argWhere()) are searched in a single pass too: whole
+    vectors are compared to the value and only the vectors with a match are scanned element by element, the positions are
+    buffered and inserted in the positions array in bulk.
+*/
+
+
+#include <new>
 #include <random>
 #include <cmath>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+#include <limits>
+#include <algorithm>
 
 #include "teracada_array.h"
+#include "teracada_stats.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define TS_SIMD_X86 1
+#endif
+
+
+std::atomic<tc_byte> TeracadaStats::m_ab8SimdLevel(TS_SIMD_AVX512);
+std::atomic<tc_uint32> TeracadaStats::m_aui32NumThreads(1);
+std::atomic<tc_index> TeracadaStats::m_aiMinChunkSize(TS_PARALLEL_MIN_CHUNK_SIZE);
+
+
+// Data types the stats functions and the kernels are built for
+template <typename tDataType>
+static constexpr tc_bool isStatsDataType ( void ) {
+  return std::is_same_v<tDataType, tc_byte> || std::is_same_v<tDataType, tc_int> || std::is_same_v<tDataType, tc_decimal>;
+}
+
+
+template <typename tDataType>
+static inline tc_void mergeSummary ( stdTeracadaStatsSummary<tDataType>* pstSummary, tc_index iNumElements,
+                                     tDataType tMin, tDataType tMax, tc_double dSum, tc_double dSumSquares ) {
+  if ( ! pstSummary->iNumElements || tMin < pstSummary->tMin )
+    pstSummary->tMin = tMin;
+
+  if ( ! pstSummary->iNumElements || tMax > pstSummary->tMax )
+    pstSummary->tMax = tMax;
+
+  pstSummary->iNumElements += iNumElements;
+  pstSummary->dSum += dSum;
+  pstSummary->dSumSquares += dSumSquares;
+}
+
+
+// Element by element kernel, TS_SIMD_SCALAR
+template <typename tDataType>
+static tc_void reduceScalar ( const tDataType* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tDataType>* pstSummary ) {
+  tDataType tMin = ptElements[0], tMax = ptElements[0];
+  tc_double dShift = pstSummary->dShift, dSum = 0, dSumSquares = 0;
+
+  for ( tc_index iIndex = 0; iIndex < iNumElements; iIndex++ ) {
+    tDataType tValue = ptElements[iIndex];
+    tc_double dValue = (tc_double) tValue - dShift;
+
+    tMin = (tValue < tMin) ? tValue : tMin;
+    tMax = (tValue > tMax) ? tValue : tMax;
+    dSum += dValue;
+    dSumSquares += dValue * dValue;
+  }
+
+  mergeSummary(pstSummary, iNumElements, tMin, tMax, dSum, dSumSquares);
+}
+
+
+// Vector of iNumLanes elements (the vector size can't depend on a template value parameter in a function typedef)
+template <typename tDataType, tc_int iNumLanes>
+struct stdStatsVector {
+  typedef tDataType tVector __attribute__((vector_size(iNumLanes * sizeof(tDataType))));
+};
+
+
+/*
+  Vector kernel, inlined into the kernel of every SIMD level (reduceSSE2(), reduceAVX2(), reduceAVX512())
+  iNumLanes elements per vector, as many as tc_double accumulators in a register of the level. TS_SIMD_NUM_VECTORS
+  vectors per iteration, into as many sets of accumulators so that the additions of consecutive vectors don't wait
+  on each other, the remaining elements are reduced element by element.
+*/
+template <typename tDataType, tc_int iNumLanes>
+static inline __attribute__((always_inline)) tc_void reduceVector ( const tDataType* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tDataType>* pstSummary ) {
+  typedef typename stdStatsVector<tDataType, iNumLanes>::tVector tVector;
+  typedef typename stdStatsVector<tc_double, iNumLanes>::tVector dVector;
+
+  tc_index iNumVectorElements = iNumElements - (iNumElements % (TS_SIMD_NUM_VECTORS * iNumLanes));
+  tc_double dShift = pstSummary->dShift, dSum = 0, dSumSquares = 0;
+  tDataType tMin, tMax;
+  tVector atvMin[TS_SIMD_NUM_VECTORS], atvMax[TS_SIMD_NUM_VECTORS], tvValues;
+  dVector dvShift = dVector {} + dShift;
+  dVector advSum[TS_SIMD_NUM_VECTORS] = {}, advSumSquares[TS_SIMD_NUM_VECTORS] = {};
+
+  if ( ! iNumVectorElements ) {
+    reduceScalar(ptElements, iNumElements, pstSummary);
+    return;
+  }
+
+  for ( tc_int iVector = 0; iVector < TS_SIMD_NUM_VECTORS; iVector++ ) {
+    memcpy(&atvMin[iVector], ptElements, sizeof(tVector));
+    atvMax[iVector] = atvMin[iVector];
+  }
+
+  for ( tc_index iIndex = 0; iIndex < iNumVectorElements; iIndex += (TS_SIMD_NUM_VECTORS * iNumLanes) ) {
+    // Unrolled, so that the accumulators stay in registers
+    #pragma GCC unroll 4
+    for ( tc_int iVector = 0; iVector < TS_SIMD_NUM_VECTORS; iVector++ ) {
+      memcpy(&tvValues, (ptElements + iIndex + (iVector * iNumLanes)), sizeof(tVector));
+
+      dVector dvValues = __builtin_convertvector(tvValues, dVector) - dvShift;
+
+      atvMin[iVector] = (tvValues < atvMin[iVector]) ? tvValues : atvMin[iVector];
+      atvMax[iVector] = (tvValues > atvMax[iVector]) ? tvValues : atvMax[iVector];
+      advSum[iVector] += dvValues;
+      advSumSquares[iVector] += dvValues * dvValues;
+    }
+  }
+
+  tMin = atvMin[0][0];
+  tMax = atvMax[0][0];
+
+  for ( tc_int iVector = 0; iVector < TS_SIMD_NUM_VECTORS; iVector++ ) {
+    for ( tc_int iLane = 0; iLane < iNumLanes; iLane++ ) {
+      tMin = (atvMin[iVector][iLane] < tMin) ? atvMin[iVector][iLane] : tMin;
+      tMax = (atvMax[iVector][iLane] > tMax) ? atvMax[iVector][iLane] : tMax;
+      dSum += advSum[iVector][iLane];
+      dSumSquares += advSumSquares[iVector][iLane];
+    }
+  }
+
+  for ( tc_index iIndex = iNumVectorElements; iIndex < iNumElements; iIndex++ ) {
+    tDataType tValue = ptElements[iIndex];
+    tc_double dValue = (tc_double) tValue - dShift;
+
+    tMin = (tValue < tMin) ? tValue : tMin;
+    tMax = (tValue > tMax) ? tValue : tMax;
+    dSum += dValue;
+    dSumSquares += dValue * dValue;
+  }
+
+  mergeSummary(pstSummary, iNumElements, tMin, tMax, dSum, dSumSquares);
+}
+
+
+#ifdef TS_SIMD_X86
+
+template <typename tDataType>
+static __attribute__((target("sse2"))) tc_void reduceSSE2 ( const tDataType* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tDataType>* pstSummary ) {
+  reduceVector<tDataType, 2>(ptElements, iNumElements, pstSummary);
+}
+
+
+template <typename tDataType>
+static __attribute__((target("avx2"))) tc_void reduceAVX2 ( const tDataType* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tDataType>* pstSummary ) {
+  reduceVector<tDataType, 4>(ptElements, iNumElements, pstSummary);
+}
+
+
+template <typename tDataType>
+static __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) tc_void reduceAVX512 ( const tDataType* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tDataType>* pstSummary ) {
+  reduceVector<tDataType, 8>(ptElements, iNumElements, pstSummary);
+}
+
+#endif
+
+
+static tc_byte detectSimdLevel ( void ) {
+  #ifdef TS_SIMD_X86
+    __builtin_cpu_init();
+
+    if ( __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+         __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl") )
+      return TS_SIMD_AVX512;
+
+    if ( __builtin_cpu_supports("avx2") )
+      return TS_SIMD_AVX2;
+
+    if ( __builtin_cpu_supports("sse2") )
+      return TS_SIMD_SSE2;
+  #endif
+
+  return TS_SIMD_SCALAR;
+}
+
+
+tc_byte TeracadaStats::getMaxSimdLevel ( void ) {
+  static const tc_byte b8MaxSimdLevel = detectSimdLevel();
+
+  return b8MaxSimdLevel;
+}
+
+
+tc_byte TeracadaStats::getSimdLevel ( void ) {
+  return std::min(m_ab8SimdLevel.load(std::memory_order_relaxed), getMaxSimdLevel());
+}
+
+
+tc_byte TeracadaStats::setSimdLevel ( tc_byte b8SimdLevel ) {
+  m_ab8SimdLevel.store(b8SimdLevel, std::memory_order_relaxed);
+
+  return getSimdLevel();
+}
+
+
+const tc_char* TeracadaStats::getSimdLevelName ( tc_byte b8SimdLevel ) {
+  switch ( b8SimdLevel ) {
+    case TS_SIMD_SCALAR:
+      return "SCALAR";
+
+    case TS_SIMD_SSE2:
+      return "SSE2";
+
+    case TS_SIMD_AVX2:
+      return "AVX2";
+
+    case TS_SIMD_AVX512:
+      return "AVX512";
+
+    default:
+      return "UNKNOWN";
+  }
+}
+
+
+/*
+  Worker threads of the parallel reductions (TeracadaStats::parallelFor()), started by the first parallel reduction
+  - The chunks of a reduction are taken in turn by the workers and the calling thread until there are none left.
+  - One reduction at a time, run() returns false when the workers are busy (another thread, or a reduction nested
+    in a chunk) and the caller reduces the chunks itself.
+  - The workers are stopped when there are fewer threads set than workers, and at exit.
+*/
+class TeracadaStatsThreadPool {
+  private:
+    // Held for the whole reduction
+    std::mutex m_mtxDispatch;
+
+    // Guards the job and the workers
+    std::mutex m_mtxLock;
+    std::condition_variable m_cvWork;
+    std::condition_variable m_cvDone;
+
+    std::thread m_athrWorkers[TS_MAX_NUM_THREADS];
+    tc_uint32   m_ui32NumWorkers = 0;
+    tc_uint32   m_ui32NumJobWorkers = 0;
+    tc_uint32   m_ui32NumBusyWorkers = 0;
+    tc_uint64   m_ui64JobId = 0;
+    tc_bool     m_bStop = false;
+
+    const std::function<tc_void ( tc_index )>* m_pfnChunk = nullptr;
+    tc_index              m_iNumChunks = 0;
+    std::atomic<tc_index> m_aiNextChunk;
+
+    tc_void runChunks ( void ) {
+      tc_index iChunk;
+
+      while ( (iChunk = m_aiNextChunk.fetch_add(1, std::memory_order_relaxed)) < m_iNumChunks )
+        (*m_pfnChunk)(iChunk);
+    }
+
+    tc_void runWorker ( tc_uint32 ui32Worker, tc_uint64 ui64JobId ) {
+      std::unique_lock<std::mutex> objLock(m_mtxLock);
+
+      while ( true ) {
+        m_cvWork.wait(objLock, [&] { return m_bStop || m_ui64JobId != ui64JobId; });
+
+        if ( m_bStop )
+          break;
+
+        ui64JobId = m_ui64JobId;
+
+        // Fewer workers than started take part when the job has fewer chunks or fewer threads are set
+        if ( ui32Worker >= m_ui32NumJobWorkers )
+          continue;
+
+        objLock.unlock();
+        runChunks();
+        objLock.lock();
+
+        if ( ! --m_ui32NumBusyWorkers )
+          m_cvDone.notify_one();
+      }
+    }
+
+  public:
+    ~TeracadaStatsThreadPool ( void ) {
+      stop();
+    }
+
+    tc_bool run ( tc_uint32 ui32NumThreads, tc_index iNumChunks, const std::function<tc_void ( tc_index )>& fnChunk ) {
+      std::unique_lock<std::mutex> objDispatchLock(m_mtxDispatch, std::try_to_lock);
+
+      if ( ! objDispatchLock.owns_lock() )
+        return false;
+
+      {
+        std::lock_guard<std::mutex> objLock(m_mtxLock);
+
+        while ( (m_ui32NumWorkers + 1) < ui32NumThreads ) {
+          try {
+            m_athrWorkers[m_ui32NumWorkers] = std::thread(&TeracadaStatsThreadPool::runWorker, this, m_ui32NumWorkers, m_ui64JobId);
+            m_ui32NumWorkers++;
+
+          } catch ( const std::system_error& objError ) {
+            TC_LOG(LOG_ERR, "TeracadaStatsThreadPool::run(): Failed to start a worker thread [ NUM_WORKERS: %u | ERROR: %s ]", m_ui32NumWorkers, objError.what());
+            break;
+          }
+        }
+
+        m_ui32NumJobWorkers = (tc_uint32) std::min<tc_index>(std::min(m_ui32NumWorkers, ui32NumThreads - 1), iNumChunks - 1);
+        m_ui32NumBusyWorkers = m_ui32NumJobWorkers;
+        m_pfnChunk = &fnChunk;
+        m_iNumChunks = iNumChunks;
+        m_aiNextChunk.store(0, std::memory_order_relaxed);
+        m_ui64JobId++;
+      }
+
+      m_cvWork.notify_all();
+      runChunks();
+
+      std::unique_lock<std::mutex> objLock(m_mtxLock);
+      m_cvDone.wait(objLock, [&] { return ! m_ui32NumBusyWorkers; });
+
+      return true;
+    }
+
+    tc_void stop ( void ) {
+      std::lock_guard<std::mutex> objDispatchLock(m_mtxDispatch);
+
+      {
+        std::lock_guard<std::mutex> objLock(m_mtxLock);
+        m_bStop = true;
+      }
+
+      m_cvWork.notify_all();
+
+      for ( tc_uint32 ui32Worker = 0; ui32Worker < m_ui32NumWorkers; ui32Worker++ )
+        m_athrWorkers[ui32Worker].join();
+
+      m_ui32NumWorkers = 0;
+      m_bStop = false;
+    }
+
+    tc_uint32 getNumWorkers ( void ) {
+      std::lock_guard<std::mutex> objLock(m_mtxLock);
+      return m_ui32NumWorkers;
+    }
+};
+
+
+static TeracadaStatsThreadPool& getThreadPool ( void ) {
+  static TeracadaStatsThreadPool objThreadPool;
+
+  return objThreadPool;
+}
+
+
+tc_uint32 TeracadaStats::getNumThreads ( void ) {
+  return m_aui32NumThreads.load(std::memory_order_relaxed);
+}
+
+
+tc_uint32 TeracadaStats::setNumThreads ( tc_uint32 ui32NumThreads ) {
+  if ( ! ui32NumThreads )
+    ui32NumThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  ui32NumThreads = std::min(ui32NumThreads, (tc_uint32) TS_MAX_NUM_THREADS);
+  m_aui32NumThreads.store(ui32NumThreads, std::memory_order_relaxed);
+
+  // The extra workers are stopped, the remaining ones are started again by the next parallel reduction
+  if ( getThreadPool().getNumWorkers() >= ui32NumThreads )
+    getThreadPool().stop();
+
+  return ui32NumThreads;
+}
+
+
+tc_index TeracadaStats::getMinChunkSize ( void ) {
+  return m_aiMinChunkSize.load(std::memory_order_relaxed);
+}
+
+
+tc_index TeracadaStats::setMinChunkSize ( tc_index iMinChunkSize ) {
+  iMinChunkSize = std::max<tc_index>(iMinChunkSize, 1);
+  m_aiMinChunkSize.store(iMinChunkSize, std::memory_order_relaxed);
+
+  return iMinChunkSize;
+}
+
+
+tc_index TeracadaStats::getNumChunks ( tc_index iNumElements ) {
+  tc_uint32 ui32NumThreads = getNumThreads();
+
+  if ( ui32NumThreads <= 1 )
+    return 1;
+
+  return std::max<tc_index>(std::min<tc_index>(iNumElements / getMinChunkSize(), (tc_index) ui32NumThreads * TS_PARALLEL_CHUNKS_PER_THREAD), 1);
+}
+
+
+tc_void TeracadaStats::parallelFor ( tc_index iNumChunks, const std::function<tc_void ( tc_index )>& fnChunk ) {
+  if ( iNumChunks > 1 && getNumThreads() > 1 && getThreadPool().run(getNumThreads(), iNumChunks, fnChunk) )
+    return;
+
+  for ( tc_index iChunk = 0; iChunk < iNumChunks; iChunk++ )
+    fnChunk(iChunk);
+}
+
+
+// Kernel of the SIMD level in effect, on the calling thread
+template <typename tDataType>
+static tc_void reduceSerial ( const tDataType* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tDataType>* pstSummary ) {
+  switch ( TeracadaStats::getSimdLevel() ) {
+    #ifdef TS_SIMD_X86
+      case TS_SIMD_AVX512:
+        reduceAVX512(ptElements, iNumElements, pstSummary);
+        break;
+
+      case TS_SIMD_AVX2:
+        reduceAVX2(ptElements, iNumElements, pstSummary);
+        break;
+
+      case TS_SIMD_SSE2:
+        // SSE2 has no 32/64 bit integer min/max (nor 64 bit conversions), the scalar kernel is faster for them
+        if constexpr ( std::is_integral_v<tDataType> && sizeof(tDataType) > 1 ) {
+          reduceScalar(ptElements, iNumElements, pstSummary);
+          break;
+        }
+
+        reduceSSE2(ptElements, iNumElements, pstSummary);
+        break;
+    #endif
+
+    default:
+      reduceScalar(ptElements, iNumElements, pstSummary);
+      break;
+  }
+}
+
+
+/*!
+  @brief
+    Add the elements to the summary
+
+  @details
+    The elements are split in TeracadaStats::getNumChunks() chunks, reduced in parallel with the shift of the summary
+    and merged in the order of the chunks. A single chunk is reduced on the calling thread.
+
+  @param[in]
+    ptElements The elements
+
+  @param[in]
+    iNumElements The number of elements
+
+  @param[in,out]
+    pstSummary The summary the elements are added to, its dShift is set by the caller
+*/
+template <typename tDataType>
+tc_void TeracadaStats::reduce ( const tDataType* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tDataType>* pstSummary ) {
+  stdTeracadaStatsSummary<tDataType>* pstChunkSummaries = nullptr;
+  tc_index iNumChunks = 0;
+
+  if ( iNumElements <= 0 )
+    return;
+
+  iNumChunks = getNumChunks(iNumElements);
+
+  if ( iNumChunks > 1 )
+    pstChunkSummaries = new (std::nothrow) stdTeracadaStatsSummary<tDataType>[iNumChunks];
+
+  if ( ! pstChunkSummaries ) {
+    reduceSerial(ptElements, iNumElements, pstSummary);
+    return;
+  }
+
+  parallelFor(iNumChunks, [&] ( tc_index iChunk ) {
+    tc_index iBegin = (iNumElements * iChunk) / iNumChunks, iEnd = (iNumElements * (iChunk + 1)) / iNumChunks;
+
+    pstChunkSummaries[iChunk] = stdTeracadaStatsSummary<tDataType> {};
+    pstChunkSummaries[iChunk].dShift = pstSummary->dShift;
+    reduceSerial(ptElements + iBegin, iEnd - iBegin, &pstChunkSummaries[iChunk]);
+  });
+
+  for ( tc_index iChunk = 0; iChunk < iNumChunks; iChunk++ ) {
+    stdTeracadaStatsSummary<tDataType>& stChunkSummary = pstChunkSummaries[iChunk];
+    mergeSummary(pstSummary, stChunkSummary.iNumElements, stChunkSummary.tMin, stChunkSummary.tMax, stChunkSummary.dSum, stChunkSummary.dSumSquares);
+  }
+
+  delete[] pstChunkSummaries;
+}
+
+template tc_void TeracadaStats::reduce<tc_byte> ( const tc_byte* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tc_byte>* pstSummary );
+template tc_void TeracadaStats::reduce<tc_int> ( const tc_int* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tc_int>* pstSummary );
+template tc_void TeracadaStats::reduce<tc_decimal> ( const tc_decimal* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tc_decimal>* pstSummary );
+
+
+/*
+  Positions found by the search kernels (searchExtreme(), searchValue()), buffered by TS_POSITIONS_BUFFER_SIZE into
+  a scratch array of tc_index positions. discard() drops the positions of the search so far (a new min/max was found),
+  only the scratch array is cleared, the positions array is not touched until finish() appends all the positions at once.
+  The positions are checked to fit in tc_int there, the positions array is left unchanged if they don't (32 bit builds).
+*/
+class TeracadaStatsPositions {
+  private:
+    TeracadaArray<tc_int>* m_ptcaPositions;
+    tc_index* m_piScratch;
+    tc_index  m_iScratchCapacity;
+    tc_index  m_iNumScratch;
+    tc_index  m_iNumBuffered;
+    tc_bool   m_bFailed;
+    tc_index  m_aiBuffer[TS_POSITIONS_BUFFER_SIZE];
+
+  public:
+    TeracadaStatsPositions ( TeracadaArray<tc_int>* ptcaPositions ) :
+      m_ptcaPositions(ptcaPositions),
+      m_piScratch(nullptr),
+      m_iScratchCapacity(0),
+      m_iNumScratch(0),
+      m_iNumBuffered(0),
+      m_bFailed(false)
+    {}
+
+    ~TeracadaStatsPositions ( void ) {
+      free(m_piScratch);
+    }
+
+    TeracadaStatsPositions ( const TeracadaStatsPositions& objOther ) = delete;
+    TeracadaStatsPositions& operator= ( const TeracadaStatsPositions& objOther ) = delete;
+
+    inline tc_void push ( tc_index iIndex ) {
+      if ( ! m_ptcaPositions )
+        return;
+
+      if ( m_iNumBuffered == TS_POSITIONS_BUFFER_SIZE )
+        flush();
+
+      m_aiBuffer[m_iNumBuffered++] = iIndex + 1;
+    }
+
+    tc_void flush ( void ) {
+      tc_index* piScratch = nullptr;
+      tc_index iScratchCapacity = 0;
+
+      if ( ! m_iNumBuffered || m_bFailed )
+        goto EXIT;
+
+      // The scratch array is grown geometrically, it is reused (not shrunk) by discard()
+      if ( (m_iNumScratch + m_iNumBuffered) > m_iScratchCapacity ) {
+        iScratchCapacity = std::max((2 * m_iScratchCapacity), (m_iNumScratch + m_iNumBuffered));
+        piScratch = (tc_index*) realloc(m_piScratch, (iScratchCapacity * sizeof(tc_index)));
+
+        if ( ! piScratch ) {
+          TC_LOG(LOG_ERR, "TeracadaStatsPositions::flush(): Failed to grow the positions scratch array [ NUM_POSITIONS: %ld ]", (tc_int64) (m_iNumScratch + m_iNumBuffered));
+          m_ptcaPositions->setErrno(ERR_TA_MEMALLOC_FAILED);
+          m_bFailed = true;
+          goto EXIT;
+        }
+
+        m_piScratch = piScratch;
+        m_iScratchCapacity = iScratchCapacity;
+      }
+
+      memcpy((m_piScratch + m_iNumScratch), m_aiBuffer, (m_iNumBuffered * sizeof(tc_index)));
+      m_iNumScratch += m_iNumBuffered;
+
+      EXIT:
+        m_iNumBuffered = 0;
+    }
+
+    tc_void discard ( void ) {
+      m_iNumBuffered = 0;
+      m_iNumScratch = 0;
+    }
+
+    // false if the positions do not fit in tc_int or could not be inserted
+    tc_bool finish ( void ) {
+      tc_int* piPositions = nullptr;
+      tc_int iPosition = 0;
+
+      if ( ! m_ptcaPositions )
+        goto EXIT;
+
+      flush();
+
+      if ( m_bFailed )
+        goto ERREXIT;
+
+      if ( ! m_iNumScratch )
+        goto EXIT;
+
+      piPositions = (tc_int*) m_piScratch;
+
+      /*
+        Narrowed to tc_int in place, position i is written over the bytes of the positions before it (already read),
+        every position is checked before the positions array is touched
+      */
+      for ( tc_index iScratch = 0; iScratch < m_iNumScratch; iScratch++ ) {
+        if ( m_piScratch[iScratch] > std::numeric_limits<tc_int>::max() ) {
+          TC_LOG(LOG_ERR, "TeracadaStatsPositions::finish(): Position does not fit in the positions array data type [ POSITION: %ld ]", (tc_int64) m_piScratch[iScratch]);
+          m_ptcaPositions->setErrno(ERR_TA_INVALID_POSITION_OR_INDEX);
+          goto ERREXIT;
+        }
+
+        iPosition = (tc_int) m_piScratch[iScratch];
+        memcpy((piPositions + iScratch), &iPosition, sizeof(tc_int));
+      }
+
+      if ( ! m_ptcaPositions->insertBack(piPositions, m_iNumScratch) ) {
+        TC_LOG(LOG_ERR, "TeracadaStatsPositions::finish(): Failed to insert the positions [ NUM_POSITIONS: %ld ]", (tc_int64) m_iNumScratch);
+        goto ERREXIT;
+      }
+
+      EXIT:
+        return true;
+
+      ERREXIT:
+        return false;
+    }
+};
+
+
+// Element by element search of the min/max from ptElements[iBegin], tExtreme and iFirstIndex are the ones before iBegin
+template <typename tDataType, tc_bool bMax>
+static inline tc_void scanExtreme ( const tDataType* ptElements, tc_index iBegin, tc_index iEnd, tDataType& tExtreme,
+                                    tc_index& iFirstIndex, TeracadaStatsPositions* pobjPositions ) {
+  for ( tc_index iIndex = iBegin; iIndex < iEnd; iIndex++ ) {
+    tDataType tValue = ptElements[iIndex];
+
+    if ( bMax ? (tValue > tExtreme) : (tValue < tExtreme) ) {
+      tExtreme = tValue;
+      iFirstIndex = iIndex;
+      pobjPositions->discard();
+      pobjPositions->push(iIndex);
+
+    } else if ( tValue == tExtreme ) {
+      pobjPositions->push(iIndex);
+    }
+  }
+}
+
+
+// Any lane of a vector compare result set, tested as 64 bit words rather than lane by lane (up to 64 byte lanes)
+template <typename tMask>
+static inline __attribute__((always_inline)) tc_bool anyLane ( const tMask& tvMatch ) {
+  typedef typename stdStatsVector<tc_uint64, (sizeof(tMask) / sizeof(tc_uint64))>::tVector tWords;
+  tWords tvWords = (tWords) tvMatch;
+  tc_uint64 ui64Match = 0;
+
+  for ( tc_uint32 ui32Word = 0; ui32Word < (sizeof(tMask) / sizeof(tc_uint64)); ui32Word++ )
+    ui64Match |= tvWords[ui32Word];
+
+  return ui64Match != 0;
+}
+
+/*
+  Min (bMax false) or max of the elements and the index of the first one, their positions are pushed to pobjPositions
+  iVectorSize bytes per vector, TS_SIMD_NUM_VECTORS vectors per iteration compared to the min/max so far: the iterations
+  without an element less/greater than or equal to it (all of them but a few, unless the min/max is repeated) are skipped,
+  the others are scanned element by element.
+*/
+template <typename tDataType, tc_bool bMax, tc_int iVectorSize>
+static inline __attribute__((always_inline)) tDataType searchExtremeVector ( const tDataType* ptElements, tc_index iNumElements,
+                                                                             tc_index* piFirstIndex, TeracadaStatsPositions* pobjPositions ) {
+  constexpr tc_int iNumLanes = iVectorSize / sizeof(tDataType);
+  typedef typename stdStatsVector<tDataType, iNumLanes>::tVector tVector;
+
+  tc_index iNumVectorElements = iNumElements - (iNumElements % (TS_SIMD_NUM_VECTORS * iNumLanes));
+  tDataType tExtreme = ptElements[0];
+  tc_index iFirstIndex = 0;
+  tVector tvExtreme = tVector {} + tExtreme, tvValues;
+
+  pobjPositions->push(0);
+
+  for ( tc_index iIndex = 0; iIndex < iNumVectorElements; iIndex += (TS_SIMD_NUM_VECTORS * iNumLanes) ) {
+    decltype(tvValues < tvValues) tvMatch = {};
+    tc_bool bMatch;
+
+    // Not unrolled with the pragma, the compares of the unrolled loop are not vectorized by GCC (fully unrolled anyway)
+    for ( tc_int iVector = 0; iVector < TS_SIMD_NUM_VECTORS; iVector++ ) {
+      memcpy(&tvValues, (ptElements + iIndex + (iVector * iNumLanes)), sizeof(tVector));
+      tvMatch |= bMax ? (tvValues >= tvExtreme) : (tvValues <= tvExtreme);
+    }
+
+    bMatch = anyLane(tvMatch);
+
+    if ( ! bMatch )
+      continue;
+
+    // Only the vectors with a match are scanned, the first element is the min/max so far, not a match of itself
+    for ( tc_int iVector = 0; iVector < TS_SIMD_NUM_VECTORS; iVector++ ) {
+      tc_index iVectorIndex = iIndex + (iVector * iNumLanes);
+
+      memcpy(&tvValues, (ptElements + iVectorIndex), sizeof(tVector));
+
+      if ( ! anyLane(bMax ? (tvValues >= tvExtreme) : (tvValues <= tvExtreme)) )
+        continue;
+
+      scanExtreme<tDataType, bMax>(ptElements, (iVectorIndex ? iVectorIndex : 1), iVectorIndex + iNumLanes, tExtreme, iFirstIndex, pobjPositions);
+      tvExtreme = tVector {} + tExtreme;
+    }
+  }
+
+  scanExtreme<tDataType, bMax>(ptElements, std::max<tc_index>(iNumVectorElements, 1), iNumElements, tExtreme, iFirstIndex, pobjPositions);
+
+  *piFirstIndex = iFirstIndex;
+
+  return tExtreme;
+}
+
+
+// Number of elements equal to tValue, their positions are pushed to pobjPositions (the vectors without one are skipped)
+template <typename tDataType, tc_int iVectorSize>
+static inline __attribute__((always_inline)) tc_index searchValueVector ( const tDataType* ptElements, tc_index iNumElements,
+                                                                          tDataType tValue, TeracadaStatsPositions* pobjPositions ) {
+  constexpr tc_int iNumLanes = iVectorSize / sizeof(tDataType);
+  typedef typename stdStatsVector<tDataType, iNumLanes>::tVector tVector;
+
+  tc_index iNumVectorElements = iNumElements - (iNumElements % (TS_SIMD_NUM_VECTORS * iNumLanes));
+  tc_index iNumMatches = 0;
+  tVector tvValue = tVector {} + tValue, tvValues;
+
+  for ( tc_index iIndex = 0; iIndex < iNumVectorElements; iIndex += (TS_SIMD_NUM_VECTORS * iNumLanes) ) {
+    decltype(tvValues < tvValues) tvMatch = {};
+    tc_bool bMatch;
+
+    // Not unrolled with the pragma, the compares of the unrolled loop are not vectorized by GCC (fully unrolled anyway)
+    for ( tc_int iVector = 0; iVector < TS_SIMD_NUM_VECTORS; iVector++ ) {
+      memcpy(&tvValues, (ptElements + iIndex + (iVector * iNumLanes)), sizeof(tVector));
+      tvMatch |= (tvValues == tvValue);
+    }
+
+    bMatch = anyLane(tvMatch);
+
+    if ( ! bMatch )
+      continue;
+
+    // Only the vectors with a match are scanned
+    for ( tc_int iVector = 0; iVector < TS_SIMD_NUM_VECTORS; iVector++ ) {
+      tc_index iVectorIndex = iIndex + (iVector * iNumLanes);
+
+      memcpy(&tvValues, (ptElements + iVectorIndex), sizeof(tVector));
+
+      if ( ! anyLane(tvValues == tvValue) )
+        continue;
+
+      for ( tc_index iMatchIndex = iVectorIndex; iMatchIndex < iVectorIndex + iNumLanes; iMatchIndex++ ) {
+        if ( ptElements[iMatchIndex] == tValue ) {
+          pobjPositions->push(iMatchIndex);
+          iNumMatches++;
+        }
+      }
+    }
+  }
+
+  for ( tc_index iIndex = iNumVectorElements; iIndex < iNumElements; iIndex++ ) {
+    if ( ptElements[iIndex] == tValue ) {
+      pobjPositions->push(iIndex);
+      iNumMatches++;
+    }
+  }
+
+  return iNumMatches;
+}
+
+
+#ifdef TS_SIMD_X86
+
+template <typename tDataType, tc_bool bMax>
+static __attribute__((target("sse2"))) tDataType searchExtremeSSE2 ( const tDataType* ptElements, tc_index iNumElements, tc_index* piFirstIndex, TeracadaStatsPositions* pobjPositions ) {
+  return searchExtremeVector<tDataType, bMax, 16>(ptElements, iNumElements, piFirstIndex, pobjPositions);
+}
+
+
+template <typename tDataType, tc_bool bMax>
+static __attribute__((target("avx2"))) tDataType searchExtremeAVX2 ( const tDataType* ptElements, tc_index iNumElements, tc_index* piFirstIndex, TeracadaStatsPositions* pobjPositions ) {
+  return searchExtremeVector<tDataType, bMax, 32>(ptElements, iNumElements, piFirstIndex, pobjPositions);
+}
+
+
+template <typename tDataType, tc_bool bMax>
+static __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) tDataType searchExtremeAVX512 ( const tDataType* ptElements, tc_index iNumElements, tc_index* piFirstIndex, TeracadaStatsPositions* pobjPositions ) {
+  return searchExtremeVector<tDataType, bMax, 64>(ptElements, iNumElements, piFirstIndex, pobjPositions);
+}
+
+
+template <typename tDataType>
+static __attribute__((target("sse2"))) tc_index searchValueSSE2 ( const tDataType* ptElements, tc_index iNumElements, tDataType tValue, TeracadaStatsPositions* pobjPositions ) {
+  return searchValueVector<tDataType, 16>(ptElements, iNumElements, tValue, pobjPositions);
+}
+
+
+template <typename tDataType>
+static __attribute__((target("avx2"))) tc_index searchValueAVX2 ( const tDataType* ptElements, tc_index iNumElements, tDataType tValue, TeracadaStatsPositions* pobjPositions ) {
+  return searchValueVector<tDataType, 32>(ptElements, iNumElements, tValue, pobjPositions);
+}
+
+
+template <typename tDataType>
+static __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) tc_index searchValueAVX512 ( const tDataType* ptElements, tc_index iNumElements, tDataType tValue, TeracadaStatsPositions* pobjPositions ) {
+  return searchValueVector<tDataType, 64>(ptElements, iNumElements, tValue, pobjPositions);
+}
+
+#endif
+
+
+// Search kernel of the SIMD level in effect, the element by element search for TS_SIMD_SCALAR
+template <typename tDataType, tc_bool bMax>
+static tDataType searchExtreme ( const tDataType* ptElements, tc_index iNumElements, tc_index* piFirstIndex, TeracadaStatsPositions* pobjPositions ) {
+  switch ( TeracadaStats::getSimdLevel() ) {
+    #ifdef TS_SIMD_X86
+      case TS_SIMD_AVX512:
+        return searchExtremeAVX512<tDataType, bMax>(ptElements, iNumElements, piFirstIndex, pobjPositions);
+
+      case TS_SIMD_AVX2:
+        return searchExtremeAVX2<tDataType, bMax>(ptElements, iNumElements, piFirstIndex, pobjPositions);
+
+      case TS_SIMD_SSE2:
+        // SSE2 has no 64 bit integer compares
+        if constexpr ( ! (std::is_integral_v<tDataType> && sizeof(tDataType) > 4) )
+          return searchExtremeSSE2<tDataType, bMax>(ptElements, iNumElements, piFirstIndex, pobjPositions);
+
+        break;
+    #endif
+
+    default:
+      break;
+  }
+
+  tDataType tExtreme = ptElements[0];
+
+  *piFirstIndex = 0;
+  pobjPositions->push(0);
+  scanExtreme<tDataType, bMax>(ptElements, 1, iNumElements, tExtreme, *piFirstIndex, pobjPositions);
+
+  return tExtreme;
+}
 
 
 template <typename tDataType>
-tDataType TeracadaArray::_min ( TeracadaArray *tcaMinValPositions ) {
-  tDataType tMinVal = 0;
+static tc_index searchValue ( const tDataType* ptElements, tc_index iNumElements, tDataType tValue, TeracadaStatsPositions* pobjPositions ) {
+  switch ( TeracadaStats::getSimdLevel() ) {
+    #ifdef TS_SIMD_X86
+      case TS_SIMD_AVX512:
+        return searchValueAVX512(ptElements, iNumElements, tValue, pobjPositions);
 
-  if ( ! isInitSuccess() )
-    goto ERREXIT;
+      case TS_SIMD_AVX2:
+        return searchValueAVX2(ptElements, iNumElements, tValue, pobjPositions);
+
+      case TS_SIMD_SSE2:
+        if constexpr ( ! (std::is_integral_v<tDataType> && sizeof(tDataType) > 4) )
+          return searchValueSSE2(ptElements, iNumElements, tValue, pobjPositions);
+
+        break;
+    #endif
+
+    default:
+      break;
+  }
+
+  tc_index iNumMatches = 0;
 
-  for ( tc_int iIter = 0; iIter <= getLastElementIndex(); iIter++ ) {
-    if ( *((tDataType *) m_pvArray + iIter) < tMinVal ) {
-      tMinVal = *((tDataType *) m_pvArray + iIter);
+  for ( tc_index iIndex = 0; iIndex < iNumElements; iIndex++ ) {
+    if ( ptElements[iIndex] == tValue ) {
+      pobjPositions->push(iIndex);
+      iNumMatches++;
     }
   }
 
-  if ( tcaMinValPositions ) {
-    for ( tc_int iIter = 0; iIter <= getLastElementIndex(); iIter++ ) {
-      if ( *((tDataType *) m_pvArray + iIter) == tMinVal ) {
-        tcaMinValPositions->insert((tc_int) indexToPosition(iIter));
-      }
+  return iNumMatches;
+}
+
+
+// Central moment sums of the elements about dMean, into TS_SIMD_NUM_VECTORS sets of accumulators as the vector kernels
+template <typename tDataType>
+static tc_void reduceCentralMoments ( const tDataType* ptElements, tc_index iNumElements, tc_double dMean,
+                                      tc_double* pdM2, tc_double* pdM3, tc_double* pdM4 ) {
+  tc_index iNumUnrolledElements = iNumElements - (iNumElements % TS_SIMD_NUM_VECTORS);
+  tc_double adM2[TS_SIMD_NUM_VECTORS] = {}, adM3[TS_SIMD_NUM_VECTORS] = {}, adM4[TS_SIMD_NUM_VECTORS] = {};
+
+  for ( tc_index iIndex = 0; iIndex < iNumUnrolledElements; iIndex += TS_SIMD_NUM_VECTORS ) {
+    #pragma GCC unroll 4
+    for ( tc_int iAccumulator = 0; iAccumulator < TS_SIMD_NUM_VECTORS; iAccumulator++ ) {
+      tc_double dDeviation = (tc_double) ptElements[iIndex + iAccumulator] - dMean;
+      tc_double dDeviationSquare = dDeviation * dDeviation;
+
+      adM2[iAccumulator] += dDeviationSquare;
+      adM3[iAccumulator] += dDeviationSquare * dDeviation;
+      adM4[iAccumulator] += dDeviationSquare * dDeviationSquare;
     }
   }
 
+  for ( tc_index iIndex = iNumUnrolledElements; iIndex < iNumElements; iIndex++ ) {
+    tc_double dDeviation = (tc_double) ptElements[iIndex] - dMean;
+    tc_double dDeviationSquare = dDeviation * dDeviation;
+
+    adM2[0] += dDeviationSquare;
+    adM3[0] += dDeviationSquare * dDeviation;
+    adM4[0] += dDeviationSquare * dDeviationSquare;
+  }
+
+  *pdM2 = *pdM3 = *pdM4 = 0;
+
+  for ( tc_int iAccumulator = 0; iAccumulator < TS_SIMD_NUM_VECTORS; iAccumulator++ ) {
+    *pdM2 += adM2[iAccumulator];
+    *pdM3 += adM3[iAccumulator];
+    *pdM4 += adM4[iAccumulator];
+  }
+}
+
+
+/*!
+  @brief
+    Merge the moments of other elements into the moments
+
+  @details
+    Pairwise update formulas of Chan et al. for the mean and M2, of Pebay for M3 and M4. Adding a single
+    element is the merge of iNumElements 1 with M2, M3 and M4 0 (Welford's update).
+
+  @param[in]
+    iNumElements The number of other elements, nothing is merged for 0
+
+  @param[in]
+    tMin, tMax, dMean, dM2, dM3, dM4 The min, max, mean and central moment sums of the other elements
+*/
+template <typename tDataType>
+tc_void TeracadaStatsMoments<tDataType>::mergeMoments ( tc_index iNumElements, tDataType tMin, tDataType tMax, tc_double dMean,
+                                                        tc_double dM2, tc_double dM3, tc_double dM4 ) {
+  tc_double dNumElementsA = (tc_double) m_iNumElements, dNumElementsB = (tc_double) iNumElements;
+  tc_double dNumElements = dNumElementsA + dNumElementsB;
+  tc_double dDelta = 0, dDeltaN = 0, dDeltaN2 = 0, dTerm = 0;
+
+  if ( ! iNumElements )
+    return;
+
+  if ( ! m_iNumElements ) {
+    m_iNumElements = iNumElements;
+    m_tMin = tMin;
+    m_tMax = tMax;
+    m_dMean = dMean;
+    m_dM2 = dM2;
+    m_dM3 = dM3;
+    m_dM4 = dM4;
+    return;
+  }
+
+  dDelta = dMean - m_dMean;
+  dDeltaN = dDelta / dNumElements;
+  dDeltaN2 = dDeltaN * dDeltaN;
+  dTerm = dDelta * dDeltaN * dNumElementsA * dNumElementsB;
+
+  // M4 and M3 are updated from the M2 and M3 of before the merge
+  m_dM4 += dM4 + (dTerm * dDeltaN2 * ((dNumElementsA * dNumElementsA) - (dNumElementsA * dNumElementsB) + (dNumElementsB * dNumElementsB)))
+                + (6 * dDeltaN2 * ((dNumElementsA * dNumElementsA * dM2) + (dNumElementsB * dNumElementsB * m_dM2)))
+                + (4 * dDeltaN * ((dNumElementsA * dM3) - (dNumElementsB * m_dM3)));
+
+  m_dM3 += dM3 + (dTerm * dDeltaN * (dNumElementsA - dNumElementsB)) + (3 * dDeltaN * ((dNumElementsA * dM2) - (dNumElementsB * m_dM2)));
+  m_dM2 += dM2 + dTerm;
+  m_dMean += dDeltaN * dNumElementsB;
+
+  m_tMin = (tMin < m_tMin) ? tMin : m_tMin;
+  m_tMax = (tMax > m_tMax) ? tMax : m_tMax;
+  m_iNumElements += iNumElements;
+}
+
+
+template <typename tDataType>
+tc_void TeracadaStatsMoments<tDataType>::add ( tDataType tValue ) {
+  mergeMoments(1, tValue, tValue, (tc_double) tValue, 0, 0, 0);
+}
+
+
+/*
+  The elements are reduced by blocks of TS_MOMENTS_BLOCK_SIZE: the min, max and mean of the block with TeracadaStats::reduce(),
+  then the central moment sums of the block about its mean while it is still in the cache, and the block is merged into the moments.
+*/
+template <typename tDataType>
+tc_void TeracadaStatsMoments<tDataType>::addBlocks ( const tDataType* ptElements, tc_index iNumElements ) {
+  for ( tc_index iBlock = 0; iBlock < iNumElements; iBlock += TS_MOMENTS_BLOCK_SIZE ) {
+    const tDataType* ptBlock = ptElements + iBlock;
+    tc_index iBlockSize = std::min(iNumElements - iBlock, (tc_index) TS_MOMENTS_BLOCK_SIZE);
+    stdTeracadaStatsSummary<tDataType> stSummary {};
+    tc_double dMean = 0, dM2 = 0, dM3 = 0, dM4 = 0;
+
+    stSummary.dShift = (tc_double) ptBlock[0];
+    TeracadaStats::reduce(ptBlock, iBlockSize, &stSummary);
+
+    dMean = stSummary.dShift + (stSummary.dSum / iBlockSize);
+    reduceCentralMoments(ptBlock, iBlockSize, dMean, &dM2, &dM3, &dM4);
+
+    mergeMoments(iBlockSize, stSummary.tMin, stSummary.tMax, dMean, dM2, dM3, dM4);
+  }
+}
+
+
+/*!
+  @brief
+    Add the elements to the moments in a single pass
+
+  @details
+    The elements are split in TeracadaStats::getNumChunks() chunks, the moments of every chunk are reduced in parallel
+    and merged in the order of the chunks. A single chunk is reduced on the calling thread.
+
+  @param[in]
+    ptElements The elements
+
+  @param[in]
+    iNumElements The number of elements
+*/
+template <typename tDataType>
+tc_void TeracadaStatsMoments<tDataType>::add ( const tDataType* ptElements, tc_index iNumElements ) {
+  TeracadaStatsMoments<tDataType>* pobjChunkMoments = nullptr;
+  tc_index iNumChunks = 0;
+
+  if ( iNumElements <= 0 )
+    return;
+
+  iNumChunks = TeracadaStats::getNumChunks(iNumElements);
+
+  if ( iNumChunks > 1 )
+    pobjChunkMoments = new (std::nothrow) TeracadaStatsMoments<tDataType>[iNumChunks];
+
+  if ( ! pobjChunkMoments ) {
+    addBlocks(ptElements, iNumElements);
+    return;
+  }
+
+  TeracadaStats::parallelFor(iNumChunks, [&] ( tc_index iChunk ) {
+    tc_index iBegin = (iNumElements * iChunk) / iNumChunks, iEnd = (iNumElements * (iChunk + 1)) / iNumChunks;
+
+    pobjChunkMoments[iChunk].addBlocks(ptElements + iBegin, iEnd - iBegin);
+  });
+
+  for ( tc_index iChunk = 0; iChunk < iNumChunks; iChunk++ )
+    merge(pobjChunkMoments[iChunk]);
+
+  delete[] pobjChunkMoments;
+}
+
+
+template <typename tDataType>
+tc_void TeracadaStatsMoments<tDataType>::merge ( const TeracadaStatsMoments& objOther ) {
+  mergeMoments(objOther.m_iNumElements, objOther.m_tMin, objOther.m_tMax, objOther.m_dMean, objOther.m_dM2, objOther.m_dM3, objOther.m_dM4);
+}
+
+
+template <typename tDataType>
+tc_double TeracadaStatsMoments<tDataType>::getVariance ( tc_int iDeltaDOF ) const {
+  if ( m_iNumElements <= iDeltaDOF )
+    return -1;
+
+  return m_dM2 / (m_iNumElements - iDeltaDOF);
+}
+
+
+template <typename tDataType>
+tc_double TeracadaStatsMoments<tDataType>::getStandardDeviation ( tc_int iDeltaDOF ) const {
+  tc_double dVariance = getVariance(iDeltaDOF);
+
+  return (dVariance < 0) ? -1 : sqrt(dVariance);
+}
+
+
+template <typename tDataType>
+tc_double TeracadaStatsMoments<tDataType>::getSkewness ( void ) const {
+  if ( ! m_iNumElements || m_dM2 <= 0 )
+    return 0;
+
+  return sqrt((tc_double) m_iNumElements) * m_dM3 / pow(m_dM2, 1.5);
+}
+
+
+template <typename tDataType>
+tc_double TeracadaStatsMoments<tDataType>::getKurtosis ( void ) const {
+  if ( ! m_iNumElements || m_dM2 <= 0 )
+    return 0;
+
+  return (((tc_double) m_iNumElements * m_dM4) / (m_dM2 * m_dM2)) - 3;
+}
+
+
+/*!
+  @brief
+    Reduce the min, max, sum and sum of squares of the elements in a single pass
+
+  @details
+    The array is compacted first for the non contiguous storage modes. The sums are of the elements
+    shifted by the first element (pstSummary->dShift).
+
+  @param[out]
+    pstSummary The summary of the elements
+
+  @retval
+    true Successfully reduced the elements
+
+  @retval
+    false The array is not initialized, is empty, failed to compact, or the data type is not a number
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::summarize ( stdTeracadaStatsSummary<tDataType>* pstSummary ) {
+  const tDataType* ptElements = nullptr;
+
+  *pstSummary = stdTeracadaStatsSummary<tDataType> {};
+
+  if constexpr ( ! isStatsDataType<tDataType>() ) {
+    setErrno(ERR_TA_INVALID_DATA_TYPE);
+    goto ERREXIT;
+
+  } else {
+    if ( ! isInitSuccess() || ! getNumElements() )
+      goto ERREXIT;
+
+    ptElements = data();
+
+    if ( ! ptElements )
+      goto ERREXIT;
+
+    pstSummary->dShift = (tc_double) ptElements[0];
+    TeracadaStats::reduce(ptElements, getNumElements(), pstSummary);
+  }
+
   EXIT:
-    return tMinVal;
+    return true;
 
   ERREXIT:
-    return 0;
+    return false;
 }
 
-template tc_byte TeracadaArray::_min <tc_byte> ( TeracadaArray * );
-template tc_int TeracadaArray::_min <tc_int> ( TeracadaArray * );
-template tc_decimal TeracadaArray::_min <tc_decimal> ( TeracadaArray * );
 
+/*!
+  @brief
+    Search the min/max of the array and the positions of all of its elements equal to it in a single pass
+
+  @param[in]
+    ptcaArray The array, compacted first for the non contiguous storage modes
+
+  @param[in]
+    bMax Search the max instead of the min
+
+  @param[out]
+    ptcaPositions The positions are inserted at the back of it (ignored for nullptr)
+
+  @param[out]
+    ptExtreme The min/max
+
+  @param[out]
+    piFirstPosition The position of the first element equal to the min/max
+
+  @retval
+    true Successfully searched the elements
 
+  @retval
+    false The array is not initialized, is empty, failed to compact, the positions could not be inserted, or the data type is not a number
+*/
 template <typename tDataType>
-tDataType TeracadaArray::_max ( TeracadaArray *tcaMinValPositions ) {
-  tDataType tMinVal = 0;
+static tc_bool searchArrayExtreme ( TeracadaArray<tDataType>* ptcaArray, tc_bool bMax, TeracadaArray<tc_int>* ptcaPositions,
+                                    tDataType* ptExtreme, tc_index* piFirstPosition ) {
+  const tDataType* ptElements = nullptr;
+  tc_index iFirstIndex = 0;
 
-  if ( ! isInitSuccess() )
+  if constexpr ( ! isStatsDataType<tDataType>() ) {
+    ptcaArray->setErrno(ERR_TA_INVALID_DATA_TYPE);
     goto ERREXIT;
 
-  for ( tc_int iIter = 0; iIter <= getLastElementIndex(); iIter++ ) {
-    if ( *((tDataType *) m_pvArray + iIter) > tMinVal ) {
-      tMinVal = *((tDataType *) m_pvArray + iIter);
-    }
+  } else {
+    TeracadaStatsPositions objPositions(ptcaPositions);
+
+    if ( ! ptcaArray->isInitSuccess() || ! ptcaArray->getNumElements() )
+      goto ERREXIT;
+
+    ptElements = ptcaArray->data();
+
+    if ( ! ptElements )
+      goto ERREXIT;
+
+    if ( bMax )
+      *ptExtreme = searchExtreme<tDataType, true>(ptElements, ptcaArray->getNumElements(), &iFirstIndex, &objPositions);
+    else
+      *ptExtreme = searchExtreme<tDataType, false>(ptElements, ptcaArray->getNumElements(), &iFirstIndex, &objPositions);
+
+    *piFirstPosition = ptcaArray->indexToPosition(iFirstIndex);
+
+    if ( ! objPositions.finish() )
+      goto ERREXIT;
   }
 
-  if ( tcaMinValPositions ) {
-    for ( tc_int iIter = 0; iIter <= getLastElementIndex(); iIter++ ) {
-      if ( *((tDataType *) m_pvArray + iIter) == tMinVal ) {
-        tcaMinValPositions->insert((tc_int) indexToPosition(iIter));
-      }
-    }
+  EXIT:
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+template <typename tDataType>
+tDataType TeracadaArray<tDataType>::min ( TeracadaArray<tc_int>* tcaMinValPositions ) {
+  stdTeracadaStatsSummary<tDataType> stSummary;
+  tDataType tMin {};
+  tc_index iFirstPosition = 0;
+
+  // Without the positions, the min is reduced by the summary kernels (in parallel for the large arrays)
+  if ( ! tcaMinValPositions ) {
+    if ( ! summarize(&stSummary) )
+      goto ERREXIT;
+
+    tMin = stSummary.tMin;
+    goto EXIT;
   }
 
+  if ( ! searchArrayExtreme(this, false, tcaMinValPositions, &tMin, &iFirstPosition) )
+    goto ERREXIT;
+
   EXIT:
-    return tMinVal;
+    return tMin;
 
   ERREXIT:
-    return 0;
+    return tDataType {};
 }
 
-template tc_byte TeracadaArray::_max <tc_byte> ( TeracadaArray * );
-template tc_int TeracadaArray::_max <tc_int> ( TeracadaArray * );
-template tc_decimal TeracadaArray::_max <tc_decimal> ( TeracadaArray * );
+
+template <typename tDataType>
+tDataType TeracadaArray<tDataType>::max ( TeracadaArray<tc_int>* tcaMaxValPositions ) {
+  stdTeracadaStatsSummary<tDataType> stSummary;
+  tDataType tMax {};
+  tc_index iFirstPosition = 0;
+
+  if ( ! tcaMaxValPositions ) {
+    if ( ! summarize(&stSummary) )
+      goto ERREXIT;
+
+    tMax = stSummary.tMax;
+    goto EXIT;
+  }
+
+  if ( ! searchArrayExtreme(this, true, tcaMaxValPositions, &tMax, &iFirstPosition) )
+    goto ERREXIT;
+
+  EXIT:
+    return tMax;
+
+  ERREXIT:
+    return tDataType {};
+}
 
 
 template <typename tDataType>
-tc_decimal TeracadaArray::_mean ( void ) {
-  tc_decimal dMean = 0;
+tc_index TeracadaArray<tDataType>::argMin ( TeracadaArray<tc_int>* tcaPositions ) {
+  tDataType tMin {};
+  tc_index iFirstPosition = 0;
 
-  if ( ! isInitSuccess() )
+  if ( ! searchArrayExtreme(this, false, tcaPositions, &tMin, &iFirstPosition) )
     goto ERREXIT;
 
+  EXIT:
+    return iFirstPosition;
+
+  ERREXIT:
+    return 0;
+}
 
-  for ( tc_int iIter = 0; iIter <= getLastElementIndex(); iIter++ ) {
-    dMean += *((tDataType *) m_pvArray + iIter);
-  }
 
-  dMean = (dMean / getNumElements());
+template <typename tDataType>
+tc_index TeracadaArray<tDataType>::argMax ( TeracadaArray<tc_int>* tcaPositions ) {
+  tDataType tMax {};
+  tc_index iFirstPosition = 0;
+
+  if ( ! searchArrayExtreme(this, true, tcaPositions, &tMax, &iFirstPosition) )
+    goto ERREXIT;
 
   EXIT:
-    return dMean;
+    return iFirstPosition;
 
   ERREXIT:
     return 0;
 }
 
-template tc_decimal TeracadaArray::_mean <tc_byte> (void);
-template tc_decimal TeracadaArray::_mean <tc_int> (void);
-template tc_decimal TeracadaArray::_mean <tc_decimal> (void);
 
+/*!
+  @brief
+    Search the elements equal to a value in a single pass
+
+  @param[in]
+    tValue The value
 
+  @param[out]
+    tcaPositions The positions of the elements equal to tValue are inserted at the back of it (ignored for nullptr)
+
+  @retval
+    The number of elements equal to tValue
+
+  @retval
+    -1 The array is not initialized, failed to compact, the positions could not be inserted, or the data type is not a number
+*/
 template <typename tDataType>
-tc_decimal TeracadaArray::_variance ( tc_int iDeltaDOF ) {
-  tc_decimal dVariance = 0, dMean = 0;
+tc_index TeracadaArray<tDataType>::argWhere ( tDataType tValue, TeracadaArray<tc_int>* tcaPositions ) {
+  const tDataType* ptElements = nullptr;
+  tc_index iNumMatches = 0;
 
-  if ( ! isInitSuccess() )
+  if constexpr ( ! isStatsDataType<tDataType>() ) {
+    setErrno(ERR_TA_INVALID_DATA_TYPE);
     goto ERREXIT;
 
-  dMean = mean();
+  } else {
+    TeracadaStatsPositions objPositions(tcaPositions);
 
-  for ( tc_int iIter = 0; iIter <= getLastElementIndex(); iIter++ ) {
-    dVariance += pow((*((tDataType *) m_pvArray + iIter) - dMean), 2);
-  }
+    if ( ! isInitSuccess() )
+      goto ERREXIT;
 
-  dVariance = (dVariance / (getNumElements() - iDeltaDOF));
+    if ( ! getNumElements() )
+      goto EXIT;
+
+    ptElements = data();
+
+    if ( ! ptElements )
+      goto ERREXIT;
+
+    iNumMatches = searchValue(ptElements, getNumElements(), tValue, &objPositions);
+
+    if ( ! objPositions.finish() )
+      goto ERREXIT;
+  }
 
   EXIT:
-    return dVariance;
+    return iNumMatches;
 
   ERREXIT:
-    // Return negative for error as variance can never be negative
     return -1;
 }
 
-template tc_decimal TeracadaArray::_variance < tc_byte > ( tc_int );
-template tc_decimal TeracadaArray::_variance < tc_int > ( tc_int );
-template tc_decimal TeracadaArray::_variance < tc_decimal > ( tc_int );
+
+template <typename tDataType>
+tc_decimal TeracadaArray<tDataType>::mean ( void ) {
+  stdTeracadaStatsSummary<tDataType> stSummary;
+
+  if ( ! summarize(&stSummary) )
+    goto ERREXIT;
+
+  EXIT:
+    return (tc_decimal) (stSummary.dShift + (stSummary.dSum / stSummary.iNumElements));
+
+  ERREXIT:
+    return 0;
+}
 
 
-template < typename tDataType >
-tc_decimal TeracadaArray::_standardDeviation ( tc_int iDeltaDOF ) {
-  tc_decimal dVariance = 0, dSD = 0;
+template <typename tDataType>
+tc_decimal TeracadaArray<tDataType>::variance ( tc_int iDeltaDOF ) {
+  stdTeracadaStatsSummary<tDataType> stSummary;
+  tc_double dVariance = 0;
 
-  if ( ! isInitSuccess() )
+  if ( ! summarize(&stSummary) || stSummary.iNumElements <= iDeltaDOF )
     goto ERREXIT;
 
-  dVariance = _variance<tDataType>(iDeltaDOF);
+  dVariance = (stSummary.dSumSquares - ((stSummary.dSum * stSummary.dSum) / stSummary.iNumElements)) / (stSummary.iNumElements - iDeltaDOF);
+
+  EXIT:
+    // Rounding can leave a tiny negative variance for (nearly) constant elements
+    return (tc_decimal) std::max(dVariance, 0.0);
+
+  ERREXIT:
+    // Return negative for error as variance can never be negative
+    return -1;
+}
+
+
+template <typename tDataType>
+tc_decimal TeracadaArray<tDataType>::standardDeviation ( tc_int iDeltaDOF ) {
+  tc_decimal dVariance = variance(iDeltaDOF);
 
-  dSD = sqrt(dVariance);
+  if ( dVariance < 0 )
+    goto ERREXIT;
 
   EXIT:
-    return dSD;
+    return sqrt(dVariance);
 
   ERREXIT:
     // Return negative for error as SD can never be negative
     return -1;
 }
 
-template tc_decimal TeracadaArray::_standardDeviation < tc_byte > ( tc_int );
-template tc_decimal TeracadaArray::_standardDeviation < tc_int > ( tc_int );
-template tc_decimal TeracadaArray::_standardDeviation < tc_decimal > ( tc_int );
 
+template <typename tDataType>
+tc_decimal TeracadaArray<tDataType>::range ( void ) {
+  stdTeracadaStatsSummary<tDataType> stSummary;
+  tc_double dRange = 0;
 
-template < typename tDataType >
-tc_decimal TeracadaArray::_range ( void ) {
-  tc_decimal dRange = -1;
-
-  if ( ! isInitSuccess() )
+  if ( ! summarize(&stSummary) )
     goto ERREXIT;
 
-  dRange = _max<tDataType>() - _min<tDataType>();
+  // summarize() fails for the other data types
+  if constexpr ( std::is_arithmetic_v<tDataType> )
+    dRange = (tc_double) stSummary.tMax - (tc_double) stSummary.tMin;
 
   EXIT:
-    return dRange;
+    return (tc_decimal) dRange;
 
   ERREXIT:
     return -1;
 }
 
-template tc_decimal TeracadaArray::_range < tc_byte > ( void );
-template tc_decimal TeracadaArray::_range < tc_int > ( void );
-template tc_decimal TeracadaArray::_range < tc_decimal > ( void );
+
+/*!
+  @brief
+    Add the elements to the moments in a single pass
+
+  @details
+    The moments are not reset, so the elements of several arrays (chunks, streams) can be added to the same moments.
+    The array is compacted first for the non contiguous storage modes.
+
+  @param[in,out]
+    pobjMoments The moments the elements are added to
+
+  @retval
+    true Successfully added the elements, or the array is empty
+
+  @retval
+    false The array is not initialized, failed to compact, or the data type is not a number
+*/
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::moments ( TeracadaStatsMoments<tDataType>* pobjMoments ) {
+  const tDataType* ptElements = nullptr;
+
+  if constexpr ( ! isStatsDataType<tDataType>() ) {
+    setErrno(ERR_TA_INVALID_DATA_TYPE);
+    goto ERREXIT;
+
+  } else {
+    if ( ! isInitSuccess() )
+      goto ERREXIT;
+
+    if ( ! getNumElements() )
+      goto EXIT;
+
+    ptElements = data();
+
+    if ( ! ptElements )
+      goto ERREXIT;
+
+    pobjMoments->add(ptElements, getNumElements());
+  }
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+template <typename tDataType>
+tc_decimal TeracadaArray<tDataType>::skewness ( void ) {
+  tc_double dSkewness = 0;
+
+  if constexpr ( ! isStatsDataType<tDataType>() ) {
+    setErrno(ERR_TA_INVALID_DATA_TYPE);
+    goto ERREXIT;
+
+  } else {
+    TeracadaStatsMoments<tDataType> objMoments;
+
+    if ( ! moments(&objMoments) )
+      goto ERREXIT;
+
+    dSkewness = objMoments.getSkewness();
+  }
+
+  EXIT:
+    return (tc_decimal) dSkewness;
+
+  ERREXIT:
+    return 0;
+}
+
+
+template <typename tDataType>
+tc_decimal TeracadaArray<tDataType>::kurtosis ( void ) {
+  tc_double dKurtosis = 0;
+
+  if constexpr ( ! isStatsDataType<tDataType>() ) {
+    setErrno(ERR_TA_INVALID_DATA_TYPE);
+    goto ERREXIT;
+
+  } else {
+    TeracadaStatsMoments<tDataType> objMoments;
+
+    if ( ! moments(&objMoments) )
+      goto ERREXIT;
+
+    dKurtosis = objMoments.getKurtosis();
+  }
+
+  EXIT:
+    return (tc_decimal) dKurtosis;
+
+  ERREXIT:
+    return 0;
+}
 
 
-tc_bool TeracadaArray::arrayInitRandomUniformDist ( tc_int iLow, tc_int iHigh, tc_int iSeed ) {
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::arrayInitRandomUniformDist ( tc_int iLow, tc_int iHigh, tc_int iSeed ) {
+  tc_index iNumElements = getMaxNumElements() - getNullTermSize() - getNumElements();
   std::mt19937 randomGenerator;
 
   if ( ! iSeed ) {
@@ -182,8 +1530,11 @@ tc_bool TeracadaArray::arrayInitRandomUniformDist ( tc_int iLow, tc_int iHigh, t
 
   std::uniform_int_distribution uniformDistribution(iLow, iHigh);
 
-  for ( tc_int iIter = 1; iIter <= m_iMaxNumArrayElements; iIter++ ) {
-    insert(uniformDistribution(randomGenerator));
+  // Fills the free capacity of the array, the capacity grows with the inserts once it is full
+  if constexpr ( std::is_arithmetic_v<tDataType> ) {
+    for ( tc_index iIter = 1; iIter <= iNumElements; iIter++ ) {
+      insertBack((tDataType) uniformDistribution(randomGenerator));
+    }
   }
 
   EXIT:
@@ -194,7 +1545,9 @@ tc_bool TeracadaArray::arrayInitRandomUniformDist ( tc_int iLow, tc_int iHigh, t
 }
 
 
-tc_bool TeracadaArray::arrayInitRandomUniformDist ( tc_decimal dLow, tc_decimal dHigh, tc_int iSeed ) {
+template <typename tDataType>
+tc_bool TeracadaArray<tDataType>::arrayInitRandomUniformDist ( tc_decimal dLow, tc_decimal dHigh, tc_int iSeed ) {
+  tc_index iNumElements = getMaxNumElements() - getNullTermSize() - getNumElements();
   std::mt19937 randomGenerator;
 
   if ( ! iSeed ) {
@@ -207,8 +1560,11 @@ tc_bool TeracadaArray::arrayInitRandomUniformDist ( tc_decimal dLow, tc_decimal
 
   std::uniform_real_distribution uniformDistribution(dLow, dHigh);
 
-  for ( tc_int iIter = 1; iIter <= m_iMaxNumArrayElements; iIter++ ) {
-    insert(uniformDistribution(randomGenerator));
+  // Fills the free capacity of the array, the capacity grows with the inserts once it is full
+  if constexpr ( std::is_arithmetic_v<tDataType> ) {
+    for ( tc_index iIter = 1; iIter <= iNumElements; iIter++ ) {
+      insertBack((tDataType) uniformDistribution(randomGenerator));
+    }
   }
 
   EXIT:
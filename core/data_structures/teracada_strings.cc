@@ -0,0 +1,1033 @@
+/*!
+  @file
+
+  @brief
+    Implementation of TeracadaStringArray, the owned string column
+
+  @attention
+    Same as TeracadaArray, all api functions MUST make sure that whenever they ERREXIT, they properly call throwException(ERR)
+*/
+
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <functional>
+
+#include "teracada_strings.h"
+
+
+/*!
+  @brief
+    The class constructor.
+
+  @param[in]
+    iNumStrings The number of strings the column can hold before it grows, the default is 100
+
+  @param[in]
+    ui64NumChars The number of characters (null terminators included) the column can hold before it grows,
+    the default (0) is TS_DEFAULT_AVG_STRING_LENGTH characters per string
+
+  @param[in]
+    pobjAllocator The allocator of the character and offsets buffers (see teracada_allocator.h), it has to outlive the column,
+    the process-wide heap allocator (TeracadaAllocator::getDefault()) is used when it is nullptr
+
+  @par Examples
+    @code{.cpp}
+    TeracadaStringArray objStrings;
+    TeracadaStringArray objStrings(1000000, 32000000);
+    TeracadaStringArray objStrings(1000, 0, &objArenaAllocator);
+    @endcode
+
+  @par Errors/Exceptions
+    - ERR_TA_MEMALLOC_FAILED
+    - ERR_TA_INIT_FAILED
+*/
+TeracadaStringArray::TeracadaStringArray ( tc_index iNumStrings, tc_uint64 ui64NumChars, TeracadaAllocator* pobjAllocator ) :
+  m_pcChars(nullptr),
+  m_ui64NumChars(0),
+  m_ui64MaxChars(ui64NumChars ? ui64NumChars : ((tc_uint64) std::max<tc_index>(iNumStrings, 1) * TS_DEFAULT_AVG_STRING_LENGTH)),
+  m_pui64Offsets(nullptr),
+  m_iNumStrings(0),
+  m_iMaxNumStrings(iNumStrings),
+  m_pobjAllocator(pobjAllocator ? pobjAllocator : TeracadaAllocator::getDefault()),
+  m_bIsInitSuccess(false),
+  m_iErrno(0),
+  m_bEnableExceptions(true)
+{
+  TC_LOG(LOG_INFO, "TeracadaStringArray::TeracadaStringArray(): Initializing TeracadaStringArray [ NUM_STRINGS: %ld | NUM_CHARS: %lu ]", m_iMaxNumStrings, m_ui64MaxChars);
+
+  if ( m_iMaxNumStrings <= 0 || m_iMaxNumStrings >= (tc_index) (PTRDIFF_MAX / sizeof(tc_uint64)) || m_ui64MaxChars > PTRDIFF_MAX ) {
+    TC_LOG(LOG_ERR, "TeracadaStringArray::TeracadaStringArray(): Invalid size requested [ NUM_STRINGS: %ld | NUM_CHARS: %lu ]", m_iMaxNumStrings, m_ui64MaxChars);
+    goto ERREXIT;
+  }
+
+  m_pcChars = (tc_char*) getAllocator()->allocate(m_ui64MaxChars, false);
+  m_pui64Offsets = (tc_uint64*) getAllocator()->allocate(getOffsetsSize(m_iMaxNumStrings), false);
+
+  if ( ! m_pcChars || ! m_pui64Offsets ) {
+    TC_LOG(LOG_ERR, "TeracadaStringArray::TeracadaStringArray(): Failed to allocate the column buffers");
+    throwException(ERR_TA_MEMALLOC_FAILED);
+    goto ERREXIT;
+  }
+
+  m_pui64Offsets[0] = 0;
+  m_bIsInitSuccess = true;
+
+  TeracadaMetrics::recordAlloc(m_ui64MaxChars);
+  TeracadaMetrics::recordAlloc(getOffsetsSize(m_iMaxNumStrings));
+
+  EXIT:
+    return;
+
+  ERREXIT:
+    if ( m_pcChars )
+      getAllocator()->deallocate(m_pcChars, m_ui64MaxChars);
+
+    if ( m_pui64Offsets )
+      getAllocator()->deallocate(m_pui64Offsets, getOffsetsSize(m_iMaxNumStrings));
+
+    m_pcChars = nullptr;
+    m_pui64Offsets = nullptr;
+    m_ui64MaxChars = 0;
+    m_iMaxNumStrings = 0;
+
+    TC_LOG(LOG_ERR, "TeracadaStringArray::TeracadaStringArray(): Failed to initialize the column");
+    throwException(ERR_TA_INIT_FAILED);
+    return;
+}
+
+
+TeracadaStringArray::TeracadaStringArray ( TeracadaStringArray&& objOther ) noexcept {
+  moveFrom(objOther);
+}
+
+
+TeracadaStringArray& TeracadaStringArray::operator= ( TeracadaStringArray&& objOther ) noexcept {
+  if ( this != &objOther ) {
+    freeBuffers();
+    moveFrom(objOther);
+  }
+
+  return *this;
+}
+
+
+TeracadaStringArray::~TeracadaStringArray ( void ) {
+  freeBuffers();
+}
+
+
+tc_void TeracadaStringArray::freeBuffers ( void ) {
+  if ( m_pcChars ) {
+    getAllocator()->deallocate(m_pcChars, m_ui64MaxChars);
+    TeracadaMetrics::recordFree(m_ui64MaxChars);
+  }
+
+  if ( m_pui64Offsets ) {
+    getAllocator()->deallocate(m_pui64Offsets, getOffsetsSize(m_iMaxNumStrings));
+    TeracadaMetrics::recordFree(getOffsetsSize(m_iMaxNumStrings));
+  }
+
+  m_pcChars = nullptr;
+  m_ui64NumChars = 0;
+  m_ui64MaxChars = 0;
+  m_pui64Offsets = nullptr;
+  m_iNumStrings = 0;
+  m_iMaxNumStrings = 0;
+  m_bIsInitSuccess = false;
+}
+
+
+// Take over the buffers and state of the other column, the other column is left uninitialized without any buffer
+tc_void TeracadaStringArray::moveFrom ( TeracadaStringArray& objOther ) {
+  m_pcChars = objOther.m_pcChars;
+  m_ui64NumChars = objOther.m_ui64NumChars;
+  m_ui64MaxChars = objOther.m_ui64MaxChars;
+  m_pui64Offsets = objOther.m_pui64Offsets;
+  m_iNumStrings = objOther.m_iNumStrings;
+  m_iMaxNumStrings = objOther.m_iMaxNumStrings;
+  m_pobjAllocator = objOther.m_pobjAllocator;
+  m_bIsInitSuccess = objOther.m_bIsInitSuccess;
+  m_iErrno = objOther.m_iErrno;
+  m_bEnableExceptions = objOther.m_bEnableExceptions;
+
+  objOther.m_pcChars = nullptr;
+  objOther.m_ui64NumChars = 0;
+  objOther.m_ui64MaxChars = 0;
+  objOther.m_pui64Offsets = nullptr;
+  objOther.m_iNumStrings = 0;
+  objOther.m_iMaxNumStrings = 0;
+  objOther.m_bIsInitSuccess = false;
+}
+
+
+// Same position semantics as TeracadaArray::positionToIndex(), the index may be one past the last string
+tc_index TeracadaStringArray::positionToIndex ( tc_index iPosition ) {
+  tc_index iIndex = TA_NONE_INDEX;
+
+  // Position value 0 represents index after the last string
+  if ( iPosition == 0 ) {
+    iIndex = getNumElements();
+    goto EXIT;
+  }
+
+  if ( iPosition > 0 ) {
+    iIndex = iPosition - 1;
+    goto EXIT;
+  }
+
+  iIndex = std::max<tc_index>(getNumElements() - 1, 0) + (iPosition + 1);
+
+  if ( iIndex < 0 )
+    goto ERREXIT;
+
+  EXIT:
+    return iIndex;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaStringArray::positionToIndex(): Failed to convert the position value to a valid string index [ POSITION: %ld ]", iPosition);
+    throwException(ERR_TA_INVALID_POSITION_OR_INDEX);
+    return TA_NONE_INDEX;
+}
+
+
+tc_bool TeracadaStringArray::reallocChars ( tc_uint64 ui64NewMaxChars ) {
+  tc_char* pcNewChars = nullptr;
+  uintptr_t uiPreCharsAddr = (uintptr_t) m_pcChars;
+
+  TeracadaMetrics::recordReallocAttempt();
+
+  if ( ui64NewMaxChars == 0 || ui64NewMaxChars > PTRDIFF_MAX ) {
+    TC_LOG(LOG_ERR, "TeracadaStringArray::reallocChars(): Invalid number of characters requested [ NUM_CHARS: %lu ]", ui64NewMaxChars);
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
+  }
+
+  pcNewChars = (tc_char*) getAllocator()->reallocate(m_pcChars, m_ui64MaxChars, ui64NewMaxChars);
+
+  if ( ! pcNewChars ) {
+    TC_LOG(LOG_ERR, "TeracadaStringArray::reallocChars(): Failed to reallocate the character buffer [ SIZE: %lu ]", ui64NewMaxChars);
+    throwException(ERR_TA_MEMALLOC_FAILED);
+    goto ERREXIT;
+  }
+
+  EXIT:
+    TeracadaMetrics::recordRealloc(m_ui64MaxChars, ui64NewMaxChars, ((uintptr_t) pcNewChars != uiPreCharsAddr));
+
+    m_pcChars = pcNewChars;
+    m_ui64MaxChars = ui64NewMaxChars;
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+tc_bool TeracadaStringArray::reallocOffsets ( tc_index iNewMaxNumStrings ) {
+  tc_uint64* pui64NewOffsets = nullptr;
+  uintptr_t uiPreOffsetsAddr = (uintptr_t) m_pui64Offsets;
+
+  TeracadaMetrics::recordReallocAttempt();
+
+  if ( iNewMaxNumStrings <= 0 || iNewMaxNumStrings >= (tc_index) (PTRDIFF_MAX / sizeof(tc_uint64)) ) {
+    TC_LOG(LOG_ERR, "TeracadaStringArray::reallocOffsets(): Invalid number of strings requested [ NUM_STRINGS: %ld ]", iNewMaxNumStrings);
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
+  }
+
+  pui64NewOffsets = (tc_uint64*) getAllocator()->reallocate(m_pui64Offsets, getOffsetsSize(m_iMaxNumStrings), getOffsetsSize(iNewMaxNumStrings));
+
+  if ( ! pui64NewOffsets ) {
+    TC_LOG(LOG_ERR, "TeracadaStringArray::reallocOffsets(): Failed to reallocate the offsets buffer [ SIZE: %lu ]", getOffsetsSize(iNewMaxNumStrings));
+    throwException(ERR_TA_MEMALLOC_FAILED);
+    goto ERREXIT;
+  }
+
+  EXIT:
+    TeracadaMetrics::recordRealloc(getOffsetsSize(m_iMaxNumStrings), getOffsetsSize(iNewMaxNumStrings), ((uintptr_t) pui64NewOffsets != uiPreOffsetsAddr));
+
+    m_pui64Offsets = pui64NewOffsets;
+    m_iMaxNumStrings = iNewMaxNumStrings;
+    return true;
+
+  ERREXIT:
+    return false;
+}
+
+
+// Make room for iNumStrings more strings of ui64NumChars characters in total (null terminators included), both buffers grow 2x
+tc_bool TeracadaStringArray::growBeforeInsert ( tc_index iNumStrings, tc_uint64 ui64NumChars ) {
+  if ( (m_ui64MaxChars - m_ui64NumChars) < ui64NumChars ) {
+    if ( ! reallocChars(std::max<tc_uint64>((m_ui64MaxChars * 2), (m_ui64NumChars + ui64NumChars))) )
+      return false;
+  }
+
+  if ( (m_iMaxNumStrings - m_iNumStrings) < iNumStrings ) {
+    if ( ! reallocOffsets(std::max<tc_index>((m_iMaxNumStrings * 2), (m_iNumStrings + iNumStrings))) )
+      return false;
+  }
+
+  return true;
+}
+
+
+/*!
+  @brief
+    Insert a copy of a string
+
+  @details
+    Appending (position 0) is a single copy of the characters, inserting in between also moves the characters and offsets after it.
+
+  @param[in]
+    iPosition The position to insert the string at
+
+  @param[in]
+    svValue The string, its length is taken from the view (no strlen(), may contain null characters)
+
+  @retval
+    iPosition On success, the position (from start/left) of the inserted string
+
+  @retval
+    -1 On failure
+
+  @par Errors/Exceptions
+    - ERR_TA_INVALID_POSITION_OR_INDEX
+    - ERR_TA_MEMALLOC_FAILED
+    - ERR_TA_INSERTION_FAILURE
+*/
+tc_index TeracadaStringArray::insert ( tc_index iPosition, std::string_view svValue ) {
+  tc_index iIndex = TA_NONE_INDEX;
+  tc_uint64 ui64Length = svValue.size() + 1;
+  tc_uint64 ui64Offset = 0;
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  iIndex = positionToIndex(iPosition);
+
+  if ( iIndex < 0 || iIndex > getNumElements() ) {
+    throwException(ERR_TA_INVALID_POSITION_OR_INDEX);
+    goto ERREXIT;
+  }
+
+  // The value may point into the character buffer, which can move when it grows
+  if ( svValue.data() >= m_pcChars && svValue.data() < (m_pcChars + m_ui64MaxChars) ) {
+    std::string objCopy(svValue);
+    return insert(iPosition, std::string_view(objCopy));
+  }
+
+  if ( ! growBeforeInsert(1, ui64Length) )
+    goto ERREXIT;
+
+  ui64Offset = m_pui64Offsets[iIndex];
+
+  /* Move the characters and offsets of the strings after the inserted one */
+
+  if ( iIndex < getNumElements() ) {
+    memmove((m_pcChars + ui64Offset + ui64Length), (m_pcChars + ui64Offset), (m_ui64NumChars - ui64Offset));
+    memmove((m_pui64Offsets + iIndex + 2), (m_pui64Offsets + iIndex + 1), ((getNumElements() - iIndex) * sizeof(tc_uint64)));
+
+    for ( tc_index iIter = iIndex + 2; iIter <= (getNumElements() + 1); iIter++ )
+      m_pui64Offsets[iIter] += ui64Length;
+  }
+
+  memcpy((m_pcChars + ui64Offset), svValue.data(), svValue.size());
+  m_pcChars[ui64Offset + svValue.size()] = '\0';
+
+  m_pui64Offsets[iIndex + 1] = ui64Offset + ui64Length;
+  m_ui64NumChars += ui64Length;
+  m_iNumStrings++;
+
+  EXIT:
+    return iIndex + 1;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaStringArray::insert(): String insertion operation failure [ POSITION: %ld ]", iPosition);
+    throwException(ERR_TA_INSERTION_FAILURE);
+    return TA_NONE_INDEX;
+}
+
+
+/*!
+  @brief
+    Append all the strings of a delimited character buffer (one per line by default)
+
+  @details
+    - The buffer is copied with a single memcpy(), the delimiters become the null terminators in place.
+    - The buffer can't be part of the column character buffer itself.
+    - A trailing delimiter doesn't add an empty string at the end, empty strings in between are kept.
+
+  @param[in]
+    pcBuffer The character buffer
+
+  @param[in]
+    ui64NumChars Number of characters in the buffer
+
+  @param[in]
+    cDelimiter The character separating the strings
+
+  @retval
+    NumStrings On success, the number of appended strings
+
+  @retval
+    -1 On failure, the column is left unchanged
+
+  @par Examples
+    @code{.cpp}
+    objStrings.appendBulk(pcFileContents, ui64FileSize);
+    objStrings.appendBulk(pcCsvField, strlen(pcCsvField), ',');
+    @endcode
+*/
+tc_index TeracadaStringArray::appendBulk ( const tc_char* pcBuffer, tc_uint64 ui64NumChars, tc_char cDelimiter ) {
+  tc_index iNumStrings = 0;
+  tc_uint64 ui64Offset = m_ui64NumChars;
+  tc_bool bTrailingDelimiter = false;
+  const tc_char* pcDelimiter = nullptr;
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  if ( ! pcBuffer || ui64NumChars == 0 )
+    return 0;
+
+  // The character buffer can move when it grows
+  if ( pcBuffer >= m_pcChars && pcBuffer < (m_pcChars + m_ui64MaxChars) ) {
+    TC_LOG(LOG_ERR, "TeracadaStringArray::appendBulk(): The buffer can't be part of the column character buffer");
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
+  }
+
+  bTrailingDelimiter = (pcBuffer[ui64NumChars - 1] == cDelimiter);
+
+  // One string per delimiter, plus the last string when there is no trailing delimiter
+  for ( const tc_char* pcIter = pcBuffer; (pcIter = (const tc_char*) memchr(pcIter, cDelimiter, (pcBuffer + ui64NumChars - pcIter))); pcIter++ )
+    iNumStrings++;
+
+  if ( ! bTrailingDelimiter )
+    iNumStrings++;
+
+  if ( ! growBeforeInsert(iNumStrings, (ui64NumChars + (bTrailingDelimiter ? 0 : 1))) )
+    goto ERREXIT;
+
+  memcpy((m_pcChars + ui64Offset), pcBuffer, ui64NumChars);
+
+  if ( ! bTrailingDelimiter )
+    m_pcChars[ui64Offset + ui64NumChars] = cDelimiter;
+
+  for ( tc_index iIter = 1; iIter <= iNumStrings; iIter++ ) {
+    pcDelimiter = (const tc_char*) memchr((m_pcChars + ui64Offset), cDelimiter, (m_ui64MaxChars - ui64Offset));
+
+    ui64Offset = (pcDelimiter - m_pcChars);
+    m_pcChars[ui64Offset++] = '\0';
+    m_pui64Offsets[m_iNumStrings + iIter] = ui64Offset;
+  }
+
+  m_ui64NumChars = ui64Offset;
+  m_iNumStrings += iNumStrings;
+
+  EXIT:
+    return iNumStrings;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaStringArray::appendBulk(): Failed to append the strings of the buffer [ NUM_CHARS: %lu ]", ui64NumChars);
+    throwException(ERR_TA_INSERTION_FAILURE);
+    return TA_NONE_INDEX;
+}
+
+
+/*!
+  @brief
+    Append strings stored back to back in a character buffer, with their lengths
+
+  @param[in]
+    pcChars The characters of all the strings, without any separator
+
+  @param[in]
+    piLengths The length of every string
+
+  @param[in]
+    iNumStrings The number of strings
+
+  @retval
+    NumStrings On success, the number of appended strings
+
+  @retval
+    -1 On failure, the column is left unchanged
+*/
+tc_index TeracadaStringArray::appendBulk ( const tc_char* pcChars, const tc_index* piLengths, tc_index iNumStrings ) {
+  tc_uint64 ui64NumChars = 0;
+  tc_uint64 ui64Offset = m_ui64NumChars;
+
+  if ( ! isInitSuccess() || iNumStrings < 0 || (iNumStrings && (! pcChars || ! piLengths)) ) {
+    throwException(ERR_TA_INVALID_PARAM);
+    goto ERREXIT;
+  }
+
+  for ( tc_index iIter = 0; iIter < iNumStrings; iIter++ ) {
+    if ( piLengths[iIter] < 0 ) {
+      TC_LOG(LOG_ERR, "TeracadaStringArray::appendBulk(): Invalid string length [ INDEX: %ld | LENGTH: %ld ]", iIter, piLengths[iIter]);
+      throwException(ERR_TA_INVALID_PARAM);
+      goto ERREXIT;
+    }
+
+    ui64NumChars += piLengths[iIter] + 1;
+  }
+
+  if ( ! growBeforeInsert(iNumStrings, ui64NumChars) )
+    goto ERREXIT;
+
+  for ( tc_index iIter = 0; iIter < iNumStrings; iIter++ ) {
+    memcpy((m_pcChars + ui64Offset), pcChars, piLengths[iIter]);
+
+    pcChars += piLengths[iIter];
+    ui64Offset += piLengths[iIter];
+    m_pcChars[ui64Offset++] = '\0';
+    m_pui64Offsets[m_iNumStrings + iIter + 1] = ui64Offset;
+  }
+
+  m_ui64NumChars = ui64Offset;
+  m_iNumStrings += iNumStrings;
+
+  EXIT:
+    return iNumStrings;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaStringArray::appendBulk(): Failed to append the strings [ NUM_STRINGS: %ld ]", iNumStrings);
+    throwException(ERR_TA_INSERTION_FAILURE);
+    return TA_NONE_INDEX;
+}
+
+
+/*!
+  @brief
+    Remove consecutive strings, starting at a position
+
+  @param[in]
+    iPosition The position of the first string to remove, the default (0) is the last string
+
+  @param[in]
+    iNumElements The number of strings to remove
+
+  @retval
+    true Successfully removed the strings
+
+  @retval
+    false Failed to remove the strings, the column is left unchanged
+*/
+tc_bool TeracadaStringArray::remove ( tc_index iPosition, tc_index iNumElements ) {
+  tc_index iIndex = TA_NONE_INDEX;
+  tc_uint64 ui64Offset = 0;
+  tc_uint64 ui64NumChars = 0;
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  // Position value 0 removes the last string
+  iIndex = ( iPosition == 0 ) ? (getNumElements() - 1) : positionToIndex(iPosition);
+
+  if ( iIndex < 0 || iNumElements <= 0 || iNumElements > (getNumElements() - iIndex) ) {
+    TC_LOG(LOG_ERR, "TeracadaStringArray::remove(): Invalid strings to remove [ POSITION: %ld | NUM_ELEMENTS: %ld ]", iPosition, iNumElements);
+    throwException(ERR_TA_INVALID_POSITION_OR_INDEX);
+    goto ERREXIT;
+  }
+
+  ui64Offset = m_pui64Offsets[iIndex];
+  ui64NumChars = m_pui64Offsets[iIndex + iNumElements] - ui64Offset;
+
+  memmove((m_pcChars + ui64Offset), (m_pcChars + ui64Offset + ui64NumChars), (m_ui64NumChars - ui64Offset - ui64NumChars));
+
+  for ( tc_index iIter = iIndex + 1; iIter <= (getNumElements() - iNumElements); iIter++ )
+    m_pui64Offsets[iIter] = m_pui64Offsets[iIter + iNumElements] - ui64NumChars;
+
+  m_ui64NumChars -= ui64NumChars;
+  m_iNumStrings -= iNumElements;
+
+  EXIT:
+    return true;
+
+  ERREXIT:
+    TC_LOG(LOG_ERR, "TeracadaStringArray::remove(): String remove operation failure [ POSITION: %ld ]", iPosition);
+    throwException(ERR_TA_REMOVE_FAILURE);
+    return false;
+}
+
+
+/*!
+  @brief
+    Grow the column to hold at least the requested number of strings and characters, without any further reallocation
+
+  @param[in]
+    iNumStrings The total number of strings
+
+  @param[in]
+    ui64NumChars The total number of characters, null terminators included (0 keeps the current capacity)
+
+  @retval
+    true The column can hold the requested strings and characters
+
+  @retval
+    false Failed to grow the column buffers
+*/
+tc_bool TeracadaStringArray::reserve ( tc_index iNumStrings, tc_uint64 ui64NumChars ) {
+  if ( ! isInitSuccess() ) {
+    throwException(ERR_TA_NOT_INIT);
+    return false;
+  }
+
+  if ( iNumStrings > m_iMaxNumStrings && ! reallocOffsets(iNumStrings) )
+    return false;
+
+  if ( ui64NumChars > m_ui64MaxChars && ! reallocChars(ui64NumChars) )
+    return false;
+
+  return true;
+}
+
+
+// Shrink both buffers to the strings they hold
+tc_bool TeracadaStringArray::shrinkToFit ( void ) {
+  if ( ! isInitSuccess() ) {
+    throwException(ERR_TA_NOT_INIT);
+    return false;
+  }
+
+  if ( m_ui64MaxChars > std::max<tc_uint64>(m_ui64NumChars, 1) && ! reallocChars(std::max<tc_uint64>(m_ui64NumChars, 1)) )
+    return false;
+
+  if ( m_iMaxNumStrings > std::max<tc_index>(m_iNumStrings, 1) && ! reallocOffsets(std::max<tc_index>(m_iNumStrings, 1)) )
+    return false;
+
+  return true;
+}
+
+
+// Remove all the strings, the capacity is kept
+tc_bool TeracadaStringArray::reset ( void ) {
+  if ( ! isInitSuccess() ) {
+    throwException(ERR_TA_NOT_INIT);
+    return false;
+  }
+
+  m_ui64NumChars = 0;
+  m_iNumStrings = 0;
+
+  return true;
+}
+
+
+/*!
+  @brief
+    Get a view of the string at a position
+
+  @retval
+    View The view of the string (without the null terminator)
+
+  @retval
+    EmptyView On failure (check getErrno() with the exceptions disabled, an empty view is also a valid empty string)
+
+  @note
+    The view is invalidated by the next insert/remove/resize of the column.
+*/
+std::string_view TeracadaStringArray::get ( tc_index iPosition ) {
+  tc_index iIndex = TA_NONE_INDEX;
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  iIndex = positionToIndex(iPosition);
+
+  if ( iIndex < 0 || iIndex >= getNumElements() ) {
+    throwException(ERR_TA_INVALID_POSITION_OR_INDEX);
+    goto ERREXIT;
+  }
+
+  EXIT:
+    return (*this)[iIndex];
+
+  ERREXIT:
+    return std::string_view();
+}
+
+
+// Null terminated string at a position, nullptr on failure
+const tc_char* TeracadaStringArray::getCStr ( tc_index iPosition ) {
+  tc_index iIndex = TA_NONE_INDEX;
+
+  if ( ! isInitSuccess() )
+    goto ERREXIT;
+
+  iIndex = positionToIndex(iPosition);
+
+  if ( iIndex < 0 || iIndex >= getNumElements() ) {
+    throwException(ERR_TA_INVALID_POSITION_OR_INDEX);
+    goto ERREXIT;
+  }
+
+  EXIT:
+    return (m_pcChars + m_pui64Offsets[iIndex]);
+
+  ERREXIT:
+    return nullptr;
+}
+
+
+/*!
+  @brief
+    Find the first string equal to the value, starting at a position
+
+  @details
+    Linear scan of the offsets, the characters are only compared for the strings of the same length.
+
+  @retval
+    iPosition The position of the first equal string
+
+  @retval
+    -1 Not found (no error is raised)
+*/
+tc_index TeracadaStringArray::find ( std::string_view svValue, tc_index iFromPosition ) {
+  tc_index iIndex = TA_NONE_INDEX;
+  tc_uint64 ui64Length = svValue.size() + 1;
+
+  if ( ! isInitSuccess() || getNumElements() == 0 )
+    return TA_NONE_INDEX;
+
+  iIndex = positionToIndex(iFromPosition);
+
+  if ( iIndex < 0 )
+    return TA_NONE_INDEX;
+
+  for ( ; iIndex < getNumElements(); iIndex++ ) {
+    if ( (m_pui64Offsets[iIndex + 1] - m_pui64Offsets[iIndex]) == ui64Length &&
+         ! memcmp((m_pcChars + m_pui64Offsets[iIndex]), svValue.data(), svValue.size()) )
+      return iIndex + 1;
+  }
+
+  return TA_NONE_INDEX;
+}
+
+
+tc_void TeracadaStringArray::print ( void ) {
+  if ( ! isInitSuccess() )
+    return;
+
+  printf("strings([ ");
+
+  for ( tc_index iIndex = 0; iIndex < getNumElements(); iIndex++ ) {
+    std::string_view svValue = (*this)[iIndex];
+    printf("%.*s,\n", (tc_int32) svValue.size(), svValue.data());
+  }
+
+  printf("])\n");
+  fflush(stdout);
+}
+
+
+/*!
+  @brief
+    The class constructor of the string interning pool.
+
+  @param[in]
+    iNumStrings The number of distinct strings the pool can hold before its entries and hash table grow, the default is 1024
+
+  @param[in]
+    pobjAllocator The allocator of the blocks, entries and hash table (see teracada_allocator.h), it has to outlive the pool,
+    the process-wide heap allocator (TeracadaAllocator::getDefault()) is used when it is nullptr
+
+  @param[in]
+    ui64BlockSize The size of the blocks the strings are copied to, strings larger than a quarter of it get their own block
+
+  @par Examples
+    @code{.cpp}
+    TeracadaStringPool objPool;
+    tc_index iId = objPool.intern("category");
+
+    TeracadaArray<tc_str> objLabels(1000);
+    objLabels.insertBack((tc_str) objPool.internCStr("category"));
+    @endcode
+
+  @par Errors/Exceptions
+    - ERR_TA_MEMALLOC_FAILED
+    - ERR_TA_INIT_FAILED
+*/
+TeracadaStringPool::TeracadaStringPool ( tc_index iNumStrings, TeracadaAllocator* pobjAllocator, tc_uint64 ui64BlockSize ) :
+  m_pstBlock(nullptr),
+  m_ui64BlockSize(ui64BlockSize),
+  m_pstEntries(nullptr),
+  m_iNumStrings(0),
+  m_iMaxNumStrings(iNumStrings),
+  m_piSlots(nullptr),
+  m_ui64NumSlots(TS_POOL_MIN_NUM_SLOTS),
+  m_pobjAllocator(pobjAllocator ? pobjAllocator : TeracadaAllocator::getDefault()),
+  m_bIsInitSuccess(false),
+  m_ui64NumInterns(0),
+  m_ui64NumHits(0),
+  m_ui64StoredBytes(0),
+  m_ui64BytesSaved(0),
+  m_ui64BlockBytes(0),
+  m_iErrno(0),
+  m_bEnableExceptions(true)
+{
+  if ( m_iMaxNumStrings <= 0 || m_iMaxNumStrings > (tc_index) (PTRDIFF_MAX / (sizeof(stdPoolEntry) * 2)) || m_ui64BlockSize < 64 ) {
+    TC_LOG(LOG_ERR, "TeracadaStringPool::TeracadaStringPool(): Invalid size requested [ NUM_STRINGS: %ld | BLOCK_SIZE: %lu ]", m_iMaxNumStrings, m_ui64BlockSize);
+    goto ERREXIT;
+  }
+
+  // Enough slots to keep the table at most 3/4 full with all the strings
+  while ( ((m_ui64NumSlots * 3) / 4) < (tc_uint64) m_iMaxNumStrings )
+    m_ui64NumSlots *= 2;
+
+  m_pstEntries = (stdPoolEntry*) getAllocator()->allocate((m_iMaxNumStrings * sizeof(stdPoolEntry)), false);
+  m_piSlots = (tc_index*) getAllocator()->allocate((m_ui64NumSlots * sizeof(tc_index)), false);
+
+  if ( ! m_pstEntries || ! m_piSlots ) {
+    TC_LOG(LOG_ERR, "TeracadaStringPool::TeracadaStringPool(): Failed to allocate the pool buffers");
+    throwException(ERR_TA_MEMALLOC_FAILED);
+    goto ERREXIT;
+  }
+
+  std::fill(m_piSlots, (m_piSlots + m_ui64NumSlots), (tc_index) TA_NONE_INDEX);
+  m_bIsInitSuccess = true;
+
+  EXIT:
+    return;
+
+  ERREXIT:
+    if ( m_pstEntries )
+      getAllocator()->deallocate(m_pstEntries, (m_iMaxNumStrings * sizeof(stdPoolEntry)));
+
+    if ( m_piSlots )
+      getAllocator()->deallocate(m_piSlots, (m_ui64NumSlots * sizeof(tc_index)));
+
+    m_pstEntries = nullptr;
+    m_piSlots = nullptr;
+
+    TC_LOG(LOG_ERR, "TeracadaStringPool::TeracadaStringPool(): Failed to initialize the pool");
+    throwException(ERR_TA_INIT_FAILED);
+    return;
+}
+
+
+TeracadaStringPool::~TeracadaStringPool ( void ) {
+  stdPoolBlock* pstPrev = nullptr;
+
+  for ( stdPoolBlock* pstBlock = m_pstBlock; pstBlock; pstBlock = pstPrev ) {
+    pstPrev = pstBlock->pstPrev;
+    getAllocator()->deallocate(pstBlock, (sizeof(stdPoolBlock) + pstBlock->ui64Size));
+  }
+
+  if ( m_pstEntries )
+    getAllocator()->deallocate(m_pstEntries, (m_iMaxNumStrings * sizeof(stdPoolEntry)));
+
+  if ( m_piSlots )
+    getAllocator()->deallocate(m_piSlots, (m_ui64NumSlots * sizeof(tc_index)));
+}
+
+
+tc_uint64 TeracadaStringPool::hashString ( std::string_view svValue ) {
+  return std::hash<std::string_view>()(svValue);
+}
+
+
+// Id of the string, or TA_NONE_INDEX with the empty slot it would go to
+tc_index TeracadaStringPool::lookup ( std::string_view svValue, tc_uint64 ui64Hash, tc_uint64* pui64Slot ) const {
+  tc_uint64 ui64Mask = m_ui64NumSlots - 1;
+  tc_uint64 ui64Slot = ui64Hash & ui64Mask;
+  const stdPoolEntry* pstEntry = nullptr;
+
+  for ( ; m_piSlots[ui64Slot] != TA_NONE_INDEX; ui64Slot = ((ui64Slot + 1) & ui64Mask) ) {
+    pstEntry = &m_pstEntries[m_piSlots[ui64Slot]];
+
+    if ( pstEntry->ui64Hash == ui64Hash && pstEntry->ui64Length == svValue.size() &&
+         ! memcmp(pstEntry->pcString, svValue.data(), svValue.size()) )
+      return m_piSlots[ui64Slot];
+  }
+
+  if ( pui64Slot )
+    *pui64Slot = ui64Slot;
+
+  return TA_NONE_INDEX;
+}
+
+
+// Copy the string and its null terminator to the current block, large strings get their own block behind the current one
+const tc_char* TeracadaStringPool::copyString ( std::string_view svValue ) {
+  tc_uint64 ui64Bytes = svValue.size() + 1;
+  stdPoolBlock* pstBlock = m_pstBlock;
+  tc_char* pcString = nullptr;
+
+  if ( ! pstBlock || (pstBlock->ui64Size - pstBlock->ui64Used) < ui64Bytes ) {
+    tc_bool bOwnBlock = (ui64Bytes > (m_ui64BlockSize / 4));
+    tc_uint64 ui64BlockSize = bOwnBlock ? ui64Bytes : m_ui64BlockSize;
+
+    pstBlock = (stdPoolBlock*) getAllocator()->allocate((sizeof(stdPoolBlock) + ui64BlockSize), false);
+
+    if ( ! pstBlock )
+      return nullptr;
+
+    pstBlock->ui64Size = ui64BlockSize;
+    pstBlock->ui64Used = 0;
+    m_ui64BlockBytes += sizeof(stdPoolBlock) + ui64BlockSize;
+
+    if ( bOwnBlock && m_pstBlock ) {
+      pstBlock->pstPrev = m_pstBlock->pstPrev;
+      m_pstBlock->pstPrev = pstBlock;
+    } else {
+      pstBlock->pstPrev = m_pstBlock;
+      m_pstBlock = pstBlock;
+    }
+  }
+
+  pcString = (tc_char*) (pstBlock + 1) + pstBlock->ui64Used;
+  memcpy(pcString, svValue.data(), svValue.size());
+  pcString[svValue.size()] = '\0';
+  pstBlock->ui64Used += ui64Bytes;
+
+  return pcString;
+}
+
+
+tc_bool TeracadaStringPool::growEntries ( void ) {
+  tc_index iNewMaxNumStrings = m_iMaxNumStrings * 2;
+  stdPoolEntry* pstNewEntries = nullptr;
+
+  if ( iNewMaxNumStrings > (tc_index) (PTRDIFF_MAX / (sizeof(stdPoolEntry) * 2)) )
+    return false;
+
+  pstNewEntries = (stdPoolEntry*) getAllocator()->reallocate(m_pstEntries, (m_iMaxNumStrings * sizeof(stdPoolEntry)), (iNewMaxNumStrings * sizeof(stdPoolEntry)));
+
+  if ( ! pstNewEntries )
+    return false;
+
+  m_pstEntries = pstNewEntries;
+  m_iMaxNumStrings = iNewMaxNumStrings;
+
+  return true;
+}
+
+
+// Double the hash table and put all the ids back, from the hashes kept in the entries
+tc_bool TeracadaStringPool::growSlots ( void ) {
+  tc_uint64 ui64NewNumSlots = m_ui64NumSlots * 2;
+  tc_uint64 ui64Mask = ui64NewNumSlots - 1;
+  tc_uint64 ui64Slot = 0;
+  tc_index* piNewSlots = (tc_index*) getAllocator()->allocate((ui64NewNumSlots * sizeof(tc_index)), false);
+
+  if ( ! piNewSlots )
+    return false;
+
+  std::fill(piNewSlots, (piNewSlots + ui64NewNumSlots), (tc_index) TA_NONE_INDEX);
+
+  for ( tc_index iId = 0; iId < m_iNumStrings; iId++ ) {
+    for ( ui64Slot = (m_pstEntries[iId].ui64Hash & ui64Mask); piNewSlots[ui64Slot] != TA_NONE_INDEX; ui64Slot = ((ui64Slot + 1) & ui64Mask) );
+
+    piNewSlots[ui64Slot] = iId;
+  }
+
+  getAllocator()->deallocate(m_piSlots, (m_ui64NumSlots * sizeof(tc_index)));
+
+  m_piSlots = piNewSlots;
+  m_ui64NumSlots = ui64NewNumSlots;
+
+  return true;
+}
+
+
+/*!
+  @brief
+    Intern a string, adding a copy of it to the pool if it isn't there yet
+
+  @param[in]
+    svValue The string, its length is taken from the view (may contain null characters)
+
+  @retval
+    iId The id of the string, equal strings always get the same id
+
+  @retval
+    -1 On failure
+
+  @par Errors/Exceptions
+    - ERR_TA_NOT_INIT
+    - ERR_TA_MEMALLOC_FAILED
+*/
+tc_index TeracadaStringPool::intern ( std::string_view svValue ) {
+  tc_uint64 ui64Hash = hashString(svValue);
+  tc_uint64 ui64Slot = 0;
+  tc_index iId = TA_NONE_INDEX;
+  const tc_char* pcString = nullptr;
+
+  if ( ! isInitSuccess() ) {
+    throwException(ERR_TA_NOT_INIT);
+    goto ERREXIT;
+  }
+
+  m_ui64NumInterns++;
+
+  iId = lookup(svValue, ui64Hash, &ui64Slot);
+
+  if ( iId != TA_NONE_INDEX ) {
+    m_ui64NumHits++;
+    m_ui64BytesSaved += svValue.size() + 1;
+    goto EXIT;
+  }
+
+  /* New string */
+
+  if ( m_iNumStrings == m_iMaxNumStrings && ! growEntries() ) {
+    TC_LOG(LOG_ERR, "TeracadaStringPool::intern(): Failed to grow the pool entries [ NUM_STRINGS: %ld ]", m_iNumStrings);
+    throwException(ERR_TA_MEMALLOC_FAILED);
+    goto ERREXIT;
+  }
+
+  if ( ((tc_uint64) (m_iNumStrings + 1) * 4) > (m_ui64NumSlots * 3) ) {
+    if ( ! growSlots() ) {
+      TC_LOG(LOG_ERR, "TeracadaStringPool::intern(): Failed to grow the hash table [ NUM_SLOTS: %lu ]", m_ui64NumSlots);
+      throwException(ERR_TA_MEMALLOC_FAILED);
+      goto ERREXIT;
+    }
+
+    lookup(svValue, ui64Hash, &ui64Slot);
+  }
+
+  pcString = copyString(svValue);
+
+  if ( ! pcString ) {
+    TC_LOG(LOG_ERR, "TeracadaStringPool::intern(): Failed to allocate a block for the string [ LENGTH: %lu ]", svValue.size());
+    throwException(ERR_TA_MEMALLOC_FAILED);
+    goto ERREXIT;
+  }
+
+  iId = m_iNumStrings++;
+  m_pstEntries[iId] = { pcString, svValue.size(), ui64Hash };
+  m_piSlots[ui64Slot] = iId;
+  m_ui64StoredBytes += svValue.size() + 1;
+
+  EXIT:
+    return iId;
+
+  ERREXIT:
+    return TA_NONE_INDEX;
+}
+
+
+tc_index TeracadaStringPool::find ( std::string_view svValue ) const {
+  if ( ! isInitSuccess() )
+    return TA_NONE_INDEX;
+
+  return lookup(svValue, hashString(svValue), nullptr);
+}
+
+
+stdTeracadaStringPoolStats TeracadaStringPool::getStats ( void ) const {
+  stdTeracadaStringPoolStats stStats;
+
+  stStats.ui64NumInterns = m_ui64NumInterns;
+  stStats.ui64NumHits = m_ui64NumHits;
+  stStats.ui64NumStrings = m_iNumStrings;
+  stStats.ui64StoredBytes = m_ui64StoredBytes;
+  stStats.ui64BytesSaved = m_ui64BytesSaved;
+  stStats.ui64TotalBytes = m_ui64BlockBytes + (m_iMaxNumStrings * sizeof(stdPoolEntry)) + (m_ui64NumSlots * sizeof(tc_index));
+
+  return stStats;
+}
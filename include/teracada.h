@@ -3,8 +3,15 @@
 
 #include "teracada_common.h"
 #include "teracada_error.h"
+#include "teracada_metrics.h"
+#include "teracada_allocator.h"
+#include "teracada_stats.h"
 #include "teracada_array.h"
+#include "teracada_strings.h"
+#include "teracada_categorical.h"
 #include "teracada_dict.h"
+#include "teracada_concurrent_dict.h"
+#include "teracada_dict_snapshot.h"
 
 
 #endif
@@ -0,0 +1,208 @@
+#ifndef _TERACADA_ALLOCATOR_H
+#define _TERACADA_ALLOCATOR_H
+
+#include <atomic>
+
+#include "teracada_common.h"
+
+
+// Alignment of every buffer handed out by the bundled allocators
+#define TC_ALLOC_ALIGNMENT                 16
+
+// TeracadaArenaAllocator: Default size of the blocks the arena carves the buffers from
+#define TC_ARENA_BLOCK_SIZE                (1 << 20)
+
+// TeracadaPoolAllocator: Size classes are powers of two, from TC_POOL_MIN_CLASS_SIZE to TC_POOL_MAX_CLASS_SIZE bytes
+#define TC_POOL_MIN_CLASS_SIZE             16
+#define TC_POOL_MAX_CLASS_SIZE             (64 << 10)
+#define TC_POOL_NUM_SIZE_CLASSES           13
+#define TC_POOL_SLAB_SIZE                  (256 << 10)
+
+// TeracadaHugePageAllocator: Buffers are mapped in multiples of the huge page size
+#define TC_HUGE_PAGE_SIZE                  (2 << 20)
+
+/*
+  Snapshot of the allocator counters (TeracadaAllocator::getStats())
+*/
+struct stdTeracadaAllocatorStats {
+  // Number of allocate()/reallocate()/deallocate() calls
+  tc_uint64 ui64NumAllocs;
+  tc_uint64 ui64NumReallocs;
+  tc_uint64 ui64NumFrees;
+
+  // Number of malloc()/realloc()/mmap()/mremap() calls made to get memory from the system
+  tc_uint64 ui64NumSystemAllocs;
+
+  // Bytes currently held from the system (blocks, slabs, mappings, or heap buffers)
+  tc_uint64 ui64SystemBytes;
+};
+
+
+/*
+  Allocator interface of the TeracadaArray buffers, passed per instance to the TeracadaArray/TeracadaDict constructor.
+  - The allocator is not owned by the arrays, it has to outlive all the arrays using it.
+  - The sizes of the buffers are passed back by the callers on reallocate()/deallocate(), the allocators don't track them.
+  - Failures are returned as nullptr (like malloc()), the callers raise the errors.
+*/
+class TeracadaAllocator {
+  protected:
+    std::atomic<tc_uint64> m_aui64NumAllocs;
+    std::atomic<tc_uint64> m_aui64NumReallocs;
+    std::atomic<tc_uint64> m_aui64NumFrees;
+    std::atomic<tc_uint64> m_aui64NumSystemAllocs;
+    std::atomic<tc_uint64> m_aui64SystemBytes;
+
+    tc_void recordSystemAlloc ( tc_uint64 ui64Bytes ) {
+      m_aui64NumSystemAllocs.fetch_add(1, std::memory_order_relaxed);
+      m_aui64SystemBytes.fetch_add(ui64Bytes, std::memory_order_relaxed);
+    }
+
+    tc_void recordSystemFree ( tc_uint64 ui64Bytes ) {
+      m_aui64SystemBytes.fetch_sub(ui64Bytes, std::memory_order_relaxed);
+    }
+
+  public:
+    TeracadaAllocator ( void );
+    virtual ~TeracadaAllocator ( void ) {}
+
+    TeracadaAllocator ( const TeracadaAllocator& objOther ) = delete;
+    TeracadaAllocator& operator= ( const TeracadaAllocator& objOther ) = delete;
+
+    virtual tc_void* allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill = true ) = 0;
+
+    // Contents are kept up to the smaller of the two sizes, the old buffer is left untouched on failure
+    virtual tc_void* reallocate ( tc_void* pvBuffer, tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes ) = 0;
+
+    virtual tc_void deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) = 0;
+
+    // If the buffers can be handed to/taken from malloc()/free() (TeracadaArray::adopt()/release())
+    virtual tc_bool isMallocCompatible ( void ) const {
+      return false;
+    }
+
+    stdTeracadaAllocatorStats getStats ( void ) const;
+    tc_void resetStats ( void );
+
+    // Process-wide heap allocator, used by the arrays when no allocator is passed
+    static TeracadaAllocator* getDefault ( void );
+};
+
+
+/*
+  malloc()/calloc()/realloc()/free(), thread safe
+*/
+class TeracadaHeapAllocator : public TeracadaAllocator {
+  public:
+    tc_void* allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill = true ) override;
+    tc_void* reallocate ( tc_void* pvBuffer, tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes ) override;
+    tc_void deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) override;
+
+    tc_bool isMallocCompatible ( void ) const override {
+      return true;
+    }
+};
+
+
+/*
+  Bump allocator for short-lived batches, not thread safe
+  - Buffers are carved one after the other from large blocks, deallocate() only reclaims the last buffer.
+  - The last buffer is grown in place by reallocate() when its block has space left.
+  - Buffers larger than a quarter of the block size go straight to the heap, so that a growing array
+    doesn't leave a trail of copies behind in the blocks.
+  - All the memory is released at once by reset() or the destructor, the arrays using it must be gone by then.
+*/
+class TeracadaArenaAllocator : public TeracadaAllocator {
+  private:
+    struct stdArenaBlock {
+      stdArenaBlock* pstPrev;
+      tc_uint64      ui64Size;
+      tc_uint64      ui64Used;
+    };
+
+    stdArenaBlock*   m_pstBlock;
+    tc_uint64        m_ui64BlockSize;
+    tc_void*         m_pvLastBuffer;
+
+    tc_bool isHeapBuffer ( tc_uint64 ui64Bytes ) const {
+      return ui64Bytes > (m_ui64BlockSize / 4);
+    }
+
+    // Block header size, rounded up to keep the block data aligned
+    static constexpr tc_uint64 ui64BLOCK_HEADER_SIZE = ((sizeof(stdArenaBlock) + TC_ALLOC_ALIGNMENT - 1) / TC_ALLOC_ALIGNMENT) * TC_ALLOC_ALIGNMENT;
+
+    tc_byte* getBlockData ( stdArenaBlock* pstBlock ) const {
+      return (tc_byte*) pstBlock + ui64BLOCK_HEADER_SIZE;
+    }
+
+    tc_void* carve ( tc_uint64 ui64Bytes );
+
+    tc_bool addBlock ( tc_uint64 ui64MinBytes );
+
+  public:
+    TeracadaArenaAllocator ( tc_uint64 ui64BlockSize = TC_ARENA_BLOCK_SIZE );
+    ~TeracadaArenaAllocator ( void );
+
+    tc_void* allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill = true ) override;
+    tc_void* reallocate ( tc_void* pvBuffer, tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes ) override;
+    tc_void deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) override;
+
+    // Release all the buffers, the first block is kept for reuse
+    tc_void reset ( void );
+};
+
+
+/*
+  Size-class pool for many small arrays, not thread safe
+  - Buffers up to TC_POOL_MAX_CLASS_SIZE bytes are rounded up to a power of two size class,
+    carved from slabs and recycled through a free list per size class.
+  - Larger buffers go straight to the heap.
+  - Slabs are only released by the destructor, the arrays using it must be gone by then.
+*/
+class TeracadaPoolAllocator : public TeracadaAllocator {
+  private:
+    tc_void*         m_apvFreeLists[TC_POOL_NUM_SIZE_CLASSES];
+    tc_void*         m_pvSlabs;
+    tc_byte*         m_pb8SlabCursor;
+    tc_byte*         m_pb8SlabEnd;
+
+    static tc_int getSizeClass ( tc_uint64 ui64Bytes );
+
+    static tc_uint64 getSizeClassBytes ( tc_int iSizeClass ) {
+      return ((tc_uint64) TC_POOL_MIN_CLASS_SIZE << iSizeClass);
+    }
+
+    tc_void* allocateFromClass ( tc_int iSizeClass );
+
+  public:
+    TeracadaPoolAllocator ( void );
+    ~TeracadaPoolAllocator ( void );
+
+    tc_void* allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill = true ) override;
+    tc_void* reallocate ( tc_void* pvBuffer, tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes ) override;
+    tc_void deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) override;
+};
+
+
+/*
+  Huge page backed allocator for very large arrays, thread safe
+  - Every buffer is its own anonymous mapping, rounded up to TC_HUGE_PAGE_SIZE and advised with MADV_HUGEPAGE
+    (transparent huge pages, silently ignored when disabled on the host).
+  - Buffers are always zero filled (by the kernel, as pages are first touched) and grown/shrunk in place with mremap(),
+    or copied to a new aligned mapping when the pages after a buffer are taken.
+  - Small buffers still take a whole huge page, use it for the arrays expected to grow large.
+*/
+class TeracadaHugePageAllocator : public TeracadaAllocator {
+  private:
+    static tc_uint64 getMappingBytes ( tc_uint64 ui64Bytes ) {
+      return ((ui64Bytes + TC_HUGE_PAGE_SIZE - 1) / TC_HUGE_PAGE_SIZE) * TC_HUGE_PAGE_SIZE;
+    }
+
+    static tc_byte* mapAligned ( tc_uint64 ui64MappingBytes );
+
+  public:
+    tc_void* allocate ( tc_uint64 ui64Bytes, tc_bool bZeroFill = true ) override;
+    tc_void* reallocate ( tc_void* pvBuffer, tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes ) override;
+    tc_void deallocate ( tc_void* pvBuffer, tc_uint64 ui64Bytes ) override;
+};
+
+#endif
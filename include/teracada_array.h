@@ -2,9 +2,15 @@
 #define _TERACADA_ARRAY_H
 
 #include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
 
 #include "teracada_common.h"
 #include "teracada_error.h"
+#include "teracada_metrics.h"
+#include "teracada_allocator.h"
+#include "teracada_stats.h"
 
 #define TA_NONE_INDEX -1
 
@@ -13,10 +19,100 @@ enum {
   TA_RESIZE_ALGO_10PERCENT,
   TA_RESIZE_ALGO_STATIC10,
   TA_RESIZE_ALGO_STATIC100,
-  TA_RESIZE_ALGO_STATIC1000
+  TA_RESIZE_ALGO_STATIC1000,
+  TA_RESIZE_ALGO_GROWTH_1_5X,
+  TA_RESIZE_ALGO_GROWTH_2X,
+  TA_RESIZE_ALGO_GROWTH_CUSTOM
 };
 
-#define TA_REALLOC_ATTEMPTS_DUMP_FPATH     "/dev/shm/teracada_realloc_attempts"
+// Growth factor used by TA_RESIZE_ALGO_GROWTH_CUSTOM, until set otherwise
+#define TA_RESIZE_GROWTH_FACTOR_DEFAULT    1.5
+
+// No upper bound on the number of elements added by a single geometric resize
+#define TA_RESIZE_GROWTH_CAP_NONE          0
+
+/*
+  Storage modes of the array elements (see TeracadaArray::setStorageMode())
+  - TA_STORAGE_CONTIGUOUS: All the elements are in order at the start of the main array buffer (default)
+  - TA_STORAGE_GAP_BUFFER: Free space (gap) is kept at the last edit position, for cheap localized inserts/removes
+  - TA_STORAGE_ROPE: Elements are kept in a list of small chunks, for cheap scattered inserts/removes
+  - TA_STORAGE_DEQUE: Free space is kept on both sides of the elements, for O(1) amortized inserts/removes at both ends
+  - TA_STORAGE_RING: Bounded circular buffer of the array capacity, insertBack() overwrites the oldest element
+*/
+enum {
+  TA_STORAGE_CONTIGUOUS,
+  TA_STORAGE_GAP_BUFFER,
+  TA_STORAGE_ROPE,
+  TA_STORAGE_DEQUE,
+  TA_STORAGE_RING
+};
+
+// Minimum free space kept by TA_STORAGE_DEQUE when the elements are recentered, in addition to half the elements
+#define TA_DEQUE_MIN_FREE_NUM_ELEMENTS     8
+
+// Size of a single chunk buffer in bytes, for TA_STORAGE_ROPE
+#define TA_ROPE_CHUNK_SIZE                 4096
+
+// Minimum number of elements in a single chunk buffer, for TA_STORAGE_ROPE
+#define TA_ROPE_CHUNK_MIN_NUM_ELEMENTS     16
+
+struct stdTeracadaArrayRopeChunk {
+  tc_void*  pvElements;
+  tc_index  iNumElements;
+};
+
+// Circular list of element sequence numbers, for the TA_STORAGE_RING window min/max
+struct stdTeracadaArrayMonoDeque {
+  tc_uint64* pui64Seqs;
+  tc_index   iFront;
+  tc_index   iNumSeqs;
+};
+
+/*
+  Non-owning typed view over contiguous array elements (see TeracadaArray::view())
+  Valid until the next insert/remove/resize of the viewed array
+*/
+template <typename tDataType>
+class TeracadaArrayView {
+  private:
+    tDataType*  m_ptElements;
+    tc_index    m_iNumElements;
+
+  public:
+    TeracadaArrayView ( tDataType* ptElements = nullptr, tc_index iNumElements = 0 ) :
+      m_ptElements(ptElements),
+      m_iNumElements(iNumElements)
+    {}
+
+    tDataType* data ( void ) const {
+      return m_ptElements;
+    }
+
+    tc_index size ( void ) const {
+      return m_iNumElements;
+    }
+
+    tc_bool empty ( void ) const {
+      return (m_iNumElements == 0);
+    }
+
+    // 0-based index within the view, unchecked
+    tDataType& operator[] ( tc_index iIndex ) const {
+      return m_ptElements[iIndex];
+    }
+
+    tDataType* begin ( void ) const {
+      return m_ptElements;
+    }
+
+    tDataType* end ( void ) const {
+      return (m_ptElements + m_iNumElements);
+    }
+
+    TeracadaArrayView<tDataType> subview ( tc_index iOffset, tc_index iNumElements ) const {
+      return TeracadaArrayView<tDataType>((m_ptElements + iOffset), iNumElements);
+    }
+};
 
 template <typename tDataType>
 class TeracadaArray {
@@ -27,31 +123,74 @@ class TeracadaArray {
     // Main array pointers
     tc_void*          m_pvArray;
 
+    // Allocator of the main array buffer, not owned by the array (TeracadaAllocator::getDefault() if none is passed)
+    // The rope chunks and ring aggregates are small storage mode buffers, they stay on the heap
+    TeracadaAllocator* m_pobjAllocator;
+
     // If Teracada array has been successfully initialized
     tc_bool           m_bIsInitSuccess;
 
+    // If the unused capacity of the array is zero filled at construction/reset
+    // Otherwise it is left uninitialized, the skipped elements are zeroed only when an insert goes past them
+    tc_bool           m_bZeroFill;
+
     // Number of elements in the array (m_iArrayLastIndex + 1)
-    tc_int            m_iMaxNumArrayElements;
+    tc_index          m_iMaxNumArrayElements;
 
     // Actual last used index of array starting from 0
     // Maximum value of m_iArrayLastIndex = m_iMaxNumArrayElements - 1
     // For TERACADA_DTYPE_CHAR/m_pcArray it does not include the null character
     // Value should only be updated after successfull insert/remove operation
-    tc_int            m_iArrayLastIndex;
+    tc_index          m_iArrayLastIndex;
 
     // The resize/padding algorithm to use
     tc_byte           m_b8ResizeAlgo;
     tc_byte           m_b8ResizePaddingAlgo;
 
+    // Geometric resize algorithm parameters (TA_RESIZE_ALGO_GROWTH_*)
+    // m_iResizeGrowthCap limits the elements added per resize, TA_RESIZE_GROWTH_CAP_NONE for no limit
+    tc_double         m_dResizeGrowthFactor;
+    tc_index          m_iResizeGrowthCap;
+
     tc_bool           m_bOverwrite;
 
-    // Total number of reallocation attempts
-    tc_int            m_uliTotalReallocAttempts;
+    // Buffer metrics (reallocation attempts, bytes moved by realloc, peak buffer capacity)
+    // Only updated by the array itself on (re)allocation, can be read from any thread (getMetrics())
+    std::atomic<tc_uint64> m_aui64ReallocAttempts;
+    std::atomic<tc_uint64> m_aui64BytesMoved;
+    std::atomic<tc_uint64> m_aui64PeakCapacityBytes;
 
     // Value 0 represents no error
     tc_int            m_iErrno;
     tc_bool           m_bEnableExceptions;
 
+    // Storage mode of the array elements (TA_STORAGE_*)
+    tc_byte           m_b8StorageMode;
+
+    // TA_STORAGE_GAP_BUFFER: Elements [0, m_iGapIndex) are at the start of the main array buffer,
+    //   the remaining elements are at the end of the buffer, the gap (free space) is in between
+    tc_index          m_iGapIndex;
+
+    // TA_STORAGE_ROPE: List of chunks, nullptr while the elements are flattened in the main array buffer
+    // The cursor (last located chunk and index of its first element) makes sequential access O(1)
+    stdTeracadaArrayRopeChunk* m_pstRopeChunks;
+    tc_index          m_iNumRopeChunks;
+    tc_index          m_iMaxRopeChunks;
+    tc_index          m_iRopeCursorChunk;
+    tc_index          m_iRopeCursorIndex;
+
+    // TA_STORAGE_DEQUE/TA_STORAGE_RING: Index of the first element in the main array buffer
+    tc_index          m_iHeadIndex;
+
+    // TA_STORAGE_RING: Incremental window aggregates (arithmetic data types only)
+    // Every element pushed gets the next sequence number, the first element is (m_ui64RingPushSeq - getNumElements())
+    // The min/max deques hold the sequence numbers of the elements with increasing/decreasing values
+    tc_uint64         m_ui64RingPushSeq;
+    long double       m_ldRingWindowSum;
+    tc_index          m_iRingAggCapacity;
+    stdTeracadaArrayMonoDeque m_stRingMinDeque;
+    stdTeracadaArrayMonoDeque m_stRingMaxDeque;
+
 
   protected:
     tc_byte getElementSize ( void ) const {
@@ -70,36 +209,125 @@ class TeracadaArray {
       m_bIsInitSuccess = false;
     }
 
-    tc_int setMaxNumElements ( tc_int iMaxNumElements ) {
+    tc_index setMaxNumElements ( tc_index iMaxNumElements ) {
       return (m_iMaxNumArrayElements = iMaxNumElements);
     }
 
-    tc_void incrementTotalReallocAttempts ( void ) {
-      m_uliTotalReallocAttempts ++;
+    // Single writer (the array itself), so relaxed load + store is enough, no atomic read-modify-write
+    tc_void recordReallocAttempt ( void ) {
+      m_aui64ReallocAttempts.store(m_aui64ReallocAttempts.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      TeracadaMetrics::recordReallocAttempt();
+    }
+
+    tc_void recordRealloc ( tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes, tc_bool bMoved ) {
+      if ( bMoved )
+        m_aui64BytesMoved.store(m_aui64BytesMoved.load(std::memory_order_relaxed) + std::min(ui64PreBytes, ui64NewBytes), std::memory_order_relaxed);
+
+      if ( ui64NewBytes > m_aui64PeakCapacityBytes.load(std::memory_order_relaxed) )
+        m_aui64PeakCapacityBytes.store(ui64NewBytes, std::memory_order_relaxed);
+
+      TeracadaMetrics::recordRealloc(ui64PreBytes, ui64NewBytes, bMoved);
     }
 
     tc_bool setDataType ( void );
 
     tc_bool validateTypeSafety ( void );
 
-    tc_int positionToIndex ( tc_int iPosition );
+    tc_index positionToIndex ( tc_index iPosition );
+
+    tc_bool reallocArray ( tc_index iNewNumElements );
+
+    tc_index getGeometricResizeTarget ( tc_index iNumElements ) const;
+
+    tc_bool resize ( tc_index iNumElements = 0 );
+    tc_index resizeBeforeInsert ( tc_index iInsertIndex, tc_index uiNumElements );
+
+    tc_bool _remove ( tc_index iPosition, tc_index uiNumElements );
+
+    tc_void shiftElements ( tc_index iFromIndex, tc_index iToIndex, tc_index iNumElements );
+    tc_void zeroSkippedElements ( tc_index iInsertIndex );
+
+    tc_void freeBuffers ( void );
+    tc_void moveFrom ( TeracadaArray<tDataType>& objOther );
+    tc_void resetStorageState ( void );
+
+    // Space for the null terminator of TC_CHAR arrays, not part of the array elements
+    tc_byte getNullTermSize ( void ) const {
+      return std::is_same_v<tDataType, tc_char> ? 1 : 0;
+    }
+
+
+    /* Function declarations for (teracada_array_storage.cc) */
+
+    tc_bool storageInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength );
+    tc_bool storageRemove ( tc_index iIndex, tc_index iNumElements );
+    tc_void* storageGet ( tc_index iIndex );
+
+    tc_index getGapLength ( void ) const {
+      return getMaxNumElements() - getNullTermSize() - getNumElements();
+    }
+
+    tc_void moveGapTo ( tc_index iIndex );
+    tc_bool gapInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength );
+    tc_bool gapRemove ( tc_index iIndex, tc_index iNumElements );
+
+    tc_index getRopeChunkNumElements ( void ) const {
+      return std::max<tc_index>((TA_ROPE_CHUNK_SIZE / sizeof(tDataType)), TA_ROPE_CHUNK_MIN_NUM_ELEMENTS);
+    }
+
+    tc_bool ropeBuild ( void );
+    tc_bool ropeFlatten ( void );
+    tc_void ropeFree ( void );
+    tc_index ropeLocate ( tc_index iIndex, tc_index* piOffset );
+    stdTeracadaArrayRopeChunk* ropeInsertChunk ( tc_index iChunk );
+    tc_void ropeDeleteChunk ( tc_index iChunk );
+    tc_bool ropeInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength );
+    tc_bool ropeRemove ( tc_index iIndex, tc_index iNumElements );
+
+    tc_bool dequeRecenter ( tc_index iInsertIndex, tc_index iLength );
+    tc_bool dequeInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength );
+    tc_bool dequeRemove ( tc_index iIndex, tc_index iNumElements );
 
-    tc_bool resize ( tc_int iNumElements = 0 );
-    tc_int resizeBeforeInsert ( tc_int iInsertIndex, tc_int uiNumElements );
+    tDataType* ringElement ( tc_index iIndex ) const {
+      return (tDataType*) getArray() + ((m_iHeadIndex + iIndex) % getRingCapacity());
+    }
+
+    tDataType* ringSeqElement ( tc_uint64 ui64Seq ) const {
+      return ringElement(ui64Seq - (m_ui64RingPushSeq - getNumElements()));
+    }
 
-    tc_bool _remove ( tc_int iPosition, tc_int uiNumElements );
+    tc_bool ringInsert ( tc_index iIndex, tDataType* ptValue, tc_index iLength );
+    tc_bool ringRemove ( tc_index iIndex, tc_index iNumElements );
+    tc_void ringEvictFront ( tc_index iNumElements );
+    tc_void ringPushAggregates ( tc_uint64 ui64Seq );
+    tc_bool ringRebuildAggregates ( void );
+    tc_void ringFreeAggregates ( void );
 
 
   public:
 
-    TeracadaArray ( tc_int iNumElements = 100 );
+    TeracadaArray ( tc_index iNumElements = 100, tc_bool bZeroFill = true, TeracadaAllocator* pobjAllocator = nullptr );
+
+    // Moved-from arrays are left uninitialized (no buffer), use adopt() to reuse them
+    TeracadaArray ( TeracadaArray<tDataType>&& objOther ) noexcept;
+    TeracadaArray<tDataType>& operator= ( TeracadaArray<tDataType>&& objOther ) noexcept;
+
+    // No implicit copies, use clone()
+    TeracadaArray ( const TeracadaArray<tDataType>& objOther ) = delete;
+    TeracadaArray<tDataType>& operator= ( const TeracadaArray<tDataType>& objOther ) = delete;
 
     ~TeracadaArray();
 
+    TeracadaArray<tDataType> clone ( void );
+
+    tc_bool adopt ( tc_void* pvBuffer, tc_index iNumElements, tc_index iMaxNumElements );
+    tc_void* release ( tc_index* piNumElements = nullptr, tc_index* piMaxNumElements = nullptr );
+
     tc_byte getDataType ( void ) const {
       return m_b8DataType;
     }
 
+    // Elements are in order only if isContiguous(), call compact() first for the other storage modes
     tc_void* getArray ( void ) const {
       return m_pvArray;
     }
@@ -108,46 +336,59 @@ class TeracadaArray {
       return m_bIsInitSuccess;
     };
 
-    tc_int getLastElementIndex ( void ) const {
+    tc_bool isZeroFill ( void ) const {
+      return m_bZeroFill;
+    }
+
+    TeracadaAllocator* getAllocator ( void ) const {
+      return m_pobjAllocator;
+    }
+
+    tc_index getLastElementIndex ( void ) const {
       return m_iArrayLastIndex;
     }
 
-    tc_int getLastElementPos ( void ) const {
+    tc_index getLastElementPos ( void ) const {
       return m_iArrayLastIndex + 1;
     }
 
-    tc_int setLastElementIndex ( tc_int iLastIndex ) {
+    tc_index setLastElementIndex ( tc_index iLastIndex ) {
       return (m_iArrayLastIndex = iLastIndex);
     }
 
-    tc_int incrementLastElementIndexBy ( tc_int iNumElements = 1 ) {
+    tc_index incrementLastElementIndexBy ( tc_index iNumElements = 1 ) {
       return (m_iArrayLastIndex += iNumElements);
     }
 
-    tc_int decrementLastElementIndexBy ( tc_int iNumElements = 1 ) {
+    tc_index decrementLastElementIndexBy ( tc_index iNumElements = 1 ) {
       return (m_iArrayLastIndex -= iNumElements);
     }
 
-    tc_int getNumElements ( void ) const {
+    tc_index getNumElements ( void ) const {
       return m_iArrayLastIndex + 1;
     }
 
-    tc_void setNumElements ( tc_int iArrayElements ) {
+    tc_void setNumElements ( tc_index iArrayElements ) {
       if ( iArrayElements <= m_iMaxNumArrayElements ) {
         m_iArrayLastIndex = iArrayElements - 1;
       }
     }
 
-    tc_int getMaxNumElements ( void ) const {
+    tc_index getMaxNumElements ( void ) const {
       return m_iMaxNumArrayElements;
     }
 
-    tc_int getLastIndex ( void ) const {
+    tc_index getLastIndex ( void ) const {
       return m_iMaxNumArrayElements - 1;
     }
 
-    tc_int getArraySize ( void ) const {
-      return (m_iMaxNumArrayElements * sizeof(tDataType));
+    tc_uint64 getArraySize ( void ) const {
+      return ((tc_uint64) m_iMaxNumArrayElements * sizeof(tDataType));
+    }
+
+    // Largest number of elements whose size in bytes can be computed without overflow and passed to calloc/realloc
+    static constexpr tc_index getMaxAllocNumElements ( void ) {
+      return (tc_index) (PTRDIFF_MAX / sizeof(tDataType));
     }
 
     tc_byte getResizeAlgo ( void ) const {
@@ -166,6 +407,32 @@ class TeracadaArray {
       return (m_b8ResizePaddingAlgo = b8PaddingAlgo);
     }
 
+    tc_bool isGeometricResizeAlgo ( void ) const {
+      return ( m_b8ResizeAlgo == TA_RESIZE_ALGO_GROWTH_1_5X ||
+               m_b8ResizeAlgo == TA_RESIZE_ALGO_GROWTH_2X ||
+               m_b8ResizeAlgo == TA_RESIZE_ALGO_GROWTH_CUSTOM );
+    }
+
+    tc_double getResizeGrowthFactor ( void ) const {
+      return m_dResizeGrowthFactor;
+    }
+
+    // Growth factor for TA_RESIZE_ALGO_GROWTH_CUSTOM, values <= 1.0 are ignored
+    tc_double setResizeGrowthFactor ( tc_double dGrowthFactor ) {
+      if ( dGrowthFactor > 1.0 )
+        m_dResizeGrowthFactor = dGrowthFactor;
+
+      return m_dResizeGrowthFactor;
+    }
+
+    tc_index getResizeGrowthCap ( void ) const {
+      return m_iResizeGrowthCap;
+    }
+
+    tc_index setResizeGrowthCap ( tc_index iGrowthCap ) {
+      return (m_iResizeGrowthCap = std::max<tc_index>(iGrowthCap, TA_RESIZE_GROWTH_CAP_NONE));
+    }
+
     tc_void enableOverwrite ( void ) {
       m_bOverwrite = true;
     }
@@ -178,10 +445,24 @@ class TeracadaArray {
       return m_bOverwrite;
     }
 
-    tc_int getTotalReallocAttempts ( void ) const {
-      return m_uliTotalReallocAttempts;
+    tc_uint64 getTotalReallocAttempts ( void ) const {
+      return m_aui64ReallocAttempts.load(std::memory_order_relaxed);
     }
 
+    stdTeracadaArrayMetrics getMetrics ( void ) const {
+      stdTeracadaArrayMetrics stMetrics;
+
+      stMetrics.ui64ReallocAttempts = m_aui64ReallocAttempts.load(std::memory_order_relaxed);
+      stMetrics.ui64BytesMoved = m_aui64BytesMoved.load(std::memory_order_relaxed);
+      stMetrics.ui64CapacityBytes = (isInitSuccess() ? getArraySize() : 0);
+      stMetrics.ui64PeakCapacityBytes = m_aui64PeakCapacityBytes.load(std::memory_order_relaxed);
+
+      return stMetrics;
+    }
+
+    // Memory footprint of this array (object, main buffer, storage mode buffers, resident pages)
+    stdTeracadaArrayFootprint getFootprint ( void ) const;
+
     tc_int getErrno ( void ) const {
       return m_iErrno;
     }
@@ -204,156 +485,143 @@ class TeracadaArray {
       return m_bEnableExceptions;
     }
 
-    tc_int indexToPosition ( tc_int iIndex ) const {
+    tc_index indexToPosition ( tc_index iIndex ) const {
       return iIndex + 1;
     }
 
-    tc_int insert ( tc_int iPosition, tDataType tValue );
+    tc_index insert ( tc_index iPosition, tDataType tValue );
 
-    tc_int insertBack ( tDataType tValue ) {
+    tc_index insertBack ( tDataType tValue ) {
       return insert(0, tValue);
     }
 
-    tc_int insertFront ( tDataType tValue ) {
+    tc_index insertFront ( tDataType tValue ) {
       return insert(1, tValue);
     }
 
-    tc_bool insert ( tc_int iPosition, tDataType* ptValue, tc_int iLength = 0 );
+    tc_bool insert ( tc_index iPosition, tDataType* ptValue, tc_index iLength = 0 );
 
-    tc_bool insertBack ( tDataType* ptValue, tc_int iLength = 0 ) {
+    tc_bool insertBack ( tDataType* ptValue, tc_index iLength = 0 ) {
       return insert(0, ptValue, iLength);
     }
 
-    tc_bool insertFront ( tDataType* ptValue, tc_int iLength = 0 ) {
+    tc_bool insertFront ( tDataType* ptValue, tc_index iLength = 0 ) {
       return insert(1, ptValue, iLength);
     }
 
-    tc_bool remove ( tc_int iPosition = 0, tc_int uiNumElements = 1 );
+    tc_bool remove ( tc_index iPosition = 0, tc_index uiNumElements = 1 );
 
-    tc_bool reset ( void );
+    tc_bool reserve ( tc_index iNumElements );
 
-    tc_void* get ( tc_int iPosition = 1 );
+    tc_bool shrinkToFit ( void );
 
-    tc_void print ( void );
-
-    TeracadaArray<tc_char>* printToBuff ( TeracadaArray<tc_char>* ptcaBuff = nullptr );
-
-
-    /* Function declarations for teracada_error.cc */
-
-    tc_str getErrStr ( tc_int iErrno = 0 );
-    tc_void throwException ( tc_int iErrno = 0 );
+    tc_bool reset ( void );
 
+    tc_byte getStorageMode ( void ) const {
+      return m_b8StorageMode;
+    }
 
-    /* Function declarations for (teracada_stats.cc) */
+    tc_bool setStorageMode ( tc_byte b8StorageMode );
 
-    // tDataType _min ( TeracadaArray *tcaMinValPositions = nullptr );
+    tc_bool isContiguous ( void ) const {
+      switch ( m_b8StorageMode ) {
+        case TA_STORAGE_GAP_BUFFER:
+          return (m_iGapIndex == getNumElements());
 
-    // inline tc_decimal min ( TeracadaArray *tcaMinValPositions = nullptr ) {
-    //   switch ( getDataType() ) {
-    //     case TC_BYTE:
-    //       return _min<tc_byte>(tcaMinValPositions);
+        case TA_STORAGE_ROPE:
+          return (m_pstRopeChunks == nullptr);
 
-    //     case TC_INT:
-    //       return _min<tc_int>(tcaMinValPositions);
+        case TA_STORAGE_DEQUE:
+        case TA_STORAGE_RING:
+          return (m_iHeadIndex == 0);
 
-    //     case TC_DECIMAL:
-    //       return _min<tc_decimal>(tcaMinValPositions);
+        default:
+          return true;
+      }
+    }
 
-    //     default:
-    //       return 0;
-    //   }
-    // }
+    tc_bool compact ( void );
 
-    // tDataType _max ( TeracadaArray *tcaMinValPositions = nullptr );
+    // TA_STORAGE_RING: Maximum number of elements in the window, the main array buffer capacity
+    tc_index getRingCapacity ( void ) const {
+      return getMaxNumElements() - getNullTermSize();
+    }
 
-    // inline tc_decimal max ( TeracadaArray *tcaMaxValPositions = nullptr ) {
-    //   switch ( getDataType() ) {
-    //     case TC_BYTE:
-    //       return _max<tc_byte>(tcaMaxValPositions);
+    tc_decimal getWindowSum ( void ) const;
+    tc_decimal getWindowMean ( void ) const;
+    tDataType getWindowMin ( void ) const;
+    tDataType getWindowMax ( void ) const;
 
-    //     case TC_INT:
-    //       return _max<tc_int>(tcaMaxValPositions);
+    tc_void* get ( tc_index iPosition = 1 );
 
-    //     case TC_DECIMAL:
-    //       return _max<tc_decimal>(tcaMaxValPositions);
+    /*
+      Typed unchecked access, with a 0-based index (no position translation, init or bounds check)
+      The elements have to be contiguous (isContiguous()), call data() or compact() first for the other storage modes
+    */
+    tDataType& operator[] ( tc_index iIndex ) {
+      return ((tDataType*) m_pvArray)[iIndex];
+    }
 
-    //     default:
-    //       return 0;
-    //   }
-    // }
+    const tDataType& operator[] ( tc_index iIndex ) const {
+      return ((const tDataType*) m_pvArray)[iIndex];
+    }
 
-    // tc_decimal _mean ( void );
+    // Pointer to the first element, compacting the array first if required (nullptr on failure)
+    tDataType* data ( void ) {
+      return (isContiguous() || compact()) ? (tDataType*) m_pvArray : nullptr;
+    }
 
-    // inline tc_decimal mean ( void ) {
-    //   switch ( getDataType() ) {
-    //     case TC_BYTE:
-    //       return _mean<tc_byte>();
+    tDataType* begin ( void ) {
+      return data();
+    }
 
-    //     case TC_INT:
-    //       return _mean<tc_int>();
+    tDataType* end ( void ) {
+      return (data() ? (data() + getNumElements()) : nullptr);
+    }
 
-    //     case TC_DECIMAL:
-    //       return _mean<tc_decimal>();
+    TeracadaArrayView<tDataType> view ( tc_index iFirstPosition = 1, tc_index iLastPosition = -1 );
 
-    //     default:
-    //       return 0;
-    //   }
-    // }
+    tc_void print ( void );
 
-    // tc_decimal _variance ( tc_int iDeltaDOF = 0 );
+    TeracadaArray<tc_char>* printToBuff ( TeracadaArray<tc_char>* ptcaBuff = nullptr );
 
-    // inline tc_decimal variance ( tc_int iDeltaDOF = 0 ) {
-    //   switch ( getDataType() ) {
-    //     case TC_BYTE:
-    //       return _variance<tc_byte>(iDeltaDOF);
 
-    //     case TC_INT:
-    //       return _variance<tc_int>(iDeltaDOF);
+    /* Function declarations for teracada_error.cc */
 
-    //     case TC_DECIMAL:
-    //       return _variance<tc_decimal>(iDeltaDOF);
+    tc_str getErrStr ( tc_int iErrno = 0 );
+    tc_void throwException ( tc_int iErrno = 0 );
 
-    //     default:
-    //       return -1;
-    //   }
-    // }
 
-    // tc_decimal _standardDeviation ( tc_int iDeltaDOF = 0 );
+    /* Function declarations for (teracada_stats.cc), for the arithmetic data types */
 
-    // inline tc_decimal standardDeviation ( tc_int iDeltaDOF = 0 ) {
-    //   switch ( getDataType() ) {
-    //     case TC_BYTE:
-    //       return _standardDeviation<tc_byte>(iDeltaDOF);
+    // Min, max, sum and sum of squares of the elements in a single pass, false if the array is empty
+    tc_bool summarize ( stdTeracadaStatsSummary<tDataType>* pstSummary );
 
-    //     case TC_INT:
-    //       return _standardDeviation<tc_int>(iDeltaDOF);
+    // The positions of the elements equal to the min/max are inserted at the back of tcaMinValPositions/tcaMaxValPositions
+    tDataType min ( TeracadaArray<tc_int>* tcaMinValPositions = nullptr );
+    tDataType max ( TeracadaArray<tc_int>* tcaMaxValPositions = nullptr );
 
-    //     case TC_DECIMAL:
-    //       return _standardDeviation<tc_decimal>(iDeltaDOF);
+    // Position of the first min/max element (0 on error), the positions of all of them are inserted at the back of tcaPositions
+    tc_index argMin ( TeracadaArray<tc_int>* tcaPositions = nullptr );
+    tc_index argMax ( TeracadaArray<tc_int>* tcaPositions = nullptr );
 
-    //     default:
-    //       return -1;
-    //   }
-    // }
+    // Number of elements equal to tValue (-1 on error), their positions are inserted at the back of tcaPositions
+    tc_index argWhere ( tDataType tValue, TeracadaArray<tc_int>* tcaPositions = nullptr );
 
-    // tc_decimal _range ( void );
+    tc_decimal mean ( void );
 
-    // inline tc_decimal range ( void ) {
-    //   switch ( getDataType() ) {
-    //     case TC_BYTE:
-    //       return _range<tc_byte>();
+    // Variance and standard deviation with iDeltaDOF delta degrees of freedom, negative on error
+    tc_decimal variance ( tc_int iDeltaDOF = 0 );
+    tc_decimal standardDeviation ( tc_int iDeltaDOF = 0 );
 
-    //     case TC_INT:
-    //       return _range<tc_int>();
+    tc_decimal range ( void );
 
-    //     case TC_DECIMAL:
-    //       return _range<tc_decimal>();
+    // Add the elements to the moments (count, mean, M2, M3, M4, min, max), the moments are not reset first
+    tc_bool moments ( TeracadaStatsMoments<tDataType>* pobjMoments );
 
-    //     default:
-    //       return -1;
-    //   }
-    // }
+    // Population skewness and excess kurtosis of the elements, 0 on error
+    tc_decimal skewness ( void );
+    tc_decimal kurtosis ( void );
 
     tc_bool arrayInitRandomUniformDist ( tc_int iLow, tc_int iHigh, tc_int iSeed = 0 );
     tc_bool arrayInitRandomUniformDist ( tc_decimal dLow, tc_decimal dHigh, tc_int iSeed = 0 );
@@ -367,12 +635,44 @@ class TeracadaArray {
 
 typedef struct stdTeracadaDictNode* tc_dict;
 
+class TeracadaDictIndex;
+
+// TeracadaDict: Size of a node, nodes are laid out one per cache line
+#define TD_NODE_SIZE                       64
+
+// TeracadaDict: String values shorter than this are stored in the node itself (null terminator included)
+#define TD_NODE_INLINE_STRING_SIZE         32
+
+/*
+  TeracadaDict node, a single cache line (TD_NODE_SIZE bytes)
+  - Keys and values are stored inline as tagged unions (b8DataTypeKey/b8DataTypeVal): tc_int and tc_decimal keys and values,
+    the id of an interned string key, and string values shorter than TD_NODE_INLINE_STRING_SIZE.
+  - Longer string values are kept in the string column of the dict, at position unVal.iArrayPos.
+*/
 struct stdTeracadaDictNode {
+  TeracadaArray<tc_dict>* ptcaNext;
+  // Hash index of the children (ptcaNext), nullptr while there are few of them
+  TeracadaDictIndex* pobjIndex;
+
+  union {
+    tc_int     iInt;
+    tc_decimal dDecimal;
+    tc_index   iStringId;
+  } unKey;
+
   tc_byte   b8DataTypeKey;
-  tc_int    iArrayPosKey;
   tc_byte   b8DataTypeVal;
-  tc_int    iArrayPosVal;
-  TeracadaArray<tc_dict>* ptcaNext;
+  // String value in unVal.acString (otherwise in the string column)
+  tc_bool   bInlineVal;
+  // Shard of the TeracadaConcurrentDict the node belongs to (0 in a plain TeracadaDict), fits in the padding before unVal
+  tc_byte   b8Shard;
+
+  union {
+    tc_int     iInt;
+    tc_decimal dDecimal;
+    tc_index   iArrayPos;
+    tc_char    acString[TD_NODE_INLINE_STRING_SIZE];
+  } unVal;
 };
 
 template class TeracadaArray<tc_byte>;
@@ -395,25 +695,25 @@ typedef struct stdTeracadaArrayClass stdTeraArray;
 
 /* TeracadaArray C-API prefix: teraArray from now onwards (including pyapi) */
 
-EXTERN_C stdTeraArray* ta_arrayInit ( tc_int iDataType, tc_int iNumElements );
+EXTERN_C stdTeraArray* ta_arrayInit ( tc_int iDataType, tc_index iNumElements );
 EXTERN_C tc_void ta_arrayDelete ( stdTeraArray* pstiTerracadaArray );
 EXTERN_C tc_bool ta_isInitSuccess ( stdTeraArray* pstiTeracadaArray );
 
 EXTERN_C tc_byte ta_getDataType ( stdTeraArray* pstiTeracadaArray );
 EXTERN_C tc_void* ta_getArray ( stdTeraArray* pstiTeracadaArray );
-EXTERN_C tc_int ta_getNumElements ( stdTeraArray* pstiTeracadaArray );
+EXTERN_C tc_index ta_getNumElements ( stdTeraArray* pstiTeracadaArray );
 
-EXTERN_C tc_bool ta_insertByte ( stdTeraArray* pstiTeracadaArray, tc_int iPosition, const tc_byte bValue );
-EXTERN_C tc_bool ta_insertInt ( stdTeraArray* pstiTeracadaArray, tc_int iPosition, const tc_int iValue );
-EXTERN_C tc_bool ta_insertDecimal ( stdTeraArray* pstiTeracadaArray, tc_int iPosition, const tc_decimal dValue );
-EXTERN_C tc_bool ta_insertChar ( stdTeraArray* pstiTeracadaArray, tc_int iPosition, const tc_char cValue );
+EXTERN_C tc_bool ta_insertByte ( stdTeraArray* pstiTeracadaArray, tc_index iPosition, const tc_byte bValue );
+EXTERN_C tc_bool ta_insertInt ( stdTeraArray* pstiTeracadaArray, tc_index iPosition, const tc_int iValue );
+EXTERN_C tc_bool ta_insertDecimal ( stdTeraArray* pstiTeracadaArray, tc_index iPosition, const tc_decimal dValue );
+EXTERN_C tc_bool ta_insertChar ( stdTeraArray* pstiTeracadaArray, tc_index iPosition, const tc_char cValue );
 
 
 // EXTERN_C tc_bool ta_insertInts ( stdTeraArray* pstiTeracadaArray, const tc_int *piValue, tc_int iLength = 0, tc_int iPosition = 0, tc_bool bOverwrite = false );
 // EXTERN_C tc_bool ta_insertDecimals ( stdTeraArray* pstiTeracadaArray, const tc_decimal *pdValue, tc_int iLength = 0, tc_int iPosition = 0, tc_bool bOverwrite = false );
 // EXTERN_C tc_bool ta_insertString ( stdTeraArray* pstiTeracadaArray, const tc_char *pcValue, tc_int iLength = 0, tc_int iPosition = 0, tc_bool bOverwrite = false );
 
-EXTERN_C tc_void* ta_get ( stdTeraArray* pstiTeracadaArray, tc_int iPosition );
+EXTERN_C tc_void* ta_get ( stdTeraArray* pstiTeracadaArray, tc_index iPosition );
 
 EXTERN_C tc_int ta_getErrno ( stdTeraArray* pstiTeracadaArray );
 EXTERN_C tc_void ta_errnoReset ( stdTeraArray* pstiTeracadaArray );
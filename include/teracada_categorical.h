@@ -0,0 +1,130 @@
+#ifndef _TERACADA_CATEGORICAL_H
+#define _TERACADA_CATEGORICAL_H
+
+#include <string_view>
+
+#include "teracada_common.h"
+#include "teracada_allocator.h"
+#include "teracada_array.h"
+#include "teracada_strings.h"
+
+// Largest number of categories held with the 1 byte (tca_byte) codes, the codes are widened to tca_int past it
+#define TC_CATEGORICAL_MAX_BYTE_CATEGORIES 256
+
+/*
+  Dictionary encoded (categorical) string column
+  - The distinct values (categories) are interned once in a TeracadaStringPool, the pool id of a value is its code.
+  - The column itself is a code array sized to the number of categories: tca_byte up to
+    TC_CATEGORICAL_MAX_BYTE_CATEGORIES categories, widened once to tca_int when a value past it is inserted.
+  - Counting, group-by and equality filters run over the narrow integer codes, the strings are only compared once
+    to find the code of the filtered value.
+
+  Positions follow TeracadaArray: 1-based from the left, negative from the right, 0 after the last element.
+  Errors are raised by the code array and the pool (see getErrno()).
+*/
+class TeracadaCategoricalArray {
+  private:
+    // Distinct values, the id of a value in the pool is its code
+    TeracadaStringPool* m_pobjCategories;
+
+    // Code column, only one of them is allocated at a time
+    tca_byte*         m_ptcaByteCodes;
+    tca_int*          m_ptcaIntCodes;
+
+    TeracadaAllocator* m_pobjAllocator;
+
+    tc_bool           m_bEnableExceptions;
+
+
+  protected:
+    tc_bool widenCodes ( void );
+
+    template <typename tDataType>
+    tc_index countCode ( TeracadaArray<tDataType>* ptcaCodes, tc_index iCode ) const;
+
+    template <typename tDataType>
+    tc_index filterCode ( TeracadaArray<tDataType>* ptcaCodes, tc_index iCode, tca_int* ptcaPositions ) const;
+
+    template <typename tDataType>
+    tc_void countCodes ( TeracadaArray<tDataType>* ptcaCodes, tc_int* piCounts ) const;
+
+
+  public:
+    TeracadaCategoricalArray ( tc_index iNumElements = 100, TeracadaAllocator* pobjAllocator = nullptr );
+    ~TeracadaCategoricalArray ( void );
+
+    TeracadaCategoricalArray ( const TeracadaCategoricalArray& objOther ) = delete;
+    TeracadaCategoricalArray& operator= ( const TeracadaCategoricalArray& objOther ) = delete;
+
+    tc_bool isInitSuccess ( void ) const {
+      return ( m_pobjCategories && m_pobjCategories->isInitSuccess() &&
+               ((m_ptcaByteCodes && m_ptcaByteCodes->isInitSuccess()) || (m_ptcaIntCodes && m_ptcaIntCodes->isInitSuccess())) );
+    }
+
+    tc_index getNumElements ( void ) const {
+      return m_ptcaIntCodes ? m_ptcaIntCodes->getNumElements() : (m_ptcaByteCodes ? m_ptcaByteCodes->getNumElements() : 0);
+    }
+
+    tc_index getNumCategories ( void ) const {
+      return m_pobjCategories ? m_pobjCategories->getNumElements() : 0;
+    }
+
+    // Size in bytes of a single code, 1 until the codes are widened
+    tc_byte getCodeSize ( void ) const {
+      return m_ptcaIntCodes ? sizeof(tc_int) : sizeof(tc_byte);
+    }
+
+    // The code arrays, only one of them is not nullptr
+    tca_byte* getByteCodes ( void ) const {
+      return m_ptcaIntCodes ? nullptr : m_ptcaByteCodes;
+    }
+
+    tca_int* getIntCodes ( void ) const {
+      return m_ptcaIntCodes;
+    }
+
+    const TeracadaStringPool* getCategories ( void ) const {
+      return m_pobjCategories;
+    }
+
+    std::string_view getCategory ( tc_index iCode ) const {
+      return m_pobjCategories->get(iCode);
+    }
+
+    // Code of a value, TA_NONE_INDEX if the value is not a category of the column
+    tc_index getCode ( std::string_view svValue ) const {
+      return m_pobjCategories->find(svValue);
+    }
+
+    // Bytes of the code column and the categories
+    tc_uint64 getArraySize ( void ) const;
+
+    tc_int getErrno ( void ) const;
+
+    tc_void enableExceptions ( void );
+    tc_void disableExceptions ( void );
+
+    tc_index insert ( tc_index iPosition, std::string_view svValue );
+
+    tc_index insertBack ( std::string_view svValue ) {
+      return insert(0, svValue);
+    }
+
+    tc_index appendStrings ( TeracadaArray<tc_str>& objStrings );
+    tc_index appendStrings ( TeracadaStringArray& objStrings );
+
+    tc_bool remove ( tc_index iPosition = 0, tc_index iNumElements = 1 );
+
+    std::string_view get ( tc_index iPosition = 1 );
+    tc_index getCodeAt ( tc_index iPosition = 1 );
+
+    tc_index countEqual ( std::string_view svValue );
+    tc_index filterEqual ( std::string_view svValue, tca_int* ptcaPositions );
+    tc_bool groupCount ( tca_int* ptcaCounts );
+
+    tc_void print ( void );
+};
+
+typedef TeracadaCategoricalArray tca_categorical;
+
+#endif
@@ -2,17 +2,18 @@
 #define _TERACADA_COMMON_H
 
 #include <cstdint>
+#include <atomic>
 
 #include "logman.h"
 
 
-#define TC_LOG(level, fmt, ...) LOGMAN("Teracada", level, fmt, ##__VA_ARGS__)
-
 #define EXTERN_C extern "C"
 
 typedef uint8_t  tc_byte;
 typedef int32_t  tc_int32;
 typedef int64_t  tc_int64;
+typedef uint32_t tc_uint32;
+typedef uint64_t tc_uint64;
 typedef float    tc_float;
 typedef double   tc_double;
 typedef char     tc_char;
@@ -42,6 +43,39 @@ typedef void     tc_void;
   typedef tc_float tc_decimal;
 #endif 
 
+// Array sizes, indices and positions are 64-bit in every build, independent of the tc_int element data type
+typedef tc_int64 tc_index;
+
+/*
+  Logging:
+  - _TERACADA_LOG_LEVEL is the compile-time minimum log level (syslog severity, set by the CMake option TERACADA_LOG_LEVEL).
+    TC_LOG calls with a less severe level compile to nothing, including the formatting of their arguments.
+  - The compiled-in levels are additionally checked against the runtime log level (tc_setLogLevel()),
+    which only costs a relaxed atomic load when the level is disabled.
+*/
+#ifndef _TERACADA_LOG_LEVEL
+  #define _TERACADA_LOG_LEVEL LOG_DEBUG
+#endif
+
+// Runtime log level, defined once in the library (initialized to the library's compile-time level)
+extern std::atomic<tc_int> aiTERACADA_LOG_LEVEL;
+
+inline tc_int tc_getLogLevel ( void ) {
+  return aiTERACADA_LOG_LEVEL.load(std::memory_order_relaxed);
+}
+
+inline tc_void tc_setLogLevel ( tc_int iLogLevel ) {
+  aiTERACADA_LOG_LEVEL.store(iLogLevel, std::memory_order_relaxed);
+}
+
+#define TC_LOG(level, fmt, ...) \
+  do { \
+    if constexpr ( (level) <= _TERACADA_LOG_LEVEL ) { \
+      if ( (level) <= tc_getLogLevel() ) \
+        LOGMAN("Teracada", level, fmt, ##__VA_ARGS__); \
+    } \
+  } while ( 0 )
+
 enum {
   TC_NONE,
   TC_BYTE,
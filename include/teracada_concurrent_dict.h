@@ -0,0 +1,89 @@
+#ifndef _TERACADA_CONCURRENT_DICT_H
+#define _TERACADA_CONCURRENT_DICT_H
+
+#include <string>
+#include <shared_mutex>
+
+#include "teracada_common.h"
+#include "teracada_allocator.h"
+#include "teracada_dict.h"
+
+// Default number of shards, a power of two (the number of shards is rounded up to one)
+#define TD_CONCURRENT_DEFAULT_NUM_SHARDS   64
+
+// Shards are numbered in the b8Shard byte of the nodes
+#define TD_CONCURRENT_MAX_NUM_SHARDS       256
+
+/*
+  Thread safe TeracadaDict, sharded by the top level key with a reader/writer lock per shard (lock striping)
+  - A top level key is hashed to its shard, a TeracadaDict of its own with its own slabs, key pool and string column,
+    so writers to different shards never contend, and readers of a shard only share its lock.
+  - The nested levels stay in the shard of their top level node, every node carries its shard (b8Shard),
+    so the calls with a parent node lock the shard of the parent.
+  - Reads copy the value out under the shared lock (get()): the value pointers of a TeracadaDict are invalidated
+    by the updates and the string column compactions of other threads.
+  - Nodes returned by update()/find() stay valid as parents until they are erased, erasing a node while
+    other threads use it as a parent is not supported (as with a TeracadaDict).
+
+  The allocator is shared by all the shards, it has to be thread safe (the default heap allocator is).
+*/
+class TeracadaConcurrentDict {
+  private:
+    // A shard per cache line, the locks of neighbouring shards don't share a line
+    struct alignas(64) stdDictShard {
+      std::shared_mutex mtxLock;
+      TeracadaDict*     ptdDict;
+    };
+
+    stdDictShard*     m_pstShards;
+    tc_uint32         m_ui32NumShards;
+
+    // Allocator of all the shard dicts, not owned by the dict
+    TeracadaAllocator* m_pobjAllocator;
+
+    template <typename tDataType>
+    stdDictShard& getKeyShard ( tDataType tKey );
+
+    stdDictShard& getNodeShard ( tc_dict ptcdNode ) {
+      return m_pstShards[ptcdNode->b8Shard];
+    }
+
+  public:
+    TeracadaConcurrentDict ( tc_uint32 ui32NumShards = TD_CONCURRENT_DEFAULT_NUM_SHARDS, TeracadaAllocator* pobjAllocator = nullptr );
+    ~TeracadaConcurrentDict ( void );
+
+    TeracadaConcurrentDict ( const TeracadaConcurrentDict& objOther ) = delete;
+    TeracadaConcurrentDict& operator= ( const TeracadaConcurrentDict& objOther ) = delete;
+
+    tc_bool isInitSuccess ( void ) const {
+      return m_pstShards != nullptr;
+    }
+
+    tc_uint32 getNumShards ( void ) const {
+      return m_ui32NumShards;
+    }
+
+    // Insert the key, or replace the value of the node that has it already (upsert)
+    template <typename tDataTypeKey, typename tDataTypeVal>
+    tc_dict update ( tDataTypeKey tKey, tDataTypeVal tValue );
+
+    template <typename tDataTypeKey, typename tDataTypeVal>
+    tc_dict update ( tc_dict ptcdParentNode, tDataTypeKey tKey, tDataTypeVal tValue );
+
+    /*
+      Copy of the value of the key to ptValue (tc_int, tc_decimal or std::string for the string values),
+      false if there is no such key or its value is of another data type
+    */
+    template <typename tDataTypeKey, typename tDataTypeVal>
+    tc_bool get ( tDataTypeKey tKey, tDataTypeVal* ptValue, tc_dict ptcdParentNode = nullptr );
+
+    // Node with the key, to be used as a parent node, nullptr if there is none
+    template <typename tDataType>
+    tc_dict find ( tDataType tKey, tc_dict ptcdParentNode = nullptr );
+
+    // Remove the node with the key and all its descendants, false if there is no such node
+    template <typename tDataType>
+    tc_bool erase ( tDataType tKey, tc_dict ptcdParentNode = nullptr );
+};
+
+#endif
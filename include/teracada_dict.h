@@ -3,17 +3,105 @@
 
 #include <teracada_common.h>
 #include <teracada_array.h>
+#include <teracada_strings.h>
+#include <teracada_dict_index.h>
+
+// Minimum number of dead string column slots before the column is compacted automatically
+#define TD_COMPACT_MIN_DEAD_SLOTS          1024
+
+// Nodes are carved from slabs, the first slab holds TD_NODE_SLAB_MIN_NUM_NODES nodes and the next ones double up to the max
+#define TD_NODE_SLAB_MIN_NUM_NODES         16
+#define TD_NODE_SLAB_MAX_NUM_NODES         1024
 
 
 class TeracadaDict {
   private:
+    struct stdNodeSlab {
+      stdNodeSlab*   pstPrev;
+      tc_uint64      ui64NumNodes;
+      tc_uint64      ui64Size;
+    };
+
     tca_dict*    m_ptcaDictRoot;
-    tca_int*     m_ptcaInt;
-    tca_decimal* m_ptcaDecimal;
-    tca_str*     m_ptcaString;
+    // String values too long to be inlined in their node are copied into the string column, a single character buffer
+    tca_strings* m_ptcaString;
+
+    // Node slabs, m_pstNodeSlab is the one being filled, the erased nodes are chained (through ptcaNext) for reuse
+    stdNodeSlab* m_pstNodeSlab;
+    tc_uint64    m_ui64NumSlabNodesUsed;
+    tc_dict      m_ptcdFreeNodes;
+
+    // String keys are interned, a node holds the id of its key in the pool, so keys compare as integers
+    TeracadaStringPool* m_pobjKeyPool;
+    // Nodes with a string key, and the ones released since the key pool was last rebuilt (their ids may be dead)
+    tc_index     m_iNumStringKeys;
+    tc_index     m_iNumDeadKeys;
+
+    // Allocator of the node slabs, the child node arrays and all the array/string column buffers, not owned by the dict
+    TeracadaAllocator* m_pobjAllocator;
+
+    // Hash index of the root nodes, the index of every other level is held by its parent node
+    TeracadaDictIndex* m_pobjRootIndex;
+    tc_bool      m_bEnableIndex;
+    // The indexes also keep their keys in a B+tree, for the range queries
+    tc_bool      m_bEnableOrderedIndex;
+
+    // Slots of the string column no node refers to anymore (updated or erased values)
+    tc_index     m_iNumDeadStrings;
+    tc_bool      m_bEnableAutoCompact;
+
+    // Stamped on every node of the dict (b8Shard), the shard of the TeracadaConcurrentDict holding it
+    tc_byte      m_b8Shard;
+
+    // Nodes are 64 byte aligned in the slabs
+    static tc_dict getSlabNodes ( stdNodeSlab* pstSlab ) {
+      return (tc_dict) ((((tc_uint64) (pstSlab + 1)) + TD_NODE_SIZE - 1) & ~((tc_uint64) TD_NODE_SIZE - 1));
+    }
+
+    tc_dict newNode ( void );
+    tc_void freeNode ( tc_dict ptcdNode );
+    tc_void freeSlabs ( void );
+
+    tca_dict* newChildArray ( void );
+    tc_void deleteChildArray ( tca_dict* ptcaChildren );
+    tc_void freeNodes ( tca_dict* ptcaNodes );
+
+    tc_bool getNodeKeyWord ( tc_dict ptcdNode, tc_uint64* pui64Key );
+
+    TeracadaDictIndex* buildIndex ( tca_dict* ptcaNodes );
+    tc_void deleteIndex ( TeracadaDictIndex** ppobjIndex );
+    tc_void indexNode ( tca_dict* ptcaNodes, TeracadaDictIndex** ppobjIndex, tc_dict ptcdNode );
+    tc_void rebuildIndexes ( tca_dict* ptcaNodes, TeracadaDictIndex** ppobjIndex );
+
+    tc_bool getLevel ( tc_dict ptcdParentNode, tc_bool bCreate, tca_dict** pptcaNodes, TeracadaDictIndex*** pppobjIndex );
+
+    template <typename tDataType>
+    tc_bool getKeyWord ( tDataType tKey, tc_byte* pb8DataType, tc_uint64* pui64Key );
+
+    template <typename tDataType>
+    tc_dict findNode ( tca_dict* ptcaNodes, TeracadaDictIndex* pobjIndex, tDataType tKey, tc_index* piNodeIndex = nullptr );
+
+    template <typename tDataType>
+    tc_bool storeNodeValue ( tc_dict ptcdNode, tDataType tValue );
+
+    template <typename tDataType>
+    tc_bool setNodeValue ( tc_dict ptcdNode, tDataType tValue );
+
+    template <typename tDataTypeKey, typename tDataTypeVal>
+    tc_dict upsert ( tc_dict ptcdParentNode, tDataTypeKey tKey, tDataTypeVal tValue );
+
+    tc_bool sortNodes ( tca_dict* ptcaNodes, tc_index iFirstIndex = 0 );
+
+    tc_void releaseNode ( tc_dict ptcdNode );
+
+    tc_void moveLiveStrings ( tca_dict* ptcaNodes, tca_strings* ptcaString );
+    tc_bool compactStrings ( void );
+    tc_bool remapKeys ( tca_dict* ptcaNodes, TeracadaStringPool* pobjKeyPool, tc_index* piNewIds, tc_bool bAssign );
+    tc_bool compactKeys ( void );
+    tc_void compactIfSparse ( void );
 
   public:
-    TeracadaDict( void );
+    TeracadaDict( TeracadaAllocator* pobjAllocator = nullptr, tc_byte b8Shard = 0 );
     ~TeracadaDict( void );
 
     template <typename tDataTypeKey, typename tDataTypeVal>
@@ -22,18 +110,96 @@ class TeracadaDict {
     template <typename tDataType>
     tc_dict insertNode ( tc_dict pParentNode, tDataType tValue );
 
+    // Insert the key, or replace the value of the node that has it already (upsert)
     template <typename tDataTypeKey, typename tDataTypeVal>
     tc_dict update ( tDataTypeKey tKey, tDataTypeVal tValue );
 
     template <typename tDataTypeKey, typename tDataTypeVal>
     tc_dict update ( tc_dict ptcdParentNode, tDataTypeKey tKey, tDataTypeVal tValue );
 
+    // Remove the node with the key and all its descendants, false if there is no such node
+    template <typename tDataType>
+    tc_bool erase ( tDataType tKey, tc_dict ptcdParentNode = nullptr );
+
     tc_void* getNodeKey ( tc_dict ptcdNode );
 
+    // Pool of the string keys, for its stats (hit rate, bytes saved)
+    const TeracadaStringPool* getKeyPool ( void ) const {
+      return m_pobjKeyPool;
+    }
+
     tc_void* getNodeValue ( tc_dict ptcdNode );
 
+    /*
+      The levels with more than TD_INDEX_MIN_NUM_NODES nodes are looked up through a hash index (enabled by default),
+      disabling it drops all the indexes and get() scans the levels
+    */
+    tc_void enableIndex ( void );
+    tc_void disableIndex ( void );
+
+    tc_bool isIndexEnabled ( void ) const {
+      return m_bEnableIndex;
+    }
+
+    /*
+      Sorted mode: the indexes of the levels also keep the keys in a B+tree (disabled by default, it slows down the inserts),
+      lowerBound(), range() and prefix() walk the tree instead of scanning and sorting the level.
+      Keys sort by data type first (tc_int < tc_decimal < tc_str), then by value (strings byte by byte).
+    */
+    tc_void enableOrderedIndex ( void );
+    tc_void disableOrderedIndex ( void );
+
+    tc_bool isOrderedIndexEnabled ( void ) const {
+      return m_bEnableOrderedIndex;
+    }
+
+    // Node with the smallest key not less than tKey (of the same data type) in the level, nullptr if there is none
+    template <typename tDataType>
+    tc_dict lowerBound ( tDataType tKey, tc_dict ptcdParentNode = nullptr );
+
+    // Nodes of the level with tLow <= key < tHigh in key order, put in ptcaNodes (reset first), their number (TA_NONE_INDEX on failure)
+    template <typename tDataType>
+    tc_index range ( tDataType tLow, tDataType tHigh, tca_dict* ptcaNodes, tc_dict ptcdParentNode = nullptr );
+
+    // Nodes of the level whose string key starts with pcPrefix in key order, put in ptcaNodes (reset first)
+    tc_index prefix ( tc_str pcPrefix, tca_dict* ptcaNodes, tc_dict ptcdParentNode = nullptr );
+
+    /*
+      Replaced and erased string values that were not inlined leave dead slots in the string column, the column is compacted
+      once at least half of its slots (and TD_COMPACT_MIN_DEAD_SLOTS) are dead, or on demand with compact()
+      Compaction moves the strings, pointers returned by get()/getNodeValue() to them are invalidated
+      Erased string keys stay in the key pool until it is rebuilt with the live keys, once as many string key nodes
+      (and TD_COMPACT_MIN_DEAD_SLOTS) were erased as are left, or on demand with compact()
+      The rebuild moves the keys, pointers returned by getNodeKey() to them are invalidated and the key pool stats restart
+    */
+    tc_bool compact ( void );
+
+    tc_index getNumDeadSlots ( void ) const {
+      return m_iNumDeadStrings;
+    }
+
+    // String key nodes erased since the key pool was last rebuilt
+    tc_index getNumDeadKeys ( void ) const {
+      return m_iNumDeadKeys;
+    }
+
+    tc_void enableAutoCompact ( void ) {
+      m_bEnableAutoCompact = true;
+    }
+
+    tc_void disableAutoCompact ( void ) {
+      m_bEnableAutoCompact = false;
+    }
+
     template <typename tDataType>
     tc_void* get ( tDataType ptKey, tc_dict ptcdParentNode = nullptr );
+
+    // Node with the key in the level below the parent node (the root level for nullptr), nullptr if there is none
+    template <typename tDataType>
+    tc_dict find ( tDataType tKey, tc_dict ptcdParentNode = nullptr );
+
+    // Write the dict to a snapshot file, to be mapped read only by TeracadaDictSnapshot (teracada_dict_snapshot.cc)
+    tc_bool saveSnapshot ( const tc_char* pcFilePath );
 };
 
 #endif
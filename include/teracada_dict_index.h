@@ -0,0 +1,177 @@
+#ifndef _TERACADA_DICT_INDEX_H
+#define _TERACADA_DICT_INDEX_H
+
+#include <string_view>
+
+#include "teracada_common.h"
+#include "teracada_allocator.h"
+#include "teracada_array.h"
+#include "teracada_strings.h"
+
+// Minimum number of hash table slots, the table is kept at most 7/8 full
+#define TD_INDEX_MIN_NUM_SLOTS             16
+
+// Dict levels with up to this many nodes are scanned, the hash index of a level is only built past it
+#define TD_INDEX_MIN_NUM_NODES             8
+
+// Keys per B+tree node of the ordered index, the key words of a node fill two cache lines
+#define TD_BTREE_NODE_NUM_KEYS             16
+
+// Deepest B+tree path, nodes are at least half full after a split so this is never reached
+#define TD_BTREE_MAX_DEPTH                 32
+
+/*
+  Sort key of a dict key, keys are ordered by data type first (tc_int < tc_decimal < tc_str) and then by value
+  - ui64Word is an order preserving word of the value: the sign biased tc_int, the sign flipped tc_decimal bits,
+    the first 8 bytes of a string (big endian, zero padded).
+  - svString is the whole string (string keys only), compared when the words are equal.
+*/
+struct stdTeracadaDictKey {
+  tc_byte          b8DataType;
+  tc_uint64        ui64Word;
+  std::string_view svString;
+};
+
+/*
+  Hash index of the nodes of a single dict level (the root, or the children of a node)
+  - Keys are reduced to a (data type, 64-bit word) pair: the tc_int value, the tc_decimal bit pattern,
+    or the TeracadaStringPool id of an interned string key, so lookups never compare strings.
+  - Open addressing with Robin Hood linear probing: on insert a key takes the slot of any key closer to its home slot,
+    which keeps the probe lengths short and even, and a lookup stops as soon as it meets a key closer to home than itself.
+  - Keys are mapped to their node, and to the (0-based) index of the node in the level array, the index doesn't own the nodes.
+  - Keys are removed with backward shift deletion (no tombstones), the following keys of the cluster move one slot back.
+
+  Ordered index (bOrdered), kept alongside the hash table for range queries
+  - B+tree of the nodes by stdTeracadaDictKey, TD_BTREE_NODE_NUM_KEYS keys per tree node, the leaves are chained in key order.
+  - Tree nodes hold the key words and data types apart from the payloads, a node is searched without touching the dict nodes,
+    the string keys are only read from the pool when two words tie.
+  - Leaves are not merged on erase, an emptied leaf stays in the chain until the index is rebuilt.
+*/
+class TeracadaDictIndex {
+  private:
+    struct stdIndexSlot {
+      tc_uint64 ui64Key;
+      tc_dict   ptcdNode;
+      tc_index  iNodeIndex;
+      // Distance from the home slot + 1, 0 for an empty slot
+      tc_uint32 ui32Distance;
+      tc_byte   b8DataType;
+    };
+
+    struct stdTreeNode {
+      tc_uint64     aui64Words[TD_BTREE_NODE_NUM_KEYS];
+      tc_byte       ab8DataTypes[TD_BTREE_NODE_NUM_KEYS];
+      tc_uint32     ui32NumKeys;
+      tc_bool       bLeaf;
+      // Next leaf in key order
+      stdTreeNode*  pstNext;
+
+      union {
+        // Leaf: the dict node of each key
+        tc_dict     aptcdNodes[TD_BTREE_NODE_NUM_KEYS];
+        // Inner node: the pool id of each string key, the separator key i is the smallest key of the child i
+        tc_index    aiStringIds[TD_BTREE_NODE_NUM_KEYS];
+      };
+
+      stdTreeNode*  apstChildren[TD_BTREE_NODE_NUM_KEYS];
+    };
+
+    stdIndexSlot*     m_pstSlots;
+    tc_uint64         m_ui64NumSlots;
+    tc_uint64         m_ui64NumKeys;
+
+    // Ordered index, nullptr unless bOrdered
+    stdTreeNode*      m_pstTreeRoot;
+    tc_uint64         m_ui64NumTreeNodes;
+    tc_bool           m_bOrdered;
+
+    // Tree nodes allocated by treeInsert() ahead of the splits of an insert, so that an insert never fails half way
+    stdTreeNode*      m_apstSpareNodes[TD_BTREE_MAX_DEPTH + 1];
+    tc_uint32         m_ui32NumSpareNodes;
+
+    // Pool of the string keys, not owned by the index
+    const TeracadaStringPool* m_pobjKeyPool;
+
+    // Allocator of the slots and tree nodes, not owned by the index
+    TeracadaAllocator* m_pobjAllocator;
+
+    static tc_uint64 hashKey ( tc_byte b8DataType, tc_uint64 ui64Key );
+
+    tc_uint64 findSlot ( tc_byte b8DataType, tc_uint64 ui64Key ) const;
+
+    tc_bool growSlots ( void );
+    tc_bool insertSlot ( stdIndexSlot stSlot );
+
+    stdTreeNode* newTreeNode ( tc_bool bLeaf );
+    tc_void freeTree ( stdTreeNode* pstNode );
+
+    tc_int compareEntry ( const stdTeracadaDictKey& stKey, const stdTreeNode* pstNode, tc_uint32 ui32Entry ) const;
+    tc_uint32 findChild ( const stdTreeNode* pstNode, const stdTeracadaDictKey& stKey ) const;
+    tc_uint32 findEntry ( const stdTreeNode* pstNode, const stdTeracadaDictKey& stKey ) const;
+
+    stdTreeNode* splitTreeNode ( stdTreeNode* pstNode );
+    tc_void setSeparator ( stdTreeNode* pstNode, tc_uint32 ui32Entry, stdTreeNode* pstChild );
+    stdTreeNode* insertEntry ( stdTreeNode* pstNode, tc_uint32 ui32Entry, const stdTeracadaDictKey& stKey, tc_dict ptcdNode, stdTreeNode* pstChild );
+    tc_bool treeInsert ( tc_dict ptcdNode );
+    tc_void treeErase ( tc_dict ptcdNode );
+
+    const stdTreeNode* treeLowerBound ( const stdTeracadaDictKey& stKey, tc_uint32* pui32Entry ) const;
+
+  public:
+    TeracadaDictIndex ( TeracadaAllocator* pobjAllocator = nullptr, tc_uint64 ui64NumKeys = 0,
+                        const TeracadaStringPool* pobjKeyPool = nullptr, tc_bool bOrdered = false );
+    ~TeracadaDictIndex ( void );
+
+    TeracadaDictIndex ( const TeracadaDictIndex& objOther ) = delete;
+    TeracadaDictIndex& operator= ( const TeracadaDictIndex& objOther ) = delete;
+
+    tc_uint64 getNumKeys ( void ) const {
+      return m_ui64NumKeys;
+    }
+
+    tc_bool isOrdered ( void ) const {
+      return m_bOrdered;
+    }
+
+    // Bytes of the slots and tree nodes
+    tc_uint64 getIndexSize ( void ) const {
+      return (m_ui64NumSlots * sizeof(stdIndexSlot)) + (m_ui64NumTreeNodes * sizeof(stdTreeNode));
+    }
+
+    // Key word of a tc_decimal key, -0.0 is stored as 0.0 so that both find the same node (as with ==)
+    static tc_uint64 decimalKey ( tc_decimal dKey );
+
+    static stdTeracadaDictKey sortKey ( tc_int iKey );
+    static stdTeracadaDictKey sortKey ( tc_decimal dKey );
+    static stdTeracadaDictKey sortKey ( std::string_view svKey );
+
+    // Sort key of a dict node, string keys are read from the pool
+    static stdTeracadaDictKey sortKey ( tc_dict ptcdNode, const TeracadaStringPool* pobjKeyPool );
+
+    // <0, 0 or >0 as the first key sorts before, equal to or after the second one
+    static tc_int compareKeys ( const stdTeracadaDictKey& stKeyA, const stdTeracadaDictKey& stKeyB );
+
+    // Adds the key, a key already in the index keeps its node (false on allocation failure only)
+    tc_bool insert ( tc_byte b8DataType, tc_uint64 ui64Key, tc_dict ptcdNode, tc_index iNodeIndex );
+
+    // Node of the key, nullptr if the key is not in the index (its node index is returned in piNodeIndex)
+    tc_dict find ( tc_byte b8DataType, tc_uint64 ui64Key, tc_index* piNodeIndex = nullptr ) const;
+
+    // Moves an indexed key to another node index (false if the key is not in the index)
+    tc_bool assign ( tc_byte b8DataType, tc_uint64 ui64Key, tc_index iNodeIndex );
+
+    tc_bool erase ( tc_byte b8DataType, tc_uint64 ui64Key );
+
+    tc_void clear ( void );
+
+    // Ordered index only: first node with a key not less than stKey (of the same data type), nullptr if there is none
+    tc_dict lowerBound ( const stdTeracadaDictKey& stKey ) const;
+
+    // Ordered index only: appends the nodes with stLow <= key < stHigh in key order, the number of nodes appended (TA_NONE_INDEX on failure)
+    tc_index range ( const stdTeracadaDictKey& stLow, const stdTeracadaDictKey& stHigh, tca_dict* ptcaNodes ) const;
+
+    // Ordered index only: appends the nodes whose string key starts with svPrefix in key order
+    tc_index prefix ( std::string_view svPrefix, tca_dict* ptcaNodes ) const;
+};
+
+#endif
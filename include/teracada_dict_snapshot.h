@@ -0,0 +1,117 @@
+#ifndef _TERACADA_DICT_SNAPSHOT_H
+#define _TERACADA_DICT_SNAPSHOT_H
+
+#include <string_view>
+
+#include "teracada_common.h"
+#include "teracada_dict.h"
+
+#define TD_SNAPSHOT_MAGIC                  "TCDSNAP"
+#define TD_SNAPSHOT_VERSION                1
+
+// The node table starts on a cache line
+#define TD_SNAPSHOT_ALIGNMENT              64
+
+/*
+  Node of a dict snapshot, all the references are offsets/indexes, the nodes are used right from the mapped file
+  - The nodes of a level are contiguous in the node table, sorted by key (see stdTeracadaDictKey), the root level first.
+  - String keys and values are null terminated strings of the string arena, at unKey/unVal.ui64Offset.
+*/
+struct stdTeracadaDictSnapshotNode {
+  // Order preserving word of the key (stdTeracadaDictKey::ui64Word), the nodes are compared on it first
+  tc_uint64 ui64KeyWord;
+
+  union {
+    tc_int     iInt;
+    tc_decimal dDecimal;
+    tc_uint64  ui64Offset;
+  } unKey;
+
+  union {
+    tc_int     iInt;
+    tc_decimal dDecimal;
+    tc_uint64  ui64Offset;
+  } unVal;
+
+  // Children, ui32NumChildren nodes from ui64FirstChild in the node table
+  tc_uint64 ui64FirstChild;
+  tc_uint32 ui32NumChildren;
+
+  tc_uint32 ui32KeyLength;
+  tc_byte   b8DataTypeKey;
+  tc_byte   b8DataTypeVal;
+};
+
+typedef const stdTeracadaDictSnapshotNode* tc_dict_snapshot_node;
+
+struct stdTeracadaDictSnapshotHeader {
+  tc_char   acMagic[8];
+  tc_uint32 ui32Version;
+  // Sizes of the build that wrote the snapshot, a snapshot is only opened by a build with the same ones
+  tc_byte   b8IntSize;
+  tc_byte   b8DecimalSize;
+  tc_byte   b8NodeSize;
+  tc_byte   b8Reserved;
+  tc_uint64 ui64FileSize;
+
+  tc_uint64 ui64NodesOffset;
+  tc_uint64 ui64NumNodes;
+  tc_uint64 ui64NumRootNodes;
+
+  tc_uint64 ui64StringsOffset;
+  tc_uint64 ui64StringsSize;
+};
+
+/*
+  Read only TeracadaDict snapshot, written by TeracadaDict::saveSnapshot() and mapped with mmap() by open()
+  - Nothing is deserialized on open(), the header is checked and the lookups binary search the sorted levels
+    of the mapped node table, so the pages are only read in as they are looked up.
+  - Values are returned as pointers into the mapping (tc_int, tc_decimal or null terminated string),
+    valid until close() or the destructor.
+  - The snapshot is position independent and can be mapped by any number of processes, it has to be written and read
+    by builds with the same data type sizes (_TERACADA_DTYPE32/_TERACADA_DTYPE64) and byte order.
+*/
+class TeracadaDictSnapshot {
+  private:
+    const tc_byte*    m_pb8Mapping;
+    tc_uint64         m_ui64MappingSize;
+
+    const stdTeracadaDictSnapshotHeader* m_pstHeader;
+    const stdTeracadaDictSnapshotNode*   m_pstNodes;
+    const tc_char*    m_pcStrings;
+
+    tc_bool checkNode ( tc_dict_snapshot_node pstNode ) const;
+    tc_int compareNode ( const stdTeracadaDictKey& stKey, tc_dict_snapshot_node pstNode ) const;
+
+  public:
+    TeracadaDictSnapshot ( void );
+    ~TeracadaDictSnapshot ( void );
+
+    TeracadaDictSnapshot ( const TeracadaDictSnapshot& objOther ) = delete;
+    TeracadaDictSnapshot& operator= ( const TeracadaDictSnapshot& objOther ) = delete;
+
+    // Map the snapshot file, false if it can't be mapped or is not a snapshot of this build
+    tc_bool open ( const tc_char* pcFilePath );
+    tc_void close ( void );
+
+    tc_bool isOpen ( void ) const {
+      return m_pb8Mapping != nullptr;
+    }
+
+    tc_uint64 getNumNodes ( void ) const {
+      return m_pstHeader ? m_pstHeader->ui64NumNodes : 0;
+    }
+
+    // Node with the key in the level below the parent node (the root level for nullptr), nullptr if there is none
+    template <typename tDataType>
+    tc_dict_snapshot_node find ( tDataType tKey, tc_dict_snapshot_node pstParentNode = nullptr ) const;
+
+    // Value of the key (as TeracadaDict::get()), nullptr if there is no such key
+    template <typename tDataType>
+    const tc_void* get ( tDataType tKey, tc_dict_snapshot_node pstParentNode = nullptr ) const;
+
+    const tc_void* getNodeKey ( tc_dict_snapshot_node pstNode ) const;
+    const tc_void* getNodeValue ( tc_dict_snapshot_node pstNode ) const;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef _TERACADA_METRICS_H
+#define _TERACADA_METRICS_H
+
+#include <atomic>
+
+#include "teracada_common.h"
+
+
+// Default file path for the background metrics exporter
+#define TC_METRICS_DUMP_FPATH              "/dev/shm/teracada_metrics"
+
+// Default interval between two exports of the background metrics exporter
+#define TC_METRICS_EXPORT_INTERVAL_MS      1000
+
+/*
+  Snapshot of the TeracadaArray buffer metrics.
+  Per-array snapshots (TeracadaArray::getMetrics()) report the array's own buffer,
+  process-wide snapshots (TeracadaMetrics::getArrayMetrics()) report all the arrays together.
+*/
+struct stdTeracadaArrayMetrics {
+  // Number of buffer reallocation attempts, the failed ones included
+  tc_uint64 ui64ReallocAttempts;
+
+  // Bytes copied by realloc when the buffer had to be moved
+  tc_uint64 ui64BytesMoved;
+
+  // Current buffer capacity in bytes
+  tc_uint64 ui64CapacityBytes;
+
+  // Highest buffer capacity in bytes seen so far
+  tc_uint64 ui64PeakCapacityBytes;
+};
+
+/*
+  Memory footprint of a single TeracadaArray (TeracadaArray::getFootprint()).
+  Resident bytes are counted in whole pages of the main buffer that are backed by RAM,
+  untouched pages of a lazily (not zero filled) or calloc() allocated buffer are not resident.
+*/
+struct stdTeracadaArrayFootprint {
+  // Size of the array object itself
+  tc_uint64 ui64ObjectBytes;
+
+  // Main array buffer capacity in bytes
+  tc_uint64 ui64CapacityBytes;
+
+  // Bytes of the storage mode buffers (rope chunks, ring window aggregates)
+  tc_uint64 ui64StorageBytes;
+
+  // Bytes holding the array elements (and the TC_CHAR null terminator)
+  tc_uint64 ui64UsedBytes;
+
+  // Allocated bytes not holding elements (capacity + storage - used)
+  tc_uint64 ui64SlackBytes;
+
+  // Bytes of the main array buffer resident in RAM
+  tc_uint64 ui64ResidentBytes;
+
+  // Object + capacity + storage bytes
+  tc_uint64 ui64TotalBytes;
+};
+
+
+/*
+  Process-wide, lock-free TeracadaArray buffer metrics.
+  The counters are only updated when an array buffer is allocated, reallocated or freed,
+  never on plain insert/get/remove, and can be read at any time from any thread.
+*/
+class TeracadaMetrics {
+  private:
+    static std::atomic<tc_uint64> m_aui64ReallocAttempts;
+    static std::atomic<tc_uint64> m_aui64BytesMoved;
+    static std::atomic<tc_uint64> m_aui64CapacityBytes;
+    static std::atomic<tc_uint64> m_aui64PeakCapacityBytes;
+
+  public:
+    static tc_void recordAlloc ( tc_uint64 ui64Bytes );
+    static tc_void recordReallocAttempt ( void );
+    static tc_void recordRealloc ( tc_uint64 ui64PreBytes, tc_uint64 ui64NewBytes, tc_bool bMoved );
+    static tc_void recordFree ( tc_uint64 ui64Bytes );
+
+    static stdTeracadaArrayMetrics getArrayMetrics ( void );
+    static tc_void resetArrayMetrics ( void );
+
+    static tc_bool dumpArrayMetrics ( const tc_char* pcFilePath = TC_METRICS_DUMP_FPATH );
+
+    static tc_bool startExporter ( const tc_char* pcFilePath = TC_METRICS_DUMP_FPATH, tc_int iIntervalMs = TC_METRICS_EXPORT_INTERVAL_MS );
+    static tc_void stopExporter ( void );
+    static tc_bool isExporterRunning ( void );
+};
+
+#endif
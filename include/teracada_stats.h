@@ -0,0 +1,174 @@
+#ifndef _TERACADA_STATS_H
+#define _TERACADA_STATS_H
+
+#include <atomic>
+#include <functional>
+
+#include "teracada_common.h"
+
+/*
+  SIMD levels of the stats reduction kernels (see TeracadaStats::setSimdLevel())
+  - TS_SIMD_SCALAR: Plain element by element loop, the fallback on every cpu
+  - TS_SIMD_SSE2: 128 bit vectors (x86 baseline)
+  - TS_SIMD_AVX2: 256 bit vectors
+  - TS_SIMD_AVX512: 512 bit vectors (AVX-512 F/BW/DQ/VL)
+*/
+enum {
+  TS_SIMD_SCALAR,
+  TS_SIMD_SSE2,
+  TS_SIMD_AVX2,
+  TS_SIMD_AVX512
+};
+
+// Number of vectors a kernel reduces per iteration, each into its own accumulators
+#define TS_SIMD_NUM_VECTORS                4
+
+// Threads of the parallel reductions, the calling thread included (see TeracadaStats::setNumThreads())
+#define TS_MAX_NUM_THREADS                 256
+
+// Default elements of the smallest chunk of a parallel reduction, smaller arrays are reduced by the calling thread
+#define TS_PARALLEL_MIN_CHUNK_SIZE         (1 << 20)
+
+// Chunks per thread, the threads that are done first take over the remaining chunks
+#define TS_PARALLEL_CHUNKS_PER_THREAD      4
+
+// Positions the search kernels (TeracadaArray::argMin(), argMax(), argWhere()) buffer before inserting them in the positions array
+#define TS_POSITIONS_BUFFER_SIZE           1024
+
+// Elements TeracadaStatsMoments::add() reduces per block, the block is read twice from the cache
+#define TS_MOMENTS_BLOCK_SIZE              4096
+
+/*
+  Min, max, sum and sum of squares of elements, reduced in a single pass (TeracadaArray::summarize())
+  The sums are of the elements shifted by dShift (the first element of the array), so the variance
+  (dSumSquares - dSum^2 / n) does not cancel out when the elements are large compared to their spread.
+  Summaries of chunks of an array reduced with the same shift are merged by adding them up (TeracadaStats::reduce()).
+*/
+template <typename tDataType>
+struct stdTeracadaStatsSummary {
+  tc_index  iNumElements;
+  tDataType tMin;
+  tDataType tMax;
+
+  tc_double dShift;
+  tc_double dSum;
+  tc_double dSumSquares;
+};
+
+/*
+  Reduction kernels of the stats functions (teracada_stats.cc)
+  - The kernel is picked at runtime, the best SIMD level the cpu supports unless capped with setSimdLevel().
+  - Arrays of at least twice the min chunk size are split in chunks reduced in parallel by a pool of worker threads
+    and the calling thread once setNumThreads() is more than 1 (1 by default). The partial results are merged in the
+    order of the chunks, so the results don't depend on which threads reduced them.
+*/
+class TeracadaStats {
+  private:
+    // Cap set with setSimdLevel(), the best supported level is used if it is higher than the cpu supports
+    static std::atomic<tc_byte> m_ab8SimdLevel;
+
+    static std::atomic<tc_uint32> m_aui32NumThreads;
+    static std::atomic<tc_index>  m_aiMinChunkSize;
+
+  public:
+    // Best SIMD level supported by the cpu (TS_SIMD_SCALAR when not built for x86)
+    static tc_byte getMaxSimdLevel ( void );
+
+    // SIMD level used by the kernels
+    static tc_byte getSimdLevel ( void );
+
+    // Cap the SIMD level used by the kernels (e.g. TS_SIMD_SCALAR), returns the level in effect
+    static tc_byte setSimdLevel ( tc_byte b8SimdLevel );
+
+    static const tc_char* getSimdLevelName ( tc_byte b8SimdLevel );
+
+    static tc_uint32 getNumThreads ( void );
+
+    // Threads of the parallel reductions (0 for as many as the cpu has), returns the number in effect
+    static tc_uint32 setNumThreads ( tc_uint32 ui32NumThreads );
+
+    static tc_index getMinChunkSize ( void );
+    static tc_index setMinChunkSize ( tc_index iMinChunkSize );
+
+    // Chunks the elements are split in for a parallel reduction, 1 when they are reduced by the calling thread
+    static tc_index getNumChunks ( tc_index iNumElements );
+
+    // Run fnChunk for every chunk in [0, iNumChunks), on the worker threads and the calling thread, returns once all are done
+    static tc_void parallelFor ( tc_index iNumChunks, const std::function<tc_void ( tc_index )>& fnChunk );
+
+    // Add the elements to the summary (initialized with iNumElements 0 and the shift)
+    template <typename tDataType>
+    static tc_void reduce ( const tDataType* ptElements, tc_index iNumElements, stdTeracadaStatsSummary<tDataType>* pstSummary );
+};
+
+/*
+  Count, mean, min, max and the central moment sums M2, M3 and M4 of a stream of elements, for the arithmetic data types
+  - add() updates the moments in a single pass over the elements: a block of elements is reduced on its own
+    (TeracadaStats::reduce() then its central moments while it is in the cache) and merged into the moments with the
+    pairwise update formulas of Chan et al. and Pebay, so the sums never cancel out whatever the magnitude of the elements.
+  - The moments of chunks of the elements (threads, partitions, streams) are combined with merge(), the result is the
+    same as adding all of the elements to one of them, up to the rounding.
+*/
+template <typename tDataType>
+class TeracadaStatsMoments {
+  private:
+    tc_index  m_iNumElements;
+    tDataType m_tMin;
+    tDataType m_tMax;
+
+    tc_double m_dMean;
+    tc_double m_dM2;
+    tc_double m_dM3;
+    tc_double m_dM4;
+
+    tc_void addBlocks ( const tDataType* ptElements, tc_index iNumElements );
+
+    tc_void mergeMoments ( tc_index iNumElements, tDataType tMin, tDataType tMax, tc_double dMean, tc_double dM2, tc_double dM3, tc_double dM4 );
+
+  public:
+    TeracadaStatsMoments ( void ) {
+      reset();
+    }
+
+    tc_void reset ( void ) {
+      m_iNumElements = 0;
+      m_tMin = m_tMax = tDataType {};
+      m_dMean = m_dM2 = m_dM3 = m_dM4 = 0;
+    }
+
+    tc_void add ( tDataType tValue );
+    tc_void add ( const tDataType* ptElements, tc_index iNumElements );
+
+    tc_void merge ( const TeracadaStatsMoments& objOther );
+
+    tc_index getNumElements ( void ) const {
+      return m_iNumElements;
+    }
+
+    // The min, max and mean are 0 while there are no elements
+    tDataType getMin ( void ) const {
+      return m_tMin;
+    }
+
+    tDataType getMax ( void ) const {
+      return m_tMax;
+    }
+
+    tc_double getMean ( void ) const {
+      return m_dMean;
+    }
+
+    // Variance and standard deviation with iDeltaDOF delta degrees of freedom, negative if there are not more elements than iDeltaDOF
+    tc_double getVariance ( tc_int iDeltaDOF = 0 ) const;
+    tc_double getStandardDeviation ( tc_int iDeltaDOF = 0 ) const;
+
+    // Population skewness (g1) and excess kurtosis (g2), 0 when there are no elements or they are all equal
+    tc_double getSkewness ( void ) const;
+    tc_double getKurtosis ( void ) const;
+};
+
+template class TeracadaStatsMoments<tc_byte>;
+template class TeracadaStatsMoments<tc_int>;
+template class TeracadaStatsMoments<tc_decimal>;
+
+#endif
@@ -0,0 +1,349 @@
+#ifndef _TERACADA_STRINGS_H
+#define _TERACADA_STRINGS_H
+
+#include <string_view>
+
+#include "teracada_common.h"
+#include "teracada_error.h"
+#include "teracada_metrics.h"
+#include "teracada_allocator.h"
+#include "teracada_array.h"
+
+// Average string length used to size the character buffer, when its size is not passed to the constructor
+#define TS_DEFAULT_AVG_STRING_LENGTH       16
+
+/*
+  Owned string column (Arrow-style layout)
+  - All the characters are stored back to back in a single character buffer, every string followed by a null terminator.
+  - The offsets buffer holds the start of every string in the character buffer, plus the end of the last string,
+    so the length of a string is (offset[i + 1] - offset[i] - 1) and is never recomputed with strlen().
+  - Both buffers are owned by the column and taken from its allocator, they grow geometrically.
+  - Strings may contain null characters, the terminators are only there so that getCStr() is free.
+
+  Positions follow TeracadaArray: 1-based from the left, negative from the right, 0 after the last string.
+  Views returned by get()/operator[] are invalidated by the next insert/remove/resize of the column.
+*/
+class TeracadaStringArray {
+  private:
+    // Character buffer, used bytes include the null terminators
+    tc_char*          m_pcChars;
+    tc_uint64         m_ui64NumChars;
+    tc_uint64         m_ui64MaxChars;
+
+    // Offsets buffer, holds (m_iNumStrings + 1) offsets, capacity is (m_iMaxNumStrings + 1) offsets
+    tc_uint64*        m_pui64Offsets;
+    tc_index          m_iNumStrings;
+    tc_index          m_iMaxNumStrings;
+
+    // Allocator of both buffers, not owned by the column (TeracadaAllocator::getDefault() if none is passed)
+    TeracadaAllocator* m_pobjAllocator;
+
+    tc_bool           m_bIsInitSuccess;
+
+    // Value 0 represents no error
+    tc_int            m_iErrno;
+    tc_bool           m_bEnableExceptions;
+
+
+  protected:
+    tc_uint64 getOffsetsSize ( tc_index iMaxNumStrings ) const {
+      return ((tc_uint64) (iMaxNumStrings + 1) * sizeof(tc_uint64));
+    }
+
+    tc_index positionToIndex ( tc_index iPosition );
+
+    tc_bool reallocChars ( tc_uint64 ui64NewMaxChars );
+    tc_bool reallocOffsets ( tc_index iNewMaxNumStrings );
+    tc_bool growBeforeInsert ( tc_index iNumStrings, tc_uint64 ui64NumChars );
+
+    tc_void freeBuffers ( void );
+    tc_void moveFrom ( TeracadaStringArray& objOther );
+
+
+  public:
+    TeracadaStringArray ( tc_index iNumStrings = 100, tc_uint64 ui64NumChars = 0, TeracadaAllocator* pobjAllocator = nullptr );
+
+    // Moved-from columns are left uninitialized (no buffers)
+    TeracadaStringArray ( TeracadaStringArray&& objOther ) noexcept;
+    TeracadaStringArray& operator= ( TeracadaStringArray&& objOther ) noexcept;
+
+    TeracadaStringArray ( const TeracadaStringArray& objOther ) = delete;
+    TeracadaStringArray& operator= ( const TeracadaStringArray& objOther ) = delete;
+
+    ~TeracadaStringArray ( void );
+
+    tc_bool isInitSuccess ( void ) const {
+      return m_bIsInitSuccess;
+    }
+
+    TeracadaAllocator* getAllocator ( void ) const {
+      return m_pobjAllocator;
+    }
+
+    tc_index getNumElements ( void ) const {
+      return m_iNumStrings;
+    }
+
+    tc_index getMaxNumElements ( void ) const {
+      return m_iMaxNumStrings;
+    }
+
+    // Characters of all the strings, without the null terminators
+    tc_uint64 getNumChars ( void ) const {
+      return m_ui64NumChars - (tc_uint64) m_iNumStrings;
+    }
+
+    tc_uint64 getMaxNumChars ( void ) const {
+      return m_ui64MaxChars;
+    }
+
+    // Raw buffers, for scanning the whole column
+    const tc_char* getChars ( void ) const {
+      return m_pcChars;
+    }
+
+    const tc_uint64* getOffsets ( void ) const {
+      return m_pui64Offsets;
+    }
+
+    // Bytes held by both buffers
+    tc_uint64 getArraySize ( void ) const {
+      return (m_ui64MaxChars + (m_pui64Offsets ? getOffsetsSize(m_iMaxNumStrings) : 0));
+    }
+
+    tc_int getErrno ( void ) const {
+      return m_iErrno;
+    }
+
+    tc_void setErrno ( tc_int iErrno ) {
+      // Don't overwrite error number
+      if ( ! getErrno() )
+        m_iErrno = iErrno;
+    }
+
+    tc_void enableExceptions ( void ) {
+      m_bEnableExceptions = true;
+    }
+
+    tc_void disableExceptions ( void ) {
+      m_bEnableExceptions = false;
+    }
+
+    tc_bool isExceptionsEnabled ( void ) const {
+      return m_bEnableExceptions;
+    }
+
+    tc_index insert ( tc_index iPosition, std::string_view svValue );
+
+    tc_index insertBack ( std::string_view svValue ) {
+      return insert(0, svValue);
+    }
+
+    tc_index insertFront ( std::string_view svValue ) {
+      return insert(1, svValue);
+    }
+
+    tc_index appendBulk ( const tc_char* pcBuffer, tc_uint64 ui64NumChars, tc_char cDelimiter = '\n' );
+    tc_index appendBulk ( const tc_char* pcChars, const tc_index* piLengths, tc_index iNumStrings );
+
+    tc_bool remove ( tc_index iPosition = 0, tc_index iNumElements = 1 );
+
+    tc_bool reserve ( tc_index iNumStrings, tc_uint64 ui64NumChars = 0 );
+
+    tc_bool shrinkToFit ( void );
+
+    tc_bool reset ( void );
+
+    std::string_view get ( tc_index iPosition = 1 );
+    const tc_char* getCStr ( tc_index iPosition = 1 );
+
+    // Typed unchecked access, with a 0-based index (no position translation, init or bounds check)
+    std::string_view operator[] ( tc_index iIndex ) const {
+      return std::string_view((m_pcChars + m_pui64Offsets[iIndex]), (m_pui64Offsets[iIndex + 1] - m_pui64Offsets[iIndex] - 1));
+    }
+
+    tc_index find ( std::string_view svValue, tc_index iFromPosition = 1 );
+
+    tc_void print ( void );
+
+
+    /* Function declarations for teracada_error.cc */
+
+    tc_str getErrStr ( tc_int iErrno = 0 );
+    tc_void throwException ( tc_int iErrno = 0 );
+};
+
+typedef TeracadaStringArray tca_strings;
+
+
+// TeracadaStringPool: Default size of the blocks the interned strings are copied to
+#define TS_POOL_BLOCK_SIZE                 (64 << 10)
+
+// TeracadaStringPool: Minimum number of hash table slots, the table is kept at most 3/4 full
+#define TS_POOL_MIN_NUM_SLOTS              64
+
+/*
+  Snapshot of the string pool counters (TeracadaStringPool::getStats())
+*/
+struct stdTeracadaStringPoolStats {
+  // Number of intern() calls, and of those that found the string already in the pool
+  tc_uint64 ui64NumInterns;
+  tc_uint64 ui64NumHits;
+
+  // Number of distinct strings, and their bytes (null terminators included)
+  tc_uint64 ui64NumStrings;
+  tc_uint64 ui64StoredBytes;
+
+  // Bytes the hits would have taken as separate copies (null terminators included)
+  tc_uint64 ui64BytesSaved;
+
+  // Bytes of the blocks, entries and hash table
+  tc_uint64 ui64TotalBytes;
+};
+
+/*
+  String interning pool, not thread safe
+  - Every distinct string is copied once to blocks that never move, and gets a dense id (0, 1, 2, ...) in insertion order.
+  - intern() of an equal string returns the same id and the same stable null terminated copy,
+    so interned strings compare by id (or by pointer, when stored in a TeracadaArray<tc_str>).
+  - Lookups go through an open addressing (linear probing) hash table of the ids, the hashes are kept with the strings.
+  - Strings are only released by the destructor, the stored pointers are valid for the lifetime of the pool.
+*/
+class TeracadaStringPool {
+  private:
+    struct stdPoolBlock {
+      stdPoolBlock*  pstPrev;
+      tc_uint64      ui64Size;
+      tc_uint64      ui64Used;
+    };
+
+    struct stdPoolEntry {
+      const tc_char* pcString;
+      tc_uint64      ui64Length;
+      tc_uint64      ui64Hash;
+    };
+
+    // Blocks the strings are copied to, m_pstBlock is the one being filled
+    stdPoolBlock*     m_pstBlock;
+    tc_uint64         m_ui64BlockSize;
+
+    // Strings by id
+    stdPoolEntry*     m_pstEntries;
+    tc_index          m_iNumStrings;
+    tc_index          m_iMaxNumStrings;
+
+    // Hash table of the ids, TA_NONE_INDEX for the empty slots, the number of slots is a power of two
+    tc_index*         m_piSlots;
+    tc_uint64         m_ui64NumSlots;
+
+    // Allocator of the blocks, entries and hash table, not owned by the pool (TeracadaAllocator::getDefault() if none is passed)
+    TeracadaAllocator* m_pobjAllocator;
+
+    tc_bool           m_bIsInitSuccess;
+
+    tc_uint64         m_ui64NumInterns;
+    tc_uint64         m_ui64NumHits;
+    tc_uint64         m_ui64StoredBytes;
+    tc_uint64         m_ui64BytesSaved;
+    tc_uint64         m_ui64BlockBytes;
+
+    // Value 0 represents no error
+    tc_int            m_iErrno;
+    tc_bool           m_bEnableExceptions;
+
+
+  protected:
+    static tc_uint64 hashString ( std::string_view svValue );
+
+    tc_index lookup ( std::string_view svValue, tc_uint64 ui64Hash, tc_uint64* pui64Slot ) const;
+
+    const tc_char* copyString ( std::string_view svValue );
+    tc_bool growEntries ( void );
+    tc_bool growSlots ( void );
+
+
+  public:
+    TeracadaStringPool ( tc_index iNumStrings = 1024, TeracadaAllocator* pobjAllocator = nullptr, tc_uint64 ui64BlockSize = TS_POOL_BLOCK_SIZE );
+    ~TeracadaStringPool ( void );
+
+    TeracadaStringPool ( const TeracadaStringPool& objOther ) = delete;
+    TeracadaStringPool& operator= ( const TeracadaStringPool& objOther ) = delete;
+
+    tc_bool isInitSuccess ( void ) const {
+      return m_bIsInitSuccess;
+    }
+
+    TeracadaAllocator* getAllocator ( void ) const {
+      return m_pobjAllocator;
+    }
+
+    tc_index getNumElements ( void ) const {
+      return m_iNumStrings;
+    }
+
+    tc_index intern ( std::string_view svValue );
+
+    // Stable null terminated copy of the interned string, for TeracadaArray<tc_str> (nullptr on failure)
+    const tc_char* internCStr ( std::string_view svValue ) {
+      tc_index iId = intern(svValue);
+      return (iId < 0) ? nullptr : m_pstEntries[iId].pcString;
+    }
+
+    // Id of an already interned string, TA_NONE_INDEX if it is not in the pool (nothing is added)
+    tc_index find ( std::string_view svValue ) const;
+
+    std::string_view get ( tc_index iId ) const {
+      if ( iId < 0 || iId >= m_iNumStrings )
+        return std::string_view();
+
+      return std::string_view(m_pstEntries[iId].pcString, m_pstEntries[iId].ui64Length);
+    }
+
+    const tc_char* getCStr ( tc_index iId ) const {
+      return (iId < 0 || iId >= m_iNumStrings) ? nullptr : m_pstEntries[iId].pcString;
+    }
+
+    stdTeracadaStringPoolStats getStats ( void ) const;
+
+    // Share of the intern() calls that found the string already in the pool
+    tc_double getHitRate ( void ) const {
+      return m_ui64NumInterns ? ((tc_double) m_ui64NumHits / m_ui64NumInterns) : 0;
+    }
+
+    // Only the intern()/hit/bytes saved counters, the pool contents are kept
+    tc_void resetStats ( void ) {
+      m_ui64NumInterns = 0;
+      m_ui64NumHits = 0;
+      m_ui64BytesSaved = 0;
+    }
+
+    tc_int getErrno ( void ) const {
+      return m_iErrno;
+    }
+
+    tc_void setErrno ( tc_int iErrno ) {
+      // Don't overwrite error number
+      if ( ! getErrno() )
+        m_iErrno = iErrno;
+    }
+
+    tc_void enableExceptions ( void ) {
+      m_bEnableExceptions = true;
+    }
+
+    tc_void disableExceptions ( void ) {
+      m_bEnableExceptions = false;
+    }
+
+    tc_bool isExceptionsEnabled ( void ) const {
+      return m_bEnableExceptions;
+    }
+
+
+    /* Function declarations for teracada_error.cc */
+
+    tc_str getErrStr ( tc_int iErrno = 0 );
+    tc_void throwException ( tc_int iErrno = 0 );
+};
+
+#endif